@@ -0,0 +1,37 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+// Converts a Hypatia dynamic state directory (fstate_<ns>.txt files) into the
+// memory-mapped binary format replayed lazily by NDNSatSimulator::ImportDynamicStateSat.
+//
+// ./waf --run="fstate-to-binary --dynamic_state_dir='scenarios/data/<network>/dynamic_state_100ms_for_200s'"
+
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/fstate-binary.h"
+
+using namespace ns3;
+
+int
+main (int argc, char* argv[])
+{
+  std::string dynamicStateDir = "";
+  std::string output = "";
+  CommandLine cmd;
+  cmd.Usage ("Usage: ./waf --run=\"fstate-to-binary --dynamic_state_dir='<path/to/dynamic_state>'\"");
+  cmd.AddValue ("dynamic_state_dir", "Directory containing the fstate_<ns>.txt files", dynamicStateDir);
+  cmd.AddValue ("output", "Output file (default: <dynamic_state_dir>/fstate.bin)", output);
+  cmd.Parse (argc, argv);
+  if (dynamicStateDir.empty ())
+    {
+      cmd.PrintHelp (std::cout);
+      return 1;
+    }
+  if (output.empty ())
+    {
+      output = dynamicStateDir + "/fstate.bin";
+    }
+
+  uint32_t nEpochs = FstateBinaryFile::ConvertDirectory (dynamicStateDir, output);
+  std::cout << "Converted " << nEpochs << " epochs into " << output << std::endl;
+  return 0;
+}
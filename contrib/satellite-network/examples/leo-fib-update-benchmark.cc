@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+// Measures the rate at which LeoFibTable applies route changes to the FIBs of a synthetic
+// +Grid constellation (22 satellites per orbit), through signed command Interests to the FIB
+// manager and in place with L3Protocol::updateFib.
+//
+// Every epoch, each satellite changes its next hop toward a number of destinations to another
+// of its ISLs, so that after the first epoch every change replaces a route.
+//
+// ./waf --run="leo-fib-update-benchmark --satellites=1000 --destinations=100 --epochs=10"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/ndn-leo-fib-table.h"
+#include "ns3/ndn-leo-stack-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/point-to-point-laser-helper.h"
+
+using namespace ns3;
+
+static const uint32_t SATELLITES_PER_ORBIT = 22;
+
+// Node at the other end of the ISL of a device
+static uint32_t
+GetNeighbor (Ptr<Node> node, uint32_t deviceId)
+{
+  Ptr<Channel> channel = node->GetDevice (deviceId)->GetChannel ();
+  Ptr<NetDevice> other = channel->GetDevice (0)->GetNode () == node ? channel->GetDevice (1) : channel->GetDevice (0);
+  return other->GetNode ()->GetId ();
+}
+
+int
+main (int argc, char* argv[])
+{
+  uint32_t numSatellites = 1000;
+  uint32_t numDestinations = 100;
+  uint32_t numEpochs = 10;
+  double intervalMs = 100;
+  CommandLine cmd;
+  cmd.AddValue ("satellites", "Constellation size (rounded up to full orbits)", numSatellites);
+  cmd.AddValue ("destinations", "Destinations whose next hop changes on every node per epoch", numDestinations);
+  cmd.AddValue ("epochs", "Number of epochs", numEpochs);
+  cmd.AddValue ("interval_ms", "Time between epochs", intervalMs);
+  cmd.Parse (argc, argv);
+
+  uint32_t numOrbits = (numSatellites + SATELLITES_PER_ORBIT - 1) / SATELLITES_PER_ORBIT;
+  numSatellites = numOrbits * SATELLITES_PER_ORBIT;
+  numDestinations = std::min (numDestinations, numSatellites - 1);
+
+  std::cout << std::setw (10) << "nodes" << std::setw (10) << "mode" << std::setw (12) << "routes"
+            << std::setw (12) << "time (s)" << std::setw (14) << "routes/s" << std::setw (10) << "speedup" << std::endl;
+
+  double commandRate = 0;
+  for (bool inPlace : {false, true})
+    {
+      // Node ids restart from 0 after Simulator::Destroy, as LeoFibTable requires
+      NodeContainer satellites;
+      satellites.Create (numSatellites);
+      for (uint32_t sid = 0; sid < numSatellites; sid++)
+        {
+          Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+          mobility->SetPosition (Vector (7000000.0 + 1000.0 * sid, 0, 0));
+          satellites.Get (sid)->AggregateObject (mobility);
+        }
+      PointToPointLaserHelper laserHelper;
+      for (uint32_t sid = 0; sid < numSatellites; sid++)
+        {
+          uint32_t orbit = sid / SATELLITES_PER_ORBIT;
+          uint32_t index = sid % SATELLITES_PER_ORBIT;
+          laserHelper.Install (satellites.Get (sid),
+                               satellites.Get (orbit * SATELLITES_PER_ORBIT + (index + 1) % SATELLITES_PER_ORBIT));
+          laserHelper.Install (satellites.Get (sid), satellites.Get (((orbit + 1) % numOrbits) * SATELLITES_PER_ORBIT + index));
+        }
+      ndn::LeoStackHelper ndnHelper;
+      ndnHelper.Install (satellites);
+
+      Ptr<ndn::LeoFaceTable> faces = Create<ndn::LeoFaceTable> (satellites);
+      Ptr<ndn::LeoFibTable> table = Create<ndn::LeoFibTable> (satellites, faces, true);
+      table->SetInPlace (inPlace);
+      uint64_t routes = 0;
+      for (uint32_t epoch = 0; epoch < numEpochs; epoch++)
+        {
+          Ptr<ndn::LeoFibTable::Batch> batch = Create<ndn::LeoFibTable::Batch> ();
+          for (uint32_t sid = 0; sid < numSatellites; sid++)
+            {
+              Ptr<Node> node = satellites.Get (sid);
+              for (uint32_t k = 1; k <= numDestinations; k++)
+                {
+                  uint32_t deviceId = (epoch + k) % node->GetNDevices ();
+                  batch->Add (sid, (sid + k) % numSatellites, GetNeighbor (node, deviceId), deviceId);
+                }
+            }
+          routes += batch->GetN ();
+          table->Schedule (batch, MilliSeconds (epoch * intervalMs));
+        }
+
+      // Includes the dispatch of the command Interests and their responses
+      auto start = std::chrono::steady_clock::now ();
+      Simulator::Stop (MilliSeconds (numEpochs * intervalMs));
+      Simulator::Run ();
+      double seconds = std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+      double rate = routes / seconds;
+      if (!inPlace)
+        {
+          commandRate = rate;
+        }
+
+      std::cout << std::fixed << std::setprecision (2) << std::setw (10) << numSatellites
+                << std::setw (10) << (inPlace ? "in-place" : "commands") << std::setw (12) << routes
+                << std::setw (12) << seconds << std::setw (14) << std::setprecision (0) << rate
+                << std::setw (10) << std::setprecision (1) << rate / commandRate << std::endl;
+
+      table = 0;
+      Simulator::Destroy ();
+    }
+  return 0;
+}
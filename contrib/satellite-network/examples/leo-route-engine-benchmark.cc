@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+// Measures the time of a LeoRouteEngine update on synthetic +Grid constellations
+// (22 satellites per orbit, 550 km, 53 degrees) with ground stations spread over the
+// populated latitudes, for full and incremental updates over one or more threads.
+//
+// ./waf --run="leo-route-engine-benchmark --satellites=1000,5000,10000 --threads=1,8"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/gsl-helper.h"
+#include "ns3/leo-route-engine.h"
+#include "ns3/node-container.h"
+#include "ns3/point-to-point-laser-helper.h"
+
+using namespace ns3;
+
+static const double EARTH_RADIUS_M = 6378135.0;
+static const double ORBIT_RADIUS_M = EARTH_RADIUS_M + 550000.0;
+static const double MAX_GSL_LENGTH_M = 1089686.4181956202;
+static const uint32_t SATELLITES_PER_ORBIT = 22;
+
+static std::vector<uint32_t>
+ParseList (std::string list)
+{
+  std::vector<uint32_t> values;
+  std::istringstream in (list);
+  std::string value;
+  while (std::getline (in, value, ','))
+    {
+      values.push_back (std::stoul (value));
+    }
+  return values;
+}
+
+static void
+SetPosition (Ptr<Node> node, double radius, double x, double y, double z)
+{
+  node->GetObject<ConstantPositionMobilityModel> ()->SetPosition (Vector (radius * x, radius * y, radius * z));
+}
+
+// Circular orbits, evenly spaced ascending nodes
+static void
+MoveSatellites (NodeContainer satellites, uint32_t numOrbits, double t)
+{
+  const double inclination = 53.0 * M_PI / 180.0;
+  const double angularSpeed = 2 * M_PI / 5730.0;
+  for (uint32_t sid = 0; sid < satellites.GetN (); sid++)
+    {
+      uint32_t orbit = sid / SATELLITES_PER_ORBIT;
+      double raan = 2 * M_PI * orbit / numOrbits;
+      double u = 2 * M_PI * (sid % SATELLITES_PER_ORBIT) / SATELLITES_PER_ORBIT
+                 + M_PI / SATELLITES_PER_ORBIT * (orbit % 2) + angularSpeed * t;
+      double x = std::cos (u), y = std::sin (u) * std::cos (inclination), z = std::sin (u) * std::sin (inclination);
+      SetPosition (satellites.Get (sid), ORBIT_RADIUS_M, x * std::cos (raan) - y * std::sin (raan),
+                   x * std::sin (raan) + y * std::cos (raan), z);
+    }
+}
+
+int
+main (int argc, char* argv[])
+{
+  std::string satellitesList = "1000,5000,10000";
+  std::string threadsList = "1,0";
+  uint32_t numGroundStations = 100;
+  uint32_t numEpochs = 20;
+  double intervalMs = 100;
+  CommandLine cmd;
+  cmd.AddValue ("satellites", "Comma-separated constellation sizes", satellitesList);
+  cmd.AddValue ("ground_stations", "Number of ground stations", numGroundStations);
+  cmd.AddValue ("threads", "Comma-separated thread counts (0: one per core)", threadsList);
+  cmd.AddValue ("epochs", "Updates per measurement, after the first one", numEpochs);
+  cmd.AddValue ("interval_ms", "Time between updates", intervalMs);
+  cmd.Parse (argc, argv);
+
+  std::cout << std::setw (10) << "nodes" << std::setw (8) << "mode" << std::setw (9) << "threads"
+            << std::setw (14) << "first (ms)" << std::setw (15) << "update (ms)" << std::setw (14) << "changes"
+            << std::setw (16) << "settled" << std::endl;
+
+  for (uint32_t numSatellites : ParseList (satellitesList))
+    {
+      uint32_t numOrbits = (numSatellites + SATELLITES_PER_ORBIT - 1) / SATELLITES_PER_ORBIT;
+      numSatellites = numOrbits * SATELLITES_PER_ORBIT;
+
+      NodeContainer satellites;
+      satellites.Create (numSatellites);
+      NodeContainer groundStations;
+      groundStations.Create (numGroundStations);
+      NodeContainer nodes (satellites, groundStations);
+      for (uint32_t i = 0; i < nodes.GetN (); i++)
+        {
+          nodes.Get (i)->AggregateObject (CreateObject<ConstantPositionMobilityModel> ());
+        }
+      for (uint32_t gid = 0; gid < numGroundStations; gid++)
+        {
+          double lat = (-55.0 + 110.0 * gid / numGroundStations) * M_PI / 180.0;
+          double lon = 137.5 * gid * M_PI / 180.0;
+          SetPosition (groundStations.Get (gid), EARTH_RADIUS_M, std::cos (lat) * std::cos (lon),
+                       std::cos (lat) * std::sin (lon), std::sin (lat));
+        }
+
+      // +Grid ISLs and one GSL device per node
+      PointToPointLaserHelper laserHelper;
+      for (uint32_t sid = 0; sid < numSatellites; sid++)
+        {
+          uint32_t orbit = sid / SATELLITES_PER_ORBIT;
+          uint32_t index = sid % SATELLITES_PER_ORBIT;
+          laserHelper.Install (satellites.Get (sid),
+                               satellites.Get (orbit * SATELLITES_PER_ORBIT + (index + 1) % SATELLITES_PER_ORBIT));
+          laserHelper.Install (satellites.Get (sid), satellites.Get (((orbit + 1) % numOrbits) * SATELLITES_PER_ORBIT + index));
+        }
+      std::vector<std::tuple<int32_t, double> > gslIfInfo (numSatellites + numGroundStations, std::make_tuple (1, 1.0));
+      GSLHelper gslHelper;
+      gslHelper.Install (satellites, groundStations, gslIfInfo);
+
+      for (bool incremental : {false, true})
+        {
+          for (uint32_t nThreads : ParseList (threadsList))
+            {
+              Ptr<LeoRouteEngine> engine = Create<LeoRouteEngine> (satellites, groundStations, MAX_GSL_LENGTH_M);
+              engine->SetIncremental (incremental);
+              engine->SetNThreads (nThreads);
+
+              MoveSatellites (satellites, numOrbits, 0);
+              auto start = std::chrono::steady_clock::now ();
+              engine->Update ();
+              double firstMs = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - start).count ();
+
+              double totalMs = 0;
+              uint64_t changes = 0;
+              uint64_t settled = engine->GetNSettled ();
+              for (uint32_t epoch = 1; epoch <= numEpochs; epoch++)
+                {
+                  MoveSatellites (satellites, numOrbits, epoch * intervalMs / 1000.0);
+                  start = std::chrono::steady_clock::now ();
+                  changes += engine->Update ().size ();
+                  totalMs += std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - start).count ();
+                }
+              settled = engine->GetNSettled () - settled;
+
+              std::cout << std::fixed << std::setprecision (2) << std::setw (10) << numSatellites + numGroundStations
+                        << std::setw (8) << (incremental ? "incr" : "full") << std::setw (9) << engine->GetNThreads ()
+                        << std::setw (14) << firstMs << std::setw (15) << totalMs / numEpochs
+                        << std::setw (14) << changes / numEpochs << std::setw (16) << settled / numEpochs << std::endl;
+            }
+        }
+
+      Simulator::Destroy ();
+    }
+  return 0;
+}
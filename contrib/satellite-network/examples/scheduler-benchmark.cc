@@ -0,0 +1,252 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+// Replays the operations on the event scheduler of a run against every scheduler and
+// reports the insert and remove-next throughput and the memory held at the peak number of
+// pending events. The events come out of every scheduler in the order of the recording,
+// which is checked.
+//
+// Record a trace with a single run of the scenario (scheduler_trace_file=<path> in its
+// configuration, which a_b_sweep rejects) and replay it:
+//
+// ./waf --run="scheduler-benchmark --trace=runs/starlink/scheduler-trace.bin"
+//
+// Without a trace, a synthetic LEO workload is recorded first: every routing epoch a burst
+// of events at the same time on every node, per-packet hops (transmission complete after a
+// few microseconds, reception after a propagation delay of milliseconds) and Interest
+// lifetime timers of seconds, most of them cancelled.
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <malloc.h>
+
+#include "ns3/core-module.h"
+#include "ns3/recording-scheduler.h"
+
+using namespace ns3;
+
+static std::vector<std::string>
+ParseList (std::string list)
+{
+  std::vector<std::string> values;
+  std::istringstream in (list);
+  std::string value;
+  while (std::getline (in, value, ','))
+    {
+      values.push_back (value);
+    }
+  return values;
+}
+
+static Ptr<UniformRandomVariable> g_random;
+static uint32_t g_nodes;
+static uint32_t g_hops;
+static int64_t g_epochNs;
+
+static void
+Noop (void)
+{
+}
+
+static void
+Hop (uint32_t hop, EventId lifetime)
+{
+  // Transmission complete on the sending device, reception on the next node
+  Simulator::Schedule (NanoSeconds (1200), &Noop);
+  if (hop < g_hops)
+    {
+      Simulator::Schedule (MicroSeconds (g_random->GetInteger (2000, 5000)), &Hop, hop + 1, lifetime);
+    }
+  else
+    {
+      lifetime.Cancel ();
+    }
+}
+
+static void
+Send (void)
+{
+  EventId lifetime = Simulator::Schedule (Seconds (2), &Noop);
+  Hop (0, lifetime);
+}
+
+static void
+Epoch (void)
+{
+  // Forwarding state update of every node, all at the same time
+  for (uint32_t node = 0; node < g_nodes; node++)
+    {
+      Simulator::ScheduleWithContext (node, MilliSeconds (1), &Noop);
+    }
+  Simulator::Schedule (NanoSeconds (g_epochNs), &Epoch);
+}
+
+static void
+RecordSynthetic (std::string path, uint32_t packetsPerMs, double durationS)
+{
+  ObjectFactory factory ("ns3::RecordingScheduler", "TraceFile", StringValue (path));
+  Simulator::SetScheduler (factory);
+  g_random = CreateObject<UniformRandomVariable> ();
+  Simulator::Schedule (Seconds (0), &Epoch);
+  double intervalNs = 1e6 / packetsPerMs;
+  for (double ns = 0; ns < durationS * 1e9; ns += intervalNs)
+    {
+      Simulator::Schedule (NanoSeconds (ns), &Send);
+    }
+  Simulator::Stop (Seconds (durationS));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  g_random = 0;
+}
+
+// Heap in use, including the large blocks which malloc maps separately
+static size_t
+AllocatedBytes (void)
+{
+  struct mallinfo2 info = mallinfo2 ();
+  return info.uordblks + info.hblkhd;
+}
+
+int
+main (int argc, char* argv[])
+{
+  std::string trace = "";
+  std::string schedulers = "Map,Heap,Calendar,PriorityQueue,Ladder";
+  std::string syntheticTrace = "scheduler-trace-synthetic.bin";
+  uint32_t nodes = 1584;
+  uint32_t hops = 8;
+  uint32_t packetsPerMs = 50;
+  double durationS = 2;
+  double epochMs = 100;
+  CommandLine cmd;
+  cmd.AddValue ("trace", "Recorded scheduler trace (empty: record a synthetic workload)", trace);
+  cmd.AddValue ("schedulers", "Comma-separated schedulers (ns3::<name>Scheduler; List is linear in the pending events)", schedulers);
+  cmd.AddValue ("synthetic_trace", "Where the synthetic workload is recorded", syntheticTrace);
+  cmd.AddValue ("nodes", "Synthetic: events per node burst at every epoch", nodes);
+  cmd.AddValue ("hops", "Synthetic: hops of a packet", hops);
+  cmd.AddValue ("packets_per_ms", "Synthetic: packets sent per millisecond", packetsPerMs);
+  cmd.AddValue ("duration_s", "Synthetic: simulated time", durationS);
+  cmd.AddValue ("epoch_ms", "Synthetic: time between routing epochs", epochMs);
+  cmd.Parse (argc, argv);
+
+  if (trace.empty ())
+    {
+      g_nodes = nodes;
+      g_hops = hops;
+      g_epochNs = epochMs * 1e6;
+      RecordSynthetic (syntheticTrace, packetsPerMs, durationS);
+      trace = syntheticTrace;
+    }
+  std::vector<SchedulerTraceRecord> records = RecordingScheduler::ReadTrace (trace);
+
+  // Distribution of the events: how far ahead they are scheduled, how many share the
+  // time of the previous insertion, and when the most events are pending
+  const char* delayNames[] = {"now", "< 1 us", "< 1 ms", "< 1 s", ">= 1 s"};
+  uint64_t delays[5] = {0, 0, 0, 0, 0};
+  uint64_t inserts = 0, removeNexts = 0, removes = 0, sameTime = 0;
+  uint64_t now = 0, lastInsert = UINT64_MAX;
+  int64_t pending = 0, peak = 0;
+  size_t peakIndex = 0;
+  for (size_t i = 0; i < records.size (); i++)
+    {
+      const SchedulerTraceRecord& r = records[i];
+      if (r.op == SchedulerTraceRecord::INSERT)
+        {
+          inserts++;
+          sameTime += r.ts == lastInsert;
+          lastInsert = r.ts;
+          uint64_t delay = Time (r.ts - now).GetNanoSeconds ();
+          delays[delay == 0 ? 0 : delay < 1000 ? 1 : delay < 1000000 ? 2 : delay < 1000000000 ? 3 : 4]++;
+          if (++pending > peak)
+            {
+              peak = pending;
+              peakIndex = i;
+            }
+        }
+      else
+        {
+          if (r.op == SchedulerTraceRecord::REMOVE_NEXT)
+            {
+              removeNexts++;
+              now = r.ts;
+            }
+          else
+            {
+              removes++;
+            }
+          pending--;
+        }
+    }
+
+  std::cout << "Trace " << trace << ": " << inserts << " inserts, " << removeNexts << " remove-next, "
+            << removes << " removes, at most " << peak << " pending" << std::endl;
+  std::cout << "  same time as the previous insert: " << std::fixed << std::setprecision (1)
+            << 100.0 * sameTime / std::max<uint64_t> (1, inserts) << " %" << std::endl;
+  std::cout << "  scheduled ahead:";
+  for (int k = 0; k < 5; k++)
+    {
+      std::cout << "  " << delayNames[k] << " " << 100.0 * delays[k] / std::max<uint64_t> (1, inserts) << " %";
+    }
+  std::cout << std::endl << std::endl;
+
+  std::cout << std::setw (16) << "scheduler" << std::setw (18) << "insert (Mop/s)" << std::setw (23)
+            << "remove-next (Mop/s)" << std::setw (12) << "total (s)" << std::setw (14) << "peak (MB)"
+            << std::setw (16) << "bytes/event" << std::setw (8) << "order" << std::endl;
+
+  for (std::string name : ParseList (schedulers))
+    {
+      ObjectFactory factory ("ns3::" + name + "Scheduler");
+      size_t baseBytes = AllocatedBytes ();
+      size_t peakBytes = 0;
+      Ptr<Scheduler> scheduler = factory.Create<Scheduler> ();
+
+      // Operations are timed by runs of the same kind, the clock being read when the kind changes
+      double seconds[3] = {0, 0, 0};
+      uint64_t mismatches = 0;
+      Scheduler::Event ev;
+      ev.impl = 0;
+      ev.key.m_context = 0;
+      size_t i = 0;
+      while (i < records.size ())
+        {
+          uint32_t op = records[i].op;
+          size_t end = i <= peakIndex ? peakIndex + 1 : records.size ();
+          auto start = std::chrono::steady_clock::now ();
+          for (; i < end && records[i].op == op; i++)
+            {
+              ev.key.m_ts = records[i].ts;
+              ev.key.m_uid = records[i].uid;
+              if (op == SchedulerTraceRecord::INSERT)
+                {
+                  scheduler->Insert (ev);
+                }
+              else if (op == SchedulerTraceRecord::REMOVE_NEXT)
+                {
+                  mismatches += scheduler->RemoveNext ().key.m_uid != ev.key.m_uid;
+                }
+              else
+                {
+                  scheduler->Remove (ev);
+                }
+            }
+          seconds[op] += std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+          if (i == peakIndex + 1)
+            {
+              peakBytes = AllocatedBytes () - baseBytes;
+            }
+        }
+      mismatches += !scheduler->IsEmpty ();
+
+      std::cout << std::fixed << std::setprecision (2) << std::setw (16) << name
+                << std::setw (18) << inserts / seconds[SchedulerTraceRecord::INSERT] / 1e6
+                << std::setw (23) << removeNexts / seconds[SchedulerTraceRecord::REMOVE_NEXT] / 1e6
+                << std::setw (12) << seconds[0] + seconds[1] + seconds[2]
+                << std::setw (14) << peakBytes / 1e6
+                << std::setw (16) << (double) peakBytes / std::max<int64_t> (1, peak)
+                << std::setw (8) << (mismatches == 0 ? "ok" : "WRONG") << std::endl;
+    }
+  return 0;
+}
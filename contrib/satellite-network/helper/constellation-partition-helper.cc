@@ -0,0 +1,385 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "constellation-partition-helper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/ground-station-grid.h"
+#include "ns3/point-to-point-laser-helper.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ConstellationPartitionHelper");
+
+ConstellationPartitionHelper::ConstellationPartitionHelper (uint32_t numOrbits, uint32_t satellitesPerOrbit,
+                                                            uint32_t numSystems)
+  : m_numOrbits (numOrbits),
+    m_satellitesPerOrbit (satellitesPerOrbit),
+    m_numSystems (numSystems),
+    m_nGslPairs (0),
+    m_nCrossSystemGslPairs (0)
+{
+  AssignPlanes ();
+}
+
+ConstellationPartitionHelper::ConstellationPartitionHelper (std::string satelliteNetworkDir, uint32_t numSystems)
+  : m_numOrbits (0),
+    m_satellitesPerOrbit (0),
+    m_numSystems (numSystems),
+    m_nGslPairs (0),
+    m_nCrossSystemGslPairs (0)
+{
+  ReadPlanes (satelliteNetworkDir + "/tles.txt");
+  AssignPlanes ();
+  ReadIsls (satelliteNetworkDir + "/isls.txt");
+}
+
+void
+ConstellationPartitionHelper::ReadPlanes (std::string filename)
+{
+  std::ifstream fs (filename);
+  NS_ABORT_MSG_UNLESS (fs.is_open (), "File " << filename << " could not be opened");
+  std::string line;
+  std::getline (fs, line);
+  std::istringstream iss (line);
+  NS_ABORT_MSG_UNLESS (iss >> m_numOrbits >> m_satellitesPerOrbit,
+                       "Expected \"<orbits> <satellites per orbit>\" on the first line of " << filename);
+}
+
+void
+ConstellationPartitionHelper::AssignPlanes (void)
+{
+  NS_ABORT_MSG_IF (m_numOrbits == 0 || m_satellitesPerOrbit == 0, "Constellation must have at least one satellite");
+  NS_ABORT_MSG_IF (m_numSystems == 0, "At least one system is required");
+  NS_ABORT_MSG_IF (m_numSystems > m_numOrbits, "Cannot split " << m_numOrbits << " orbital planes over "
+                                                               << m_numSystems << " systems");
+
+  m_satelliteSystem.resize (m_numOrbits * m_satellitesPerOrbit);
+  for (uint32_t sid = 0; sid < m_satelliteSystem.size (); sid++)
+    {
+      uint32_t orbit = sid / m_satellitesPerOrbit;
+      m_satelliteSystem[sid] = static_cast<uint32_t> (static_cast<uint64_t> (orbit) * m_numSystems / m_numOrbits);
+    }
+}
+
+void
+ConstellationPartitionHelper::AddIsl (uint32_t sat0, uint32_t sat1)
+{
+  NS_ABORT_MSG_UNLESS (sat0 < m_satelliteSystem.size () && sat1 < m_satelliteSystem.size () && sat0 != sat1,
+                       "Invalid ISL " << sat0 << " - " << sat1);
+  std::pair<uint32_t, uint32_t> key (std::min (sat0, sat1), std::max (sat0, sat1));
+  NS_ABORT_MSG_IF (m_islIndex.count (key), "Duplicate ISL " << sat0 << " - " << sat1);
+  m_islIndex[key] = m_isls.size ();
+  m_isls.push_back ({sat0, sat1, 1.0});
+}
+
+void
+ConstellationPartitionHelper::ReadIsls (std::string filename)
+{
+  std::ifstream fs (filename);
+  NS_ABORT_MSG_UNLESS (fs.is_open (), "File " << filename << " could not be opened");
+  std::string line;
+  while (std::getline (fs, line))
+    {
+      std::istringstream iss (line);
+      uint32_t sat0, sat1;
+      if (iss >> sat0 >> sat1)
+        {
+          AddIsl (sat0, sat1);
+        }
+    }
+}
+
+void
+ConstellationPartitionHelper::AddIslTraffic (uint32_t sat0, uint32_t sat1, double traffic)
+{
+  auto it = m_islIndex.find (std::make_pair (std::min (sat0, sat1), std::max (sat0, sat1)));
+  NS_ABORT_MSG_IF (it == m_islIndex.end (), "No ISL " << sat0 << " - " << sat1);
+  m_isls[it->second].traffic += traffic;
+}
+
+void
+ConstellationPartitionHelper::PartitionMinCut (double imbalance)
+{
+  NS_LOG_FUNCTION (this << imbalance);
+
+  uint32_t n = m_satelliteSystem.size ();
+  std::vector<std::vector<std::pair<uint32_t, double> > > adjacency (n);
+  for (const Isl& isl : m_isls)
+    {
+      adjacency[isl.sat0].push_back (std::make_pair (isl.sat1, isl.traffic));
+      adjacency[isl.sat1].push_back (std::make_pair (isl.sat0, isl.traffic));
+    }
+
+  double average = static_cast<double> (n) / m_numSystems;
+  uint32_t minSize = static_cast<uint32_t> (std::max (1.0, std::ceil (average * (1 - imbalance))));
+  uint32_t maxSize = static_cast<uint32_t> (std::floor (average * (1 + imbalance)));
+  std::vector<uint32_t> size (m_numSystems, 0);
+  for (uint32_t system : m_satelliteSystem)
+    {
+      size[system]++;
+    }
+
+  double before = GetCrossSystemTraffic ();
+  uint32_t moves = 0;
+  std::vector<double> toSystem (m_numSystems);
+  bool improved = true;
+  while (improved)
+    {
+      improved = false;
+      for (uint32_t sid = 0; sid < n; sid++)
+        {
+          uint32_t own = m_satelliteSystem[sid];
+          if (size[own] <= minSize)
+            {
+              continue;
+            }
+
+          // Traffic exchanged with each system
+          std::fill (toSystem.begin (), toSystem.end (), 0.0);
+          for (const std::pair<uint32_t, double>& neighbor : adjacency[sid])
+            {
+              toSystem[m_satelliteSystem[neighbor.first]] += neighbor.second;
+            }
+
+          uint32_t best = own;
+          for (uint32_t system = 0; system < m_numSystems; system++)
+            {
+              if (toSystem[system] > toSystem[best] && size[system] < maxSize)
+                {
+                  best = system;
+                }
+            }
+          if (best != own)
+            {
+              m_satelliteSystem[sid] = best;
+              size[own]--;
+              size[best]++;
+              moves++;
+              improved = true;
+            }
+        }
+    }
+
+  NS_LOG_INFO ("Min-cut refinement moved " << moves << " satellites, cross-system traffic "
+               << before << " -> " << GetCrossSystemTraffic ());
+}
+
+uint32_t
+ConstellationPartitionHelper::GetSatelliteSystemId (uint32_t satelliteId) const
+{
+  NS_ABORT_MSG_UNLESS (satelliteId < m_satelliteSystem.size (),
+                       "Satellite " << satelliteId << " is not part of the constellation");
+  return m_satelliteSystem[satelliteId];
+}
+
+std::vector<uint32_t>
+ConstellationPartitionHelper::AssignGroundStations (NodeContainer satellites,
+                                                    const std::vector<Vector>& groundStationPositions,
+                                                    double maxGslLengthM)
+{
+  NS_ABORT_MSG_UNLESS (satellites.GetN () == m_satelliteSystem.size (),
+                       "Expected " << m_satelliteSystem.size () << " satellites, got " << satellites.GetN ());
+
+  GroundStationGrid grid (maxGslLengthM);
+  for (uint32_t i = 0; i < groundStationPositions.size (); i++)
+    {
+      grid.Add (i, groundStationPositions[i]);
+    }
+
+  // Number of visible satellites of each system, per ground station
+  m_nGslPairs = 0;
+  m_nCrossSystemGslPairs = 0;
+  std::vector<std::vector<uint32_t> > visible (groundStationPositions.size (), std::vector<uint32_t> (m_numSystems, 0));
+  std::vector<Vector> satellitePositions (satellites.GetN ());
+  std::vector<std::pair<uint32_t, double> > inRange;
+  for (uint32_t sid = 0; sid < satellites.GetN (); sid++)
+    {
+      satellitePositions[sid] = satellites.Get (sid)->GetObject<MobilityModel> ()->GetPosition ();
+      grid.Query (satellitePositions[sid], maxGslLengthM, inRange);
+      uint32_t system = GetSatelliteSystemId (sid);
+      for (const std::pair<uint32_t, double>& gs : inRange)
+        {
+          visible[gs.first][system]++;
+        }
+    }
+
+  std::vector<uint32_t> result (groundStationPositions.size ());
+  for (uint32_t gid = 0; gid < groundStationPositions.size (); gid++)
+    {
+      uint32_t best = 0;
+      for (uint32_t system = 1; system < m_numSystems; system++)
+        {
+          if (visible[gid][system] > visible[gid][best])
+            {
+              best = system;
+            }
+        }
+
+      // Out of reach of every satellite: closest one
+      if (visible[gid][best] == 0)
+        {
+          double closest = std::numeric_limits<double>::infinity ();
+          for (uint32_t sid = 0; sid < satellitePositions.size (); sid++)
+            {
+              double distance = CalculateDistance (satellitePositions[sid], groundStationPositions[gid]);
+              if (distance < closest)
+                {
+                  closest = distance;
+                  best = GetSatelliteSystemId (sid);
+                }
+            }
+        }
+
+      NS_LOG_INFO ("Ground station " << gid << " -> system " << best);
+      result[gid] = best;
+      for (uint32_t system = 0; system < m_numSystems; system++)
+        {
+          m_nGslPairs += visible[gid][system];
+          m_nCrossSystemGslPairs += system != best ? visible[gid][system] : 0;
+        }
+    }
+  m_groundStationSystem = result;
+  return result;
+}
+
+uint32_t
+ConstellationPartitionHelper::GetNSystems (void) const
+{
+  return m_numSystems;
+}
+
+uint32_t
+ConstellationPartitionHelper::GetNIsls (void) const
+{
+  return m_isls.size ();
+}
+
+uint32_t
+ConstellationPartitionHelper::GetNCrossSystemIsls (void) const
+{
+  uint32_t n = 0;
+  for (const Isl& isl : m_isls)
+    {
+      n += m_satelliteSystem[isl.sat0] != m_satelliteSystem[isl.sat1] ? 1 : 0;
+    }
+  return n;
+}
+
+double
+ConstellationPartitionHelper::GetCrossSystemTraffic (void) const
+{
+  double traffic = 0;
+  for (const Isl& isl : m_isls)
+    {
+      traffic += m_satelliteSystem[isl.sat0] != m_satelliteSystem[isl.sat1] ? isl.traffic : 0;
+    }
+  return traffic;
+}
+
+std::vector<Time>
+ConstellationPartitionHelper::GetLookahead (NodeContainer satellites, double propagationSpeed) const
+{
+  NS_ABORT_MSG_UNLESS (satellites.GetN () == m_satelliteSystem.size (),
+                       "Expected " << m_satelliteSystem.size () << " satellites, got " << satellites.GetN ());
+
+  std::vector<Time> lookahead (m_numSystems, Time::Max ());
+  for (const Isl& isl : m_isls)
+    {
+      uint32_t system0 = m_satelliteSystem[isl.sat0];
+      uint32_t system1 = m_satelliteSystem[isl.sat1];
+      if (system0 != system1)
+        {
+          Time delay = PointToPointLaserHelper::GetMinimumDelay (satellites.Get (isl.sat0), satellites.Get (isl.sat1),
+                                                                 propagationSpeed);
+          lookahead[system0] = std::min (lookahead[system0], delay);
+          lookahead[system1] = std::min (lookahead[system1], delay);
+        }
+    }
+  return lookahead;
+}
+
+void
+ConstellationPartitionHelper::PrintReport (std::ostream& os, NodeContainer satellites, double propagationSpeed) const
+{
+  std::vector<uint32_t> nSatellites (m_numSystems, 0);
+  std::vector<uint32_t> nGroundStations (m_numSystems, 0);
+  std::vector<uint32_t> nCrossIsls (m_numSystems, 0);
+  std::vector<double> crossTraffic (m_numSystems, 0);
+  for (uint32_t system : m_satelliteSystem)
+    {
+      nSatellites[system]++;
+    }
+  for (uint32_t system : m_groundStationSystem)
+    {
+      nGroundStations[system]++;
+    }
+  double totalTraffic = 0;
+  for (const Isl& isl : m_isls)
+    {
+      uint32_t system0 = m_satelliteSystem[isl.sat0];
+      uint32_t system1 = m_satelliteSystem[isl.sat1];
+      totalTraffic += isl.traffic;
+      if (system0 != system1)
+        {
+          nCrossIsls[system0]++;
+          nCrossIsls[system1]++;
+          crossTraffic[system0] += isl.traffic;
+          crossTraffic[system1] += isl.traffic;
+        }
+    }
+  std::vector<Time> lookahead = GetLookahead (satellites, propagationSpeed);
+
+  os << "Partition of " << m_satelliteSystem.size () << " satellites and " << m_groundStationSystem.size ()
+     << " ground stations over " << m_numSystems << " systems" << std::endl;
+  os << "  System  Satellites  Ground stations  Cross ISLs  Cross traffic  Lookahead" << std::endl;
+  for (uint32_t system = 0; system < m_numSystems; system++)
+    {
+      os << "  " << std::setw (6) << system
+         << "  " << std::setw (10) << nSatellites[system]
+         << "  " << std::setw (15) << nGroundStations[system]
+         << "  " << std::setw (10) << nCrossIsls[system]
+         << "  " << std::setw (13) << crossTraffic[system] << "  ";
+      if (lookahead[system] == Time::Max ())
+        {
+          os << "-" << std::endl;
+        }
+      else
+        {
+          os << lookahead[system].As (Time::US) << std::endl;
+        }
+    }
+  os << "  Cross-system ISLs: " << GetNCrossSystemIsls () << " of " << m_isls.size ()
+     << ", estimated traffic " << GetCrossSystemTraffic () << " of " << totalTraffic;
+  if (totalTraffic > 0)
+    {
+      os << " (" << std::fixed << std::setprecision (1) << 100.0 * GetCrossSystemTraffic () / totalTraffic
+         << "%)" << std::defaultfloat;
+    }
+  os << std::endl;
+  os << "  Cross-system GSL pairs: " << m_nCrossSystemGslPairs << " of " << m_nGslPairs << std::endl;
+}
+
+} // namespace ns3
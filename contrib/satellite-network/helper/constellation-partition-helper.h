@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CONSTELLATION_PARTITION_HELPER_H
+#define CONSTELLATION_PARTITION_HELPER_H
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+/**
+ * \brief Assigns the nodes of a constellation to the systems (MPI ranks) of a distributed run
+ *
+ * Satellites are assigned by orbital plane: the planes are split into contiguous blocks of
+ * (almost) equal size, one per system, so that most ISLs stay within a system. Satellites are
+ * expected in the order of tles.txt, i.e., plane after plane. PartitionMinCut () can then move
+ * satellites across the block boundaries to reduce the (estimated) ISL traffic between systems.
+ *
+ * Each ground station is assigned to the system owning most of the satellites it can see,
+ * as its GSL traffic goes to those. A ground station seeing no satellite goes to the system
+ * of the closest satellite.
+ *
+ * The system identifiers have to be known when the nodes are created
+ * (NodeContainer::Create (n, systemId)).
+ */
+class ConstellationPartitionHelper
+{
+public:
+  /**
+   * \param numOrbits Number of orbital planes
+   * \param satellitesPerOrbit Number of satellites in each plane
+   * \param numSystems Number of systems (e.g., MpiInterface::GetSize ())
+   */
+  ConstellationPartitionHelper (uint32_t numOrbits, uint32_t satellitesPerOrbit, uint32_t numSystems);
+
+  /**
+   * \brief Partition the constellation of a satellite network directory
+   *
+   * The planes are read from the first line of tles.txt ("<orbits> <satellites per orbit>"),
+   * and the ISLs from isls.txt.
+   *
+   * \param satelliteNetworkDir Satellite network directory
+   * \param numSystems Number of systems (e.g., MpiInterface::GetSize ())
+   */
+  ConstellationPartitionHelper (std::string satelliteNetworkDir, uint32_t numSystems);
+
+  /**
+   * \brief Add an ISL, with a traffic estimate of 1
+   */
+  void AddIsl (uint32_t sat0, uint32_t sat1);
+
+  /**
+   * \brief Add the ISLs of a file with one "<satellite> <satellite>" pair per line (isls.txt)
+   */
+  void ReadIsls (std::string filename);
+
+  /**
+   * \brief Add to the traffic estimate of an ISL (in any unit, e.g., number of routes over it)
+   */
+  void AddIslTraffic (uint32_t sat0, uint32_t sat1, double traffic);
+
+  /**
+   * \brief Reduce the estimated ISL traffic between systems
+   *
+   * Starting from the current assignment, satellites on the boundary of a system are moved to
+   * the neighboring system they exchange most traffic with, as long as that is more than with
+   * their own system and all systems keep between (1 - imbalance) and (1 + imbalance) times the
+   * average number of satellites. Each move strictly lowers the cut, so this terminates.
+   *
+   * \param imbalance Allowed deviation from the average system size (e.g., 0.05)
+   */
+  void PartitionMinCut (double imbalance);
+
+  /**
+   * \param satelliteId Index of the satellite in tles.txt
+   *
+   * \return System the satellite belongs to
+   */
+  uint32_t GetSatelliteSystemId (uint32_t satelliteId) const;
+
+  /**
+   * \brief Assign ground stations to the systems of the satellites they see
+   *
+   * \param satellites Satellite nodes (in the order of tles.txt), with their mobility installed
+   * \param groundStationPositions ECEF positions of the ground stations (m)
+   * \param maxGslLengthM Maximum length of a GSL (m)
+   *
+   * \return System of every ground station, in the order of groundStationPositions
+   */
+  std::vector<uint32_t> AssignGroundStations (NodeContainer satellites,
+                                              const std::vector<Vector>& groundStationPositions,
+                                              double maxGslLengthM);
+
+  uint32_t GetNSystems (void) const;
+  uint32_t GetNIsls (void) const;
+
+  /**
+   * \return Number of ISLs between satellites of different systems
+   */
+  uint32_t GetNCrossSystemIsls (void) const;
+
+  /**
+   * \return Traffic estimate of the ISLs between satellites of different systems
+   */
+  double GetCrossSystemTraffic (void) const;
+
+  /**
+   * \brief Lookahead of every system
+   *
+   * The smallest lower bound (PointToPointLaserHelper::GetMinimumDelay) of the delay of the ISLs
+   * between the system and the others, from the current time on. GSLs are not included (see
+   * GSLHelper::GetMinimumDelay).
+   *
+   * \param satellites Satellite nodes (in the order of tles.txt), with their mobility installed
+   * \param propagationSpeed Propagation speed in m/s
+   *
+   * \return Lookahead per system (Time::Max () for a system without ISLs to other systems)
+   */
+  std::vector<Time> GetLookahead (NodeContainer satellites, double propagationSpeed) const;
+
+  /**
+   * \brief Print the size, cut and lookahead of every system
+   */
+  void PrintReport (std::ostream& os, NodeContainer satellites, double propagationSpeed) const;
+
+private:
+  void ReadPlanes (std::string filename);
+  void AssignPlanes (void);
+
+  struct Isl
+  {
+    uint32_t sat0;
+    uint32_t sat1;
+    double traffic;
+  };
+
+  uint32_t m_numOrbits;
+  uint32_t m_satellitesPerOrbit;
+  uint32_t m_numSystems;
+  std::vector<uint32_t> m_satelliteSystem;           //!< System per satellite
+  std::vector<Isl> m_isls;
+  std::map<std::pair<uint32_t, uint32_t>, uint32_t> m_islIndex;  //!< (lowest, highest satellite) -> ISL
+
+  std::vector<uint32_t> m_groundStationSystem;       //!< System per ground station (once assigned)
+  uint64_t m_nGslPairs;                              //!< Ground station - visible satellite pairs
+  uint64_t m_nCrossSystemGslPairs;                   //!< ... of which on different systems
+};
+
+} // namespace ns3
+
+#endif /* CONSTELLATION_PARTITION_HELPER_H */
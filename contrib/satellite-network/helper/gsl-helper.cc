@@ -24,6 +24,9 @@
  */
 
 
+#include <algorithm>
+#include <limits>
+
 #include "ns3/abort.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -39,6 +42,8 @@
 #include "ns3/mpi-receiver.h"
 #include "ns3/error-model.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/satellite-position-mobility-model.h"
 
 #include "ns3/trace-helper.h"
 #include "ns3/gsl-helper.h"
@@ -116,10 +121,12 @@ GSLHelper::Install (NodeContainer satellites, NodeContainer ground_stations, std
     }
 
     // The lower bound for the GSL channel must be set to facilitate distributed simulation.
-    // However, this is challenging, as delays vary over time based on the movement.
-    // As such, for now this delay = lookahead time is set to 0.
+    // Delays vary over time based on the movement, but a satellite never comes closer to
+    // a ground station than its altitude above it.
     // (see also the Delay attribute in gsl-channel.cc)
-    channel->SetAttribute("Delay", TimeValue(Seconds(0)));
+    DoubleValue propagationSpeed;
+    channel->GetAttribute("PropagationSpeed", propagationSpeed);
+    channel->SetAttribute("Delay", TimeValue(GetMinimumDelay(satellites, ground_stations, propagationSpeed.Get())));
 
     return allNetDevices;
 }
@@ -146,10 +153,12 @@ GSLHelper::Install (Ptr<Node> node, Ptr<GSLChannel> channel) {
     ndqi->GetTxQueue (0)->ConnectQueueTraces (queue);
     dev->AggregateObject (ndqi);
 
-    // Aggregate MPI receivers // TODO: Why?
-    // Ptr<MpiReceiver> mpiRec = CreateObject<MpiReceiver> ();
-    // mpiRec->SetReceiveCallback (MakeCallback (&GSLNetDevice::Receive, dev, dev->GetAddress));
-    // dev->AggregateObject(mpiRec);
+    // Packets from other MPI ranks are delivered to the device through its MpiReceiver
+    if (MpiInterface::IsEnabled()) {
+        Ptr<MpiReceiver> mpiRec = CreateObject<MpiReceiver> ();
+        mpiRec->SetReceiveCallback (MakeCallback (&GSLNetDevice::DoMpiReceive, dev));
+        dev->AggregateObject(mpiRec);
+    }
 
     // Attach to channel
     dev->Attach (channel);
@@ -157,5 +166,36 @@ GSLHelper::Install (Ptr<Node> node, Ptr<GSLChannel> channel) {
     return dev;
 }
 
+Time
+GSLHelper::GetMinimumDelay (NodeContainer satellites, NodeContainer ground_stations, double propagationSpeed) {
+
+    // The osculating radius oscillates (J2) by a few kilometers around the mean orbit
+    const double perigee_margin = 0.01;
+
+    double min_satellite_radius_m = std::numeric_limits<double>::infinity();
+    for (uint32_t i = 0; i < satellites.GetN(); i++) {
+        Ptr<Node> node = satellites.Get(i);
+        Ptr<SatellitePositionMobilityModel> satellite_mobility = node->GetObject<SatellitePositionMobilityModel>();
+        double radius_m;
+        if (satellite_mobility != 0 && satellite_mobility->GetSatellite() != 0) {
+            radius_m = satellite_mobility->GetSatellite()->GetPerigeeRadius() * (1.0 - perigee_margin);
+        } else {
+            radius_m = node->GetObject<MobilityModel>()->GetPosition().GetLength();
+        }
+        min_satellite_radius_m = std::min(min_satellite_radius_m, radius_m);
+    }
+
+    double max_ground_station_radius_m = 0;
+    for (uint32_t i = 0; i < ground_stations.GetN(); i++) {
+        Vector position = ground_stations.Get(i)->GetObject<MobilityModel>()->GetPosition();
+        max_ground_station_radius_m = std::max(max_ground_station_radius_m, position.GetLength());
+    }
+
+    if (satellites.GetN() == 0 || ground_stations.GetN() == 0
+        || min_satellite_radius_m <= max_ground_station_radius_m) {
+        return Seconds(0);
+    }
+    return Seconds((min_satellite_radius_m - max_ground_station_radius_m) / propagationSpeed);
+}
 
 } // namespace ns3
@@ -26,6 +26,7 @@
 #ifndef GSL_HELPER_H
 #define GSL_HELPER_H
 
+#include "ns3/object-factory.h"
 #include "ns3/net-device-container.h"
 #include "ns3/node-container.h"
 #include "ns3/gsl-net-device.h"
@@ -55,6 +56,22 @@ public:
   NetDeviceContainer Install (NodeContainer satellites, NodeContainer gss, std::vector<std::tuple<int32_t, double>>& node_gsl_if_info);
   Ptr<GSLNetDevice> Install (Ptr<Node> node, Ptr<GSLChannel> channel);
 
+  /**
+   * \brief Lower bound of the propagation delay between any satellite and any ground station
+   *
+   * No satellite comes closer to the Earth's center than its perigee (less a margin for the
+   * short-periodic perturbations of the orbit), and no ground station is farther from it than
+   * its own position. Satellites without a SatellitePositionMobilityModel are taken at their
+   * current position. This is the lookahead the distributed simulator can use for a GSL channel.
+   *
+   * \param satellites Satellite nodes
+   * \param ground_stations Ground station nodes
+   * \param propagationSpeed Propagation speed in m/s
+   *
+   * \return Lower bound of the satellite to ground station delay (zero if they could meet)
+   */
+  static Time GetMinimumDelay (NodeContainer satellites, NodeContainer ground_stations, double propagationSpeed);
+
 private:
   ObjectFactory m_queueFactory;         //!< Queue Factory
   ObjectFactory m_channelFactory;       //!< Channel Factory
@@ -0,0 +1,530 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "leo-route-engine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <thread>
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/gsl-net-device.h"
+#include "ns3/point-to-point-laser-net-device.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LeoRouteEngine");
+
+// Distances only count as shorter beyond this margin, so that rounding does not make
+// the repair chase equivalent paths
+static const double EPSILON_M = 1e-6;
+
+const int32_t LeoRouteEngine::NONE;
+const int32_t LeoRouteEngine::ENTRY;
+
+static const double INF = std::numeric_limits<double>::infinity ();
+
+typedef std::pair<double, uint32_t> HeapEntry;
+typedef std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry> > Heap;
+
+LeoRouteEngine::LeoRouteEngine (NodeContainer satellites, NodeContainer groundStations, double maxGslLengthM)
+  : m_satellites (satellites),
+    m_groundStations (groundStations),
+    m_maxGslLengthM (maxGslLengthM),
+    m_incremental (true),
+    m_initialized (false),
+    m_nSats (satellites.GetN ()),
+    m_nGs (groundStations.GetN ()),
+    m_grid (maxGslLengthM)
+{
+  ReadTopology ();
+  m_visible.resize (m_nGs);
+  m_distance.resize (static_cast<size_t> (m_nGs) * m_nSats, INF);
+  m_parent.resize (static_cast<size_t> (m_nGs) * m_nSats, NONE);
+  m_nextHop.resize (static_cast<size_t> (m_nSats + m_nGs) * m_nGs, std::numeric_limits<int32_t>::min ());
+  m_destinationChanges.resize (m_nGs);
+  SetNThreads (1);
+}
+
+LeoRouteEngine::Workspace::Workspace (uint32_t nSats)
+  : gslLength (nSats, INF),
+    evaluated (nSats, 0),
+    stamp (0),
+    nSettled (0)
+{
+}
+
+void
+LeoRouteEngine::SetIncremental (bool incremental)
+{
+  m_incremental = incremental;
+}
+
+void
+LeoRouteEngine::SetNThreads (uint32_t nThreads)
+{
+  if (nThreads == 0)
+    {
+      nThreads = std::max (1u, std::thread::hardware_concurrency ());
+    }
+  uint64_t nSettled = GetNSettled ();
+  m_workspaces.clear ();
+  for (uint32_t i = 0; i < nThreads; i++)
+    {
+      m_workspaces.push_back (Workspace (m_nSats));
+    }
+  m_workspaces[0].nSettled = nSettled;
+}
+
+uint32_t
+LeoRouteEngine::GetNThreads (void) const
+{
+  return m_workspaces.size ();
+}
+
+void
+LeoRouteEngine::ReadTopology (void)
+{
+  // Node ids are expected as in the satellite network directories: satellites first
+  for (uint32_t sid = 0; sid < m_nSats; sid++)
+    {
+      NS_ABORT_MSG_UNLESS (m_satellites.Get (sid)->GetId () == sid, "Satellite " << sid << " has node id "
+                                                                        << m_satellites.Get (sid)->GetId ());
+    }
+  for (uint32_t gid = 0; gid < m_nGs; gid++)
+    {
+      NS_ABORT_MSG_UNLESS (m_groundStations.Get (gid)->GetId () == m_nSats + gid,
+                           "Ground station " << gid << " has node id " << m_groundStations.Get (gid)->GetId ());
+    }
+
+  // ISLs and the first GSL device of every satellite
+  m_first.push_back (0);
+  for (uint32_t sid = 0; sid < m_nSats; sid++)
+    {
+      Ptr<Node> node = m_satellites.Get (sid);
+      m_satGslDevice.push_back (NONE);
+      for (uint32_t i = 0; i < node->GetNDevices (); i++)
+        {
+          Ptr<PointToPointLaserNetDevice> isl = DynamicCast<PointToPointLaserNetDevice> (node->GetDevice (i));
+          if (isl != 0)
+            {
+              uint32_t neighbor = isl->GetDestinationNode ()->GetId ();
+              NS_ABORT_MSG_UNLESS (neighbor < m_nSats, "ISL of satellite " << sid << " to a non-satellite");
+              m_neighbor.push_back (neighbor);
+              m_device.push_back (i);
+            }
+          else if (m_satGslDevice.back () == NONE && DynamicCast<GSLNetDevice> (node->GetDevice (i)) != 0)
+            {
+              m_satGslDevice.back () = i;
+            }
+        }
+      m_first.push_back (m_neighbor.size ());
+      m_satMobility.push_back (node->GetObject<MobilityModel> ());
+      NS_ABORT_MSG_IF (m_satMobility.back () == 0, "Satellite " << sid << " has no mobility model");
+    }
+  m_length.resize (m_neighbor.size (), INF);
+
+  // Reverse ISLs
+  m_reverse.resize (m_neighbor.size ());
+  for (uint32_t sid = 0; sid < m_nSats; sid++)
+    {
+      for (uint32_t e = m_first[sid]; e < m_first[sid + 1]; e++)
+        {
+          uint32_t neighbor = m_neighbor[e];
+          uint32_t r = m_first[neighbor];
+          while (r < m_first[neighbor + 1] && m_neighbor[r] != sid)
+            {
+              r++;
+            }
+          NS_ABORT_MSG_IF (r == m_first[neighbor + 1], "ISL " << sid << " - " << neighbor << " is one-way");
+          m_reverse[e] = r;
+        }
+    }
+
+  // Ground stations do not move
+  for (uint32_t gid = 0; gid < m_nGs; gid++)
+    {
+      Ptr<Node> node = m_groundStations.Get (gid);
+      m_gsGslDevice.push_back (NONE);
+      for (uint32_t i = 0; i < node->GetNDevices () && m_gsGslDevice.back () == NONE; i++)
+        {
+          if (DynamicCast<GSLNetDevice> (node->GetDevice (i)) != 0)
+            {
+              m_gsGslDevice.back () = i;
+            }
+        }
+      Ptr<MobilityModel> mobility = node->GetObject<MobilityModel> ();
+      NS_ABORT_MSG_IF (mobility == 0, "Ground station " << gid << " has no mobility model");
+      m_grid.Add (gid, mobility->GetPosition ());
+    }
+
+  NS_LOG_INFO ("Route engine over " << m_nSats << " satellites, " << m_neighbor.size () / 2 << " ISLs and "
+               << m_nGs << " ground stations");
+}
+
+void
+LeoRouteEngine::UpdateLengths (void)
+{
+  std::vector<Vector> positions (m_nSats);
+  for (uint32_t sid = 0; sid < m_nSats; sid++)
+    {
+      positions[sid] = m_satMobility[sid]->GetPosition ();
+    }
+
+  for (uint32_t sid = 0; sid < m_nSats; sid++)
+    {
+      for (uint32_t e = m_first[sid]; e < m_first[sid + 1]; e++)
+        {
+          m_length[e] = CalculateDistance (positions[sid], positions[m_neighbor[e]]);
+        }
+    }
+
+  for (std::vector<std::pair<uint32_t, double> >& visible : m_visible)
+    {
+      visible.clear ();
+    }
+  std::vector<std::pair<uint32_t, double> > inRange;
+  for (uint32_t sid = 0; sid < m_nSats; sid++)
+    {
+      if (m_satGslDevice[sid] == NONE)
+        {
+          continue;
+        }
+      m_grid.Query (positions[sid], m_maxGslLengthM, inRange);
+      for (const std::pair<uint32_t, double>& gs : inRange)
+        {
+          if (m_gsGslDevice[gs.first] != NONE)
+            {
+              m_visible[gs.first].push_back (std::make_pair (sid, gs.second));
+            }
+        }
+    }
+}
+
+void
+LeoRouteEngine::Recompute (uint32_t gid, Workspace& workspace)
+{
+  double* distance = &m_distance[static_cast<size_t> (gid) * m_nSats];
+  int32_t* parent = &m_parent[static_cast<size_t> (gid) * m_nSats];
+  std::fill (distance, distance + m_nSats, INF);
+  std::fill (parent, parent + m_nSats, NONE);
+
+  Heap queue;
+  for (const std::pair<uint32_t, double>& entry : m_visible[gid])
+    {
+      if (entry.second < distance[entry.first])
+        {
+          distance[entry.first] = entry.second;
+          parent[entry.first] = ENTRY;
+          queue.push (HeapEntry (entry.second, entry.first));
+        }
+    }
+
+  while (!queue.empty ())
+    {
+      HeapEntry top = queue.top ();
+      queue.pop ();
+      uint32_t sid = top.second;
+      if (top.first > distance[sid])
+        {
+          continue;
+        }
+      workspace.nSettled++;
+      for (uint32_t e = m_first[sid]; e < m_first[sid + 1]; e++)
+        {
+          uint32_t neighbor = m_neighbor[e];
+          double candidate = distance[sid] + m_length[e];
+          if (candidate < distance[neighbor])
+            {
+              distance[neighbor] = candidate;
+              parent[neighbor] = m_reverse[e];
+              queue.push (HeapEntry (candidate, neighbor));
+            }
+        }
+    }
+}
+
+void
+LeoRouteEngine::Repair (uint32_t gid, Workspace& workspace)
+{
+  double* distance = &m_distance[static_cast<size_t> (gid) * m_nSats];
+  int32_t* parent = &m_parent[static_cast<size_t> (gid) * m_nSats];
+  std::vector<double>& gslLength = workspace.gslLength;
+  for (const std::pair<uint32_t, double>& entry : m_visible[gid])
+    {
+      gslLength[entry.first] = std::min (gslLength[entry.first], entry.second);
+    }
+
+  // Re-evaluate the previous tree with the new lengths, parents before children. A
+  // satellite whose GSL went out of range loses its path, and so does its subtree.
+  std::vector<uint32_t>& evaluated = workspace.evaluated;
+  std::vector<uint32_t>& path = workspace.path;
+  uint32_t stamp = ++workspace.stamp;
+  for (uint32_t sid = 0; sid < m_nSats; sid++)
+    {
+      uint32_t current = sid;
+      while (evaluated[current] != stamp)
+        {
+          path.push_back (current);
+          if (parent[current] < 0)
+            {
+              break;
+            }
+          current = m_neighbor[parent[current]];
+        }
+      while (!path.empty ())
+        {
+          uint32_t s = path.back ();
+          path.pop_back ();
+          if (parent[s] == ENTRY)
+            {
+              distance[s] = gslLength[s];
+            }
+          else if (parent[s] >= 0)
+            {
+              distance[s] = distance[m_neighbor[parent[s]]] + m_length[parent[s]];
+            }
+          else
+            {
+              distance[s] = INF;
+            }
+          if (distance[s] == INF)
+            {
+              parent[s] = NONE;
+            }
+          evaluated[s] = stamp;
+        }
+    }
+
+  // Satellites which can now do better than over their old parent
+  Heap queue;
+  for (uint32_t sid = 0; sid < m_nSats; sid++)
+    {
+      double best = distance[sid];
+      int32_t bestParent = parent[sid];
+      if (gslLength[sid] < best - EPSILON_M)
+        {
+          best = gslLength[sid];
+          bestParent = ENTRY;
+        }
+      for (uint32_t e = m_first[sid]; e < m_first[sid + 1]; e++)
+        {
+          double candidate = distance[m_neighbor[e]] + m_length[e];
+          if (candidate < best - EPSILON_M)
+            {
+              best = candidate;
+              bestParent = e;
+            }
+        }
+      if (bestParent != parent[sid])
+        {
+          distance[sid] = best;
+          parent[sid] = bestParent;
+          queue.push (HeapEntry (best, sid));
+        }
+    }
+
+  // Propagate the improvements (the distances only decrease from here on)
+  while (!queue.empty ())
+    {
+      HeapEntry top = queue.top ();
+      queue.pop ();
+      uint32_t sid = top.second;
+      if (top.first > distance[sid])
+        {
+          continue;
+        }
+      workspace.nSettled++;
+      for (uint32_t e = m_first[sid]; e < m_first[sid + 1]; e++)
+        {
+          uint32_t neighbor = m_neighbor[e];
+          double candidate = distance[sid] + m_length[e];
+          if (candidate < distance[neighbor] - EPSILON_M)
+            {
+              distance[neighbor] = candidate;
+              parent[neighbor] = m_reverse[e];
+              queue.push (HeapEntry (candidate, neighbor));
+            }
+        }
+    }
+
+  for (const std::pair<uint32_t, double>& entry : m_visible[gid])
+    {
+      gslLength[entry.first] = INF;
+    }
+}
+
+void
+LeoRouteEngine::Emit (std::vector<FstateRecord>& changes, int32_t current, int32_t destination, int32_t nextHop,
+                      int32_t currentIf, int32_t nextHopIf)
+{
+  int32_t& previous = m_nextHop[static_cast<size_t> (current) * m_nGs + (destination - m_nSats)];
+  if (previous != nextHop)
+    {
+      previous = nextHop;
+      changes.push_back ({current, destination, nextHop, currentIf, nextHopIf});
+    }
+}
+
+void
+LeoRouteEngine::UpdateDestination (uint32_t gid, Workspace& workspace)
+{
+  if (m_incremental && m_initialized)
+    {
+      Repair (gid, workspace);
+    }
+  else
+    {
+      Recompute (gid, workspace);
+    }
+
+  // Only this destination's column of m_nextHop is written
+  std::vector<FstateRecord>& changes = m_destinationChanges[gid];
+  changes.clear ();
+  int32_t destination = m_nSats + gid;
+  const double* distance = &m_distance[static_cast<size_t> (gid) * m_nSats];
+  const int32_t* parent = &m_parent[static_cast<size_t> (gid) * m_nSats];
+
+  // Satellites: toward their parent in the tree
+  for (uint32_t sid = 0; sid < m_nSats; sid++)
+    {
+      if (parent[sid] == ENTRY)
+        {
+          Emit (changes, sid, destination, destination, m_satGslDevice[sid], m_gsGslDevice[gid]);
+        }
+      else if (parent[sid] >= 0)
+        {
+          uint32_t e = parent[sid];
+          Emit (changes, sid, destination, m_neighbor[e], m_device[e], m_device[m_reverse[e]]);
+        }
+      else
+        {
+          Emit (changes, sid, destination, NONE, NONE, NONE);
+        }
+    }
+
+  // Ground stations: to the satellite in range with the shortest path to the destination
+  for (uint32_t src = 0; src < m_nGs; src++)
+    {
+      if (src == gid)
+        {
+          continue;
+        }
+      double best = INF;
+      int32_t bestSat = NONE;
+      for (const std::pair<uint32_t, double>& entry : m_visible[src])
+        {
+          double candidate = entry.second + distance[entry.first];
+          if (candidate < best)
+            {
+              best = candidate;
+              bestSat = entry.first;
+            }
+        }
+      if (bestSat != NONE)
+        {
+          Emit (changes, m_nSats + src, destination, bestSat, m_gsGslDevice[src], m_satGslDevice[bestSat]);
+        }
+      else
+        {
+          Emit (changes, m_nSats + src, destination, NONE, NONE, NONE);
+        }
+    }
+}
+
+const std::vector<FstateRecord>&
+LeoRouteEngine::Update (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  UpdateLengths ();
+
+  // The destinations are independent: each thread takes the next one not yet updated
+  uint32_t nThreads = std::min<uint32_t> (m_workspaces.size (), m_nGs);
+  if (nThreads <= 1)
+    {
+      for (uint32_t gid = 0; gid < m_nGs; gid++)
+        {
+          UpdateDestination (gid, m_workspaces[0]);
+        }
+    }
+  else
+    {
+      std::atomic<uint32_t> next (0);
+      auto work = [this, &next] (Workspace& workspace) {
+        for (uint32_t gid = next++; gid < m_nGs; gid = next++)
+          {
+            UpdateDestination (gid, workspace);
+          }
+      };
+      std::vector<std::thread> threads;
+      for (uint32_t i = 1; i < nThreads; i++)
+        {
+          threads.push_back (std::thread (work, std::ref (m_workspaces[i])));
+        }
+      work (m_workspaces[0]);
+      for (std::thread& thread : threads)
+        {
+          thread.join ();
+        }
+    }
+  m_initialized = true;
+
+  m_changes.clear ();
+  for (const std::vector<FstateRecord>& changes : m_destinationChanges)
+    {
+      m_changes.insert (m_changes.end (), changes.begin (), changes.end ());
+    }
+  NS_LOG_INFO (m_changes.size () << " forwarding state changes");
+  return m_changes;
+}
+
+double
+LeoRouteEngine::GetDistance (uint32_t nodeId, uint32_t gid) const
+{
+  NS_ABORT_MSG_UNLESS (nodeId < m_nSats + m_nGs && gid < m_nGs, "Invalid node " << nodeId << " or ground station " << gid);
+  if (nodeId < m_nSats)
+    {
+      return m_distance[static_cast<size_t> (gid) * m_nSats + nodeId];
+    }
+  if (nodeId == m_nSats + gid)
+    {
+      return 0;
+    }
+  double best = INF;
+  for (const std::pair<uint32_t, double>& entry : m_visible[nodeId - m_nSats])
+    {
+      best = std::min (best, entry.second + m_distance[static_cast<size_t> (gid) * m_nSats + entry.first]);
+    }
+  return best;
+}
+
+uint64_t
+LeoRouteEngine::GetNSettled (void) const
+{
+  uint64_t nSettled = 0;
+  for (const Workspace& workspace : m_workspaces)
+    {
+      nSettled += workspace.nSettled;
+    }
+  return nSettled;
+}
+
+} // namespace ns3
@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LEO_ROUTE_ENGINE_H
+#define LEO_ROUTE_ENGINE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ns3/fstate-binary.h"
+#include "ns3/ground-station-grid.h"
+#include "ns3/mobility-model.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * \brief Computes the forwarding state of a LEO network during the simulation
+ *
+ * Replaces the replay of pre-generated fstate_<ns>.txt files. At every Update (), the
+ * forwarding state toward each ground station is derived from the current positions:
+ * ISLs (the point-to-point laser devices of the satellites) weigh their length, and a
+ * satellite can hand over to a ground station within the maximum GSL length. As in the
+ * Hypatia "free_one_only_over_isls" algorithms, ground stations do not relay: a satellite
+ * forwards over the shortest path to the satellite offering the shortest total distance to
+ * the destination, and a ground station forwards to the satellite in range offering the
+ * shortest total distance. Only the first GSL device of every node is used.
+ *
+ * Per destination ground station, the engine keeps a shortest path tree over the
+ * satellites. In incremental mode, the tree of the previous update is re-evaluated with
+ * the new lengths, satellites whose path got lost (GSL out of range) are cut off, and
+ * only the satellites whose distance can still decrease are settled again. In full mode,
+ * every tree is computed from scratch (Dijkstra); both give the same distances.
+ *
+ * The result of an update is the list of forwarding state changes since the previous
+ * update, in the format of the fstate files (all entries on the first update), grouped by
+ * destination.
+ *
+ * The destinations are independent, so an update can spread them over several threads,
+ * each with its own scratch space. The simulation only continues once all of them are
+ * done, and the result does not depend on the number of threads.
+ */
+class LeoRouteEngine : public SimpleRefCount<LeoRouteEngine>
+{
+public:
+  /**
+   * \param satellites Satellite nodes, with their ISLs and GSL devices installed
+   * \param groundStations Ground station nodes, with their GSL devices installed
+   * \param maxGslLengthM Maximum length of a GSL (m)
+   */
+  LeoRouteEngine (NodeContainer satellites, NodeContainer groundStations, double maxGslLengthM);
+
+  /**
+   * \param incremental Update the shortest path trees instead of recomputing them (default)
+   */
+  void SetIncremental (bool incremental);
+
+  /**
+   * \param nThreads Number of threads computing an update (default 1, 0 for one per core)
+   */
+  void SetNThreads (uint32_t nThreads);
+
+  uint32_t GetNThreads (void) const;
+
+  /**
+   * \brief Compute the forwarding state at the current simulation time
+   *
+   * \return Changes since the previous update, with node ids (satellites, then ground
+   *         stations) and next hop -1 for unreachable destinations
+   */
+  const std::vector<FstateRecord>& Update (void);
+
+  /**
+   * \return Length of the shortest path from a node to a ground station in the last
+   *         update (infinity if unreachable)
+   */
+  double GetDistance (uint32_t nodeId, uint32_t gid) const;
+
+  /**
+   * \return Number of satellites settled (taken from the priority queue) by all updates
+   */
+  uint64_t GetNSettled (void) const;
+
+private:
+  static const int32_t NONE = -1;   //!< No path
+  static const int32_t ENTRY = -2;  //!< Over the GSL to the destination itself
+
+  /**
+   * \brief Scratch space of one thread
+   */
+  struct Workspace
+  {
+    Workspace (uint32_t nSats);
+    std::vector<double> gslLength;           //!< Per satellite, for the ground station being updated
+    std::vector<uint32_t> evaluated;         //!< Per satellite, stamp of the last re-evaluation
+    uint32_t stamp;
+    std::vector<uint32_t> path;
+    uint64_t nSettled;
+  };
+
+  void ReadTopology (void);
+  void UpdateLengths (void);
+  void UpdateDestination (uint32_t gid, Workspace& workspace);
+  void Recompute (uint32_t gid, Workspace& workspace);
+  void Repair (uint32_t gid, Workspace& workspace);
+  void Emit (std::vector<FstateRecord>& changes, int32_t current, int32_t destination, int32_t nextHop,
+             int32_t currentIf, int32_t nextHopIf);
+
+  NodeContainer m_satellites;
+  NodeContainer m_groundStations;
+  double m_maxGslLengthM;
+  bool m_incremental;
+  bool m_initialized;
+  uint32_t m_nSats;
+  uint32_t m_nGs;
+
+  // ISL graph (compressed rows: the ISLs of satellite s are [m_first[s], m_first[s + 1]))
+  std::vector<uint32_t> m_first;
+  std::vector<uint32_t> m_neighbor;
+  std::vector<uint32_t> m_reverse;           //!< Same ISL seen from the neighbor
+  std::vector<int32_t> m_device;             //!< Device of the satellite toward the neighbor
+  std::vector<double> m_length;              //!< m, at the last update
+
+  std::vector<int32_t> m_satGslDevice;
+  std::vector<int32_t> m_gsGslDevice;
+  std::vector<Ptr<MobilityModel> > m_satMobility;
+  GroundStationGrid m_grid;
+  std::vector<std::vector<std::pair<uint32_t, double> > > m_visible;  //!< Per ground station: (satellite, GSL length)
+
+  // Shortest path trees, per ground station and satellite (gid * m_nSats + sid)
+  std::vector<double> m_distance;
+  std::vector<int32_t> m_parent;             //!< ISL toward the parent, ENTRY or NONE
+  std::vector<Workspace> m_workspaces;       //!< Per thread
+
+  std::vector<int32_t> m_nextHop;            //!< Per node and ground station (nodeId * m_nGs + gid)
+  std::vector<std::vector<FstateRecord> > m_destinationChanges;  //!< Per ground station
+  std::vector<FstateRecord> m_changes;
+};
+
+} // namespace ns3
+
+#endif /* LEO_ROUTE_ENGINE_H */
@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-leo-face-table.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/ndn-net-device-transport.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+NS_LOG_COMPONENT_DEFINE("ndn.LeoFaceTable");
+
+LeoFaceTable::LeoFaceTable(NodeContainer nodes)
+  : m_gslDeviceIds(nodes.GetN(), -1)
+{
+  m_offsets.reserve(nodes.GetN() + 1);
+  m_offsets.push_back(0);
+  for (uint32_t i = 0; i < nodes.GetN(); i++) {
+    Ptr<Node> node = nodes.Get(i);
+    NS_ABORT_MSG_UNLESS(node->GetId() == i, "Node " << i << " of the container has id " << node->GetId());
+    Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+    NS_ABORT_MSG_IF(ndn == nullptr, "Ndn stack should be installed on node " << i);
+
+    for (uint32_t deviceId = 0; deviceId < node->GetNDevices(); deviceId++) {
+      shared_ptr<Face> face = ndn->getFaceByNetDevice(node->GetDevice(deviceId));
+      m_faces.push_back(face.get());
+      m_transports.push_back(face == nullptr ? nullptr : dynamic_cast<NetDeviceTransport*>(face->getTransport()));
+      if (face != nullptr && face->getLinkType() == ::ndn::nfd::LINK_TYPE_AD_HOC) {
+        m_gslDeviceIds[i] = deviceId;
+      }
+    }
+    m_offsets.push_back(m_faces.size());
+  }
+  NS_LOG_DEBUG(m_faces.size() << " devices on " << nodes.GetN() << " nodes");
+}
+
+uint32_t
+LeoFaceTable::GetNDevices(uint32_t node) const
+{
+  return m_offsets.at(node + 1) - m_offsets[node];
+}
+
+Face*
+LeoFaceTable::GetFace(uint32_t node, uint32_t deviceId) const
+{
+  NS_ASSERT_MSG(deviceId < GetNDevices(node), "Node " << node << " has no device " << deviceId);
+  return m_faces[m_offsets[node] + deviceId];
+}
+
+NetDeviceTransport*
+LeoFaceTable::GetTransport(uint32_t node, uint32_t deviceId) const
+{
+  NS_ASSERT_MSG(deviceId < GetNDevices(node), "Node " << node << " has no device " << deviceId);
+  return m_transports[m_offsets[node] + deviceId];
+}
+
+int32_t
+LeoFaceTable::GetGslDeviceId(uint32_t node) const
+{
+  return m_gslDeviceIds.at(node);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_LEO_FACE_TABLE_H
+#define NDN_LEO_FACE_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include "ns3/node-container.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+namespace ndn {
+
+class NetDeviceTransport;
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Faces of the LEO nodes, indexed by (node id, device index)
+ *
+ * Built once after the NDN stacks are installed: the faces and their transports are kept in
+ * flat arrays with one offset per node, so that route installation and GSL updates look
+ * them up in constant time instead of asking L3Protocol for every (node, device).
+ *
+ * Nodes are identified by their index in the container given at construction, which must
+ * be their node id. The faces are owned by the face tables of the nodes: the table must not
+ * be used after the stacks are disposed, nor after any face of the nodes is removed.
+ */
+class LeoFaceTable : public SimpleRefCount<LeoFaceTable> {
+public:
+  /**
+   * @param nodes All nodes, indexed by node id, with their NDN stack installed
+   */
+  explicit LeoFaceTable(NodeContainer nodes);
+
+  uint32_t
+  GetNDevices(uint32_t node) const;
+
+  /**
+   * @return Face of a device of the node, nullptr if the device has none
+   */
+  Face*
+  GetFace(uint32_t node, uint32_t deviceId) const;
+
+  /**
+   * @return Transport of the face of a device of the node, nullptr if none
+   */
+  NetDeviceTransport*
+  GetTransport(uint32_t node, uint32_t deviceId) const;
+
+  /**
+   * @return Last device of the node whose face is ad hoc (the GSL), -1 if none
+   */
+  int32_t
+  GetGslDeviceId(uint32_t node) const;
+
+private:
+  std::vector<uint32_t> m_offsets;                               //!< Per node, + 1: first device entry
+  std::vector<Face*> m_faces;                                    //!< Per (node, device)
+  std::vector<NetDeviceTransport*> m_transports;                 //!< Per (node, device)
+  std::vector<int32_t> m_gslDeviceIds;                           //!< Per node
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LEO_FACE_TABLE_H
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-leo-fib-table.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+NS_LOG_COMPONENT_DEFINE("ndn.LeoFibTable");
+
+const uint32_t LeoFibTable::Batch::REMOVE;
+
+void
+LeoFibTable::Batch::Add(uint32_t node, uint32_t destination, uint32_t nextHop, uint32_t deviceId)
+{
+  m_changes.push_back({node, destination, nextHop, deviceId});
+}
+
+void
+LeoFibTable::Batch::Remove(uint32_t node, uint32_t destination)
+{
+  m_changes.push_back({node, destination, node, REMOVE});
+}
+
+size_t
+LeoFibTable::Batch::GetN() const
+{
+  return m_changes.size();
+}
+
+LeoFibTable::LeoFibTable(NodeContainer nodes, Ptr<LeoFaceTable> faceTable, bool replace)
+  : m_nodes(nodes)
+  , m_n(nodes.GetN())
+  , m_replace(replace)
+  , m_inPlace(true)
+  , m_deviceIds(static_cast<size_t>(m_n) * m_n, -1)
+  , m_faceTable(faceTable)
+  , m_mobility(m_n)
+{
+  NS_ABORT_MSG_IF(faceTable == nullptr, "LeoFibTable needs the face table of the nodes");
+  for (uint32_t i = 0; i < m_n; i++) {
+    NS_ABORT_MSG_UNLESS(nodes.Get(i)->GetId() == i, "Node " << i << " of the container has id "
+                                                             << nodes.Get(i)->GetId());
+    m_prefixes.push_back(Name("/leo/uid-" + std::to_string(i)));
+  }
+}
+
+void
+LeoFibTable::SetInPlace(bool inPlace)
+{
+  m_inPlace = inPlace;
+}
+
+const Name&
+LeoFibTable::GetPrefix(uint32_t destination) const
+{
+  return m_prefixes.at(destination);
+}
+
+void
+LeoFibTable::Schedule(Ptr<Batch> batch, Time delay)
+{
+  // Group the changes by node (keeping their order within a node)
+  std::vector<Batch::Change>& changes = batch->m_changes;
+  std::stable_sort(changes.begin(), changes.end(),
+                   [](const Batch::Change& a, const Batch::Change& b) { return a.node < b.node; });
+
+  uint32_t begin = 0;
+  while (begin < changes.size()) {
+    uint32_t end = begin + 1;
+    while (end < changes.size() && changes[end].node == changes[begin].node) {
+      end++;
+    }
+    Simulator::ScheduleWithContext(changes[begin].node, delay, &LeoFibTable::Apply, Ptr<LeoFibTable>(this),
+                                   batch, begin, end);
+    begin = end;
+  }
+}
+
+int32_t
+LeoFibTable::GetDeviceId(uint32_t node, uint32_t destination) const
+{
+  return m_deviceIds.at(static_cast<size_t>(node) * m_n + destination);
+}
+
+void
+LeoFibTable::Apply(Ptr<Batch> batch, uint32_t begin, uint32_t end)
+{
+  uint32_t nodeId = batch->m_changes[begin].node;
+  Ptr<Node> node = m_nodes.Get(nodeId);
+  if (m_mobility[nodeId] == nullptr) {
+    m_mobility[nodeId] = node->GetObject<MobilityModel>();
+  }
+  NS_LOG_FUNCTION(nodeId << end - begin);
+
+  m_updates.clear();
+  for (uint32_t i = begin; i < end; i++) {
+    const Batch::Change& change = batch->m_changes[i];
+    NS_ABORT_MSG_UNLESS(change.destination < m_n && change.nextHop < m_n, "Invalid route of node " << nodeId);
+
+    const Name& prefix = m_prefixes[change.destination];
+    int16_t& current = m_deviceIds[static_cast<size_t>(nodeId) * m_n + change.destination];
+    if (change.deviceId == Batch::REMOVE) {
+      if (current >= 0) {
+        if (m_inPlace) {
+          m_updates.push_back({&prefix, nfd::face::INVALID_FACEID, GetFace(nodeId, current)->getId(), 0});
+        }
+        else {
+          FibHelper::RemoveRoute(node, prefix, GetFace(nodeId, current)->shared_from_this());
+        }
+        current = -1;
+      }
+      continue;
+    }
+
+    // Legacy dynamic states may refer to more GSL interfaces than were created
+    uint32_t deviceId = std::min(change.deviceId, m_faceTable->GetNDevices(nodeId) - 1);
+    NS_ABORT_MSG_IF(deviceId > static_cast<uint32_t>(std::numeric_limits<int16_t>::max()),
+                    "Too many devices on node " << nodeId);
+
+    // The cost is the distance to the next hop (in meters)
+    if (m_mobility[change.nextHop] == nullptr) {
+      m_mobility[change.nextHop] = m_nodes.Get(change.nextHop)->GetObject<MobilityModel>();
+    }
+    int32_t metric = m_mobility[nodeId]->GetDistanceFrom(m_mobility[change.nextHop]);
+
+    bool isReplaced = m_replace && current >= 0 && static_cast<uint32_t>(current) != deviceId;
+    if (m_inPlace) {
+      m_updates.push_back({&prefix, GetFace(nodeId, deviceId)->getId(),
+                           isReplaced ? GetFace(nodeId, current)->getId() : nfd::face::INVALID_FACEID,
+                           static_cast<uint64_t>(metric)});
+    }
+    else {
+      FibHelper::AddRoute(node, prefix, GetFace(nodeId, deviceId)->shared_from_this(), metric);
+      if (isReplaced) {
+        FibHelper::RemoveRoute(node, prefix, GetFace(nodeId, current)->shared_from_this());
+      }
+    }
+    current = deviceId;
+  }
+
+  if (!m_updates.empty()) {
+    node->GetObject<L3Protocol>()->updateFib(m_updates);
+  }
+}
+
+Face*
+LeoFibTable::GetFace(uint32_t node, uint32_t deviceId) const
+{
+  Face* face = m_faceTable->GetFace(node, deviceId);
+  NS_ABORT_MSG_IF(face == nullptr, "There is no face associated with device " << deviceId << " of node " << node);
+  return face;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_LEO_FIB_TABLE_H
+#define NDN_LEO_FIB_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndn-leo-face-table.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "ns3/mobility-model.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Next hops of the LEO nodes toward the /leo/uid-<destination> prefixes
+ *
+ * The forwarding state of a LEO network changes for many (node, destination) pairs at every
+ * epoch. The changes of an epoch are collected in a Batch and applied with one event per
+ * node: the route over the new next hop is added with the distance to the next hop as cost,
+ * and (in replace mode) the route over the previous next hop is removed.
+ *
+ * The current next hop of every (node, destination) pair is kept as a device index in one
+ * flat table, the prefixes are built once, and the faces are looked up in a LeoFaceTable.
+ *
+ * By default the changes of a node are applied to its FIB in place, in one
+ * L3Protocol::updateFib call. With SetInPlace(false), every route goes through a signed
+ * command Interest to the FIB manager (FibHelper::AddRoute and RemoveRoute) instead.
+ *
+ * Nodes are identified by their index in the container given at construction, which must
+ * be their node id (as in NDNSatSimulator::m_allNodes).
+ *
+ * The face table is shared with the other users of the faces (such as the GSL updates of
+ * NDNSatSimulator). It holds raw pointers: no face of the nodes may be removed while the
+ * FIB table is in use.
+ */
+class LeoFibTable : public SimpleRefCount<LeoFibTable> {
+public:
+  /**
+   * @brief Next hop changes of one epoch
+   */
+  class Batch : public SimpleRefCount<Batch> {
+  public:
+    /**
+     * @brief Route the destination over a device of the node
+     * @param node Node whose next hop changes
+     * @param destination Destination node (prefix /leo/uid-<destination>)
+     * @param nextHop Next hop node, for the route cost
+     * @param deviceId Device of the node toward the next hop
+     */
+    void
+    Add(uint32_t node, uint32_t destination, uint32_t nextHop, uint32_t deviceId);
+
+    /**
+     * @brief Remove the route of the node toward the destination (unreachable)
+     */
+    void
+    Remove(uint32_t node, uint32_t destination);
+
+    size_t
+    GetN() const;
+
+  private:
+    friend class LeoFibTable;
+
+    struct Change {
+      uint32_t node;
+      uint32_t destination;
+      uint32_t nextHop;
+      uint32_t deviceId;                                           //!< REMOVE to remove the route
+    };
+
+    static const uint32_t REMOVE = std::numeric_limits<uint32_t>::max();
+
+    std::vector<Change> m_changes;
+  };
+
+  /**
+   * @param nodes All nodes, indexed by node id
+   * @param faceTable Faces of the same nodes
+   * @param replace Remove the route over the previous next hop when the next hop changes
+   *                (otherwise routes are only added)
+   */
+  LeoFibTable(NodeContainer nodes, Ptr<LeoFaceTable> faceTable, bool replace);
+
+  /**
+   * @brief Apply the changes to the FIBs in place (default) or with FIB manager commands
+   */
+  void
+  SetInPlace(bool inPlace);
+
+  /**
+   * @brief Prefix of a destination node (/leo/uid-<destination>)
+   */
+  const Name&
+  GetPrefix(uint32_t destination) const;
+
+  /**
+   * @brief Apply the changes of a batch after a delay, with one event per node
+   */
+  void
+  Schedule(Ptr<Batch> batch, Time delay);
+
+  /**
+   * @return Device of the node currently routing toward the destination, -1 if none
+   */
+  int32_t
+  GetDeviceId(uint32_t node, uint32_t destination) const;
+
+private:
+  /**
+   * @brief Apply the changes [begin, end) of a batch, all belonging to one node
+   */
+  void
+  Apply(Ptr<Batch> batch, uint32_t begin, uint32_t end);
+
+  Face*
+  GetFace(uint32_t node, uint32_t deviceId) const;
+
+private:
+  NodeContainer m_nodes;
+  uint32_t m_n;
+  bool m_replace;
+  bool m_inPlace;
+  std::vector<Name> m_prefixes;                                  //!< Per destination
+  std::vector<int16_t> m_deviceIds;                              //!< node * m_n + destination -> device, -1 if none
+  Ptr<LeoFaceTable> m_faceTable;
+  std::vector<Ptr<MobilityModel>> m_mobility;                    //!< Per node
+  std::vector<L3Protocol::FibUpdate> m_updates;                  //!< Changes of the node being applied
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LEO_FIB_TABLE_H
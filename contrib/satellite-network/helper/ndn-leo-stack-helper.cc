@@ -46,6 +46,7 @@
 #include <limits>
 #include <map>
 #include <boost/lexical_cast.hpp>
+#include <boost/property_tree/ptree.hpp>
 
 #include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-priority-fifo.hpp"
@@ -59,6 +60,7 @@ namespace ndn {
 LeoStackHelper::LeoStackHelper()
   : m_isForwarderStatusManagerDisabled(false)
   , m_isStrategyChoiceManagerDisabled(false)
+  , m_isHeadless(false)
   , m_needSetDefaultRoutes(false)
 {
   setCustomNdnCxxClocks();
@@ -127,6 +129,7 @@ void
 LeoStackHelper::setCsSize(size_t maxSize)
 {
   m_maxCsSize = maxSize;
+  m_headlessConfig = nullptr;
 }
 
 void
@@ -177,15 +180,25 @@ LeoStackHelper::doInstall(Ptr<Node> node) const
   // async install to ensure proper context
   Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol>();
 
-  if (m_isForwarderStatusManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_forwarder_status_manager", true);
+  if (m_isHeadless) {
+    if (m_headlessConfig == nullptr) {
+      m_headlessConfig = make_shared<nfd::ConfigSection>(ndn->getConfig());
+      m_headlessConfig->put("ndnSIM.headless", true);
+      m_headlessConfig->put("tables.cs_max_packets", m_maxCsSize);
+    }
+    ndn->setConfig(m_headlessConfig);
   }
+  else {
+    if (m_isForwarderStatusManagerDisabled) {
+      ndn->getConfig().put("ndnSIM.disable_forwarder_status_manager", true);
+    }
 
-  if (m_isStrategyChoiceManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
-  }
+    if (m_isStrategyChoiceManagerDisabled) {
+      ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
+    }
 
-  ndn->getConfig().put("tables.cs_max_packets", m_maxCsSize);
+    ndn->getConfig().put("tables.cs_max_packets", m_maxCsSize);
+  }
 
   ndn->setCsReplacementPolicy(m_csPolicyCreationFunc);
 
@@ -473,6 +486,12 @@ LeoStackHelper::disableForwarderStatusManager()
   m_isForwarderStatusManagerDisabled = true;
 }
 
+void
+LeoStackHelper::setHeadless(bool isHeadless)
+{
+  m_isHeadless = isHeadless;
+}
+
 void
 LeoStackHelper::SetLinkDelayAsFaceMetric()
 {
@@ -30,7 +30,10 @@
 #include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
 #include "ns3/ndnSIM/helper/ndn-strategy-choice-helper.hpp"
 
+#include <boost/property_tree/ptree_fwd.hpp>
+
 namespace nfd {
+typedef boost::property_tree::ptree ConfigSection;
 namespace cs {
 class Policy;
 } // namespace cs
@@ -221,6 +224,16 @@ public:
   void
   disableForwarderStatusManager();
 
+  /**
+   * \brief Install forwarders without management (see L3Protocol::isHeadless)
+   *
+   * Nodes get only the face table, the forwarder and its tables, and share one NFD config
+   * tree. Routes and strategies are set in place by FibHelper, StrategyChoiceHelper and
+   * LeoFibTable; the management datasets and the RIB are not available.
+   */
+  void
+  setHeadless(bool isHeadless);
+
   /**
    * @brief Set face metric of all faces connected through PointToPoint channel to channel latency
    */
@@ -255,6 +268,9 @@ private:
 
   bool m_isForwarderStatusManagerDisabled;
   bool m_isStrategyChoiceManagerDisabled;
+  bool m_isHeadless;
+  // built by the first headless install
+  mutable shared_ptr<nfd::ConfigSection> m_headlessConfig;
 
 public:
   void
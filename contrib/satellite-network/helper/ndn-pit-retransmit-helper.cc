@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-pit-retransmit-helper.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "ns3/log.h"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/nack-retx-strategy.h"
+
+namespace ns3 {
+namespace ndn {
+
+NS_LOG_COMPONENT_DEFINE("ndn.PitRetransmitHelper");
+
+std::vector<shared_ptr<nfd::pit::Entry>>
+PitRetransmitHelper::FindPending(nfd::Forwarder& forwarder, const Name& prefix)
+{
+  std::vector<shared_ptr<nfd::pit::Entry>> entries;
+  nfd::NameTree& nameTree = forwarder.getNameTree();
+  if (nameTree.findExactMatch(prefix) == nullptr) {
+    return entries;
+  }
+
+  // The enumeration starts at the longest prefix match of the prefix, which is the prefix itself
+  auto range = nameTree.partialEnumerate(prefix, [] (const nfd::name_tree::Entry& entry) {
+      return std::make_pair(entry.hasPitEntries(), true);
+    });
+  for (const nfd::name_tree::Entry& entry : range) {
+    if (!prefix.isPrefixOf(entry.getName())) {
+      continue;
+    }
+    const std::vector<shared_ptr<nfd::pit::Entry>>& pitEntries = entry.getPitEntries();
+    entries.insert(entries.end(), pitEntries.begin(), pitEntries.end());
+  }
+  return entries;
+}
+
+size_t
+PitRetransmitHelper::Retransmit(Ptr<Node> node, const Name& prefix)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  shared_ptr<nfd::Forwarder> fw = ndn->getForwarder();
+  nfd::Fib& fib = fw->getFib();
+
+  // Default life time is 2s
+  time::milliseconds interestLifeTime(2000);
+
+  std::vector<std::pair<Face*, Interest>> sends;
+  for (const shared_ptr<nfd::pit::Entry>& entry : FindPending(*fw, prefix)) {
+    const Name& fullName = entry->getName();
+    entry->clearOutRecords();
+    // Empty entry if no match, with no next hops
+    const nfd::fib::Entry& fibEntry = fib.findLongestPrefixMatch(fullName);
+    for (const nfd::fib::NextHop& nextHop : fibEntry.getNextHops()) {
+      NS_LOG_DEBUG("PIT ADDED - " << fullName << "," << nextHop.getFace().getId());
+      Interest interest(fullName, interestLifeTime);
+      entry->insertOrUpdateOutRecord(nextHop.getFace(), interest);
+      sends.emplace_back(&nextHop.getFace(), std::move(interest));
+    }
+  }
+
+  // Back-to-back sends per face, in the order of the entries
+  std::stable_sort(sends.begin(), sends.end(),
+                   [] (const std::pair<Face*, Interest>& a,
+                       const std::pair<Face*, Interest>& b) {
+                     return a.first->getId() < b.first->getId();
+                   });
+  for (const auto& send : sends) {
+    send.first->sendInterest(send.second);
+  }
+  return sends.size();
+}
+
+size_t
+PitRetransmitHelper::SendNackOrForward(Ptr<Node> node, const nfd::FaceEndpoint& faceEndpoint,
+                                       const Name& prefix)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  shared_ptr<nfd::Forwarder> fw = ndn->getForwarder();
+
+  std::unique_ptr<nfd::fw::NackRetxStrategy> fallback;
+  std::vector<shared_ptr<nfd::pit::Entry>> entries = FindPending(*fw, prefix);
+  for (const shared_ptr<nfd::pit::Entry>& entry : entries) {
+    auto strategy =
+      dynamic_cast<nfd::fw::NackRetxStrategy*>(&fw->getStrategyChoice().findEffectiveStrategy(*entry));
+    if (strategy == nullptr) {
+      if (fallback == nullptr) {
+        fallback.reset(new nfd::fw::NackRetxStrategy(*fw, "/localhost/nfd/strategy/nack-retx"));
+      }
+      strategy = fallback.get();
+    }
+    strategy->sendNackOrForward(entry->getInterest(), faceEndpoint, entry);
+  }
+  return entries.size();
+}
+
+} // namespace ndn
+} // namespace ns3
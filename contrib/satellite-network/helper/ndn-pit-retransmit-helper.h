@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_PIT_RETRANSMIT_HELPER_H
+#define NDN_PIT_RETRANSMIT_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/face-endpoint.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/pit-entry.hpp"
+
+#include <vector>
+
+#include "ns3/node.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Re-expression of the pending Interests under a prefix after a FIB change
+ *
+ * Only the name tree subtree of the prefix is visited (the PIT entries of other prefixes
+ * are not looked at), so the cost of an operation depends on the number of Interests
+ * pending under the prefix rather than on the size of the PIT.
+ */
+class PitRetransmitHelper {
+public:
+  /**
+   * @brief Send the pending Interests under a prefix again, over the current FIB next hops
+   *
+   * The out records of every matching PIT entry are replaced by one out record per next hop
+   * of the longest prefix match in the FIB. The Interests are sent once all entries have
+   * been updated, grouped per outgoing face.
+   *
+   * @return Number of Interests sent
+   */
+  static size_t
+  Retransmit(Ptr<Node> node, const Name& prefix);
+
+  /**
+   * @brief Let the nack-retx strategy nack or forward the pending Interests under a prefix
+   *
+   * The strategy instance installed for each entry is used; a NackRetxStrategy is only
+   * constructed if another strategy is installed for the entry.
+   *
+   * @return Number of PIT entries handled
+   */
+  static size_t
+  SendNackOrForward(Ptr<Node> node, const nfd::FaceEndpoint& faceEndpoint, const Name& prefix);
+
+private:
+  /**
+   * @brief PIT entries with a name under the prefix, collected before any of them is touched
+   */
+  static std::vector<shared_ptr<nfd::pit::Entry>>
+  FindPending(nfd::Forwarder& forwarder, const Name& prefix);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PIT_RETRANSMIT_HELPER_H
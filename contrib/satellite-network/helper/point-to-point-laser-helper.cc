@@ -22,6 +22,10 @@
  */
 
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "ns3/abort.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -38,6 +42,8 @@
 #include "ns3/mpi-receiver.h"
 #include "ns3/error-model.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/satellite-position-mobility-model.h"
 
 #include "ns3/trace-helper.h"
 #include "point-to-point-laser-helper.h"
@@ -125,39 +131,43 @@ PointToPointLaserHelper::Install (Ptr<Node> a, Ptr<Node> b)
   ndqiB->GetTxQueue (0)->ConnectQueueTraces (queueB);
   devB->AggregateObject (ndqiB);
 
-  // Distributed mode
-  NS_ABORT_MSG_IF(MpiInterface::IsEnabled(), "Distributed mode is not currently supported for point-to-point lasers.");
-
-  // Distributed mode is not currently supported, enable the below if it is:
-//  // If MPI is enabled, we need to see if both nodes have the same system id
-//  // (rank), and the rank is the same as this instance.  If both are true,
-//  //use a normal p2p channel, otherwise use a remote channel
-//  bool useNormalChannel = true;
-//  Ptr<PointToPointLaserChannel> channel = 0;
-//
-//  if (MpiInterface::IsEnabled ()) {
-//      uint32_t n1SystemId = a->GetSystemId ();
-//      uint32_t n2SystemId = b->GetSystemId ();
-//      uint32_t currSystemId = MpiInterface::GetSystemId ();
-//      if (n1SystemId != currSystemId || n2SystemId != currSystemId) {
-//          useNormalChannel = false;
-//      }
-//  }
-//  if (useNormalChannel) {
-//    channel = m_channelFactory.Create<PointToPointLaserChannel> ();
-//  }
-//  else {
-//    channel = m_remoteChannelFactory.Create<PointToPointLaserRemoteChannel>();
-//    Ptr<MpiReceiver> mpiRecA = CreateObject<MpiReceiver> ();
-//    Ptr<MpiReceiver> mpiRecB = CreateObject<MpiReceiver> ();
-//    mpiRecA->SetReceiveCallback (MakeCallback (&PointToPointLaserNetDevice::Receive, devA));
-//    mpiRecB->SetReceiveCallback (MakeCallback (&PointToPointLaserNetDevice::Receive, devB));
-//    devA->AggregateObject (mpiRecA);
-//    devB->AggregateObject (mpiRecB);
-//  }
-
-  // Create and attach channel
-  Ptr<PointToPointLaserChannel> channel = m_channelFactory.Create<PointToPointLaserChannel> ();
+  // If MPI is enabled, we need to see if both nodes have the same system id
+  // (rank), and the rank is the same as this instance.  If both are true,
+  // use a normal p2p channel, otherwise use a remote channel
+  bool useNormalChannel = true;
+  Ptr<PointToPointLaserChannel> channel = 0;
+
+  if (MpiInterface::IsEnabled ()) {
+      uint32_t n1SystemId = a->GetSystemId ();
+      uint32_t n2SystemId = b->GetSystemId ();
+      uint32_t currSystemId = MpiInterface::GetSystemId ();
+      if (n1SystemId != currSystemId || n2SystemId != currSystemId) {
+          useNormalChannel = false;
+      }
+  }
+  if (useNormalChannel) {
+    channel = m_channelFactory.Create<PointToPointLaserChannel> ();
+  }
+  else {
+    channel = m_remoteChannelFactory.Create<PointToPointLaserRemoteChannel>();
+    Ptr<MpiReceiver> mpiRecA = CreateObject<MpiReceiver> ();
+    Ptr<MpiReceiver> mpiRecB = CreateObject<MpiReceiver> ();
+    mpiRecA->SetReceiveCallback (MakeCallback (&PointToPointLaserNetDevice::Receive, devA));
+    mpiRecB->SetReceiveCallback (MakeCallback (&PointToPointLaserNetDevice::Receive, devB));
+    devA->AggregateObject (mpiRecA);
+    devB->AggregateObject (mpiRecB);
+
+    // The lookahead of the distributed simulator must hold for the whole run,
+    // not only at the initial distance (only links of this system are looked at)
+    uint32_t currSystemId = MpiInterface::GetSystemId ();
+    if (a->GetSystemId () == currSystemId || b->GetSystemId () == currSystemId) {
+      DoubleValue propagationSpeed;
+      channel->GetAttribute ("PropagationSpeed", propagationSpeed);
+      channel->SetAttribute ("Delay", TimeValue (GetMinimumDelay (a, b, propagationSpeed.Get ())));
+    }
+  }
+
+  // Attach channel
   devA->Attach (channel);
   devB->Attach (channel);
   container.Add (devA);
@@ -166,4 +176,85 @@ PointToPointLaserHelper::Install (Ptr<Node> a, Ptr<Node> b)
   return container;
 }
 
+/**
+ * \brief Position and velocity of a node at simulation time t
+ */
+static void
+GetState (Ptr<Node> node, Time t, Vector &position, Vector &velocity)
+{
+  Ptr<SatellitePositionMobilityModel> satellite = node->GetObject<SatellitePositionMobilityModel> ();
+  if (satellite != 0 && satellite->GetSatellite () != 0)
+    {
+      // Not through a shared constellation: each of these instants would propagate all satellites
+      satellite->GetSatellite ()->GetPositionVelocity (satellite->GetStartTime () + t, position, velocity);
+      return;
+    }
+  position = node->GetObject<MobilityModel> ()->GetPosition ();
+  velocity = Vector (0, 0, 0);
+}
+
+/**
+ * \brief Upper bound of the speed of a node on the ITRF frame, in m/s
+ */
+static double
+GetMaxSpeed (Ptr<Node> node)
+{
+  // Earth's gravitational parameter (m^3/s^2) and rotation rate (rad/s)
+  const double mu = 3.986004418e14;
+  const double omega = 7.292115e-5;
+  // The osculating orbit deviates from the mean one by a few kilometers (J2)
+  const double margin = 0.01;
+
+  Ptr<SatellitePositionMobilityModel> satellite = node->GetObject<SatellitePositionMobilityModel> ();
+  if (satellite == 0 || satellite->GetSatellite () == 0)
+    {
+      return 0;
+    }
+  double period = satellite->GetSatellite ()->GetOrbitalPeriod ().GetSeconds ();
+  double perigee = satellite->GetSatellite ()->GetPerigeeRadius ();
+  double a = std::cbrt (mu * period * period / (4 * M_PI * M_PI));
+  double apogee = std::max (perigee, 2 * a - perigee);
+  return (std::sqrt (mu * (2 / perigee - 1 / a)) + omega * apogee) * (1 + margin);
+}
+
+Time
+PointToPointLaserHelper::GetMinimumDelay (Ptr<Node> a, Ptr<Node> b, double propagationSpeed)
+{
+  Ptr<SatellitePositionMobilityModel> aSatellite = a->GetObject<SatellitePositionMobilityModel> ();
+  Ptr<SatellitePositionMobilityModel> bSatellite = b->GetObject<SatellitePositionMobilityModel> ();
+  if (aSatellite == 0 && bSatellite == 0)
+    {
+      return Seconds (a->GetObject<MobilityModel> ()->GetDistanceFrom (b->GetObject<MobilityModel> ()) / propagationSpeed);
+    }
+
+  // The relative geometry of two satellites of the same shell repeats every
+  // orbital period, so the distance is sampled over one period
+  Time period = Seconds (0);
+  if (aSatellite != 0)
+    {
+      period = Max (period, aSatellite->GetSatellite ()->GetOrbitalPeriod ());
+    }
+  if (bSatellite != 0)
+    {
+      period = Max (period, bSatellite->GetSatellite ()->GetOrbitalPeriod ());
+    }
+  const uint32_t samples = 1000;
+  Time step = period / samples;
+
+  double minDistance = std::numeric_limits<double>::infinity ();
+  Vector aPosition, aVelocity, bPosition, bVelocity;
+  for (uint32_t k = 0; k <= samples; k++)
+    {
+      Time t = Simulator::Now () + step * k;
+      GetState (a, t, aPosition, aVelocity);
+      GetState (b, t, bPosition, bVelocity);
+      minDistance = std::min (minDistance, CalculateDistance (aPosition, bPosition));
+    }
+
+  // Every instant is within half a step of a sample, and the distance cannot
+  // shrink faster than both nodes can move
+  double bound = minDistance - (GetMaxSpeed (a) + GetMaxSpeed (b)) * step.GetSeconds () / 2;
+  return Seconds (std::max (0.0, bound) / propagationSpeed);
+}
+
 } // namespace ns3
@@ -56,6 +56,29 @@ public:
   NetDeviceContainer Install (NodeContainer c);
   NetDeviceContainer Install (Ptr<Node> a, Ptr<Node> b);
 
+  /**
+   * \brief Lower bound of the propagation delay between two nodes over the run
+   *
+   * The distance between two satellites is sampled over one orbital period. Every
+   * instant is at most half a sampling step away from a sample, and the distance
+   * cannot change faster than the sum of the largest speeds of both nodes (the
+   * Keplerian speed at perigee, plus the rotation of the Earth at apogee for ITRF
+   * positions, with a margin for the SGP4 perturbations). That much is subtracted
+   * from the smallest sample. This is the lookahead the distributed simulator can
+   * use for an ISL crossing systems.
+   *
+   * The relative geometry of satellites in the same shell repeats every orbital
+   * period, up to the slow drift of the orbits: runs going past one period rely on it,
+   * and PointToPointLaserRemoteChannel aborts if a delay ever goes below the bound.
+   *
+   * \param a First node
+   * \param b Second node
+   * \param propagationSpeed Propagation speed in m/s
+   *
+   * \return Lower bound of the delay from the current time on
+   */
+  static Time GetMinimumDelay (Ptr<Node> a, Ptr<Node> b, double propagationSpeed);
+
 private:
   ObjectFactory m_queueFactory;         //!< Queue Factory
   ObjectFactory m_channelFactory;       //!< Channel Factory
@@ -0,0 +1,232 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "fstate-binary.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FstateBinaryFile");
+
+const char FstateBinaryFile::MAGIC[8] = {'N', 'D', 'N', 'F', 'S', 'T', 'B', '1'};
+
+namespace {
+
+struct FstateHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t nEpochs;
+  uint64_t nRecords;
+};
+
+const char* FSTATE_BINARY_NAME = "fstate.bin";
+
+// Parses "a,b,c,d,e" without allocating; returns false on a malformed line
+bool
+ParseFstateLine (const char* line, FstateRecord& record)
+{
+  int32_t* fields[5] = {&record.current, &record.destination, &record.nextHop,
+                        &record.currentIf, &record.nextHopIf};
+  const char* p = line;
+  for (int i = 0; i < 5; i++)
+    {
+      char* end;
+      long value = std::strtol (p, &end, 10);
+      if (end == p)
+        {
+          return false;
+        }
+      *fields[i] = static_cast<int32_t> (value);
+      p = end;
+      if (i < 4)
+        {
+          if (*p != ',')
+            {
+              return false;
+            }
+          p++;
+        }
+    }
+  return true;
+}
+
+} // namespace
+
+FstateBinaryFile::FstateBinaryFile (const std::string& path)
+  : m_data (nullptr),
+    m_size (0),
+    m_nEpochs (0),
+    m_epochs (nullptr),
+    m_records (nullptr)
+{
+  NS_LOG_FUNCTION (this << path);
+
+  int fd = open (path.c_str (), O_RDONLY);
+  NS_ABORT_MSG_IF (fd < 0, "Binary fstate file " << path << " could not be opened");
+  struct stat st;
+  NS_ABORT_MSG_IF (fstat (fd, &st) != 0, "Could not stat " << path);
+  m_size = static_cast<size_t> (st.st_size);
+  NS_ABORT_MSG_IF (m_size < sizeof (FstateHeader), "Binary fstate file " << path << " is truncated");
+
+  m_data = mmap (nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close (fd);
+  NS_ABORT_MSG_IF (m_data == MAP_FAILED, "Binary fstate file " << path << " could not be mapped");
+
+  const FstateHeader* header = static_cast<const FstateHeader*> (m_data);
+  NS_ABORT_MSG_UNLESS (std::memcmp (header->magic, MAGIC, sizeof (MAGIC)) == 0,
+                       path << " is not a binary fstate file");
+  NS_ABORT_MSG_UNLESS (header->version == VERSION,
+                       "Unsupported binary fstate version " << header->version);
+
+  m_nEpochs = header->nEpochs;
+  const uint8_t* base = static_cast<const uint8_t*> (m_data);
+  m_epochs = reinterpret_cast<const FstateEpoch*> (base + sizeof (FstateHeader));
+  m_records = reinterpret_cast<const FstateRecord*> (base + sizeof (FstateHeader)
+                                                     + m_nEpochs * sizeof (FstateEpoch));
+  size_t expected = sizeof (FstateHeader) + m_nEpochs * sizeof (FstateEpoch)
+                    + header->nRecords * sizeof (FstateRecord);
+  NS_ABORT_MSG_UNLESS (m_size == expected, "Binary fstate file " << path << " has an invalid size");
+
+  // Epochs are replayed in order, so let the kernel read ahead
+  madvise (m_data, m_size, MADV_SEQUENTIAL);
+}
+
+FstateBinaryFile::~FstateBinaryFile ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_data != nullptr)
+    {
+      munmap (m_data, m_size);
+    }
+}
+
+uint32_t
+FstateBinaryFile::GetNEpochs (void) const
+{
+  return m_nEpochs;
+}
+
+const FstateEpoch&
+FstateBinaryFile::GetEpoch (uint32_t i) const
+{
+  NS_ASSERT (i < m_nEpochs);
+  return m_epochs[i];
+}
+
+const FstateRecord*
+FstateBinaryFile::GetRecords (uint32_t i) const
+{
+  NS_ASSERT (i < m_nEpochs);
+  return m_records + m_epochs[i].firstRecord;
+}
+
+std::string
+FstateBinaryFile::FindInDirectory (const std::string& dname)
+{
+  std::filesystem::path path (dname);
+  if (std::filesystem::is_regular_file (path))
+    {
+      return dname;
+    }
+  path /= FSTATE_BINARY_NAME;
+  if (std::filesystem::is_regular_file (path))
+    {
+      return path.string ();
+    }
+  return "";
+}
+
+uint32_t
+FstateBinaryFile::ConvertDirectory (const std::string& dname, const std::string& path)
+{
+  NS_LOG_FUNCTION (dname << path);
+
+  // Collect and sort the epochs by time (directory order is arbitrary)
+  std::vector<std::pair<int64_t, std::string> > files;
+  for (const auto& entry : std::filesystem::directory_iterator (dname))
+    {
+      std::string filename = entry.path ().filename ().string ();
+      if (filename.compare (0, 7, "fstate_") != 0 || filename.size () <= 11
+          || filename.compare (filename.size () - 4, 4, ".txt") != 0)
+        {
+          continue;
+        }
+      std::string ns = filename.substr (7, filename.size () - 11);
+      files.push_back (std::make_pair (std::stoll (ns), entry.path ().string ()));
+    }
+  std::sort (files.begin (), files.end ());
+
+  std::vector<FstateEpoch> epochs;
+  std::vector<FstateRecord> records;
+  for (const auto& file : files)
+    {
+      std::ifstream input (file.second);
+      NS_ABORT_MSG_UNLESS (input.is_open (), "File " << file.second << " could not be opened");
+      FstateEpoch epoch;
+      epoch.timeNs = file.first;
+      epoch.firstRecord = records.size ();
+      std::string line;
+      while (std::getline (input, line))
+        {
+          if (line.empty ())
+            {
+              continue;
+            }
+          FstateRecord record;
+          NS_ABORT_MSG_UNLESS (ParseFstateLine (line.c_str (), record),
+                               "Malformed line in " << file.second << ": " << line);
+          records.push_back (record);
+        }
+      epoch.numRecords = records.size () - epoch.firstRecord;
+      epochs.push_back (epoch);
+    }
+
+  FstateHeader header;
+  std::memcpy (header.magic, MAGIC, sizeof (MAGIC));
+  header.version = VERSION;
+  header.nEpochs = static_cast<uint32_t> (epochs.size ());
+  header.nRecords = records.size ();
+
+  // Write to a temporary file first such that a concurrent run never maps a partial file
+  std::string tmp = path + ".tmp";
+  std::ofstream out (tmp, std::ios::binary | std::ios::trunc);
+  NS_ABORT_MSG_UNLESS (out.is_open (), "File " << tmp << " could not be created");
+  out.write (reinterpret_cast<const char*> (&header), sizeof (header));
+  out.write (reinterpret_cast<const char*> (epochs.data ()), epochs.size () * sizeof (FstateEpoch));
+  out.write (reinterpret_cast<const char*> (records.data ()), records.size () * sizeof (FstateRecord));
+  out.close ();
+  NS_ABORT_MSG_IF (out.fail (), "Writing " << tmp << " failed");
+  NS_ABORT_MSG_IF (std::rename (tmp.c_str (), path.c_str ()) != 0, "Could not move " << tmp << " to " << path);
+
+  return header.nEpochs;
+}
+
+} // namespace ns3
@@ -0,0 +1,103 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FSTATE_BINARY_H
+#define FSTATE_BINARY_H
+
+#include <cstdint>
+#include <string>
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * \brief One forwarding state change, i.e. one line of a Hypatia fstate_<ns>.txt file
+ *
+ * Text format: <current node>,<destination node>,<next hop>,<current interface>,<next hop interface>
+ */
+struct FstateRecord
+{
+  int32_t current;       //!< Node whose forwarding state changes
+  int32_t destination;   //!< Destination node (prefix /leo/uid-<destination>)
+  int32_t nextHop;       //!< New next hop node (-1 if unreachable)
+  int32_t currentIf;     //!< Interface on the current node
+  int32_t nextHopIf;     //!< Interface on the next hop node
+};
+
+/**
+ * \brief Index entry of one epoch (one fstate_<ns>.txt file) inside a binary fstate file
+ */
+struct FstateEpoch
+{
+  int64_t timeNs;        //!< Epoch time in nanoseconds
+  uint64_t firstRecord;  //!< Index of the first record of this epoch
+  uint64_t numRecords;   //!< Number of records in this epoch
+};
+
+/**
+ * \brief Read-only, memory-mapped view on a binary forwarding state file
+ *
+ * File layout (host byte order):
+ *   header:  "NDNFSTB1", uint32 version, uint32 number of epochs, uint64 number of records
+ *   index:   one FstateEpoch per epoch, sorted by time
+ *   records: all FstateRecord entries, epoch after epoch
+ *
+ * Nothing is parsed when the file is opened: epochs are read straight from the mapping
+ * when they are requested, so only the pages of the epochs actually replayed are touched.
+ */
+class FstateBinaryFile : public SimpleRefCount<FstateBinaryFile>
+{
+public:
+  static const char MAGIC[8];
+  static const uint32_t VERSION = 1;
+
+  /**
+   * \brief Map the binary fstate file at path (aborts if it is not a valid file)
+   */
+  explicit FstateBinaryFile (const std::string& path);
+  ~FstateBinaryFile ();
+
+  FstateBinaryFile (const FstateBinaryFile&) = delete;
+  FstateBinaryFile& operator= (const FstateBinaryFile&) = delete;
+
+  uint32_t GetNEpochs (void) const;
+  const FstateEpoch& GetEpoch (uint32_t i) const;
+  const FstateRecord* GetRecords (uint32_t i) const;
+
+  /**
+   * \brief Return the path of the binary fstate file belonging to a routes directory,
+   * or the empty string if the directory has not been converted
+   */
+  static std::string FindInDirectory (const std::string& dname);
+
+  /**
+   * \brief Convert a directory of Hypatia fstate_<ns>.txt files into one binary file
+   *
+   * \return Number of epochs written
+   */
+  static uint32_t ConvertDirectory (const std::string& dname, const std::string& path);
+
+private:
+  void* m_data;
+  size_t m_size;
+  uint32_t m_nEpochs;
+  const FstateEpoch* m_epochs;
+  const FstateRecord* m_records;
+};
+
+} // namespace ns3
+
+#endif /* FSTATE_BINARY_H */
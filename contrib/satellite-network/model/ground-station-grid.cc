@@ -0,0 +1,100 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ground-station-grid.h"
+
+#include <cmath>
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("GroundStationGrid");
+
+GroundStationGrid::GroundStationGrid (double cellSizeM)
+  : m_cellSize (cellSizeM),
+    m_n (0)
+{
+  NS_LOG_FUNCTION (this << cellSizeM);
+  NS_ABORT_MSG_UNLESS (cellSizeM > 0, "Grid cell size must be positive");
+}
+
+int64_t
+GroundStationGrid::GetCell (double coordinate) const
+{
+  return static_cast<int64_t> (std::floor (coordinate / m_cellSize));
+}
+
+uint64_t
+GroundStationGrid::GetKey (int64_t x, int64_t y, int64_t z)
+{
+  // Cells that alias modulo 2^21 only share a bucket; Query() filters by exact distance
+  const uint64_t mask = (1 << 21) - 1;
+  return ((static_cast<uint64_t> (x) & mask) << 42)
+         | ((static_cast<uint64_t> (y) & mask) << 21)
+         | (static_cast<uint64_t> (z) & mask);
+}
+
+void
+GroundStationGrid::Add (uint32_t index, const Vector& position)
+{
+  NS_LOG_FUNCTION (this << index << position);
+  Entry entry;
+  entry.index = index;
+  entry.position = position;
+  m_cells[GetKey (GetCell (position.x), GetCell (position.y), GetCell (position.z))].push_back (entry);
+  m_n++;
+}
+
+void
+GroundStationGrid::Query (const Vector& position, double radiusM,
+                          std::vector<std::pair<uint32_t, double> >& result) const
+{
+  result.clear ();
+  int64_t minX = GetCell (position.x - radiusM), maxX = GetCell (position.x + radiusM);
+  int64_t minY = GetCell (position.y - radiusM), maxY = GetCell (position.y + radiusM);
+  int64_t minZ = GetCell (position.z - radiusM), maxZ = GetCell (position.z + radiusM);
+  for (int64_t x = minX; x <= maxX; x++)
+    {
+      for (int64_t y = minY; y <= maxY; y++)
+        {
+          for (int64_t z = minZ; z <= maxZ; z++)
+            {
+              auto it = m_cells.find (GetKey (x, y, z));
+              if (it == m_cells.end ())
+                {
+                  continue;
+                }
+              for (const Entry& entry : it->second)
+                {
+                  double distance = CalculateDistance (position, entry.position);
+                  if (distance <= radiusM)
+                    {
+                      result.push_back (std::make_pair (entry.index, distance));
+                    }
+                }
+            }
+        }
+    }
+}
+
+uint32_t
+GroundStationGrid::GetN (void) const
+{
+  return m_n;
+}
+
+} // namespace ns3
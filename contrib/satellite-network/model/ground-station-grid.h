@@ -0,0 +1,80 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef GROUND_STATION_GRID_H
+#define GROUND_STATION_GRID_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+/**
+ * \brief Uniform grid over the (static) ECEF positions of the ground stations
+ *
+ * Answers "which ground stations are within distance r of this point" by only
+ * looking at the grid cells overlapping the query sphere, instead of computing
+ * the distance to every ground station. With the cell size set to the maximum
+ * GSL length, a query touches at most 27 cells.
+ */
+class GroundStationGrid
+{
+public:
+  /**
+   * \param cellSizeM Edge length of a grid cell in meters
+   */
+  explicit GroundStationGrid (double cellSizeM);
+
+  /**
+   * \brief Add a ground station
+   *
+   * \param index     Index returned by Query() for this ground station
+   * \param position  ECEF position (m)
+   */
+  void Add (uint32_t index, const Vector& position);
+
+  /**
+   * \brief Find all ground stations within radiusM of position (inclusive)
+   *
+   * \param result Cleared and filled with (index, distance) pairs; the distance is
+   *               computed exactly as MobilityModel::GetDistanceFrom does
+   */
+  void Query (const Vector& position, double radiusM,
+              std::vector<std::pair<uint32_t, double> >& result) const;
+
+  uint32_t GetN (void) const;
+
+private:
+  int64_t GetCell (double coordinate) const;
+  static uint64_t GetKey (int64_t x, int64_t y, int64_t z);
+
+  struct Entry
+  {
+    uint32_t index;
+    Vector position;
+  };
+
+  double m_cellSize;
+  uint32_t m_n;
+  std::unordered_map<uint64_t, std::vector<Entry> > m_cells;
+};
+
+} // namespace ns3
+
+#endif /* GROUND_STATION_GRID_H */
@@ -26,6 +26,9 @@
 #include "ns3/abort.h"
 #include "ns3/mpi-interface.h"
 #include "ns3/gsl-net-device.h"
+#include "ns3/gsl-sender-tag.h"
+
+#include <algorithm>
 
 namespace ns3 {
 
@@ -41,7 +44,8 @@ GSLChannel::GetTypeId (void)
     .SetGroupName ("GSL")
     .AddConstructor<GSLChannel> ()
     .AddAttribute ("Delay",
-                   "The lower-bound propagation delay through the channel (it is accessed by the distributed simulator to determine lookahead time)",
+                   "The lower-bound propagation delay through the channel between any two nodes on different systems "
+                   "(it is accessed by the distributed simulator to determine lookahead time, see GSLHelper::GetMinimumDelay)",
                    TimeValue (Seconds (0)),
                    MakeTimeAccessor (&GSLChannel::m_lowerBoundDelay),
                    MakeTimeChecker ())
@@ -50,131 +54,236 @@ GSLChannel::GetTypeId (void)
                    DoubleValue (299792458.0), // Default is speed of light
                    MakeDoubleAccessor (&GSLChannel::m_propagationSpeedMetersPerSecond),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("DelayTableResolution",
+                   "Sample the propagation delay of the link on this time grid and interpolate in between "
+                   "(see PropagationDelayTable). Zero computes the exact delay for every packet.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&GSLChannel::m_delayTableResolution),
+                   MakeTimeChecker (Seconds (0)))
+    .AddAttribute ("DelayTableErrorBound",
+                   "Largest deviation from the exact propagation delay allowed at the check points of a sampled "
+                   "interval (beyond it, the interval is computed exactly)",
+                   TimeValue (NanoSeconds (1)),
+                   MakeTimeAccessor (&GSLChannel::m_delayTableErrorBound),
+                   MakeTimeChecker (Seconds (0)))
+    .AddAttribute ("DelayTableValidation",
+                   "Also compute the exact propagation delay of every packet and record the largest deviation "
+                   "(see PropagationDelayTable::GetGlobalMaxError)",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&GSLChannel::m_delayTableValidation),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 GSLChannel::GSLChannel()
   :
-    Channel ()
+    Channel (),
+    m_delayTableValidation (false)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
 
+static uint64_t
+MacToKey (Mac48Address address)
+{
+  uint8_t bytes[6];
+  address.CopyTo (bytes);
+  uint64_t key = 0;
+  for (uint8_t byte : bytes)
+    {
+      key = (key << 8) | byte;
+    }
+  return key;
+}
+
 bool
 GSLChannel::TransmitStart (
   Ptr<const Packet> p,
-  Ptr<GSLNetDevice> src,
-  Address dst_address,
+  uint32_t srcIndex,
+  uint32_t dstIndex,
   Time txTime)
 {
-  NS_LOG_FUNCTION (this << p << src);
+  NS_LOG_FUNCTION (this << p << srcIndex << dstIndex);
   NS_LOG_LOGIC ("UID is " << p->GetUid () << ")");
 
-  Mac48Address address48 = Mac48Address::ConvertFrom (dst_address);
-  MacToNetDeviceI it = m_link.find (address48);
-  if (it != m_link.end ()) {
-    Ptr<GSLNetDevice> dst = it->second;
-    bool sameSystem = (src->GetNode()->GetSystemId() == dst->GetNode()->GetSystemId());
-    return TransmitTo(p, src, it->second, txTime, sameSystem);
+  NS_ASSERT_MSG (srcIndex < m_devices.size () && dstIndex < m_devices.size (), "Device index out of range");
+  return TransmitTo (p, m_devices[srcIndex], m_devices[dstIndex], srcIndex, txTime);
+}
+
+bool
+GSLChannel::TransmitTo(Ptr<const Packet> p, Device& src, Device& dst, uint32_t srcIndex, Time txTime) {
+
+  // Calculate delay
+  Time delay = this->GetDelay(GetMobility(src), GetMobility(dst));
+  NS_LOG_DEBUG(
+          "Sending packet " << p << " from node " << src.node->GetId()
+          << " to " << dst.node->GetId() << " with delay " << delay
+  );
+
+  if (src.systemId == dst.systemId) {
+
+    // Schedule arrival of packet at destination network device
+    Simulator::ScheduleWithContext(
+            dst.node->GetId(),
+            txTime + delay,
+            &GSLNetDevice::ReceiveFromChannel,
+            dst.device,
+            p->Copy (),
+            srcIndex
+    );
+
+  } else {
+    SendToRemote(p, src, dst, delay, Simulator::Now () + txTime + delay);
   }
 
-  NS_ABORT_MSG("MAC address could not be mapped to a network device.");
-  return false;
+  return true;
 }
 
 bool
-GSLChannel::TransmitTo(Ptr<const Packet> p, Ptr<GSLNetDevice> srcNetDevice, Ptr<GSLNetDevice> destNetDevice, Time txTime, bool isSameSystem) {
+GSLChannel::TransmitBatch (const std::vector<BatchedPacket>& batch, uint32_t srcIndex)
+{
+  NS_LOG_FUNCTION (this << srcIndex << batch.size ());
+  NS_ASSERT_MSG (srcIndex < m_devices.size (), "Device index out of range");
 
-  // Mobility models for source and destination
-  // std::cout << "GSL: " << srcNetDevice->GetNode()->GetId() << " -> " << destNetDevice->GetNode()->GetId() << std::endl;
+  // Receivers of the batch, in order of their first packet (mostly a single one)
+  struct Receiver
+  {
+    uint32_t index;
+    Time delay;
+    double rate;
+    Ptr<PacketBatch> received;  //!< Null for a device of another system
+  };
+  std::vector<Receiver> receivers;
 
-  Ptr<MobilityModel> senderMobility = srcNetDevice->GetNode()->GetObject<MobilityModel>();
-  Ptr<Node> receiverNode = destNetDevice->GetNode();
-  Ptr<MobilityModel> receiverMobility = receiverNode->GetObject<MobilityModel>();
+  Device& src = m_devices[srcIndex];
+  Time now = Simulator::Now ();
+  for (const BatchedPacket& b : batch) {
+    NS_ASSERT_MSG (b.peer < m_devices.size (), "Device index out of range");
+    Device& dst = m_devices[b.peer];
 
-  // Calculate delay
-  Time delay = this->GetDelay(senderMobility, receiverMobility);
-  NS_LOG_DEBUG(
-          "Sending packet " << p << " from node " << srcNetDevice->GetNode()->GetId()
-          << " to " << destNetDevice->GetNode()->GetId() << " with delay " << delay
-  );
+    auto it = std::find_if(receivers.begin(), receivers.end(),
+                           [&b](const Receiver& r) { return r.index == b.peer; });
+    if (it == receivers.end()) {
+      Receiver r;
+      r.index = b.peer;
+      r.delay = GetDelay(GetMobility(src), GetMobility(dst));
+      r.rate = batch.size() > 1 ? PropagationDelayTable::GetDelayRate(src.mobility, dst.mobility,
+                                                                      m_propagationSpeedMetersPerSecond)
+                                : 0;
+      if (src.systemId == dst.systemId) {
+        r.received = Create<PacketBatch> ();
+      }
+      it = receivers.insert(receivers.end(), r);
+    }
 
-  // Distributed mode is not enabled
-  NS_ABORT_MSG_UNLESS(isSameSystem, "MPI distributed mode is currently not supported by the GSL channel.");
-
-  // Schedule arrival of packet at destination network device
-  Simulator::ScheduleWithContext(
-          receiverNode->GetId(),
-          txTime + delay,
-          &GSLNetDevice::Receive,
-          destNetDevice,
-          p->Copy (),
-          srcNetDevice->GetAddress()
-  );
+    // The delay at the start of the transmission of this packet
+    Time arrival = now + b.txEnd + it->delay + Seconds(it->rate * b.txStart.GetSeconds());
+    if (it->received != 0) {
+      it->received->entries.push_back({arrival, b.packet->Copy (), srcIndex});
+    } else {
+      SendToRemote(b.packet, src, dst, it->delay, arrival);
+    }
+  }
 
-  // Re-enabled below code if distributed is again enabled:
-  //  if (isSameSystem) {
-  //
-  //  } else {
-  //#ifdef NS3_MPI
-  //    Time rxTime = Simulator::Now () + txTime + delay;
-  //    MpiInterface::SendPacket (p->Copy (), rxTime, destNetDevice->GetNode()->GetId (), destNetDevice->GetIfIndex());
-  //#else
-  //    NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
-  //#endif
-  //  }
+  for (const Receiver& r : receivers) {
+    if (r.received != 0) {
+      Device& dst = m_devices[r.index];
+      Simulator::ScheduleWithContext(
+              dst.node->GetId(),
+              r.received->entries[0].arrival - now,
+              &GSLNetDevice::ReceiveBatch,
+              dst.device,
+              r.received
+      );
+    }
+  }
 
   return true;
 }
 
 void
+GSLChannel::SendToRemote(Ptr<const Packet> p, Device& src, Device& dst, Time delay, Time rxTime) {
+#ifdef NS3_MPI
+    // The lookahead of the distributed simulator relies on the lower bound
+    NS_ABORT_MSG_IF(delay < m_lowerBoundDelay,
+                    "GSL delay " << delay << " is below the channel lower bound " << m_lowerBoundDelay);
+
+    // The receiving device gets the sender address from the tag
+    Ptr<Packet> copy = p->Copy ();
+    copy->AddPacketTag (GSLSenderTag (Mac48Address::ConvertFrom (src.device->GetAddress ())));
+    MpiInterface::SendPacket (copy, rxTime, dst.node->GetId (), dst.device->GetIfIndex ());
+#else
+    NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
+
+Ptr<MobilityModel>
+GSLChannel::GetMobility (Device& device) const
+{
+  if (device.mobility == 0)
+    {
+      device.mobility = device.node->GetObject<MobilityModel>();
+    }
+  return device.mobility;
+}
+
+uint32_t
 GSLChannel::Attach (Ptr<GSLNetDevice> device)
 {
     NS_LOG_FUNCTION (this << device);
     NS_ABORT_MSG_IF (device == 0, "Cannot add zero pointer network device.");
 
-    Mac48Address address48 = Mac48Address::ConvertFrom (device->GetAddress());
-    m_link[address48] = device;
-    m_net_devices.push_back(device);
+    uint32_t index = m_devices.size();
+    m_indexes[MacToKey(Mac48Address::ConvertFrom (device->GetAddress()))] = index;
+    m_devices.push_back({device, device->GetNode(), 0, device->GetNode()->GetSystemId()});
+    return index;
 }
 
-Time
-GSLChannel::GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+uint32_t
+GSLChannel::GetDeviceIndex (Mac48Address address) const
 {
-  double distance_m = a->GetDistanceFrom (b);
-  double seconds = distance_m / m_propagationSpeedMetersPerSecond;
-  return Seconds (seconds);
+    auto it = m_indexes.find (MacToKey (address));
+    NS_ABORT_MSG_IF (it == m_indexes.end (), "MAC address could not be mapped to a network device.");
+    return it->second;
 }
 
-size_t Mac48AddressHash::operator() (Mac48Address const &x) const
+Ptr<GSLNetDevice>
+GSLChannel::GetGslDevice (uint32_t index) const
 {
-    uint8_t address[6]; //!< address value
-    x.CopyTo(address);
-
-    uint32_t host = 0;
-    uint8_t byte = 0;
-    for (size_t i = 0; i < 6; i++) {
-        byte = address[i];
-        host <<= 8;
-        host |= byte;
+    return m_devices.at(index).device;
+}
+
+Time
+GSLChannel::GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  if (m_delayTableResolution.IsStrictlyPositive ())
+    {
+      if (!m_delayTable)
+        {
+          m_delayTable.reset (new PropagationDelayTable (m_delayTableResolution, m_delayTableErrorBound,
+                                                         m_delayTableValidation, m_propagationSpeedMetersPerSecond));
+        }
+      return m_delayTable->GetDelay (a, b);
     }
 
-    return host;
+  double distance_m = a->GetDistanceFrom (b);
+  double seconds = distance_m / m_propagationSpeedMetersPerSecond;
+  return Seconds (seconds);
 }
 
 std::size_t
 GSLChannel::GetNDevices (void) const
 {
     NS_LOG_FUNCTION_NOARGS ();
-    return m_net_devices.size();
+    return m_devices.size();
 }
 
 Ptr<NetDevice>
 GSLChannel::GetDevice (std::size_t i) const
 {
     NS_LOG_FUNCTION (this << i);
-    return m_net_devices.at(i);
+    return m_devices.at(i).device;
 }
 
 } // namespace ns3
@@ -27,19 +27,27 @@
 #include "ns3/channel.h"
 #include "ns3/data-rate.h"
 #include "ns3/mobility-model.h"
-#include "ns3/sgi-hashmap.h"
+#include "ns3/node.h"
 #include "ns3/mac48-address.h"
+#include "ns3/packet-batch.h"
+#include "ns3/propagation-delay-table.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3 {
 
 class GSLNetDevice;
 class Packet;
 
-class Mac48AddressHash : public std::unary_function<Mac48Address, size_t> {
-    public:
-        size_t operator() (Mac48Address const &x) const;
-};
-
+/**
+ * \brief Channel shared by all GSL devices
+ *
+ * Devices are identified by a dense index, assigned in the order they are attached.
+ * MAC addresses are only resolved at the NetDevice API boundary (GSLNetDevice::Send),
+ * the channel itself addresses devices by index in a direct-indexed table.
+ */
 class GSLChannel : public Channel 
 {
 public:
@@ -49,39 +57,71 @@ public:
   // Transmission
   virtual bool TransmitStart (
           Ptr<const Packet> p,
-          Ptr<GSLNetDevice> src,
-          Address dst_address,
+          uint32_t srcIndex,
+          uint32_t dstIndex,
           Time txTime
   );
-  bool TransmitTo(
-          Ptr<const Packet> p,
-          Ptr<GSLNetDevice> srcNetDevice,
-          Ptr<GSLNetDevice> dstNetDevice,
-          Time txTime,
-          bool isSameSystem
-  );
+
+  /**
+   * \brief Transmit packets sent back to back by one device, starting now
+   *
+   * Every receiving device on this system gets a single event for its packets
+   * (see PacketBatch), packets to other systems are sent one by one.
+   */
+  virtual bool TransmitBatch (const std::vector<BatchedPacket>& batch, uint32_t srcIndex);
 
   // Device management
-  void Attach (Ptr<GSLNetDevice> device);
+
+  /**
+   * \return Index of the device on this channel
+   */
+  uint32_t Attach (Ptr<GSLNetDevice> device);
+
+  /**
+   * \return Index of the device with this MAC address (aborts if there is none)
+   */
+  uint32_t GetDeviceIndex (Mac48Address address) const;
+
+  Ptr<GSLNetDevice> GetGslDevice (uint32_t index) const;
+
   virtual std::size_t GetNDevices (void) const;
   virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
 
 protected:
+  /// Attached device, with what every packet needs
+  struct Device
+  {
+    Ptr<GSLNetDevice> device;
+    Ptr<Node> node;
+    Ptr<MobilityModel> mobility;      //!< Resolved on first use
+    uint32_t systemId;
+  };
+
+  bool TransmitTo (Ptr<const Packet> p, Device& src, Device& dst, uint32_t srcIndex, Time txTime);
+
+  /// Send a copy of the packet to a device of another system, arriving at rxTime
+  void SendToRemote (Ptr<const Packet> p, Device& src, Device& dst, Time delay, Time rxTime);
+
+  /// Mobility model of the device, resolved on first use
+  Ptr<MobilityModel> GetMobility (Device& device) const;
+
   Time GetDelay (Ptr<MobilityModel> senderMobility, Ptr<MobilityModel> receiverMobility) const;
 
   Time   m_lowerBoundDelay;                   //!< Propagation delay which is
                                               //   used to give a minimum lookahead time to the
-                                              //   distributed simulator (if it were enabled).
-                                              //   See also: distributed-simulator-impl.cc (line 173 onwards)
+                                              //   distributed simulator.
+                                              //   See also: DistributedSimulatorImpl::CalculateLookAhead
 
   double m_propagationSpeedMetersPerSecond;   //!< Propagation speed on the channel (used to live calculate the delay
                                               //   for each packet which is sent over this channel.
 
-  // Mac address to net device
-  typedef sgi::hash_map<Mac48Address, Ptr<GSLNetDevice>, Mac48AddressHash> MacToNetDevice;
-  typedef sgi::hash_map<Mac48Address, Ptr<GSLNetDevice>, Mac48AddressHash>::iterator MacToNetDeviceI;
-  MacToNetDevice m_link;
-  std::vector<Ptr<GSLNetDevice>> m_net_devices;
+  Time m_delayTableResolution;                //!< Delay sampling step (0: exact delay per packet)
+  Time m_delayTableErrorBound;                //!< Largest deviation allowed by the delay table
+  bool m_delayTableValidation;                //!< Compare the table with the exact delay
+  mutable std::unique_ptr<PropagationDelayTable> m_delayTable; //!< Per ground station-satellite pair, created on first use
+
+  std::vector<Device> m_devices;                      //!< Per index
+  std::unordered_map<uint64_t, uint32_t> m_indexes;   //!< MAC address (48 bits) to index
 
 };
 
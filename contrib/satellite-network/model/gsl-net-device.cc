@@ -29,11 +29,13 @@
 #include "ns3/error-model.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/pointer.h"
 #include "ns3/ppp-header.h"
 #include "ns3/node-container.h"
 #include "gsl-net-device.h"
 #include "gsl-channel.h"
+#include "gsl-sender-tag.h"
 
 namespace ns3 {
 
@@ -41,6 +43,8 @@ NS_LOG_COMPONENT_DEFINE ("GSLNetDevice");
 
 NS_OBJECT_ENSURE_REGISTERED (GSLNetDevice);
 
+const uint32_t GSLNetDevice::NO_DEVICE;
+
 TypeId 
 GSLNetDevice::GetTypeId (void)
 {
@@ -73,6 +77,12 @@ GSLNetDevice::GetTypeId (void)
                    TimeValue (Seconds (0.0)),
                    MakeTimeAccessor (&GSLNetDevice::m_tInterframeGap),
                    MakeTimeChecker ())
+    .AddAttribute ("TransmitBatching",
+                   "Send the packets queued in one simulation instant back to back in one pass, "
+                   "with one event per batch at the sender and at each receiver",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&GSLNetDevice::m_transmitBatching),
+                   MakeBooleanChecker ())
 
     //
     // Transmit queueing discipline for the device which includes its own set
@@ -183,7 +193,13 @@ GSLNetDevice::GSLNetDevice ()
     m_txMachineState (READY),
     m_channel (0),
     m_linkUp (false),
-    m_currentPkt (0)
+    m_currentPkt (0),
+    m_utilizationLink (0),
+    m_channelIndex (0),
+    m_lastDestinationIndex (NO_DEVICE),
+    m_transmitBatching (false),
+    m_batchStarted (0),
+    m_batchBacklogBytes (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -220,7 +236,10 @@ GSLNetDevice::DoDispose ()
   m_channel = 0;
   m_receiveErrorModel = 0;
   m_currentPkt = 0;
+  m_batch.clear ();
+  m_batchStarts.clear ();
   m_queue = 0;
+  m_utilizationTracker = 0;
   while (!m_queueDests.empty()) {
       m_queueDests.pop();
   }
@@ -242,7 +261,7 @@ GSLNetDevice::SetInterframeGap (Time t)
 }
 
 bool
-GSLNetDevice::TransmitStart (Ptr<Packet> p, const Address dest)
+GSLNetDevice::TransmitStart (Ptr<Packet> p, uint32_t dest)
 {
   NS_LOG_FUNCTION (this << p);
   NS_LOG_LOGIC ("UID is " << p->GetUid () << ")");
@@ -256,14 +275,18 @@ GSLNetDevice::TransmitStart (Ptr<Packet> p, const Address dest)
   m_txMachineState = BUSY;
   m_currentPkt = p;
   m_phyTxBeginTrace (m_currentPkt);
+  if (m_utilizationTracker != 0)
+    {
+      m_utilizationTracker->SetBusy (m_utilizationLink, true);
+    }
 
   Time txTime = m_bps.CalculateBytesTxTime (p->GetSize ());
   Time txCompleteTime = txTime + m_tInterframeGap;
 
   NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << txCompleteTime.GetSeconds () << "sec");
-  Simulator::Schedule (txCompleteTime, &GSLNetDevice::TransmitComplete, this, dest);
+  Simulator::Schedule (txCompleteTime, &GSLNetDevice::TransmitComplete, this);
 
-  bool result = m_channel->TransmitStart (p, this, dest, txTime);
+  bool result = m_channel->TransmitStart (p, m_channelIndex, dest, txTime);
   if (result == false)
     {
       m_phyTxDropTrace (p);
@@ -274,7 +297,7 @@ GSLNetDevice::TransmitStart (Ptr<Packet> p, const Address dest)
 }
 
 void
-GSLNetDevice::TransmitComplete (const Address dest)
+GSLNetDevice::TransmitComplete (void)
 {
   NS_LOG_FUNCTION (this);
 
@@ -287,9 +310,35 @@ GSLNetDevice::TransmitComplete (const Address dest)
   NS_ASSERT_MSG (m_txMachineState == BUSY, "Must be BUSY if transmitting");
   m_txMachineState = READY;
 
+  if (!m_batch.empty ())
+    {
+      for (Ptr<Packet> p : m_batch)
+        {
+          m_phyTxEndTrace (p);
+        }
+      m_batch.clear ();
+      m_batchStarts.clear ();
+      if (m_utilizationTracker != 0)
+        {
+          m_utilizationTracker->SetBusy (m_utilizationLink, false);
+        }
+
+      // Everything queued during the batch goes out as the next one
+      if (!m_queue->IsEmpty ())
+        {
+          m_txMachineState = BUSY;
+          TransmitBatch ();
+        }
+      return;
+    }
+
   NS_ASSERT_MSG (m_currentPkt != 0, "GSLNetDevice::TransmitComplete(): m_currentPkt zero");
 
   m_phyTxEndTrace (m_currentPkt);
+  if (m_utilizationTracker != 0)
+    {
+      m_utilizationTracker->SetBusy (m_utilizationLink, false);
+    }
   m_currentPkt = 0;
 
   Ptr<Packet> p = m_queue->Dequeue ();
@@ -298,8 +347,8 @@ GSLNetDevice::TransmitComplete (const Address dest)
       NS_LOG_LOGIC ("No pending packets in device queue after tx complete");
       return;
     }
-    Address next_dest = m_queueDests.front ();
-    m_queueDests.pop ();
+  uint32_t next_dest = m_queueDests.front ();
+  m_queueDests.pop ();
 
   //
   // Got another packet off of the queue, so start the transmit process again.
@@ -309,6 +358,83 @@ GSLNetDevice::TransmitComplete (const Address dest)
   TransmitStart (p, next_dest);
 }
 
+void
+GSLNetDevice::TransmitBatch (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  NS_ASSERT_MSG (m_txMachineState == BUSY, "Must be reserved (BUSY) for the batch");
+  NS_ASSERT_MSG (m_batch.empty (), "GSLNetDevice::TransmitBatch(): batch in progress");
+
+  //
+  // Every packet starts when the previous one and its interframe gap are done,
+  // as if they were sent one by one from TransmitComplete.
+  //
+  std::vector<BatchedPacket> batch;
+  batch.reserve (m_queueDests.size ());
+  Time now = Simulator::Now ();
+  Time start = Seconds (0);
+  m_batchStarted = 0;
+  m_batchBacklogBytes = 0;
+  Ptr<Packet> p = m_currentPkt != 0 ? m_currentPkt : m_queue->Dequeue ();
+  m_currentPkt = 0;
+  for (; p != 0; p = m_queue->Dequeue ())
+    {
+      uint32_t dest = m_queueDests.front ();
+      m_queueDests.pop ();
+      m_snifferTrace (p);
+      m_promiscSnifferTrace (p);
+      m_phyTxBeginTrace (p);
+      Time txTime = m_bps.CalculateBytesTxTime (p->GetSize ());
+      batch.push_back ({p, start, start + txTime, dest});
+      m_batch.push_back (p);
+      m_batchStarts.push_back (now + start);
+      m_batchBacklogBytes += p->GetSize ();
+      start += txTime + m_tInterframeGap;
+    }
+  NS_ASSERT_MSG (!batch.empty (), "GSLNetDevice::TransmitBatch(): nothing queued");
+  if (m_utilizationTracker != 0)
+    {
+      m_utilizationTracker->SetBusy (m_utilizationLink, true);
+    }
+
+  NS_LOG_LOGIC ("Schedule TransmitCompleteEvent of " << batch.size () << " packets in " << start.GetSeconds () << "sec");
+  Simulator::Schedule (start, &GSLNetDevice::TransmitComplete, this);
+
+  if (!m_channel->TransmitBatch (batch, m_channelIndex))
+    {
+      for (const BatchedPacket& b : batch)
+        {
+          m_phyTxDropTrace (b.packet);
+        }
+    }
+}
+
+bool
+GSLNetDevice::BatchBacklogFits (Ptr<const Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
+
+  // The batch packets that have started since the last call are no longer queued
+  Time now = Simulator::Now ();
+  while (m_batchStarted < m_batch.size () && m_batchStarts[m_batchStarted] <= now)
+    {
+      m_batchBacklogBytes -= m_batch[m_batchStarted]->GetSize ();
+      m_batchStarted++;
+    }
+  if (m_batchStarted == m_batch.size ())
+    {
+      return true;
+    }
+
+  QueueSize maxSize = m_queue->GetMaxSize ();
+  if (maxSize.GetUnit () == QueueSizeUnit::PACKETS)
+    {
+      return m_queue->GetNPackets () + (m_batch.size () - m_batchStarted) + 1 <= maxSize.GetValue ();
+    }
+  return m_queue->GetNBytes () + m_batchBacklogBytes + packet->GetSize () <= maxSize.GetValue ();
+}
+
 bool
 GSLNetDevice::Attach (Ptr<GSLChannel> ch)
 {
@@ -316,7 +442,7 @@ GSLNetDevice::Attach (Ptr<GSLChannel> ch)
 
   m_channel = ch;
 
-  m_channel->Attach (this);
+  m_channelIndex = m_channel->Attach (this);
 
   //
   // This device is up whenever it is attached to a channel.  A better plan
@@ -395,6 +521,29 @@ GSLNetDevice::Receive (Ptr<Packet> packet, Address from)
     }
 }
 
+void
+GSLNetDevice::ReceiveFromChannel (Ptr<Packet> packet, uint32_t from)
+{
+  Receive (packet, m_promiscCallback.IsNull () ? Address () : m_channel->GetGslDevice (from)->GetAddress ());
+}
+
+void
+GSLNetDevice::ReceiveBatch (Ptr<PacketBatch> batch)
+{
+  NS_LOG_FUNCTION (this << batch->entries.size () - batch->next);
+
+  Time now = Simulator::Now ();
+  while (batch->next < batch->entries.size () && batch->entries[batch->next].arrival <= now)
+    {
+      const PacketBatch::Entry& entry = batch->entries[batch->next++];
+      ReceiveFromChannel (entry.packet, entry.peer);
+    }
+  if (batch->next < batch->entries.size ())
+    {
+      Simulator::Schedule (batch->entries[batch->next].arrival - now, &GSLNetDevice::ReceiveBatch, this, batch);
+    }
+}
+
 Ptr<Queue<Packet> >
 GSLNetDevice::GetQueue (void) const
 { 
@@ -402,6 +551,14 @@ GSLNetDevice::GetQueue (void) const
   return m_queue;
 }
 
+void
+GSLNetDevice::SetUtilizationTracker (Ptr<UtilizationTracker> tracker, uint32_t link)
+{
+  NS_LOG_FUNCTION (this << tracker << link);
+  m_utilizationTracker = tracker;
+  m_utilizationLink = link;
+}
+
 void
 GSLNetDevice::NotifyLinkUp (void)
 {
@@ -526,6 +683,16 @@ GSLNetDevice::Send (
       return false;
     }
 
+  //
+  // Resolve the destination on the channel (the same as for the previous packet, most often)
+  //
+  Mac48Address destination = Mac48Address::ConvertFrom (dest);
+  if (m_lastDestinationIndex == NO_DEVICE || destination != m_lastDestination)
+    {
+      m_lastDestinationIndex = m_channel->GetDeviceIndex (destination);
+      m_lastDestination = destination;
+    }
+
   //
   // Stick a point to point protocol header on the packet in preparation for
   // shoving it out the door.
@@ -536,17 +703,30 @@ GSLNetDevice::Send (
 
   //
   // We should enqueue and dequeue the packet to hit the tracing hooks.
+  // The packets of a batch in progress that have not started yet still count
+  // as queued.
   //
-  if (m_queue->Enqueue (packet))
+  if (BatchBacklogFits (packet) && m_queue->Enqueue (packet))
     {
-        m_queueDests.push (dest);
+      m_queueDests.push (m_lastDestinationIndex);
       //
       // If the channel is ready for transition we send the packet right now
       // 
+      if (m_txMachineState == READY && m_transmitBatching)
+        {
+          //
+          // Everything else sent in this instant joins the batch. The first
+          // packet leaves the queue right away, as it would without batching.
+          //
+          m_txMachineState = BUSY;
+          m_currentPkt = m_queue->Dequeue ();
+          Simulator::ScheduleNow (&GSLNetDevice::TransmitBatch, this);
+          return true;
+        }
       if (m_txMachineState == READY)
         {
           packet = m_queue->Dequeue ();
-          Address next_dest = m_queueDests.front ();
+          uint32_t next_dest = m_queueDests.front ();
           m_queueDests.pop ();
           m_snifferTrace (packet);
           m_promiscSnifferTrace (packet);
@@ -615,7 +795,15 @@ void
 GSLNetDevice::DoMpiReceive (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << p);
-  Receive (p, this->m_address);
+  GSLSenderTag tag;
+  if (p->RemovePacketTag (tag))
+    {
+      Receive (p, tag.GetSender ());
+    }
+  else
+    {
+      Receive (p, this->m_address);
+    }
 }
 
 bool
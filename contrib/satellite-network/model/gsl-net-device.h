@@ -25,6 +25,7 @@
 
 #include <cstring>
 #include <queue>
+#include <vector>
 #include "ns3/address.h"
 #include "ns3/node.h"
 #include "ns3/net-device.h"
@@ -35,6 +36,8 @@
 #include "ns3/data-rate.h"
 #include "ns3/ptr.h"
 #include "ns3/mac48-address.h"
+#include "ns3/packet-batch.h"
+#include "ns3/utilization-tracker.h"
 #include "ns3/node-container.h"
 
 namespace ns3 {
@@ -121,6 +124,14 @@ public:
    */
   Ptr<Queue<Packet> > GetQueue (void) const;
 
+  /**
+   * \brief Report the busy periods of the transmitter to a utilization tracker
+   *
+   * \param tracker Tracker (0 to stop reporting)
+   * \param link Index of the link of this device in the tracker
+   */
+  void SetUtilizationTracker (Ptr<UtilizationTracker> tracker, uint32_t link);
+
   /**
    * Attach a receive ErrorModel to the GSLNetDevice.
    *
@@ -143,6 +154,33 @@ public:
    */
   void Receive (Ptr<Packet> p, Address from);
 
+  /**
+   * Receive a packet sent by the device with the given index on the channel
+   *
+   * The address of the sender is only looked up for the promiscuous callback.
+   *
+   * \param p Ptr to the received packet.
+   * \param from Index of the sending device on the channel
+   */
+  void ReceiveFromChannel (Ptr<Packet> p, uint32_t from);
+
+  /**
+   * Receive the packets of a batch which are due, and wait for the next one.
+   *
+   * \param batch Packets sent back to back by one device on the channel
+   */
+  void ReceiveBatch (Ptr<PacketBatch> batch);
+
+  /**
+   * \brief Handler for MPI receive event
+   *
+   * Receives a packet sent by a GSLChannel on another MPI rank (see
+   * MpiReceiver). The sender address is taken from its GSLSenderTag.
+   *
+   * \param p Packet received
+   */
+  void DoMpiReceive (Ptr<Packet> p);
+
   // The remaining methods are documented in ns3::NetDevice*
 
   virtual void SetIfIndex (const uint32_t index);
@@ -184,14 +222,6 @@ public:
   virtual void SetPromiscReceiveCallback (PromiscReceiveCallback cb);
   virtual bool SupportsSendFrom (void) const;
 
-protected:
-  /**
-   * \brief Handler for MPI receive event
-   *
-   * \param p Packet received
-   */
-  void DoMpiReceive (Ptr<Packet> p);
-
 private:
 
   /**
@@ -251,10 +281,10 @@ private:
    * \see GSLChannel::TransmitStart ()
    * \see TransmitComplete()
    * \param p a reference to the packet to send
-   * \param address where the packet is to be sent
+   * \param destination index of the device on the channel where the packet is to be sent
    * \returns true if success, false on failure
    */
-  bool TransmitStart (Ptr<Packet> p, const Address address);
+  bool TransmitStart (Ptr<Packet> p, uint32_t destination);
 
   /**
    * Stop Sending a Packet Down the Wire and Begin the Interframe Gap.
@@ -262,7 +292,32 @@ private:
    * The TransmitComplete method is used internally to finish the process
    * of sending a packet out on the channel.
    */
-  void TransmitComplete (const Address destination);
+  void TransmitComplete (void);
+
+  /**
+   * Send all queued packets down the wire in one pass (batched transmission).
+   *
+   * The first one is m_currentPkt if Send already took it off the queue.
+   *
+   * The transmissions follow each other exactly as with TransmitStart, but a single
+   * TransmitComplete event is scheduled, at the end of the last one, and the channel
+   * is called once for the whole batch.
+   *
+   * \see GSLChannel::TransmitBatch ()
+   */
+  void TransmitBatch (void);
+
+  /**
+   * Check whether a packet fits in the queue together with the packets of the
+   * batch in progress that have not started their transmission yet.
+   *
+   * Without batching, those packets would still be waiting in the queue, so
+   * they count against its maximum size the same way.
+   *
+   * \param packet the packet about to be enqueued
+   * \returns false if it would overflow the queue
+   */
+  bool BatchBacklogFits (Ptr<const Packet> packet);
 
   /**
    * \brief Make the link up and running
@@ -310,10 +365,11 @@ private:
    */
   Ptr<Queue<Packet> > m_queue;
 
-    /**
-     * The FIFO queue for the destination MAC addresses
-     */
-  std::queue<Address> m_queueDests;
+  /**
+   * The FIFO queue for the destinations of the queued packets (indexes on the channel)
+   */
+  std::queue<uint32_t> m_queueDests;
+
 
   /**
    * Error model for receive packet events
@@ -451,6 +507,21 @@ private:
 
   Ptr<Packet> m_currentPkt; //!< Current packet processed
 
+  Ptr<UtilizationTracker> m_utilizationTracker; //!< Tracker of the busy periods, if any
+  uint32_t m_utilizationLink;                   //!< Index of the link in the tracker
+
+  uint32_t m_channelIndex;         //!< Index of this device on the channel
+  Mac48Address m_lastDestination;  //!< Destination of the last packet sent
+  uint32_t m_lastDestinationIndex; //!< Index of m_lastDestination on the channel (NO_DEVICE if none)
+
+  bool m_transmitBatching;               //!< Send the packets queued in one instant as a batch
+  std::vector<Ptr<Packet> > m_batch;     //!< Packets of the batch being transmitted
+  std::vector<Time> m_batchStarts;       //!< Transmission start time of each packet of the batch
+  size_t m_batchStarted;                 //!< Number of packets of the batch known to have started
+  uint64_t m_batchBacklogBytes;          //!< Bytes of the packets of the batch not known to have started
+
+  static const uint32_t NO_DEVICE = 0xffffffff;
+
   /**
    * \brief PPP to Ethernet protocol number mapping
    * \param protocol A PPP protocol number
@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "gsl-sender-tag.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (GSLSenderTag);
+
+TypeId
+GSLSenderTag::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::GSLSenderTag")
+    .SetParent<Tag> ()
+    .SetGroupName ("GSL")
+    .AddConstructor<GSLSenderTag> ()
+  ;
+  return tid;
+}
+
+TypeId
+GSLSenderTag::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+uint32_t
+GSLSenderTag::GetSerializedSize (void) const
+{
+  return 6;
+}
+
+void
+GSLSenderTag::Serialize (TagBuffer buf) const
+{
+  uint8_t address[6];
+  m_sender.CopyTo (address);
+  buf.Write (address, 6);
+}
+
+void
+GSLSenderTag::Deserialize (TagBuffer buf)
+{
+  uint8_t address[6];
+  buf.Read (address, 6);
+  m_sender.CopyFrom (address);
+}
+
+void
+GSLSenderTag::Print (std::ostream &os) const
+{
+  os << "Sender=" << m_sender;
+}
+
+GSLSenderTag::GSLSenderTag ()
+  : Tag ()
+{
+}
+
+GSLSenderTag::GSLSenderTag (Mac48Address sender)
+  : Tag (),
+    m_sender (sender)
+{
+}
+
+Mac48Address
+GSLSenderTag::GetSender (void) const
+{
+  return m_sender;
+}
+
+} // namespace ns3
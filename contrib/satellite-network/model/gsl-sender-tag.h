@@ -0,0 +1,54 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef GSL_SENDER_TAG_H
+#define GSL_SENDER_TAG_H
+
+#include "ns3/tag.h"
+#include "ns3/mac48-address.h"
+
+namespace ns3 {
+
+/**
+ * \brief MAC address of the GSL device which sent a packet to another MPI rank
+ *
+ * MpiInterface::SendPacket only carries the packet itself, while the receiving
+ * GSLNetDevice reports the sender address to its upper layers (the NDN
+ * transport only accepts packets from its next hops). The GSL channel attaches
+ * this tag to packets crossing ranks, and the receiving device removes it.
+ */
+class GSLSenderTag : public Tag
+{
+public:
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer buf) const;
+  virtual void Deserialize (TagBuffer buf);
+  virtual void Print (std::ostream &os) const;
+
+  GSLSenderTag ();
+  GSLSenderTag (Mac48Address sender);
+
+  Mac48Address GetSender (void) const;
+
+private:
+  Mac48Address m_sender;  //!< Address of the sending GSL net device
+};
+
+} // namespace ns3
+
+#endif /* GSL_SENDER_TAG_H */
@@ -0,0 +1,71 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PACKET_BATCH_H
+#define PACKET_BATCH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * \brief A packet of a batch, as handed by a device to its channel
+ *
+ * With batched transmission (attribute TransmitBatching of the ISL and GSL devices),
+ * the packets queued at a device in one simulation instant are serialized in one pass:
+ * the transmission of each packet starts when the previous one (and its interframe gap)
+ * is done, exactly as when they are sent one by one.
+ */
+struct BatchedPacket
+{
+  Ptr<Packet> packet;
+  Time txStart;   //!< Start of the transmission, relative to the start of the batch
+  Time txEnd;     //!< End of the transmission (without interframe gap), relative to the start of the batch
+  uint32_t peer;  //!< Channel index of the receiving device (GSL only)
+};
+
+/**
+ * \brief Packets of a batch arriving at one receiving device, in order of arrival
+ *
+ * The channel computes the arrival time of every packet when the batch starts, with
+ * the propagation delay at the start of its transmission (see
+ * PropagationDelayTable::GetDelayRate), and schedules a single event at the receiver.
+ * That event delivers the packets which are due and is rescheduled to the arrival of
+ * the next one, so at most one event per batch and receiver is pending.
+ */
+struct PacketBatch : public SimpleRefCount<PacketBatch>
+{
+  struct Entry
+  {
+    Time arrival;   //!< Absolute arrival time of the last bit
+    Ptr<Packet> packet;
+    uint32_t peer;  //!< Channel index of the sending device (GSL only)
+  };
+
+  PacketBatch () : next (0) {}
+
+  std::vector<Entry> entries;
+  size_t next;      //!< First entry not delivered yet
+};
+
+} // namespace ns3
+
+#endif /* PACKET_BATCH_H */
@@ -0,0 +1,201 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "phase-profiler.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PhaseProfiler");
+
+namespace {
+
+const char* HEADER = "kind,name,sim_time_s,wall_s,wall_total_s,rss_mb,rss_delta_mb,pending_events,"
+                     "executed_events,nodes,devices,faces,fib_entries,pit_entries,cs_entries";
+
+} // namespace
+
+PhaseProfiler::PhaseProfiler (const std::string& file)
+  : m_file (file),
+    m_start (std::chrono::steady_clock::now ()),
+    m_last (m_start),
+    m_lastRss (MemUsage::Get ())
+{
+  NS_LOG_FUNCTION (this << file);
+}
+
+PhaseProfiler::~PhaseProfiler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+const PhaseProfiler::Record&
+PhaseProfiler::EndPhase (const std::string& name)
+{
+  NS_LOG_FUNCTION (this << name);
+  NS_ABORT_MSG_IF (name.find (',') != std::string::npos, "Phase name " << name << " contains a comma");
+  Take ("phase", name);
+  return m_records.back ();
+}
+
+void
+PhaseProfiler::StartSampling (Time interval)
+{
+  NS_LOG_FUNCTION (this << interval);
+  NS_ABORT_MSG_UNLESS (interval.IsStrictlyPositive (), "Sampling interval must be positive");
+  m_interval = interval;
+  m_event = Simulator::Schedule (m_interval, &PhaseProfiler::Sample, this);
+  Simulator::ScheduleDestroy (&PhaseProfiler::Finish, this);
+}
+
+void
+PhaseProfiler::Sample (void)
+{
+  Take ("run", "interval");
+  // Sampling alone would keep a simulation without a stop time running
+  if (Simulator::GetPendingEventCount () > 0)
+    {
+      m_event = Simulator::Schedule (m_interval, &PhaseProfiler::Sample, this);
+    }
+}
+
+void
+PhaseProfiler::Finish (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_event.Cancel ();
+  Take ("run", "end");
+  if (!m_file.empty ())
+    {
+      Write (m_file);
+    }
+}
+
+void
+PhaseProfiler::Take (const std::string& kind, const std::string& name)
+{
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now ();
+  int64_t rss = MemUsage::Get ();
+
+  Record r;
+  r.kind = kind;
+  r.name = name;
+  r.simTimeS = Simulator::Now ().GetSeconds ();
+  r.wallS = std::chrono::duration<double> (now - m_last).count ();
+  r.wallTotalS = std::chrono::duration<double> (now - m_start).count ();
+  r.rssMb = rss / 1e6;
+  r.rssDeltaMb = (rss - m_lastRss) / 1e6;
+  r.pendingEvents = Simulator::GetPendingEventCount ();
+  r.executedEvents = Simulator::GetEventCount ();
+  r.nodes = NodeList::GetNNodes ();
+  r.devices = 0;
+  r.faces = 0;
+  r.fibEntries = 0;
+  r.pitEntries = 0;
+  r.csEntries = 0;
+  for (NodeList::Iterator it = NodeList::Begin (); it != NodeList::End (); it++)
+    {
+      r.devices += (*it)->GetNDevices ();
+      Ptr<ndn::L3Protocol> ndn = (*it)->GetObject<ndn::L3Protocol> ();
+      if (ndn != nullptr)
+        {
+          std::shared_ptr<nfd::Forwarder> forwarder = ndn->getForwarder ();
+          r.faces += forwarder->getFaceTable ().size ();
+          r.fibEntries += forwarder->getFib ().size ();
+          r.pitEntries += forwarder->getPit ().size ();
+          r.csEntries += forwarder->getCs ().size ();
+        }
+    }
+  m_records.push_back (r);
+
+  // The counting above is left out of the next record
+  m_last = std::chrono::steady_clock::now ();
+  m_lastRss = rss;
+}
+
+const std::vector<PhaseProfiler::Record>&
+PhaseProfiler::GetRecords (void) const
+{
+  return m_records;
+}
+
+const std::string&
+PhaseProfiler::GetFile (void) const
+{
+  return m_file;
+}
+
+void
+PhaseProfiler::SetFile (const std::string& file)
+{
+  m_file = file;
+}
+
+void
+PhaseProfiler::Write (const std::string& file) const
+{
+  NS_LOG_FUNCTION (this << file);
+  std::ofstream out (file, std::ios::trunc);
+  NS_ABORT_MSG_UNLESS (out.is_open (), "File " << file << " could not be created");
+  out << HEADER << std::endl;
+  for (const Record& r : m_records)
+    {
+      out << r.kind << "," << r.name << "," << r.simTimeS << "," << r.wallS << "," << r.wallTotalS << ","
+          << r.rssMb << "," << r.rssDeltaMb << "," << r.pendingEvents << "," << r.executedEvents << ","
+          << r.nodes << "," << r.devices << "," << r.faces << "," << r.fibEntries << ","
+          << r.pitEntries << "," << r.csEntries << std::endl;
+    }
+  out.close ();
+  NS_ABORT_MSG_IF (out.fail (), "Writing " << file << " failed");
+}
+
+std::vector<PhaseProfiler::Record>
+PhaseProfiler::ReadReport (const std::string& file)
+{
+  std::ifstream in (file);
+  NS_ABORT_MSG_UNLESS (in.is_open (), "File " << file << " could not be opened");
+  std::string line;
+  NS_ABORT_MSG_UNLESS (std::getline (in, line) && line == HEADER, "File " << file << " is not a phase profile");
+
+  std::vector<Record> records;
+  while (std::getline (in, line))
+    {
+      std::istringstream fields (line);
+      Record r;
+      char comma;
+      std::getline (fields, r.kind, ',');
+      std::getline (fields, r.name, ',');
+      fields >> r.simTimeS >> comma >> r.wallS >> comma >> r.wallTotalS >> comma >> r.rssMb >> comma
+             >> r.rssDeltaMb >> comma >> r.pendingEvents >> comma >> r.executedEvents >> comma >> r.nodes
+             >> comma >> r.devices >> comma >> r.faces >> comma >> r.fibEntries >> comma >> r.pitEntries
+             >> comma >> r.csEntries;
+      NS_ABORT_MSG_IF (fields.fail (), "Malformed line in " << file << ": " << line);
+      records.push_back (r);
+    }
+  return records;
+}
+
+} // namespace ns3
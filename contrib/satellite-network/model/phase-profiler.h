@@ -0,0 +1,133 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PHASE_PROFILER_H
+#define PHASE_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * \brief Wall time, memory, events and object counts per setup phase and per interval of
+ * the simulation
+ *
+ * The setup is cut into phases by calling EndPhase with the name of the phase which just
+ * completed: each phase record holds the wall time since the previous record. Once the
+ * simulation is started, a record is taken every interval of simulated time (StartSampling)
+ * for as long as other events are pending.
+ *
+ * Every record holds:
+ *  - the wall time since the previous record and since the profiler was created, in seconds;
+ *  - the resident set size and its change since the previous record, in MB;
+ *  - the events pending (Simulator::GetPendingEventCount, cancelled ones included) and executed so far;
+ *  - the nodes, devices and, summed over the NDN stacks, faces and FIB, PIT and CS entries.
+ *
+ * Write stores the records as CSV, one line per record, in the order they were taken.
+ * Once sampling is started, a last "end" record is taken and the report written when the
+ * simulation is destroyed.
+ */
+class PhaseProfiler : public SimpleRefCount<PhaseProfiler>
+{
+public:
+  struct Record
+  {
+    std::string kind;       //!< "phase" (setup) or "run" (simulation)
+    std::string name;       //!< Phase which ended, or "interval" / "end" while running
+    double simTimeS;
+    double wallS;
+    double wallTotalS;
+    double rssMb;
+    double rssDeltaMb;
+    uint64_t pendingEvents;
+    uint64_t executedEvents;
+    uint32_t nodes;
+    uint32_t devices;
+    uint64_t faces;
+    uint64_t fibEntries;
+    uint64_t pitEntries;
+    uint64_t csEntries;
+  };
+
+  /**
+   * \param file Where Write stores the report (empty: only on an explicit Write)
+   */
+  PhaseProfiler (const std::string& file);
+
+  ~PhaseProfiler ();
+
+  /**
+   * \brief Take the record of a setup phase which has just completed
+   * \return The record
+   */
+  const Record& EndPhase (const std::string& name);
+
+  /**
+   * \brief Take a "run" record every interval of simulated time from now on, and the last
+   * one and write the report when the simulation is destroyed
+   *
+   * Must be called before the first node is created, so that the last record is taken
+   * before the nodes are disposed of (destroy events run in the order they are scheduled).
+   */
+  void StartSampling (Time interval);
+
+  const std::vector<Record>& GetRecords (void) const;
+
+  const std::string& GetFile (void) const;
+
+  /**
+   * \brief Change where the report is written (e.g., per run in a forked child process)
+   */
+  void SetFile (const std::string& file);
+
+  /**
+   * \brief Write the records as CSV (with a header line)
+   */
+  void Write (const std::string& file) const;
+
+  /**
+   * \return The records of a report written by Write
+   */
+  static std::vector<Record> ReadReport (const std::string& file);
+
+private:
+  void Take (const std::string& kind, const std::string& name);
+
+  /// Scheduled every interval
+  void Sample (void);
+
+  /// Scheduled at the destruction of the simulation
+  void Finish (void);
+
+  std::string m_file;
+  std::chrono::steady_clock::time_point m_start;
+  std::chrono::steady_clock::time_point m_last;
+  int64_t m_lastRss;
+  Time m_interval;
+  EventId m_event;
+  std::vector<Record> m_records;
+};
+
+} // namespace ns3
+
+#endif /* PHASE_PROFILER_H */
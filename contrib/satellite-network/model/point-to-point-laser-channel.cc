@@ -45,6 +45,24 @@ PointToPointLaserChannel::GetTypeId (void)
                    DoubleValue (299792458.0),
                    MakeDoubleAccessor (&PointToPointLaserChannel::m_propagationSpeed),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("DelayTableResolution",
+                   "Sample the propagation delay of the link on this time grid and interpolate in between "
+                   "(see PropagationDelayTable). Zero computes the exact delay for every packet.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&PointToPointLaserChannel::m_delayTableResolution),
+                   MakeTimeChecker (Seconds (0)))
+    .AddAttribute ("DelayTableErrorBound",
+                   "Largest deviation from the exact propagation delay allowed at the check points of a sampled "
+                   "interval (beyond it, the interval is computed exactly)",
+                   TimeValue (NanoSeconds (1)),
+                   MakeTimeAccessor (&PointToPointLaserChannel::m_delayTableErrorBound),
+                   MakeTimeChecker (Seconds (0)))
+    .AddAttribute ("DelayTableValidation",
+                   "Also compute the exact propagation delay of every packet and record the largest deviation "
+                   "(see PropagationDelayTable::GetGlobalMaxError)",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PointToPointLaserChannel::m_delayTableValidation),
+                   MakeBooleanChecker ())
     .AddTraceSource ("TxRxPointToPoint",
                      "Trace source indicating transmission of packet "
                      "from the PointToPointLaserChannel, used by the Animation "
@@ -58,7 +76,8 @@ PointToPointLaserChannel::GetTypeId (void)
 PointToPointLaserChannel::PointToPointLaserChannel()
   :
     Channel (),
-    m_nDevices (0)
+    m_nDevices (0),
+    m_delayTableValidation (false)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -114,6 +133,38 @@ PointToPointLaserChannel::TransmitStart (
   return true;
 }
 
+bool
+PointToPointLaserChannel::TransmitBatch (
+  const std::vector<BatchedPacket>& batch,
+  Ptr<PointToPointLaserNetDevice> src,
+  Ptr<Node> node_other_end)
+{
+  NS_LOG_FUNCTION (this << src << batch.size ());
+
+  NS_ASSERT (m_link[0].m_state != INITIALIZING);
+  NS_ASSERT (m_link[1].m_state != INITIALIZING);
+
+  Ptr<MobilityModel> senderMobility = src->GetNode()->GetObject<MobilityModel>();
+  Ptr<MobilityModel> receiverMobility = node_other_end->GetObject<MobilityModel>();
+  std::vector<Time> arrivals = GetArrivalTimes (batch, senderMobility, receiverMobility);
+
+  uint32_t wire = src == m_link[0].m_src ? 0 : 1;
+  Time now = Simulator::Now ();
+
+  Ptr<PacketBatch> received = Create<PacketBatch> ();
+  received->entries.reserve (batch.size ());
+  for (size_t i = 0; i < batch.size (); i++)
+    {
+      received->entries.push_back ({arrivals[i], batch[i].packet->Copy (), 0});
+      m_txrxPointToPoint (batch[i].packet, src, m_link[wire].m_dst, batch[i].txEnd - batch[i].txStart, arrivals[i] - now);
+    }
+
+  Simulator::ScheduleWithContext (m_link[wire].m_dst->GetNode()->GetId (),
+                                  arrivals[0] - now, &PointToPointLaserNetDevice::ReceiveBatch,
+                                  m_link[wire].m_dst, received);
+  return true;
+}
+
 std::size_t
 PointToPointLaserChannel::GetNDevices (void) const
 {
@@ -139,11 +190,42 @@ PointToPointLaserChannel::GetDevice (std::size_t i) const
 Time
 PointToPointLaserChannel::GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
+  if (m_delayTableResolution.IsStrictlyPositive ())
+    {
+      if (!m_delayTable)
+        {
+          m_delayTable.reset (new PropagationDelayTable (m_delayTableResolution, m_delayTableErrorBound,
+                                                         m_delayTableValidation, m_propagationSpeed));
+        }
+      return m_delayTable->GetDelay (a, b);
+    }
+
   double distance = a->GetDistanceFrom (b);
   double seconds = distance / m_propagationSpeed;
   return Seconds (seconds);
 }
 
+std::vector<Time>
+PointToPointLaserChannel::GetArrivalTimes (
+  const std::vector<BatchedPacket>& batch,
+  Ptr<MobilityModel> senderMobility,
+  Ptr<MobilityModel> receiverMobility) const
+{
+  Time now = Simulator::Now ();
+  Time delay = GetDelay (senderMobility, receiverMobility);
+  double rate = batch.size () > 1 ? PropagationDelayTable::GetDelayRate (senderMobility, receiverMobility,
+                                                                         m_propagationSpeed)
+                                  : 0;
+
+  std::vector<Time> arrivals;
+  arrivals.reserve (batch.size ());
+  for (const BatchedPacket& b : batch)
+    {
+      arrivals.push_back (now + b.txEnd + delay + Seconds (rate * b.txStart.GetSeconds ()));
+    }
+  return arrivals;
+}
+
 Ptr<PointToPointLaserNetDevice>
 PointToPointLaserChannel::GetSource (uint32_t i) const
 {
@@ -156,6 +238,12 @@ PointToPointLaserChannel::GetDestination (uint32_t i) const
   return m_link[i].m_dst;
 }
 
+Time
+PointToPointLaserChannel::GetInitialDelay (void) const
+{
+  return m_initial_delay;
+}
+
 bool
 PointToPointLaserChannel::IsInitialized (void) const
 {
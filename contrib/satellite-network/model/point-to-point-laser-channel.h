@@ -29,6 +29,10 @@
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
 #include "ns3/point-to-point-laser-net-device.h"
+#include "ns3/propagation-delay-table.h"
+
+#include <memory>
+#include <vector>
 
 
 namespace ns3 {
@@ -87,6 +91,19 @@ public:
    */
   virtual bool TransmitStart (Ptr<const Packet> p, Ptr<PointToPointLaserNetDevice> src, Ptr<Node> node_other_end, Time txTime);
 
+  /**
+   * \brief Transmit packets sent back to back, starting now
+   *
+   * The receiving device gets a single event for the whole batch (see PacketBatch).
+   * 
+   * \param batch Packets in order of transmission
+   * \param src source PointToPointLaserNetDevice
+   * \param node_other_end node at the other end of the channel
+   * \returns true if successful (always true)
+   */
+  virtual bool TransmitBatch (const std::vector<BatchedPacket>& batch, Ptr<PointToPointLaserNetDevice> src,
+                              Ptr<Node> node_other_end);
+
   /**
    * \brief Write the traffic sent to each node (link utilization) to a stringstream 
    * 
@@ -131,6 +148,31 @@ protected:
    */
   Time GetDelay (Ptr<MobilityModel> senderMobility, Ptr<MobilityModel> receiverMobility) const;
 
+  /**
+   * \brief Get the arrival times of the packets of a batch starting now
+   * 
+   * The delay of each packet is the delay at the start of the batch, corrected by its
+   * rate of change at the start of the transmission of the packet.
+   * 
+   * \param batch Packets in order of transmission
+   * \param senderMobility location of the sender
+   * \param receiverMobility location of the receiver
+   * 
+   * \returns Absolute arrival time of the last bit of every packet
+   */
+  std::vector<Time> GetArrivalTimes (const std::vector<BatchedPacket>& batch, Ptr<MobilityModel> senderMobility,
+                                     Ptr<MobilityModel> receiverMobility) const;
+
+  /**
+   * \brief Get the Delay attribute
+   *
+   * For a remote channel, this is the lower bound of the propagation delay which the
+   * distributed simulator uses as lookahead (see PointToPointLaserHelper::GetMinimumDelay).
+   *
+   * \returns the Delay attribute
+   */
+  Time GetInitialDelay (void) const;
+
   /**
    * \brief Check to make sure the link is initialized
    * 
@@ -191,6 +233,11 @@ private:
   double             m_propagationSpeed;  //!< propagation speed on the channel
   std::size_t        m_nDevices;          //!< Devices of this channel
 
+  Time               m_delayTableResolution;  //!< Delay sampling step (0: exact delay per packet)
+  Time               m_delayTableErrorBound;  //!< Largest deviation allowed by the delay table
+  bool               m_delayTableValidation;  //!< Compare the table with the exact delay
+  mutable std::unique_ptr<PropagationDelayTable> m_delayTable; //!< Created on first use
+
   /**
    * The trace source for the packet transmission animation events that the 
    * device can fire.
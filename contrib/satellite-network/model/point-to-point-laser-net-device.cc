@@ -30,6 +30,7 @@
 #include "ns3/error-model.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/pointer.h"
 #include "ns3/ppp-header.h"
 #include "point-to-point-laser-net-device.h"
@@ -73,6 +74,12 @@ PointToPointLaserNetDevice::GetTypeId (void)
                    TimeValue (Seconds (0.0)),
                    MakeTimeAccessor (&PointToPointLaserNetDevice::m_tInterframeGap),
                    MakeTimeChecker ())
+    .AddAttribute ("TransmitBatching",
+                   "Send the packets queued in one simulation instant back to back in one pass, "
+                   "with one event per batch at the sender and at the receiver",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PointToPointLaserNetDevice::m_transmitBatching),
+                   MakeBooleanChecker ())
 
     //
     // Transmit queueing discipline for the device which includes its own set
@@ -183,7 +190,11 @@ PointToPointLaserNetDevice::PointToPointLaserNetDevice ()
     m_txMachineState (READY),
     m_channel (0),
     m_linkUp (false),
-    m_currentPkt (0)
+    m_currentPkt (0),
+    m_transmitBatching (false),
+    m_batchStarted (0),
+    m_batchBacklogBytes (0),
+    m_utilizationLink (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -220,7 +231,10 @@ PointToPointLaserNetDevice::DoDispose ()
   m_channel = 0;
   m_receiveErrorModel = 0;
   m_currentPkt = 0;
+  m_batch.clear ();
+  m_batchStarts.clear ();
   m_queue = 0;
+  m_utilizationTracker = 0;
   NetDevice::DoDispose ();
 }
 
@@ -253,7 +267,10 @@ PointToPointLaserNetDevice::TransmitStart (Ptr<Packet> p)
   m_txMachineState = BUSY;
   m_currentPkt = p;
   m_phyTxBeginTrace (m_currentPkt);
-  TrackUtilization(true);
+  if (m_utilizationTracker != 0)
+    {
+      m_utilizationTracker->SetBusy (m_utilizationLink, true);
+    }
 
   Time txTime = m_bps.CalculateBytesTxTime (p->GetSize ());
   Time txCompleteTime = txTime + m_tInterframeGap;
@@ -283,10 +300,35 @@ PointToPointLaserNetDevice::TransmitComplete (void)
   NS_ASSERT_MSG (m_txMachineState == BUSY, "Must be BUSY if transmitting");
   m_txMachineState = READY;
 
+  if (!m_batch.empty ())
+    {
+      for (Ptr<Packet> p : m_batch)
+        {
+          m_phyTxEndTrace (p);
+        }
+      m_batch.clear ();
+      m_batchStarts.clear ();
+      if (m_utilizationTracker != 0)
+        {
+          m_utilizationTracker->SetBusy (m_utilizationLink, false);
+        }
+
+      // Everything queued during the batch goes out as the next one
+      if (!m_queue->IsEmpty ())
+        {
+          m_txMachineState = BUSY;
+          TransmitBatch ();
+        }
+      return;
+    }
+
   NS_ASSERT_MSG (m_currentPkt != 0, "PointToPointLaserNetDevice::TransmitComplete(): m_currentPkt zero");
 
   m_phyTxEndTrace (m_currentPkt);
-  TrackUtilization(false);
+  if (m_utilizationTracker != 0)
+    {
+      m_utilizationTracker->SetBusy (m_utilizationLink, false);
+    }
   m_currentPkt = 0;
 
   Ptr<Packet> p = m_queue->Dequeue ();
@@ -304,6 +346,81 @@ PointToPointLaserNetDevice::TransmitComplete (void)
   TransmitStart (p);
 }
 
+void
+PointToPointLaserNetDevice::TransmitBatch (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  NS_ASSERT_MSG (m_txMachineState == BUSY, "Must be reserved (BUSY) for the batch");
+  NS_ASSERT_MSG (m_batch.empty (), "PointToPointLaserNetDevice::TransmitBatch(): batch in progress");
+
+  //
+  // Every packet starts when the previous one and its interframe gap are done,
+  // as if they were sent one by one from TransmitComplete.
+  //
+  std::vector<BatchedPacket> batch;
+  batch.reserve (m_queue->GetNPackets ());
+  Time now = Simulator::Now ();
+  Time start = Seconds (0);
+  m_batchStarted = 0;
+  m_batchBacklogBytes = 0;
+  Ptr<Packet> p = m_currentPkt != 0 ? m_currentPkt : m_queue->Dequeue ();
+  m_currentPkt = 0;
+  for (; p != 0; p = m_queue->Dequeue ())
+    {
+      m_snifferTrace (p);
+      m_promiscSnifferTrace (p);
+      m_phyTxBeginTrace (p);
+      Time txTime = m_bps.CalculateBytesTxTime (p->GetSize ());
+      batch.push_back ({p, start, start + txTime, 0});
+      m_batch.push_back (p);
+      m_batchStarts.push_back (now + start);
+      m_batchBacklogBytes += p->GetSize ();
+      start += txTime + m_tInterframeGap;
+    }
+  NS_ASSERT_MSG (!batch.empty (), "PointToPointLaserNetDevice::TransmitBatch(): nothing queued");
+  if (m_utilizationTracker != 0)
+    {
+      m_utilizationTracker->SetBusy (m_utilizationLink, true);
+    }
+
+  NS_LOG_LOGIC ("Schedule TransmitCompleteEvent of " << batch.size () << " packets in " << start.GetSeconds () << "sec");
+  Simulator::Schedule (start, &PointToPointLaserNetDevice::TransmitComplete, this);
+
+  if (!m_channel->TransmitBatch (batch, this, m_destination_node))
+    {
+      for (const BatchedPacket& b : batch)
+        {
+          m_phyTxDropTrace (b.packet);
+        }
+    }
+}
+
+bool
+PointToPointLaserNetDevice::BatchBacklogFits (Ptr<const Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
+
+  // The batch packets that have started since the last call are no longer queued
+  Time now = Simulator::Now ();
+  while (m_batchStarted < m_batch.size () && m_batchStarts[m_batchStarted] <= now)
+    {
+      m_batchBacklogBytes -= m_batch[m_batchStarted]->GetSize ();
+      m_batchStarted++;
+    }
+  if (m_batchStarted == m_batch.size ())
+    {
+      return true;
+    }
+
+  QueueSize maxSize = m_queue->GetMaxSize ();
+  if (maxSize.GetUnit () == QueueSizeUnit::PACKETS)
+    {
+      return m_queue->GetNPackets () + (m_batch.size () - m_batchStarted) + 1 <= maxSize.GetValue ();
+    }
+  return m_queue->GetNBytes () + m_batchBacklogBytes + packet->GetSize () <= maxSize.GetValue ();
+}
+
 bool
 PointToPointLaserNetDevice::Attach (Ptr<PointToPointLaserChannel> ch)
 {
@@ -393,6 +510,31 @@ PointToPointLaserNetDevice::GetQueue (void) const
   return m_queue;
 }
 
+void
+PointToPointLaserNetDevice::ReceiveBatch (Ptr<PacketBatch> batch)
+{
+  NS_LOG_FUNCTION (this << batch->entries.size () - batch->next);
+
+  Time now = Simulator::Now ();
+  while (batch->next < batch->entries.size () && batch->entries[batch->next].arrival <= now)
+    {
+      Receive (batch->entries[batch->next++].packet);
+    }
+  if (batch->next < batch->entries.size ())
+    {
+      Simulator::Schedule (batch->entries[batch->next].arrival - now, &PointToPointLaserNetDevice::ReceiveBatch,
+                           this, batch);
+    }
+}
+
+void
+PointToPointLaserNetDevice::SetUtilizationTracker (Ptr<UtilizationTracker> tracker, uint32_t link)
+{
+  NS_LOG_FUNCTION (this << tracker << link);
+  m_utilizationTracker = tracker;
+  m_utilizationLink = link;
+}
+
 void
 PointToPointLaserNetDevice::NotifyLinkUp (void)
 {
@@ -554,12 +696,25 @@ PointToPointLaserNetDevice::Send (
 
   //
   // We should enqueue and dequeue the packet to hit the tracing hooks.
+  // The packets of a batch in progress that have not started yet still count
+  // as queued.
   //
-  if (m_queue->Enqueue (packet))
+  if (BatchBacklogFits (packet) && m_queue->Enqueue (packet))
     {
       //
       // If the channel is ready for transition we send the packet right now
       // 
+      if (m_txMachineState == READY && m_transmitBatching)
+        {
+          //
+          // Everything else sent in this instant joins the batch. The first
+          // packet leaves the queue right away, as it would without batching.
+          //
+          m_txMachineState = BUSY;
+          m_currentPkt = m_queue->Dequeue ();
+          Simulator::ScheduleNow (&PointToPointLaserNetDevice::TransmitBatch, this);
+          return true;
+        }
       if (m_txMachineState == READY)
         {
           packet = m_queue->Dequeue ();
@@ -694,68 +849,4 @@ PointToPointLaserNetDevice::EtherToPpp (uint16_t proto)
   return 0;
 }
 
-void
-PointToPointLaserNetDevice::EnableUtilizationTracking(int64_t interval_ns) {
-    m_utilization_tracking_enabled = true;
-    m_interval_ns = interval_ns;
-    m_prev_time_ns = 0;
-    m_current_interval_start = 0;
-    m_current_interval_end = m_interval_ns;
-    m_idle_time_counter_ns = 0;
-    m_busy_time_counter_ns = 0;
-    m_current_state_is_on = false;
-}
-
-void
-PointToPointLaserNetDevice::TrackUtilization(bool next_state_is_on) {
-    if (m_utilization_tracking_enabled) {
-
-        // Current time in nanoseconds
-        int64_t now_ns = Simulator::Now().GetNanoSeconds();
-        while (now_ns >= m_current_interval_end) {
-
-            // Add everything until the end of the interval
-            if (next_state_is_on) {
-                m_idle_time_counter_ns += m_current_interval_end - m_prev_time_ns;
-            } else {
-                m_busy_time_counter_ns += m_current_interval_end - m_prev_time_ns;
-            }
-
-            // Save into the utilization array
-            m_utilization.push_back(((double) m_busy_time_counter_ns) / ((double) m_interval_ns));
-
-            // This must match up
-            NS_ABORT_MSG_IF(m_idle_time_counter_ns + m_busy_time_counter_ns != m_interval_ns, "Not all time is accounted for");
-
-            // Move to next interval
-            m_idle_time_counter_ns = 0;
-            m_busy_time_counter_ns = 0;
-            m_prev_time_ns = m_current_interval_end;
-            m_current_interval_start += m_interval_ns;
-            m_current_interval_end += m_interval_ns;
-        }
-
-        // If not at the end of a new interval, just keep track of it all
-        if (next_state_is_on) {
-            m_idle_time_counter_ns += now_ns - m_prev_time_ns;
-        } else {
-            m_busy_time_counter_ns += now_ns - m_prev_time_ns;
-        }
-
-        // This has become the previous call
-        m_current_state_is_on = next_state_is_on;
-        m_prev_time_ns = now_ns;
-
-    }
-}
-
-
-
-const std::vector<double>&
-PointToPointLaserNetDevice::FinalizeUtilization() {
-    TrackUtilization(!m_current_state_is_on);
-    return m_utilization;
-}
-
-
 } // namespace ns3
@@ -25,6 +25,7 @@
 #define POINT_TO_POINT_LASER_NET_DEVICE_H
 
 #include <cstring>
+#include <vector>
 #include "ns3/address.h"
 #include "ns3/node.h"
 #include "ns3/net-device.h"
@@ -35,6 +36,8 @@
 #include "ns3/data-rate.h"
 #include "ns3/ptr.h"
 #include "ns3/mac48-address.h"
+#include "ns3/packet-batch.h"
+#include "ns3/utilization-tracker.h"
 
 namespace ns3 {
 
@@ -121,6 +124,14 @@ public:
    */
   Ptr<Queue<Packet> > GetQueue (void) const;
 
+  /**
+   * \brief Report the busy periods of the transmitter to a utilization tracker
+   *
+   * \param tracker Tracker (0 to stop reporting)
+   * \param link Index of the link of this device in the tracker
+   */
+  void SetUtilizationTracker (Ptr<UtilizationTracker> tracker, uint32_t link);
+
   /**
    * Attach a receive ErrorModel to the PointToPointLaserNetDevice.
    *
@@ -143,6 +154,13 @@ public:
    */
   void Receive (Ptr<Packet> p);
 
+  /**
+   * Receive the packets of a batch which are due, and wait for the next one.
+   *
+   * \param batch Packets sent back to back by the other end of the channel
+   */
+  void ReceiveBatch (Ptr<PacketBatch> batch);
+
   // The remaining methods are documented in ns3::NetDevice*
 
   virtual void SetIfIndex (const uint32_t index);
@@ -272,6 +290,31 @@ private:
    */
   void TransmitComplete (void);
 
+  /**
+   * Send all queued packets down the wire in one pass (batched transmission).
+   *
+   * The first one is m_currentPkt if Send already took it off the queue.
+   *
+   * The transmissions follow each other exactly as with TransmitStart, but a single
+   * TransmitComplete event is scheduled, at the end of the last one, and the channel
+   * is called once for the whole batch.
+   *
+   * \see PointToPointLaserChannel::TransmitBatch ()
+   */
+  void TransmitBatch (void);
+
+  /**
+   * Check whether a packet fits in the queue together with the packets of the
+   * batch in progress that have not started their transmission yet.
+   *
+   * Without batching, those packets would still be waiting in the queue, so
+   * they count against its maximum size the same way.
+   *
+   * \param packet the packet about to be enqueued
+   * \returns false if it would overflow the queue
+   */
+  bool BatchBacklogFits (Ptr<const Packet> packet);
+
   /**
    * \brief Make the link up and running
    *
@@ -455,6 +498,15 @@ private:
 
   Ptr<Packet> m_currentPkt; //!< Current packet processed
 
+  bool m_transmitBatching;               //!< Send the packets queued in one instant as a batch
+  std::vector<Ptr<Packet> > m_batch;     //!< Packets of the batch being transmitted
+  std::vector<Time> m_batchStarts;       //!< Transmission start time of each packet of the batch
+  size_t m_batchStarted;                 //!< Number of packets of the batch known to have started
+  uint64_t m_batchBacklogBytes;          //!< Bytes of the packets of the batch not known to have started
+
+  Ptr<UtilizationTracker> m_utilizationTracker; //!< Tracker of the busy periods, if any
+  uint32_t m_utilizationLink;                   //!< Index of the link in the tracker
+
   /**
    * \brief PPP to Ethernet protocol number mapping
    * \param protocol A PPP protocol number
@@ -468,23 +520,6 @@ private:
    * \return The corresponding PPP protocol number
    */
   static uint16_t EtherToPpp (uint16_t protocol);
-
-private:
-  bool m_utilization_tracking_enabled = false;
-  int64_t m_interval_ns;
-  int64_t m_prev_time_ns;
-  int64_t m_current_interval_start;
-  int64_t m_current_interval_end;
-  int64_t m_idle_time_counter_ns;
-  int64_t m_busy_time_counter_ns;
-  bool m_current_state_is_on;
-  std::vector<double> m_utilization;
-  void TrackUtilization(bool next_state_is_on);
-
-public:
-    void EnableUtilizationTracking(int64_t interval_ns);
-    const std::vector<double>& FinalizeUtilization();
-
 };
 
 } // namespace ns3
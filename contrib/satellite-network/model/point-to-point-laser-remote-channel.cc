@@ -28,6 +28,7 @@
 #include "point-to-point-laser-net-device.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/abort.h"
 #include "ns3/log.h"
 #include "ns3/mpi-interface.h"
 
@@ -77,6 +78,10 @@ PointToPointLaserRemoteChannel::TransmitStart (
   Ptr<PointToPointLaserNetDevice> dst = GetDestination (wire);
 
 #ifdef NS3_MPI
+  // The lookahead of the distributed simulator relies on the lower bound
+  NS_ABORT_MSG_IF (delay < GetInitialDelay (),
+                   "ISL delay " << delay << " is below the channel lower bound " << GetInitialDelay ());
+
   // Calculate the rxTime (absolute)
   Time rxTime = Simulator::Now () + txTime + delay;
   MpiInterface::SendPacket (p->Copy (), rxTime, dst->GetNode()->GetId (), dst->GetIfIndex());
@@ -86,4 +91,37 @@ PointToPointLaserRemoteChannel::TransmitStart (
   return true;
 }
 
+bool
+PointToPointLaserRemoteChannel::TransmitBatch (
+  const std::vector<BatchedPacket>& batch,
+  Ptr<PointToPointLaserNetDevice> src,
+  Ptr<Node> node_other_end)
+{
+  NS_LOG_FUNCTION (this << src << batch.size ());
+
+  IsInitialized ();
+
+  Ptr<MobilityModel> senderMobility = src->GetNode()->GetObject<MobilityModel>();
+  Ptr<MobilityModel> receiverMobility = node_other_end->GetObject<MobilityModel>();
+  std::vector<Time> arrivals = GetArrivalTimes (batch, senderMobility, receiverMobility);
+
+  uint32_t wire = src == GetSource (0) ? 0 : 1;
+  Ptr<PointToPointLaserNetDevice> dst = GetDestination (wire);
+
+#ifdef NS3_MPI
+  Time now = Simulator::Now ();
+  for (size_t i = 0; i < batch.size (); i++)
+    {
+      // The lookahead of the distributed simulator relies on the lower bound
+      Time delay = arrivals[i] - now - batch[i].txEnd;
+      NS_ABORT_MSG_IF (delay < GetInitialDelay (),
+                       "ISL delay " << delay << " is below the channel lower bound " << GetInitialDelay ());
+      MpiInterface::SendPacket (batch[i].packet->Copy (), arrivals[i], dst->GetNode()->GetId (), dst->GetIfIndex());
+    }
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+  return true;
+}
+
 } // namespace ns3
@@ -69,6 +69,17 @@ public:
    */
   virtual bool TransmitStart (Ptr<const Packet> p, Ptr<PointToPointLaserNetDevice> src,
                               Ptr<Node> node_other_end, Time txTime);
+
+  /**
+   * \brief Transmit packets sent back to back, each with its own MPI message
+   *
+   * \param batch Packets in order of transmission
+   * \param src Source PointToPointNetDevice
+   * 
+   * \returns true if successful (always true)
+   */
+  virtual bool TransmitBatch (const std::vector<BatchedPacket>& batch, Ptr<PointToPointLaserNetDevice> src,
+                              Ptr<Node> node_other_end);
 };
 
 } // namespace ns3
@@ -0,0 +1,225 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "propagation-delay-table.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "ns3/abort.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/log.h"
+#include "ns3/satellite-position-mobility-model.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PropagationDelayTable");
+
+double PropagationDelayTable::s_maxError = 0;
+uint64_t PropagationDelayTable::s_nValidated = 0;
+
+size_t
+PropagationDelayTable::LinkKeyHash::operator() (const LinkKey& key) const
+{
+  size_t h = std::hash<const void*> () (key.first);
+  return h ^ (std::hash<const void*> () (key.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+}
+
+PropagationDelayTable::PropagationDelayTable (Time resolution, Time errorBound, bool validate,
+                                              double propagationSpeed)
+  : m_resolution (resolution),
+    m_errorBound (errorBound.GetSeconds () * propagationSpeed),
+    m_validate (validate),
+    m_propagationSpeed (propagationSpeed),
+    m_maxError (0),
+    m_nValidated (0)
+{
+  NS_LOG_FUNCTION (this << resolution << errorBound << validate << propagationSpeed);
+  NS_ABORT_MSG_UNLESS (resolution.IsStrictlyPositive (), "Delay table resolution must be positive");
+}
+
+Time
+PropagationDelayTable::GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b)
+{
+  Time now = Simulator::Now ();
+
+  // The distance is symmetric, so both directions share one link
+  LinkKey key = PeekPointer (a) < PeekPointer (b) ? LinkKey (PeekPointer (a), PeekPointer (b))
+                                                  : LinkKey (PeekPointer (b), PeekPointer (a));
+  auto it = m_links.find (key);
+  if (it == m_links.end ())
+    {
+      Link link;
+      link.tabulated = true;
+      link.valid = false;
+      link.exact = false;
+      it = m_links.insert (std::make_pair (key, link)).first;
+    }
+
+  Link& link = it->second;
+  if (link.tabulated && (!link.valid || now < link.s0.t || now >= link.s1.t))
+    {
+      link.tabulated = Refill (link, a, b, now);
+    }
+  if (!link.tabulated || link.exact)
+    {
+      return Seconds (a->GetDistanceFrom (b) / m_propagationSpeed);
+    }
+
+  double distance = Interpolate (link, now);
+  if (m_validate)
+    {
+      double error = std::fabs (distance - a->GetDistanceFrom (b)) / m_propagationSpeed;
+      m_maxError = std::max (m_maxError, error);
+      m_nValidated++;
+      s_maxError = std::max (s_maxError, error);
+      s_nValidated++;
+    }
+  return Seconds (distance / m_propagationSpeed);
+}
+
+double
+PropagationDelayTable::GetDelayRate (Ptr<MobilityModel> a, Ptr<MobilityModel> b, double propagationSpeed)
+{
+  Vector pa = a->GetPosition (), pb = b->GetPosition ();
+  Vector va = a->GetVelocity (), vb = b->GetVelocity ();
+  Vector d (pa.x - pb.x, pa.y - pb.y, pa.z - pb.z);
+  double distance = d.GetLength ();
+  if (distance == 0)
+    {
+      return 0;
+    }
+  return (d.x * (va.x - vb.x) + d.y * (va.y - vb.y) + d.z * (va.z - vb.z)) / distance / propagationSpeed;
+}
+
+Time
+PropagationDelayTable::GetMaxError (void) const
+{
+  return Seconds (m_maxError);
+}
+
+uint64_t
+PropagationDelayTable::GetNValidated (void) const
+{
+  return m_nValidated;
+}
+
+Time
+PropagationDelayTable::GetGlobalMaxError (void)
+{
+  return Seconds (s_maxError);
+}
+
+uint64_t
+PropagationDelayTable::GetGlobalNValidated (void)
+{
+  return s_nValidated;
+}
+
+bool
+PropagationDelayTable::GetState (Ptr<MobilityModel> m, Time t, Vector& position, Vector& velocity)
+{
+  Ptr<SatellitePositionMobilityModel> satellite = DynamicCast<SatellitePositionMobilityModel> (m);
+  if (satellite)
+    {
+      satellite->GetPositionVelocity (t, position, velocity);
+      return true;
+    }
+  if (DynamicCast<ConstantPositionMobilityModel> (m))
+    {
+      position = m->GetPosition ();
+      velocity = Vector (0, 0, 0);
+      return true;
+    }
+  return false;
+}
+
+bool
+PropagationDelayTable::GetSample (Ptr<MobilityModel> a, Ptr<MobilityModel> b, Time t, Sample& s) const
+{
+  Vector pa, va, pb, vb;
+  if (!GetState (a, t, pa, va) || !GetState (b, t, pb, vb))
+    {
+      return false;
+    }
+
+  Vector d (pa.x - pb.x, pa.y - pb.y, pa.z - pb.z);
+  Vector v (va.x - vb.x, va.y - vb.y, va.z - vb.z);
+  s.t = t;
+  s.distance = d.GetLength ();
+  s.rate = s.distance > 0 ? (d.x * v.x + d.y * v.y + d.z * v.z) / s.distance : 0;
+  return true;
+}
+
+bool
+PropagationDelayTable::Refill (Link& link, Ptr<MobilityModel> a, Ptr<MobilityModel> b, Time now) const
+{
+  NS_LOG_FUNCTION (this << now);
+
+  Time t0 = m_resolution * (now.GetTimeStep () / m_resolution.GetTimeStep ());
+  Time t1 = t0 + m_resolution;
+
+  // Consecutive intervals share their boundary sample
+  Sample s0, s1;
+  if (link.valid && link.s1.t == t0)
+    {
+      s0 = link.s1;
+    }
+  else if (!GetSample (a, b, t0, s0))
+    {
+      return false;
+    }
+  if (!GetSample (a, b, t1, s1))
+    {
+      return false;
+    }
+  link.s0 = s0;
+  link.s1 = s1;
+  link.valid = true;
+  link.exact = false;
+
+  for (int64_t i = 1; i <= CHECKS && !link.exact; i++)
+    {
+      Sample sc;
+      Time tc = t0 + TimeStep (m_resolution.GetTimeStep () * i / (CHECKS + 1));
+      if (!GetSample (a, b, tc, sc))
+        {
+          return false;
+        }
+      link.exact = std::fabs (Interpolate (link, tc) - sc.distance) > m_errorBound;
+    }
+  NS_LOG_LOGIC ("Interval " << t0 << " sampled, " << (link.exact ? "exact" : "interpolated"));
+  return true;
+}
+
+double
+PropagationDelayTable::Interpolate (const Link& link, Time t) const
+{
+  double h = (link.s1.t - link.s0.t).GetSeconds ();
+  double tau = (t - link.s0.t).GetSeconds () / h;
+  double tau2 = tau * tau;
+  double tau3 = tau2 * tau;
+
+  // Cubic Hermite spline on the unit interval
+  return (2 * tau3 - 3 * tau2 + 1) * link.s0.distance
+         + (tau3 - 2 * tau2 + tau) * h * link.s0.rate
+         + (-2 * tau3 + 3 * tau2) * link.s1.distance
+         + (tau3 - tau2) * h * link.s1.rate;
+}
+
+} // namespace ns3
@@ -0,0 +1,159 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PROPAGATION_DELAY_TABLE_H
+#define PROPAGATION_DELAY_TABLE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+#include "ns3/mobility-model.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+/**
+ * \brief Per-link propagation delay sampled on a time grid and interpolated
+ *
+ * Computing the exact delay of every packet costs two orbit propagations. The
+ * table instead samples the distance of each link (and its rate of change) at
+ * grid points k * resolution, and answers all packets in between with a cubic
+ * Hermite interpolation. Samples are taken lazily, when the first packet of an
+ * interval is sent.
+ *
+ * All links are sampled on the same grid, so that satellites propagated through
+ * a shared SatelliteConstellation are asked for the same few instants by all of
+ * their links. When a new interval is sampled, the interpolation is checked
+ * against the exact distance at CHECKS evenly spaced points inside the interval
+ * (on the same grid for all links too): if it deviates by more than the error
+ * bound at any of them, the delay of the link is computed exactly for every
+ * packet until the end of the interval.
+ *
+ * Only links between satellites (SatellitePositionMobilityModel) and static
+ * nodes (ConstantPositionMobilityModel) can be sampled ahead of time; the delay
+ * of any other link is computed exactly for every packet.
+ *
+ * In validation mode, the exact delay is computed as well for every packet and
+ * the maximum deviation is recorded (the interpolated delay is still used).
+ */
+class PropagationDelayTable
+{
+public:
+  /**
+   * \param resolution Sampling step (must be positive)
+   * \param errorBound Largest deviation from the exact delay at the check points of an interval
+   * \param validate Compare every interpolated delay with the exact one
+   * \param propagationSpeed Propagation speed in m/s
+   */
+  PropagationDelayTable (Time resolution, Time errorBound, bool validate, double propagationSpeed);
+
+  /**
+   * \brief Get the propagation delay between two nodes at the current simulation time
+   */
+  Time GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b);
+
+  /**
+   * \brief Rate of change of the propagation delay between two nodes (s/s)
+   *
+   * Derived from the current positions and velocities of the nodes. Over the few
+   * microseconds of a packet batch, the delay changes linearly well below the
+   * nanosecond resolution of the simulator.
+   */
+  static double GetDelayRate (Ptr<MobilityModel> a, Ptr<MobilityModel> b, double propagationSpeed);
+
+  /**
+   * \return Largest deviation from the exact delay seen by this table (validation mode)
+   */
+  Time GetMaxError (void) const;
+
+  /**
+   * \return Number of delays compared with the exact delay by this table (validation mode)
+   */
+  uint64_t GetNValidated (void) const;
+
+  /**
+   * \return Largest deviation from the exact delay seen by all tables (validation mode)
+   */
+  static Time GetGlobalMaxError (void);
+
+  /**
+   * \return Number of delays compared with the exact delay by all tables (validation mode)
+   */
+  static uint64_t GetGlobalNValidated (void);
+
+private:
+  /// Distance of a link and its rate of change at one time
+  struct Sample
+  {
+    Time t;
+    double distance;  //!< m
+    double rate;      //!< m/s
+  };
+
+  /// Interpolation state of one link
+  struct Link
+  {
+    bool tabulated;   //!< False if the link cannot be sampled ahead of time
+    bool valid;       //!< s0 and s1 hold the current interval
+    bool exact;       //!< The interpolation exceeds the error bound in the current interval
+    Sample s0;
+    Sample s1;
+  };
+
+  /// Number of points per interval where the interpolation is checked
+  static const int64_t CHECKS = 3;
+
+  typedef std::pair<const MobilityModel*, const MobilityModel*> LinkKey;
+
+  struct LinkKeyHash
+  {
+    size_t operator() (const LinkKey& key) const;
+  };
+
+  /**
+   * \brief Position and velocity of a node at simulation time t
+   * \return False if the mobility model cannot be evaluated ahead of time
+   */
+  static bool GetState (Ptr<MobilityModel> m, Time t, Vector& position, Vector& velocity);
+
+  bool GetSample (Ptr<MobilityModel> a, Ptr<MobilityModel> b, Time t, Sample& s) const;
+
+  /**
+   * \brief Sample the interval of the link containing the current time
+   * \return False if the link cannot be sampled ahead of time
+   */
+  bool Refill (Link& link, Ptr<MobilityModel> a, Ptr<MobilityModel> b, Time now) const;
+
+  double Interpolate (const Link& link, Time t) const;
+
+  Time m_resolution;
+  double m_errorBound;        //!< m
+  bool m_validate;
+  double m_propagationSpeed;  //!< m/s
+  std::unordered_map<LinkKey, Link, LinkKeyHash> m_links;
+
+  double m_maxError;          //!< s
+  uint64_t m_nValidated;
+
+  static double s_maxError;
+  static uint64_t s_nValidated;
+};
+
+} // namespace ns3
+
+#endif /* PROPAGATION_DELAY_TABLE_H */
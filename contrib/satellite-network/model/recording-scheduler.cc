@@ -0,0 +1,174 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "recording-scheduler.h"
+
+#include <cstring>
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/map-scheduler.h"
+#include "ns3/object-factory.h"
+#include "ns3/string.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("RecordingScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (RecordingScheduler);
+
+const char RecordingScheduler::MAGIC[8] = {'N', 'D', 'N', 'S', 'C', 'H', 'T', '1'};
+
+namespace {
+
+const size_t BUFFER_RECORDS = 65536;
+
+} // namespace
+
+TypeId
+RecordingScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::RecordingScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("SatelliteNetwork")
+    .AddConstructor<RecordingScheduler> ()
+    .AddAttribute ("SchedulerType",
+                   "The scheduler which holds the events",
+                   TypeIdValue (MapScheduler::GetTypeId ()),
+                   MakeTypeIdAccessor (&RecordingScheduler::m_schedulerType),
+                   MakeTypeIdChecker ())
+    .AddAttribute ("TraceFile",
+                   "The file the operations are written to",
+                   StringValue ("scheduler-trace.bin"),
+                   MakeStringAccessor (&RecordingScheduler::m_traceFile),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+RecordingScheduler::RecordingScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+RecordingScheduler::~RecordingScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+}
+
+void
+RecordingScheduler::NotifyConstructionCompleted (void)
+{
+  NS_LOG_FUNCTION (this);
+  ObjectFactory factory;
+  factory.SetTypeId (m_schedulerType);
+  m_scheduler = factory.Create<Scheduler> ();
+
+  m_out.open (m_traceFile, std::ios::binary | std::ios::trunc);
+  NS_ABORT_MSG_UNLESS (m_out.is_open (), "File " << m_traceFile << " could not be created");
+  m_out.write (MAGIC, sizeof (MAGIC));
+  m_buffer.reserve (BUFFER_RECORDS);
+  Scheduler::NotifyConstructionCompleted ();
+}
+
+void
+RecordingScheduler::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+  m_scheduler = 0;
+  Scheduler::DoDispose ();
+}
+
+void
+RecordingScheduler::Record (const Scheduler::Event &ev, SchedulerTraceRecord::Op op)
+{
+  m_buffer.push_back ({ev.key.m_ts, ev.key.m_uid, op});
+  if (m_buffer.size () == BUFFER_RECORDS)
+    {
+      m_out.write (reinterpret_cast<const char*> (m_buffer.data ()), m_buffer.size () * sizeof (SchedulerTraceRecord));
+      m_buffer.clear ();
+    }
+}
+
+void
+RecordingScheduler::Flush (void)
+{
+  if (!m_out.is_open ())
+    {
+      return;
+    }
+  m_out.write (reinterpret_cast<const char*> (m_buffer.data ()), m_buffer.size () * sizeof (SchedulerTraceRecord));
+  m_buffer.clear ();
+  m_out.close ();
+  NS_ABORT_MSG_IF (m_out.fail (), "Writing " << m_traceFile << " failed");
+}
+
+void
+RecordingScheduler::Insert (const Scheduler::Event &ev)
+{
+  Record (ev, SchedulerTraceRecord::INSERT);
+  m_scheduler->Insert (ev);
+}
+
+bool
+RecordingScheduler::IsEmpty (void) const
+{
+  return m_scheduler->IsEmpty ();
+}
+
+Scheduler::Event
+RecordingScheduler::PeekNext (void) const
+{
+  return m_scheduler->PeekNext ();
+}
+
+Scheduler::Event
+RecordingScheduler::RemoveNext (void)
+{
+  Scheduler::Event ev = m_scheduler->RemoveNext ();
+  Record (ev, SchedulerTraceRecord::REMOVE_NEXT);
+  return ev;
+}
+
+void
+RecordingScheduler::Remove (const Scheduler::Event &ev)
+{
+  Record (ev, SchedulerTraceRecord::REMOVE);
+  m_scheduler->Remove (ev);
+}
+
+std::vector<SchedulerTraceRecord>
+RecordingScheduler::ReadTrace (const std::string& path)
+{
+  std::ifstream in (path, std::ios::binary | std::ios::ate);
+  NS_ABORT_MSG_UNLESS (in.is_open (), "File " << path << " could not be opened");
+  std::streamoff size = in.tellg ();
+  char magic[sizeof (MAGIC)];
+  in.seekg (0);
+  in.read (magic, sizeof (magic));
+  NS_ABORT_MSG_IF (!in || std::memcmp (magic, MAGIC, sizeof (MAGIC)) != 0
+                   || (size - sizeof (MAGIC)) % sizeof (SchedulerTraceRecord) != 0,
+                   "File " << path << " is not a scheduler trace");
+
+  std::vector<SchedulerTraceRecord> records ((size - sizeof (MAGIC)) / sizeof (SchedulerTraceRecord));
+  in.read (reinterpret_cast<char*> (records.data ()), records.size () * sizeof (SchedulerTraceRecord));
+  NS_ABORT_MSG_IF (!in, "Reading " << path << " failed");
+  return records;
+}
+
+} // namespace ns3
@@ -0,0 +1,96 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RECORDING_SCHEDULER_H
+#define RECORDING_SCHEDULER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ns3/scheduler.h"
+#include "ns3/type-id.h"
+
+namespace ns3 {
+
+/**
+ * \brief One operation on the event scheduler, as recorded by RecordingScheduler
+ */
+struct SchedulerTraceRecord
+{
+  enum Op
+  {
+    INSERT = 0,
+    REMOVE_NEXT = 1,  //!< Event returned by RemoveNext
+    REMOVE = 2        //!< Cancelled event
+  };
+
+  uint64_t ts;   //!< Timestamp of the event (in time steps)
+  uint32_t uid;  //!< Unique id of the event
+  uint32_t op;   //!< Op
+};
+
+/**
+ * \brief Event scheduler recording every operation before forwarding it to another scheduler
+ *
+ * Set it with Simulator::SetScheduler to capture the event-time distribution of a real
+ * run; the trace can be replayed against every scheduler with scheduler-benchmark.
+ *
+ * File layout (host byte order): "NDNSCHT1", then one SchedulerTraceRecord per operation.
+ * Records are buffered and the file is complete when the scheduler is destroyed (at
+ * Simulator::Destroy).
+ */
+class RecordingScheduler : public Scheduler
+{
+public:
+  static const char MAGIC[8];
+
+  static TypeId GetTypeId (void);
+
+  RecordingScheduler ();
+  virtual ~RecordingScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+  /**
+   * \brief Read all the records of a trace file (aborts if it is not a valid file)
+   */
+  static std::vector<SchedulerTraceRecord> ReadTrace (const std::string& path);
+
+protected:
+  virtual void NotifyConstructionCompleted (void);
+  virtual void DoDispose (void);
+
+private:
+  void Record (const Scheduler::Event &ev, SchedulerTraceRecord::Op op);
+  void Flush (void);
+
+  TypeId m_schedulerType;
+  std::string m_traceFile;
+  Ptr<Scheduler> m_scheduler;
+  std::ofstream m_out;
+  std::vector<SchedulerTraceRecord> m_buffer;
+};
+
+} // namespace ns3
+
+#endif /* RECORDING_SCHEDULER_H */
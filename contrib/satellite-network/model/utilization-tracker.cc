@@ -0,0 +1,255 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "utilization-tracker.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-writer.hpp"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("UtilizationTracker");
+
+UtilizationTracker::UtilizationTracker (int64_t intervalNs)
+  : m_intervalNs (intervalNs),
+    m_intervalStart (0),
+    m_nIntervals (0),
+    m_opened (false)
+{
+  NS_LOG_FUNCTION (this << intervalNs);
+  NS_ABORT_MSG_UNLESS (intervalNs > 0, "Utilization tracking interval must be positive");
+
+  int64_t now = Simulator::Now ().GetNanoSeconds ();
+  m_intervalStart = now - now % m_intervalNs;
+  m_event = Simulator::Schedule (NanoSeconds (m_intervalStart + m_intervalNs - now),
+                                 &UtilizationTracker::CloseInterval, this);
+}
+
+UtilizationTracker::~UtilizationTracker ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+UtilizationTracker::SetOutput (const std::string& linkFile, const std::string& groupFile)
+{
+  NS_ABORT_MSG_IF (m_opened, "Utilization output set after the first interval");
+  m_linkFile = linkFile;
+  m_groupFile = groupFile;
+}
+
+uint32_t
+UtilizationTracker::GetGroup (const std::string& name)
+{
+  auto result = m_groupIndex.insert (std::make_pair (name, m_groups.size ()));
+  if (result.second)
+    {
+      m_groups.push_back ({name, 0, {}});
+    }
+  return result.first->second;
+}
+
+uint32_t
+UtilizationTracker::AddLink (int32_t from, int32_t to, uint32_t group)
+{
+  NS_ASSERT (group < m_groups.size ());
+  m_groups[group].nLinks++;
+  m_links.push_back ({from, to, group, false, false, 0, 0});
+  return m_links.size () - 1;
+}
+
+void
+UtilizationTracker::SetBusy (uint32_t link, bool busy)
+{
+  Link& l = m_links[link];
+  int64_t now = Simulator::Now ().GetNanoSeconds ();
+  if (l.busy)
+    {
+      l.busyNs += now - l.since;
+    }
+  l.since = now;
+  l.busy = busy;
+  if (!l.active)
+    {
+      l.active = true;
+      m_active.push_back (link);
+    }
+}
+
+void
+UtilizationTracker::CloseInterval (void)
+{
+  Flush ();
+  m_event = Simulator::Schedule (NanoSeconds (m_intervalNs), &UtilizationTracker::CloseInterval, this);
+}
+
+void
+UtilizationTracker::OpenOutput (void)
+{
+  m_opened = true;
+  using ndn::TraceWriter;
+  if (!m_linkFile.empty ())
+    {
+      m_linkWriter.reset (new TraceWriter (m_linkFile, {TraceWriter::INT, TraceWriter::INT,
+                                                        TraceWriter::INT, TraceWriter::REAL}));
+      NS_ABORT_MSG_UNLESS (m_linkWriter->IsOpen (), "File " << m_linkFile << " could not be opened");
+      m_linkWriter->SetHeader ("IntervalStart\tFrom\tTo\tUtilization");
+    }
+  if (!m_groupFile.empty ())
+    {
+      m_groupWriter.reset (new TraceWriter (m_groupFile, {TraceWriter::INT, TraceWriter::STRING,
+                                                          TraceWriter::INT, TraceWriter::REAL,
+                                                          TraceWriter::REAL, TraceWriter::REAL,
+                                                          TraceWriter::REAL, TraceWriter::REAL}));
+      NS_ABORT_MSG_UNLESS (m_groupWriter->IsOpen (), "File " << m_groupFile << " could not be opened");
+      m_groupWriter->SetHeader ("IntervalStart\tGroup\tActive\tMean\tP50\tP90\tP99\tMax");
+    }
+}
+
+void
+UtilizationTracker::Flush (void)
+{
+  if (!m_opened)
+    {
+      OpenOutput ();
+    }
+
+  int64_t end = m_intervalStart + m_intervalNs;
+  size_t kept = 0;
+  for (uint32_t index : m_active)
+    {
+      Link& l = m_links[index];
+      if (l.busy)
+        {
+          l.busyNs += end - l.since;
+          l.since = end;
+        }
+      if (l.busyNs > 0)
+        {
+          double utilization = (double) l.busyNs / (double) m_intervalNs;
+          if (m_linkWriter != nullptr)
+            {
+              m_linkWriter->Append ({{ndn::TraceWriter::Int (m_intervalStart), ndn::TraceWriter::Int (l.from),
+                                      ndn::TraceWriter::Int (l.to), ndn::TraceWriter::Real (utilization)}});
+            }
+          if (m_groupWriter != nullptr)
+            {
+              Group& group = m_groups[l.group];
+              if (group.values.empty ())
+                {
+                  m_activeGroups.push_back (l.group);
+                }
+              group.values.push_back (utilization);
+            }
+        }
+      l.busyNs = 0;
+
+      // Links still transmitting are part of the next interval
+      if (l.busy)
+        {
+          m_active[kept++] = index;
+        }
+      else
+        {
+          l.active = false;
+        }
+    }
+  m_active.resize (kept);
+
+  for (uint32_t index : m_activeGroups)
+    {
+      WriteGroup (index);
+    }
+  m_activeGroups.clear ();
+
+  m_intervalStart = end;
+  m_nIntervals++;
+}
+
+void
+UtilizationTracker::WriteGroup (uint32_t index)
+{
+  Group& group = m_groups[index];
+  while (m_groupNames.size () < m_groups.size ())
+    {
+      m_groupNames.push_back (m_groupWriter->Intern (m_groups[m_groupNames.size ()].name));
+    }
+
+  // Nearest-rank percentiles, the idle links of the group being the lowest values
+  std::vector<double>& values = group.values;
+  std::sort (values.begin (), values.end ());
+  uint32_t nIdle = group.nLinks - values.size ();
+  auto percentile = [&values, &group, nIdle] (double p) {
+    uint32_t rank = std::max<uint32_t> (1, (uint32_t) std::ceil (p * group.nLinks));
+    return rank <= nIdle ? 0.0 : values[rank - 1 - nIdle];
+  };
+  double sum = 0;
+  for (double value : values)
+    {
+      sum += value;
+    }
+
+  using ndn::TraceWriter;
+  m_groupWriter->Append ({{TraceWriter::Int (m_intervalStart), m_groupNames[index], TraceWriter::Int (values.size ()),
+                           TraceWriter::Real (sum / group.nLinks), TraceWriter::Real (percentile (0.5)),
+                           TraceWriter::Real (percentile (0.9)), TraceWriter::Real (percentile (0.99)),
+                           TraceWriter::Real (values.back ())}});
+  values.clear ();
+}
+
+void
+UtilizationTracker::Finalize (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_event.IsRunning ())
+    {
+      return;
+    }
+  m_event.Cancel ();
+  // The interval ending now may not have been closed (e.g., it ends when the simulation stops)
+  while (m_intervalStart + m_intervalNs <= Simulator::Now ().GetNanoSeconds ())
+    {
+      Flush ();
+    }
+  if (m_linkWriter != nullptr)
+    {
+      m_linkWriter->Close ();
+    }
+  if (m_groupWriter != nullptr)
+    {
+      m_groupWriter->Close ();
+    }
+}
+
+int64_t
+UtilizationTracker::GetIntervalNs (void) const
+{
+  return m_intervalNs;
+}
+
+uint64_t
+UtilizationTracker::GetNIntervals (void) const
+{
+  return m_nIntervals;
+}
+
+} // namespace ns3
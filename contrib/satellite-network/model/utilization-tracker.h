@@ -0,0 +1,156 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef UTILIZATION_TRACKER_H
+#define UTILIZATION_TRACKER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ns3/event-id.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+namespace ndn {
+class TraceWriter;
+}
+
+/**
+ * \brief Busy fraction of the transmitters of ISL and GSL devices, per interval
+ *
+ * Devices report when their transmitter becomes busy or idle (SetBusy). At the end of
+ * every interval, the busy fraction of each link that transmitted during the interval is
+ * written out and the interval is forgotten, so memory does not grow with the duration
+ * of the run. Only the links that were busy in an interval are visited when it closes.
+ *
+ * Two outputs, both optional, are written with ndn::TraceWriter (convert them to text
+ * with ndn-trace-to-text):
+ *  - per link: IntervalStart (ns), From, To (-1 for GSLs), Utilization; links idle
+ *    during the whole interval are left out;
+ *  - per group of links (e.g., the ISLs of an orbit, the GSLs of a ground station):
+ *    IntervalStart (ns), Group, Active (number of links not idle), Mean, P50, P90, P99
+ *    and Max over all links of the group, idle links counting as 0; groups without any
+ *    active link are left out.
+ *
+ * The outputs are opened when the first interval closes: they can be set after the
+ * devices are registered, e.g. per run in a forked child process.
+ *
+ * The interval in progress when the simulation ends is not written. The tracker must be
+ * kept until Finalize is called (e.g., with Simulator::ScheduleDestroy).
+ */
+class UtilizationTracker : public SimpleRefCount<UtilizationTracker>
+{
+public:
+  /**
+   * \param intervalNs Length of an interval in nanoseconds (intervals start at multiples of it)
+   */
+  UtilizationTracker (int64_t intervalNs);
+
+  ~UtilizationTracker ();
+
+  /**
+   * \param linkFile Output per link (empty to disable)
+   * \param groupFile Output per group (empty to disable)
+   */
+  void SetOutput (const std::string& linkFile, const std::string& groupFile);
+
+  /**
+   * \return Index of the group of links with this name (added on first use)
+   */
+  uint32_t GetGroup (const std::string& name);
+
+  /**
+   * \param from Node of the device
+   * \param to Node at the other end (-1 if several, as for GSLs)
+   * \param group Group of the link, as returned by GetGroup
+   * \return Index of the link, to be given to SetBusy
+   */
+  uint32_t AddLink (int32_t from, int32_t to, uint32_t group);
+
+  /**
+   * \brief Transmitter of the link starts (busy = true) or stops transmitting, now
+   */
+  void SetBusy (uint32_t link, bool busy);
+
+  /**
+   * \brief Write the intervals completed by now and close the outputs
+   */
+  void Finalize (void);
+
+  int64_t GetIntervalNs (void) const;
+
+  /**
+   * \return Number of intervals closed so far
+   */
+  uint64_t GetNIntervals (void) const;
+
+private:
+  struct Link
+  {
+    int32_t from;
+    int32_t to;
+    uint32_t group;
+    bool busy;
+    bool active;        //!< In m_active
+    int64_t since;      //!< Last change within the interval (ns)
+    int64_t busyNs;     //!< Busy time in the interval until since
+  };
+
+  struct Group
+  {
+    std::string name;
+    uint32_t nLinks;
+    std::vector<double> values;  //!< Busy fractions of the active links in the interval
+  };
+
+  /// Scheduled at the end of every interval
+  void CloseInterval (void);
+
+  /**
+   * \brief Write the busy fractions of the current interval and move to the next one
+   */
+  void Flush (void);
+
+  void OpenOutput (void);
+
+  void WriteGroup (uint32_t index);
+
+  int64_t m_intervalNs;
+  int64_t m_intervalStart;
+  uint64_t m_nIntervals;
+  EventId m_event;
+
+  std::vector<Link> m_links;
+  std::vector<uint32_t> m_active;        //!< Links busy at some point of the interval
+  std::vector<Group> m_groups;
+  std::unordered_map<std::string, uint32_t> m_groupIndex;
+  std::vector<uint32_t> m_activeGroups;  //!< Groups with values in the interval
+
+  std::string m_linkFile;
+  std::string m_groupFile;
+  bool m_opened;
+  std::unique_ptr<ndn::TraceWriter> m_linkWriter;
+  std::unique_ptr<ndn::TraceWriter> m_groupWriter;
+  std::vector<uint64_t> m_groupNames;     //!< Interned in the group output, per group
+};
+
+} // namespace ns3
+
+#endif /* UTILIZATION_TRACKER_H */
@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include "ns3/constellation-partition-helper.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/gsl-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/satellite.h"
+#include "ns3/satellite-position-helper.h"
+#include "ns3/satellite-position-mobility-model.h"
+#include "ns3/simulator.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class ConstellationPartitionHelperTestCase : public TestCase {
+public:
+    ConstellationPartitionHelperTestCase () : TestCase ("constellation-partition-helper") {};
+
+    Vector Spherical(double radius_m, double lat, double lon) {
+        double phi = lat * M_PI / 180.0;
+        double lambda = lon * M_PI / 180.0;
+        return Vector(radius_m * std::cos(phi) * std::cos(lambda),
+                      radius_m * std::cos(phi) * std::sin(lambda),
+                      radius_m * std::sin(phi));
+    }
+
+    void DoRun () {
+
+        const double earth_radius_m = 6378135.0;
+        const double max_gsl_length_m = 1089686.4181956202;
+
+        // 5 orbits of 4 satellites over 3 systems: planes {0, 1}, {2, 3}, {4}
+        ConstellationPartitionHelper partitioner(5, 4, 3);
+        ASSERT_EQUAL(partitioner.GetNSystems(), 3);
+        std::vector<uint32_t> expected_system = {0, 0, 1, 1, 2};
+        for (uint32_t sid = 0; sid < 20; sid++) {
+            ASSERT_EQUAL(partitioner.GetSatelliteSystemId(sid), expected_system[sid / 4]);
+        }
+
+        // Satellite i of plane p above the equator at longitude 90 * i + 5 * p
+        NodeContainer satellites;
+        satellites.Create(20);
+        for (uint32_t sid = 0; sid < 20; sid++) {
+            Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+            mobility->SetPosition(Spherical(earth_radius_m + 550000.0, 0, 90.0 * (sid % 4) + 5.0 * (sid / 4)));
+            satellites.Get(sid)->AggregateObject(mobility);
+        }
+
+        // A ground station on the equator sees satellites up to 8.1 degrees of longitude away
+        std::vector<Vector> ground_stations = {
+                Spherical(earth_radius_m, 0, 0),     // sees planes 0 and 1 -> system 0
+                Spherical(earth_radius_m, 0, 12.5),  // sees planes 1, 2, 3 and 4 -> system 1
+                Spherical(earth_radius_m, 0, 19),    // sees planes 3 and 4 -> tie, lowest system 1
+                Spherical(earth_radius_m, 0, 25),    // sees plane 4 -> system 2
+                Spherical(earth_radius_m, 45, 110),  // sees none, closest is in plane 4 -> system 2
+        };
+        std::vector<uint32_t> assigned = partitioner.AssignGroundStations(satellites, ground_stations, max_gsl_length_m);
+        ASSERT_EQUAL(assigned.size(), 5);
+        ASSERT_EQUAL(assigned[0], 0);
+        ASSERT_EQUAL(assigned[1], 1);
+        ASSERT_EQUAL(assigned[2], 1);
+        ASSERT_EQUAL(assigned[3], 2);
+        ASSERT_EQUAL(assigned[4], 2);
+
+        // +Grid ISLs (no wrap-around between the first and last plane), one of them carrying
+        // most traffic across the boundary between system 0 and 1
+        for (uint32_t p = 0; p < 5; p++) {
+            for (uint32_t i = 0; i < 4; i++) {
+                partitioner.AddIsl(p * 4 + i, p * 4 + (i + 1) % 4);
+                if (p + 1 < 5) {
+                    partitioner.AddIsl(p * 4 + i, (p + 1) * 4 + i);
+                }
+            }
+        }
+        partitioner.AddIslTraffic(8, 4, 10);
+        ASSERT_EQUAL(partitioner.GetNIsls(), 36);
+        ASSERT_EQUAL(partitioner.GetNCrossSystemIsls(), 8);
+        ASSERT_EQUAL_APPROX(partitioner.GetCrossSystemTraffic(), 18, 1e-9);
+
+        // Satellites 4 and 8 gain from joining each other: 4 is visited first and moves to system 1
+        partitioner.PartitionMinCut(0.5);
+        for (uint32_t sid = 0; sid < 20; sid++) {
+            ASSERT_EQUAL(partitioner.GetSatelliteSystemId(sid), sid == 4 ? 1 : expected_system[sid / 4]);
+        }
+        ASSERT_EQUAL(partitioner.GetNCrossSystemIsls(), 10);
+        ASSERT_EQUAL_APPROX(partitioner.GetCrossSystemTraffic(), 10, 1e-9);
+
+        // The balance bound stops any move: systems 0 and 1 are full
+        ConstellationPartitionHelper balanced(5, 4, 3);
+        balanced.AddIsl(8, 4);
+        balanced.AddIslTraffic(8, 4, 10);
+        balanced.PartitionMinCut(0);
+        ASSERT_EQUAL(balanced.GetSatelliteSystemId(8), 1);
+
+        // Lookahead of static satellites: the closest ISL to another system, 5 degrees apart
+        double isl_delay_s = 2 * (earth_radius_m + 550000.0) * std::sin(2.5 * M_PI / 180.0) / 299792458.0;
+        std::vector<Time> lookahead = partitioner.GetLookahead(satellites, 299792458.0);
+        ASSERT_EQUAL(lookahead.size(), 3);
+        for (uint32_t system = 0; system < 3; system++) {
+            ASSERT_EQUAL_APPROX(lookahead[system].GetSeconds(), isl_delay_s, 1e-9);
+        }
+        ASSERT_EQUAL_APPROX(PointToPointLaserHelper::GetMinimumDelay(satellites.Get(0), satellites.Get(4), 299792458.0).GetSeconds(),
+                            isl_delay_s, 1e-9);
+
+        std::ostringstream report;
+        partitioner.PrintReport(report, satellites, 299792458.0);
+        ASSERT_TRUE(report.str().find("Cross-system ISLs: 10 of 36") != std::string::npos);
+        ASSERT_TRUE(report.str().find("Cross-system GSL pairs:") != std::string::npos);
+
+        // GSL lookahead of static satellites: their altitude above the highest ground station
+        NodeContainer gs_nodes;
+        gs_nodes.Create(2);
+        for (uint32_t gid = 0; gid < 2; gid++) {
+            Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+            mobility->SetPosition(Spherical(earth_radius_m + 1000.0 * gid, 45, 0));
+            gs_nodes.Get(gid)->AggregateObject(mobility);
+        }
+        Time min_delay = GSLHelper::GetMinimumDelay(satellites, gs_nodes, 299792458.0);
+        ASSERT_EQUAL_APPROX(min_delay.GetSeconds(), 549000.0 / 299792458.0, 1e-9);
+
+        // Orbiting satellite: the bound holds along its orbit
+        Ptr<Satellite> satellite = CreateObject<Satellite>();
+        satellite->SetName("Starlink-550");
+        satellite->SetTleInfo(
+                "1 00001U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    04",
+                "2 00001  53.0000   0.0000 0000001   0.0000   0.0000 15.19000000    08");
+        NodeContainer orbiting;
+        orbiting.Create(1);
+        Ptr<SatellitePositionMobilityModel> mobility = CreateObject<SatellitePositionMobilityModel>();
+        mobility->SetSatellite(satellite);
+        mobility->SetStartTime(satellite->GetTleEpoch());
+        orbiting.Get(0)->AggregateObject(mobility);
+        min_delay = GSLHelper::GetMinimumDelay(orbiting, gs_nodes, 299792458.0);
+        ASSERT_TRUE(min_delay > MilliSeconds(1));
+        Vector position, velocity;
+        for (int64_t t = 0; t < 6000; t += 10) {
+            mobility->GetPositionVelocity(Seconds(t), position, velocity);
+            double min_distance_m = position.GetLength() - (earth_radius_m + 1000.0);
+            ASSERT_TRUE(Seconds(min_distance_m / 299792458.0) > min_delay);
+        }
+
+        // Orbiting satellites in neighboring planes: the ISL lower bound holds at every
+        // second of two orbital periods, not only at its own samples
+        Ptr<Satellite> neighbor = CreateObject<Satellite>();
+        neighbor->SetName("Starlink-550");
+        neighbor->SetTleInfo(
+                "1 00023U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    08",
+                "2 00023  53.0000   5.0000 0000001   0.0000   8.1818 15.19000000    03");
+        orbiting.Create(1);
+        Ptr<SatellitePositionMobilityModel> neighbor_mobility = CreateObject<SatellitePositionMobilityModel>();
+        neighbor_mobility->SetSatellite(neighbor);
+        neighbor_mobility->SetStartTime(satellite->GetTleEpoch());
+        orbiting.Get(1)->AggregateObject(neighbor_mobility);
+        Time isl_min_delay = PointToPointLaserHelper::GetMinimumDelay(orbiting.Get(0), orbiting.Get(1), 299792458.0);
+        ASSERT_TRUE(isl_min_delay > MilliSeconds(1));
+        Time exact_min_delay = Time::Max();
+        Vector neighbor_position;
+        for (int64_t t = 0; t < 2 * satellite->GetOrbitalPeriod().GetSeconds(); t++) {
+            mobility->GetPositionVelocity(Seconds(t), position, velocity);
+            neighbor_mobility->GetPositionVelocity(Seconds(t), neighbor_position, velocity);
+            exact_min_delay = std::min(exact_min_delay, Seconds(CalculateDistance(position, neighbor_position) / 299792458.0));
+        }
+        ASSERT_TRUE(isl_min_delay <= exact_min_delay);
+        ASSERT_TRUE(isl_min_delay > exact_min_delay - MicroSeconds(200));
+
+        Simulator::Destroy();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
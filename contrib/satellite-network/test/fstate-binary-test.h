@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <fstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ns3/ptr.h"
+#include "ns3/fstate-binary.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class FstateBinaryTestCase : public TestCase {
+public:
+    FstateBinaryTestCase () : TestCase ("fstate-binary") {};
+
+    void DoRun () {
+
+        std::string dir = ".tmp-fstate-binary-test";
+        mkdir(dir.c_str(), 0777);
+
+        // Written out of order on purpose: epochs must be sorted by time
+        std::ofstream f1(dir + "/fstate_100000000.txt");
+        f1 << "3,5,-1,0,0" << std::endl;
+        f1.close();
+        std::ofstream f0(dir + "/fstate_0.txt");
+        f0 << "0,1584,21,2,1" << std::endl;
+        f0 << "1585,1,7,0,3" << std::endl;
+        f0.close();
+        std::ofstream ignored(dir + "/description.txt");
+        ignored << "not an fstate file" << std::endl;
+        ignored.close();
+
+        std::string path = dir + "/fstate.bin";
+        ASSERT_EQUAL(FstateBinaryFile::ConvertDirectory(dir, path), 2);
+        ASSERT_EQUAL(FstateBinaryFile::FindInDirectory(dir), path);
+        ASSERT_EQUAL(FstateBinaryFile::FindInDirectory(path), path);
+
+        {
+            Ptr<FstateBinaryFile> file = Create<FstateBinaryFile>(path);
+            ASSERT_EQUAL(file->GetNEpochs(), 2);
+
+            ASSERT_EQUAL(file->GetEpoch(0).timeNs, 0);
+            ASSERT_EQUAL(file->GetEpoch(0).numRecords, 2);
+            const FstateRecord* r0 = file->GetRecords(0);
+            ASSERT_EQUAL(r0[0].current, 0);
+            ASSERT_EQUAL(r0[0].destination, 1584);
+            ASSERT_EQUAL(r0[0].nextHop, 21);
+            ASSERT_EQUAL(r0[0].currentIf, 2);
+            ASSERT_EQUAL(r0[0].nextHopIf, 1);
+            ASSERT_EQUAL(r0[1].current, 1585);
+            ASSERT_EQUAL(r0[1].nextHopIf, 3);
+
+            ASSERT_EQUAL(file->GetEpoch(1).timeNs, 100000000);
+            ASSERT_EQUAL(file->GetEpoch(1).numRecords, 1);
+            ASSERT_EQUAL(file->GetRecords(1)[0].nextHop, -1);
+        }
+
+        unlink((dir + "/fstate_0.txt").c_str());
+        unlink((dir + "/fstate_100000000.txt").c_str());
+        unlink((dir + "/description.txt").c_str());
+        unlink(path.c_str());
+        rmdir(dir.c_str());
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
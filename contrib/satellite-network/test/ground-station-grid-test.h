@@ -0,0 +1,71 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "ns3/ground-station-grid.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class GroundStationGridTestCase : public TestCase {
+public:
+    GroundStationGridTestCase () : TestCase ("ground-station-grid") {};
+
+    void DoRun () {
+
+        const double earth_radius_m = 6378135.0;
+        const double max_gsl_length_m = 1089686.4181956202;
+
+        // Ground stations on a latitude/longitude grid on the surface
+        std::vector<Vector> ground_stations;
+        GroundStationGrid grid(max_gsl_length_m);
+        for (int lat = -80; lat <= 80; lat += 10) {
+            for (int lon = -180; lon < 180; lon += 10) {
+                double phi = lat * M_PI / 180.0;
+                double lambda = lon * M_PI / 180.0;
+                Vector position(earth_radius_m * std::cos(phi) * std::cos(lambda),
+                                earth_radius_m * std::cos(phi) * std::sin(lambda),
+                                earth_radius_m * std::sin(phi));
+                grid.Add(ground_stations.size(), position);
+                ground_stations.push_back(position);
+            }
+        }
+        ASSERT_EQUAL(grid.GetN(), ground_stations.size());
+
+        // Satellites at 550 km must see exactly the same ground stations as a full scan
+        std::vector<std::pair<uint32_t, double>> visible;
+        for (int lat = -85; lat <= 85; lat += 7) {
+            for (int lon = -180; lon < 180; lon += 13) {
+                double phi = lat * M_PI / 180.0;
+                double lambda = lon * M_PI / 180.0;
+                double r = earth_radius_m + 550000.0;
+                Vector satellite(r * std::cos(phi) * std::cos(lambda),
+                                 r * std::cos(phi) * std::sin(lambda),
+                                 r * std::sin(phi));
+
+                std::vector<std::pair<uint32_t, double>> expected;
+                for (uint32_t i = 0; i < ground_stations.size(); i++) {
+                    double distance = CalculateDistance(satellite, ground_stations[i]);
+                    if (distance <= max_gsl_length_m) {
+                        expected.push_back(std::make_pair(i, distance));
+                    }
+                }
+
+                grid.Query(satellite, max_gsl_length_m, visible);
+                std::sort(visible.begin(), visible.end());
+                ASSERT_TRUE(visible == expected);
+            }
+        }
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
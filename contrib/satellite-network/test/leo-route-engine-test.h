@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/gsl-helper.h"
+#include "ns3/leo-route-engine.h"
+#include "ns3/node-container.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/simulator.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class LeoRouteEngineTestCase : public TestCase {
+public:
+    LeoRouteEngineTestCase () : TestCase ("leo-route-engine") {};
+
+    void SetPosition(Ptr<Node> node, Vector position) {
+        node->GetObject<ConstantPositionMobilityModel>()->SetPosition(position);
+    }
+
+    void AddMobility(NodeContainer nodes) {
+        for (uint32_t i = 0; i < nodes.GetN(); i++) {
+            nodes.Get(i)->AggregateObject(CreateObject<ConstantPositionMobilityModel>());
+        }
+    }
+
+    void InstallGsls(NodeContainer satellites, NodeContainer ground_stations) {
+        std::vector<std::tuple<int32_t, double>> node_gsl_if_info;
+        for (uint32_t i = 0; i < satellites.GetN() + ground_stations.GetN(); i++) {
+            node_gsl_if_info.push_back(std::make_tuple(1, 1.0));
+        }
+        GSLHelper gsl_helper;
+        gsl_helper.Install(satellites, ground_stations, node_gsl_if_info);
+    }
+
+    // Applies the changes of an update to the next hops per (node, destination)
+    void Apply(std::map<std::pair<int32_t, int32_t>, int32_t>& state, const std::vector<FstateRecord>& changes) {
+        for (const FstateRecord& r : changes) {
+            state[std::make_pair(r.current, r.destination)] = r.nextHop;
+        }
+    }
+
+    void DoRun () {
+        DoRunLine();
+        DoRunConstellation();
+    }
+
+    // Four satellites in a line 500 km above two ground stations 3000 km apart
+    void DoRunLine() {
+        NodeContainer satellites;
+        satellites.Create(4);
+        NodeContainer ground_stations;
+        ground_stations.Create(2);
+        AddMobility(satellites);
+        AddMobility(ground_stations);
+        for (uint32_t sid = 0; sid < 4; sid++) {
+            SetPosition(satellites.Get(sid), Vector(1000000.0 * sid, 0, 500000));
+        }
+        SetPosition(ground_stations.Get(0), Vector(0, 0, 0));
+        SetPosition(ground_stations.Get(1), Vector(3000000, 0, 0));
+        PointToPointLaserHelper p2p_laser_helper;
+        for (uint32_t sid = 0; sid < 3; sid++) {
+            p2p_laser_helper.Install(satellites.Get(sid), satellites.Get(sid + 1));
+        }
+        InstallGsls(satellites, ground_stations);
+
+        Ptr<LeoRouteEngine> engine = Create<LeoRouteEngine>(satellites, ground_stations, 600000);
+
+        // First update: every (node, destination) pair
+        std::vector<FstateRecord> changes = engine->Update();
+        ASSERT_EQUAL(changes.size(), 10);
+        std::map<std::pair<int32_t, int32_t>, FstateRecord> records;
+        for (const FstateRecord& r : changes) {
+            records[std::make_pair(r.current, r.destination)] = r;
+        }
+
+        // Satellite 0 hands over to ground station 0 (node 4) over its GSL (device 1)
+        FstateRecord r = records[std::make_pair(0, 4)];
+        ASSERT_EQUAL(r.nextHop, 4);
+        ASSERT_EQUAL(r.currentIf, 1);
+        ASSERT_EQUAL(r.nextHopIf, 0);
+
+        // Satellite 1 forwards to satellite 0 (its ISL device 0, device 0 of satellite 0)
+        r = records[std::make_pair(1, 4)];
+        ASSERT_EQUAL(r.nextHop, 0);
+        ASSERT_EQUAL(r.currentIf, 0);
+        ASSERT_EQUAL(r.nextHopIf, 0);
+
+        // Satellite 1 forwards to satellite 2 (its ISL device 1, device 0 of satellite 2)
+        r = records[std::make_pair(1, 5)];
+        ASSERT_EQUAL(r.nextHop, 2);
+        ASSERT_EQUAL(r.currentIf, 1);
+        ASSERT_EQUAL(r.nextHopIf, 0);
+
+        // Ground station 0 uplinks to satellite 0 (its GSL device 1)
+        r = records[std::make_pair(4, 5)];
+        ASSERT_EQUAL(r.nextHop, 0);
+        ASSERT_EQUAL(r.currentIf, 0);
+        ASSERT_EQUAL(r.nextHopIf, 1);
+        ASSERT_EQUAL_APPROX(engine->GetDistance(4, 1), 4000000.0, 1e-3);
+        ASSERT_EQUAL_APPROX(engine->GetDistance(1, 1), 2500000.0, 1e-3);
+
+        // Nothing moved: no changes
+        ASSERT_EQUAL(engine->Update().size(), 0);
+
+        // Satellite 3 leaves ground station 1: all routes toward and from it are lost
+        SetPosition(satellites.Get(3), Vector(3000000, 0, 700000));
+        changes = engine->Update();
+        ASSERT_EQUAL(changes.size(), 6);
+        for (const FstateRecord& c : changes) {
+            ASSERT_TRUE(c.destination == 5 || c.current == 5);
+            ASSERT_EQUAL(c.nextHop, -1);
+            ASSERT_EQUAL(c.currentIf, -1);
+        }
+        ASSERT_TRUE(std::isinf(engine->GetDistance(0, 1)));
+        ASSERT_TRUE(std::isinf(engine->GetDistance(5, 0)));
+
+        // ... and comes back
+        SetPosition(satellites.Get(3), Vector(3000000, 0, 500000));
+        changes = engine->Update();
+        ASSERT_EQUAL(changes.size(), 6);
+        ASSERT_EQUAL_APPROX(engine->GetDistance(4, 1), 4000000.0, 1e-3);
+
+        Simulator::Destroy();
+    }
+
+    // Incremental updates give the same forwarding state as full recomputations
+    void DoRunConstellation() {
+        const double earth_radius_m = 6378135.0;
+        const double orbit_radius_m = earth_radius_m + 550000.0;
+        const uint32_t num_orbits = 6;
+        const uint32_t satellites_per_orbit = 10;
+        const uint32_t num_satellites = num_orbits * satellites_per_orbit;
+
+        NodeContainer satellites;
+        satellites.Create(num_satellites);
+        NodeContainer ground_stations;
+        ground_stations.Create(8);
+        AddMobility(satellites);
+        AddMobility(ground_stations);
+        for (uint32_t gid = 0; gid < 8; gid++) {
+            double lat = (-50.0 + 14.0 * gid) * M_PI / 180.0;
+            double lon = (37.0 * gid) * M_PI / 180.0;
+            SetPosition(ground_stations.Get(gid), Vector(earth_radius_m * std::cos(lat) * std::cos(lon),
+                                                         earth_radius_m * std::cos(lat) * std::sin(lon),
+                                                         earth_radius_m * std::sin(lat)));
+        }
+
+        // +Grid ISLs
+        PointToPointLaserHelper p2p_laser_helper;
+        for (uint32_t orbit = 0; orbit < num_orbits; orbit++) {
+            for (uint32_t i = 0; i < satellites_per_orbit; i++) {
+                uint32_t sid = orbit * satellites_per_orbit + i;
+                p2p_laser_helper.Install(satellites.Get(sid), satellites.Get(orbit * satellites_per_orbit + (i + 1) % satellites_per_orbit));
+                p2p_laser_helper.Install(satellites.Get(sid), satellites.Get(((orbit + 1) % num_orbits) * satellites_per_orbit + i));
+            }
+        }
+        InstallGsls(satellites, ground_stations);
+        NodeContainer all(satellites, ground_stations);
+
+        Ptr<LeoRouteEngine> incremental = Create<LeoRouteEngine>(satellites, ground_stations, 2000000);
+        Ptr<LeoRouteEngine> full = Create<LeoRouteEngine>(satellites, ground_stations, 2000000);
+        full->SetIncremental(false);
+        Ptr<LeoRouteEngine> threaded = Create<LeoRouteEngine>(satellites, ground_stations, 2000000);
+        threaded->SetNThreads(3);
+        ASSERT_EQUAL(threaded->GetNThreads(), 3);
+        std::map<std::pair<int32_t, int32_t>, int32_t> incremental_state;
+        std::map<std::pair<int32_t, int32_t>, int32_t> full_state;
+        std::map<std::pair<int32_t, int32_t>, int32_t> threaded_state;
+
+        // Circular orbits at 53 degrees, one update every 20 s for 20 minutes
+        const double inclination = 53.0 * M_PI / 180.0;
+        const double angular_speed = 2 * M_PI / 5730.0;
+        uint64_t changed = 0;
+        for (uint32_t epoch = 0; epoch < 60; epoch++) {
+            for (uint32_t sid = 0; sid < num_satellites; sid++) {
+                double raan = 2 * M_PI * (sid / satellites_per_orbit) / num_orbits;
+                double u = 2 * M_PI * (sid % satellites_per_orbit) / satellites_per_orbit
+                           + M_PI / satellites_per_orbit * (sid / satellites_per_orbit) + angular_speed * 20.0 * epoch;
+                double x = std::cos(u), y = std::sin(u) * std::cos(inclination), z = std::sin(u) * std::sin(inclination);
+                SetPosition(satellites.Get(sid), Vector(orbit_radius_m * (x * std::cos(raan) - y * std::sin(raan)),
+                                                        orbit_radius_m * (x * std::sin(raan) + y * std::cos(raan)),
+                                                        orbit_radius_m * z));
+            }
+            Apply(incremental_state, incremental->Update());
+            Apply(threaded_state, threaded->Update());
+            const std::vector<FstateRecord>& full_changes = full->Update();
+            if (epoch > 0) {
+                changed += full_changes.size();
+            }
+            Apply(full_state, full_changes);
+
+            for (uint32_t node = 0; node < num_satellites + 8; node++) {
+                for (uint32_t gid = 0; gid < 8; gid++) {
+                    double expected = full->GetDistance(node, gid);
+                    double actual = incremental->GetDistance(node, gid);
+                    if (std::isinf(expected)) {
+                        ASSERT_TRUE(std::isinf(actual));
+                    } else {
+                        ASSERT_EQUAL_APPROX(actual, expected, 1e-3);
+                    }
+                }
+            }
+
+            // The threads make the same choices
+            ASSERT_TRUE(threaded_state == incremental_state);
+
+            // Equally short paths may be chosen differently, but every next hop is on a shortest path
+            ASSERT_EQUAL(incremental_state.size(), full_state.size());
+            for (const auto& entry : incremental_state) {
+                int32_t node = entry.first.first;
+                uint32_t gid = entry.first.second - num_satellites;
+                int32_t next_hop = entry.second;
+                if (next_hop < 0) {
+                    ASSERT_EQUAL(full_state[entry.first], -1);
+                } else if (next_hop != full_state[entry.first]) {
+                    double hop = CalculateDistance(all.Get(node)->GetObject<MobilityModel>()->GetPosition(),
+                                                   all.Get(next_hop)->GetObject<MobilityModel>()->GetPosition());
+                    ASSERT_EQUAL_APPROX(hop + full->GetDistance(next_hop, gid), full->GetDistance(node, gid), 1e-3);
+                }
+            }
+        }
+
+        // The state did change over time, and the trees were only partially settled again
+        ASSERT_TRUE(changed > 0);
+        ASSERT_TRUE(incremental->GetNSettled() < full->GetNSettled() / 2);
+        ASSERT_EQUAL(threaded->GetNSettled(), incremental->GetNSettled());
+
+        Simulator::Destroy();
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <tuple>
+#include <vector>
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/gsl-helper.h"
+#include "ns3/ndn-leo-face-table.h"
+#include "ns3/ndn-leo-stack-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/ndn-net-device-transport.hpp"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class LeoFaceTableTestCase : public TestCase {
+public:
+    LeoFaceTableTestCase () : TestCase ("ndn-leo-face-table") {};
+
+    void DoRun () {
+
+        // Two satellites with an ISL, one ground station
+        NodeContainer satellites;
+        satellites.Create(2);
+        NodeContainer ground_stations;
+        ground_stations.Create(1);
+        NodeContainer nodes(satellites, ground_stations);
+        for (uint32_t i = 0; i < nodes.GetN(); i++) {
+            Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+            mobility->SetPosition(Vector(7000000, 1000000.0 * i, 0));
+            nodes.Get(i)->AggregateObject(mobility);
+        }
+        PointToPointLaserHelper p2p_laser_helper;
+        p2p_laser_helper.Install(satellites.Get(0), satellites.Get(1));
+        std::vector<std::tuple<int32_t, double>> gsl_if_info(nodes.GetN(), std::make_tuple(1, 1.0));
+        GSLHelper gsl_helper;
+        gsl_helper.Install(satellites, ground_stations, gsl_if_info);
+        ndn::LeoStackHelper ndn_helper;
+        ndn_helper.Install(nodes);
+
+        Ptr<ndn::LeoFaceTable> table = Create<ndn::LeoFaceTable>(nodes);
+        for (uint32_t i = 0; i < nodes.GetN(); i++) {
+            Ptr<Node> node = nodes.Get(i);
+            Ptr<ndn::L3Protocol> ndn = node->GetObject<ndn::L3Protocol>();
+            ASSERT_EQUAL(table->GetNDevices(i), node->GetNDevices());
+            for (uint32_t device_id = 0; device_id < node->GetNDevices(); device_id++) {
+                // Same face as the lookup by NetDevice
+                ASSERT_TRUE(table->GetFace(i, device_id) == ndn->getFaceByNetDevice(node->GetDevice(device_id)).get());
+                ASSERT_TRUE(table->GetTransport(i, device_id)->GetNetDevice() == node->GetDevice(device_id));
+            }
+        }
+
+        // The GSL comes after the ISL on the satellites, it is the only device of the ground station
+        ASSERT_EQUAL(table->GetGslDeviceId(0), 1);
+        ASSERT_EQUAL(table->GetGslDeviceId(1), 1);
+        ASSERT_EQUAL(table->GetGslDeviceId(2), 0);
+
+        table = 0;
+        Simulator::Destroy();
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <utility>
+#include <vector>
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/ndn-leo-fib-table.h"
+#include "ns3/ndn-leo-stack-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class LeoFibTableTestCase : public TestCase {
+public:
+    // In place (L3Protocol::updateFib) or through FIB manager commands
+    LeoFibTableTestCase (bool in_place) : TestCase (in_place ? "ndn-leo-fib-table" : "ndn-leo-fib-table-commands"),
+                                          m_in_place(in_place) {};
+
+    // Next hops (face id, cost) of a node toward a prefix
+    std::vector<std::pair<uint32_t, uint64_t>> GetNextHops(Ptr<Node> node, const ndn::Name& prefix) {
+        std::vector<std::pair<uint32_t, uint64_t>> next_hops;
+        auto& fib = node->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+        for (auto it = fib.begin(); it != fib.end(); it++) {
+            if (it->getPrefix() == prefix) {
+                for (const auto& next_hop : it->getNextHops()) {
+                    next_hops.push_back(std::make_pair(next_hop.getFace().getId(), next_hop.getCost()));
+                }
+            }
+        }
+        return next_hops;
+    }
+
+    uint32_t GetFaceId(Ptr<Node> node, uint32_t device_id) {
+        return node->GetObject<ndn::L3Protocol>()->getFaceByNetDevice(node->GetDevice(device_id))->getId();
+    }
+
+    void CheckFirstEpoch(NodeContainer nodes) {
+        std::vector<std::pair<uint32_t, uint64_t>> next_hops = GetNextHops(nodes.Get(0), m_table->GetPrefix(2));
+        ASSERT_EQUAL(next_hops.size(), 1);
+        ASSERT_EQUAL(next_hops[0].first, GetFaceId(nodes.Get(0), 0));
+        ASSERT_EQUAL(next_hops[0].second, 1000000);
+        ASSERT_EQUAL(GetNextHops(nodes.Get(1), m_table->GetPrefix(2)).size(), 1);
+        ASSERT_EQUAL(m_table->GetDeviceId(0, 2), 0);
+        ASSERT_EQUAL(m_table->GetDeviceId(1, 2), 0);
+        ASSERT_EQUAL(m_table->GetDeviceId(2, 0), -1);
+    }
+
+    void CheckSecondEpoch(NodeContainer nodes) {
+        // The route over node 1 is replaced by the direct one
+        std::vector<std::pair<uint32_t, uint64_t>> next_hops = GetNextHops(nodes.Get(0), m_table->GetPrefix(2));
+        ASSERT_EQUAL(next_hops.size(), 1);
+        ASSERT_EQUAL(next_hops[0].first, GetFaceId(nodes.Get(0), 1));
+        ASSERT_EQUAL(next_hops[0].second, 2000000);
+        ASSERT_EQUAL(m_table->GetDeviceId(0, 2), 1);
+    }
+
+    void CheckThirdEpoch(NodeContainer nodes) {
+        // Node 2 became unreachable from node 0
+        ASSERT_EQUAL(GetNextHops(nodes.Get(0), m_table->GetPrefix(2)).size(), 0);
+        ASSERT_EQUAL(m_table->GetDeviceId(0, 2), -1);
+        ASSERT_EQUAL(m_table->GetDeviceId(1, 2), 0);
+    }
+
+    void DoRun () {
+
+        // Node 0 with an ISL to node 1 (1000 km) and one to node 2 (2000 km)
+        NodeContainer nodes;
+        nodes.Create(3);
+        std::vector<Vector> positions = {Vector(7000000, 0, 0), Vector(7000000, 1000000, 0), Vector(7000000, 0, 2000000)};
+        for (uint32_t i = 0; i < 3; i++) {
+            Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+            mobility->SetPosition(positions[i]);
+            nodes.Get(i)->AggregateObject(mobility);
+        }
+        PointToPointLaserHelper p2p_laser_helper;
+        p2p_laser_helper.Install(nodes.Get(0), nodes.Get(1));
+        p2p_laser_helper.Install(nodes.Get(0), nodes.Get(2));
+        ndn::LeoStackHelper ndn_helper;
+        ndn_helper.Install(nodes);
+
+        m_table = Create<ndn::LeoFibTable>(nodes, Create<ndn::LeoFaceTable>(nodes), true);
+        m_table->SetInPlace(m_in_place);
+        ASSERT_TRUE(m_table->GetPrefix(2) == ndn::Name("/leo/uid-2"));
+
+        // First epoch: node 0 reaches node 2 over node 1
+        Ptr<ndn::LeoFibTable::Batch> first = Create<ndn::LeoFibTable::Batch>();
+        first->Add(0, 2, 1, 0);
+        first->Add(1, 2, 0, 0);
+        ASSERT_EQUAL(first->GetN(), 2);
+        m_table->Schedule(first, Seconds(1));
+        Simulator::Schedule(Seconds(1.5), &LeoFibTableTestCase::CheckFirstEpoch, this, nodes);
+
+        // Second epoch: directly
+        Ptr<ndn::LeoFibTable::Batch> second = Create<ndn::LeoFibTable::Batch>();
+        second->Add(0, 2, 2, 1);
+        m_table->Schedule(second, Seconds(2));
+        Simulator::Schedule(Seconds(2.5), &LeoFibTableTestCase::CheckSecondEpoch, this, nodes);
+
+        // Third epoch: unreachable
+        Ptr<ndn::LeoFibTable::Batch> third = Create<ndn::LeoFibTable::Batch>();
+        third->Remove(0, 2);
+        m_table->Schedule(third, Seconds(3));
+        Simulator::Schedule(Seconds(3.5), &LeoFibTableTestCase::CheckThirdEpoch, this, nodes);
+
+        Simulator::Stop(Seconds(4));
+        Simulator::Run();
+        m_table = 0;
+        Simulator::Destroy();
+
+    }
+
+private:
+    bool m_in_place;
+    Ptr<ndn::LeoFibTable> m_table;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/ndn-leo-stack-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class LeoStackHelperHeadlessTestCase : public TestCase {
+public:
+    LeoStackHelperHeadlessTestCase () : TestCase ("ndn-leo-stack-helper-headless") {};
+
+    void DoRun () {
+
+        NodeContainer nodes;
+        nodes.Create(2);
+        PointToPointLaserHelper p2p_laser_helper;
+        p2p_laser_helper.Install(nodes.Get(0), nodes.Get(1));
+        ndn::LeoStackHelper ndn_helper;
+        ndn_helper.setCsSize(10);
+        ndn_helper.setHeadless(true);
+        ndn_helper.Install(nodes);
+
+        // Only the face of the ISL, no management
+        Ptr<ndn::L3Protocol> ndn = nodes.Get(0)->GetObject<ndn::L3Protocol>();
+        ASSERT_TRUE(ndn->isHeadless());
+        ASSERT_TRUE(ndn->getFibManager() == nullptr);
+        ASSERT_EQUAL(ndn->getFaceTable().size(), 1);
+        ASSERT_EQUAL(ndn->getForwarder()->getCs().getLimit(), 10);
+        ASSERT_TRUE(ndn->getForwarder()->getFib().findExactMatch("/localhost/nfd") == nullptr);
+
+        // Routes and strategies are set without command Interests
+        std::shared_ptr<ndn::Face> face = ndn->getFaceByNetDevice(nodes.Get(0)->GetDevice(0));
+        ndn::FibHelper::AddRoute(nodes.Get(0), "/leo/uid-1", face, 5);
+        nfd::fib::Entry* entry = ndn->getForwarder()->getFib().findExactMatch("/leo/uid-1");
+        ASSERT_TRUE(entry != nullptr);
+        ASSERT_EQUAL(entry->getNextHops().size(), 1);
+        ASSERT_EQUAL(entry->getNextHops()[0].getCost(), 5);
+
+        ndn::StrategyChoiceHelper::Install(nodes.Get(0), "/leo", "/localhost/nfd/strategy/multicast");
+        ndn::Name strategy = ndn->getForwarder()->getStrategyChoice().findEffectiveStrategy("/leo/uid-1").getInstanceName();
+        ASSERT_TRUE(ndn::Name("/localhost/nfd/strategy/multicast").isPrefixOf(strategy));
+
+        ndn::FibHelper::RemoveRoute(nodes.Get(0), "/leo/uid-1", face);
+        ASSERT_TRUE(ndn->getForwarder()->getFib().findExactMatch("/leo/uid-1") == nullptr);
+
+        Simulator::Destroy();
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ns3/nack-retx-strategy.h"
+#include "ns3/ndn-leo-stack-helper.h"
+#include "ns3/ndn-pit-retransmit-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class PitRetransmitHelperTestCase : public TestCase {
+public:
+    PitRetransmitHelperTestCase () : TestCase ("ndn-pit-retransmit-helper") {};
+
+    void OutInterest(const ndn::Interest& interest, const ndn::Face& face) {
+        m_out_interests.push_back(std::make_pair(face.getId(), interest.getName().toUri()));
+    }
+
+    void OutNack(const ndn::lp::Nack& nack, const ndn::Face& face) {
+        m_out_nacks.push_back(std::make_pair(face.getId(), nack.getInterest().getName().toUri()));
+    }
+
+    // Pending Interest received over a face
+    std::shared_ptr<nfd::pit::Entry> AddPending(nfd::Forwarder& forwarder, const std::string& name, ndn::Face& face) {
+        ndn::Interest interest(name);
+        interest.setCanBePrefix(false);
+        std::shared_ptr<nfd::pit::Entry> entry = forwarder.getPit().insert(interest).first;
+        entry->insertOrUpdateInRecord(face, interest);
+        return entry;
+    }
+
+    // Faces of the out records of an entry
+    std::set<nfd::FaceId> GetOutFaces(const std::shared_ptr<nfd::pit::Entry>& entry) {
+        std::set<nfd::FaceId> faces;
+        for (const nfd::pit::OutRecord& record : entry->getOutRecords()) {
+            faces.insert(record.getFace().getId());
+        }
+        return faces;
+    }
+
+    void DoRun () {
+
+        // Node 0 with an ISL to each of nodes 1, 2 and 3
+        NodeContainer nodes;
+        nodes.Create(4);
+        PointToPointLaserHelper p2p_laser_helper;
+        for (uint32_t i = 1; i < 4; i++) {
+            p2p_laser_helper.Install(nodes.Get(0), nodes.Get(i));
+        }
+        ndn::LeoStackHelper ndn_helper;
+        ndn_helper.setHeadless(true);
+        ndn_helper.Install(nodes);
+
+        Ptr<Node> node = nodes.Get(0);
+        Ptr<ndn::L3Protocol> ndn = node->GetObject<ndn::L3Protocol>();
+        nfd::Forwarder& forwarder = *ndn->getForwarder();
+        std::shared_ptr<ndn::Face> face1 = ndn->getFaceByNetDevice(node->GetDevice(0));
+        std::shared_ptr<ndn::Face> face2 = ndn->getFaceByNetDevice(node->GetDevice(1));
+        std::shared_ptr<ndn::Face> face3 = ndn->getFaceByNetDevice(node->GetDevice(2));
+        ASSERT_TRUE(face1->getId() < face2->getId());
+        ndn->TraceConnectWithoutContext("OutInterests", MakeCallback(&PitRetransmitHelperTestCase::OutInterest, this));
+        ndn->TraceConnectWithoutContext("OutNack", MakeCallback(&PitRetransmitHelperTestCase::OutNack, this));
+
+        // /leo/uid-1 over nodes 1 and 2 (node 1 first), /leo/uid-10 over node 1, /leo/uid-3 back over node 1
+        ndn::FibHelper::AddRoute(node, "/leo/uid-1", face1, 1);
+        ndn::FibHelper::AddRoute(node, "/leo/uid-1", face2, 2);
+        ndn::FibHelper::AddRoute(node, "/leo/uid-10", face1, 1);
+        ndn::FibHelper::AddRoute(node, "/leo/uid-3", face1, 1);
+        ndn::StrategyChoiceHelper::Install(node, "/", "/localhost/nfd/strategy/nack-retx");
+
+        // Interests from node 3 pending under /leo/uid-1 and /leo/uid-10, one from node 1 under /leo/uid-3
+        std::vector<std::string> names = {"/leo/uid-1/a", "/leo/uid-1/b", "/leo/uid-1/c/d"};
+        std::vector<std::shared_ptr<nfd::pit::Entry>> entries;
+        for (const std::string& name : names) {
+            entries.push_back(AddPending(forwarder, name, *face3));
+            entries.back()->insertOrUpdateOutRecord(*face3, entries.back()->getInterest());
+        }
+        std::shared_ptr<nfd::pit::Entry> other = AddPending(forwarder, "/leo/uid-10/a", *face3);
+        other->insertOrUpdateOutRecord(*face1, other->getInterest());
+        std::shared_ptr<nfd::pit::Entry> back = AddPending(forwarder, "/leo/uid-3/a", *face1);
+
+        // Retransmit: out records replaced by the next hops, sends grouped per face
+        ASSERT_EQUAL(ndn::PitRetransmitHelper::Retransmit(node, "/leo/uid-1"), 6);
+        ASSERT_EQUAL(m_out_interests.size(), 6);
+        std::vector<std::string> order;
+        for (size_t i = 0; i < 3; i++) {
+            ASSERT_EQUAL(m_out_interests[i].first, face1->getId());
+            ASSERT_EQUAL(m_out_interests[i + 3].first, face2->getId());
+            // The same order of the entries on both faces
+            ASSERT_EQUAL(m_out_interests[i].second, m_out_interests[i + 3].second);
+            order.push_back(m_out_interests[i].second);
+        }
+        ASSERT_TRUE(std::set<std::string>(order.begin(), order.end()) == std::set<std::string>(names.begin(), names.end()));
+        for (const std::shared_ptr<nfd::pit::Entry>& entry : entries) {
+            ASSERT_TRUE(GetOutFaces(entry) == std::set<nfd::FaceId>({face1->getId(), face2->getId()}));
+        }
+
+        // /leo/uid-10 is not under /leo/uid-1
+        ASSERT_TRUE(GetOutFaces(other) == std::set<nfd::FaceId>({face1->getId()}));
+        ASSERT_EQUAL(ndn::PitRetransmitHelper::Retransmit(node, "/leo/uid-4"), 0);
+
+        // SendNackOrForward with the installed strategy: forwarded over the next hop other than the ingress face
+        for (const std::shared_ptr<nfd::pit::Entry>& entry : entries) {
+            nfd::fw::Strategy& strategy = forwarder.getStrategyChoice().findEffectiveStrategy(*entry);
+            ASSERT_TRUE(dynamic_cast<nfd::fw::NackRetxStrategy*>(&strategy) != nullptr);
+        }
+        m_out_interests.clear();
+        ASSERT_EQUAL(ndn::PitRetransmitHelper::SendNackOrForward(node, nfd::FaceEndpoint(*face1, 0), "/leo/uid-1"), 3);
+        ASSERT_EQUAL(m_out_interests.size(), 3);
+        for (const auto& out : m_out_interests) {
+            ASSERT_EQUAL(out.first, face2->getId());
+        }
+        ASSERT_EQUAL(m_out_nacks.size(), 0);
+
+        // No next hop other than the ingress face: nacked back
+        ASSERT_EQUAL(ndn::PitRetransmitHelper::SendNackOrForward(node, nfd::FaceEndpoint(*face1, 0), "/leo/uid-3"), 1);
+        ASSERT_EQUAL(m_out_nacks.size(), 1);
+        ASSERT_EQUAL(m_out_nacks[0].first, face1->getId());
+        ASSERT_EQUAL(m_out_nacks[0].second, "/leo/uid-3/a");
+        ASSERT_EQUAL(m_out_interests.size(), 3);
+        ASSERT_FALSE(back->hasInRecords());
+
+        // /leo/uid-10 is still left alone
+        ASSERT_TRUE(GetOutFaces(other) == std::set<nfd::FaceId>({face1->getId()}));
+
+        Simulator::Destroy();
+
+    }
+
+private:
+    std::vector<std::pair<nfd::FaceId, std::string>> m_out_interests;
+    std::vector<std::pair<nfd::FaceId, std::string>> m_out_nacks;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
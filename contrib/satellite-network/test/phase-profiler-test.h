@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/ndn-leo-stack-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/phase-profiler.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/simulator.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class PhaseProfilerTestCase : public TestCase {
+public:
+    PhaseProfilerTestCase () : TestCase ("phase-profiler") {};
+
+    void DoRun () {
+        std::string file = ".tmp-phase-profile.csv";
+
+        // Started before the first node, as the scenario does
+        Ptr<PhaseProfiler> profiler = Create<PhaseProfiler>(file);
+        profiler->StartSampling(Seconds(1));
+
+        // Two satellites with an ISL and NDN stacks
+        NodeContainer nodes;
+        nodes.Create(2);
+        for (uint32_t i = 0; i < 2; i++) {
+            Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+            mobility->SetPosition(Vector(7000000, 1000000.0 * i, 0));
+            nodes.Get(i)->AggregateObject(mobility);
+        }
+        PointToPointLaserHelper p2p_laser_helper;
+        p2p_laser_helper.Install(nodes.Get(0), nodes.Get(1));
+        const PhaseProfiler::Record& isls = profiler->EndPhase("isls");
+        ASSERT_EQUAL(isls.kind, "phase");
+        ASSERT_EQUAL(isls.nodes, 2);
+        ASSERT_EQUAL(isls.devices, 2);
+        ASSERT_EQUAL(isls.faces, 0);
+        ASSERT_TRUE(isls.pendingEvents >= 1);  // At least the first sample
+        ASSERT_TRUE(isls.wallS >= 0 && isls.wallTotalS >= isls.wallS);
+
+        ndn::LeoStackHelper ndn_helper;
+        ndn_helper.Install(nodes);
+        const PhaseProfiler::Record& stacks = profiler->EndPhase("stacks");
+        ASSERT_TRUE(stacks.faces >= 2);  // At least one per ISL device
+        ASSERT_EQUAL(stacks.pitEntries, 0);
+
+        // One record per simulated second, the last one when the simulation is destroyed
+        Simulator::Stop(Seconds(2.5));
+        Simulator::Run();
+        Simulator::Destroy();
+        std::vector<PhaseProfiler::Record> records = profiler->GetRecords();
+        ASSERT_EQUAL(records.size(), 5);
+        ASSERT_EQUAL(records[2].kind, "run");
+        ASSERT_EQUAL(records[2].name, "interval");
+        ASSERT_EQUAL(records[2].simTimeS, 1);
+        ASSERT_EQUAL(records[3].simTimeS, 2);
+        ASSERT_EQUAL(records[4].name, "end");
+        ASSERT_EQUAL(records[4].simTimeS, 2.5);
+        ASSERT_EQUAL(records[4].nodes, 2);
+        ASSERT_TRUE(records[4].executedEvents >= 2);
+
+        // Written as it was recorded
+        std::vector<PhaseProfiler::Record> report = PhaseProfiler::ReadReport(file);
+        ASSERT_EQUAL(report.size(), records.size());
+        for (uint32_t i = 0; i < report.size(); i++) {
+            ASSERT_EQUAL(report[i].kind, records[i].kind);
+            ASSERT_EQUAL(report[i].name, records[i].name);
+            ASSERT_EQUAL(report[i].devices, records[i].devices);
+            ASSERT_EQUAL(report[i].faces, records[i].faces);
+            ASSERT_EQUAL(report[i].executedEvents, records[i].executedEvents);
+        }
+        ASSERT_EQUAL(report[1].name, "stacks");
+        remove(file.c_str());
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <cmath>
+#include <vector>
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/propagation-delay-table.h"
+#include "ns3/satellite.h"
+#include "ns3/satellite-position-helper.h"
+#include "ns3/satellite-position-mobility-model.h"
+#include "ns3/simulator.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class PropagationDelayTableTestCase : public TestCase {
+public:
+    PropagationDelayTableTestCase () : TestCase ("propagation-delay-table") {};
+
+    Ptr<MobilityModel> CreateSatelliteMobility(std::string tle1, std::string tle2) {
+        Ptr<Satellite> satellite = CreateObject<Satellite>();
+        satellite->SetName("Starlink-550");
+        satellite->SetTleInfo(tle1, tle2);
+        Ptr<SatellitePositionMobilityModel> mobility = CreateObject<SatellitePositionMobilityModel>();
+        mobility->SetSatellite(satellite);
+        mobility->SetStartTime(satellite->GetTleEpoch());
+        return mobility;
+    }
+
+    void Query(PropagationDelayTable* table, Ptr<MobilityModel> a, Ptr<MobilityModel> b) {
+        Time delay = table->GetDelay(a, b);
+        Time exact = Seconds(a->GetDistanceFrom(b) / 299792458.0);
+        m_max_deviation_ns = std::max(m_max_deviation_ns, std::abs((delay - exact).GetNanoSeconds()));
+    }
+
+    void Run(PropagationDelayTable* table, const std::vector<std::pair<Ptr<MobilityModel>, Ptr<MobilityModel>>>& links) {
+        m_max_deviation_ns = 0;
+        for (int64_t t = 0; t < 30000; t += 7) {
+            for (const auto& link : links) {
+                Simulator::Schedule(MilliSeconds(t), &PropagationDelayTableTestCase::Query, this, table, link.first, link.second);
+            }
+        }
+        Simulator::Run();
+        Simulator::Destroy();
+    }
+
+    void DoRun () {
+
+        // Same plane neighbor, neighbor in the next plane and a ground station
+        Ptr<MobilityModel> sat0 = CreateSatelliteMobility(
+                "1 00001U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    04",
+                "2 00001  53.0000   0.0000 0000001   0.0000   0.0000 15.19000000    08");
+        Ptr<MobilityModel> sat1 = CreateSatelliteMobility(
+                "1 00002U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    05",
+                "2 00002  53.0000   0.0000 0000001   0.0000  16.3636 15.19000000    04");
+        Ptr<MobilityModel> sat22 = CreateSatelliteMobility(
+                "1 00023U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    08",
+                "2 00023  53.0000   5.0000 0000001   0.0000   8.1818 15.19000000    03");
+        Ptr<MobilityModel> gs = CreateObject<ConstantPositionMobilityModel>();
+        gs->SetPosition(Vector(6378135.0, 0, 0));
+
+        std::vector<std::pair<Ptr<MobilityModel>, Ptr<MobilityModel>>> links = {{sat0, sat1}, {sat22, sat0}, {gs, sat0}};
+
+        // Query every link every 7 ms for 30 seconds (crossing many sampling intervals)
+        PropagationDelayTable table(MilliSeconds(100), NanoSeconds(1), true, 299792458.0);
+        Run(&table, links);
+
+        // Within the error bound (plus rounding to the nanosecond)
+        ASSERT_EQUAL(table.GetNValidated(), 3 * ((30000 + 6) / 7));
+        ASSERT_TRUE(table.GetMaxError() <= NanoSeconds(1));
+        ASSERT_TRUE(m_max_deviation_ns <= 2);
+        ASSERT_TRUE(PropagationDelayTable::GetGlobalMaxError() >= table.GetMaxError());
+
+        // A grid too coarse for the error bound (about 2 ns off for the ground station
+        // link in 2 minute intervals): the intervals failing the checks are computed exactly
+        // (and not validated), so the bound still holds
+        PropagationDelayTable coarse(Seconds(120), NanoSeconds(1), true, 299792458.0);
+        Run(&coarse, links);
+        ASSERT_TRUE(coarse.GetNValidated() > 0);
+        ASSERT_TRUE(coarse.GetNValidated() < 3 * ((30000 + 6) / 7));
+        ASSERT_TRUE(coarse.GetMaxError() <= NanoSeconds(1));
+        ASSERT_TRUE(m_max_deviation_ns <= 2);
+
+    }
+
+private:
+    int64_t m_max_deviation_ns;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
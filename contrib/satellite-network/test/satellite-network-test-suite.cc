@@ -6,7 +6,20 @@
 #include "manual-two-sat-two-gs-test.h"
 #include "satellite-info-test.h"
 #include "ground-station-info-test.h"
+#include "satellite-position-cache-test.h"
 #include "end-to-end-special-test.h"
+#include "fstate-binary-test.h"
+#include "ground-station-grid-test.h"
+#include "propagation-delay-table-test.h"
+#include "constellation-partition-helper-test.h"
+#include "ndn-leo-fib-table-test.h"
+#include "ndn-leo-stack-helper-test.h"
+#include "ndn-leo-face-table-test.h"
+#include "ndn-pit-retransmit-helper-test.h"
+#include "leo-route-engine-test.h"
+#include "utilization-tracker-test.h"
+#include "transmit-batching-test.h"
+#include "phase-profiler-test.h"
 
 using namespace ns3;
 
@@ -31,6 +44,36 @@ public:
         AddTestCase(new SatelliteInfoTestCase, TestCase::QUICK);
         AddTestCase(new GroundStationInfoTestCase, TestCase::QUICK);
 
+        // Cached SGP4 positions
+        AddTestCase(new SatellitePositionCacheTestCase, TestCase::QUICK);
+
+        // Dynamic state storage
+        AddTestCase(new FstateBinaryTestCase, TestCase::QUICK);
+
+        // GSL visibility
+        AddTestCase(new GroundStationGridTestCase, TestCase::QUICK);
+
+        // Interpolated propagation delays
+        AddTestCase(new PropagationDelayTableTestCase, TestCase::QUICK);
+
+        // Distributed simulation
+        AddTestCase(new ConstellationPartitionHelperTestCase, TestCase::QUICK);
+        // Forwarding state updates
+        AddTestCase(new LeoFibTableTestCase(true), TestCase::QUICK);
+        AddTestCase(new LeoFibTableTestCase(false), TestCase::QUICK);
+        AddTestCase(new LeoStackHelperHeadlessTestCase, TestCase::QUICK);
+        AddTestCase(new LeoFaceTableTestCase, TestCase::QUICK);
+        // Re-expression of pending Interests after a FIB change
+        AddTestCase(new PitRetransmitHelperTestCase, TestCase::QUICK);
+        // Forwarding state computed in the simulation
+        AddTestCase(new LeoRouteEngineTestCase, TestCase::QUICK);
+        // Link utilization
+        AddTestCase(new UtilizationTrackerTestCase, TestCase::QUICK);
+        // Batched transmission on ISLs and GSLs
+        AddTestCase(new TransmitBatchingTestCase, TestCase::QUICK);
+        // Startup profiling
+        AddTestCase(new PhaseProfilerTestCase, TestCase::QUICK);
+
     }
 };
 static SatelliteNetworkTestSuite SatelliteNetworkTestSuite;
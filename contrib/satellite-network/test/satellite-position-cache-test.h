@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <algorithm>
+
+#include "ns3/boolean.h"
+#include "ns3/nstime.h"
+#include "ns3/satellite.h"
+#include "ns3/satellite-position-helper.h"
+#include "ns3/satellite-position-mobility-model.h"
+#include "ns3/simulator.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class SatellitePositionCacheTestCase : public TestCase {
+public:
+    SatellitePositionCacheTestCase () : TestCase ("satellite-position-cache") {};
+
+    Ptr<SatellitePositionMobilityModel> CreateMobility(Ptr<Satellite> satellite, Time resolution, bool interpolate) {
+        Ptr<SatellitePositionMobilityModel> mobility = CreateObject<SatellitePositionMobilityModel>();
+        mobility->SetAttribute("CacheResolution", TimeValue(resolution));
+        mobility->SetAttribute("CacheInterpolation", BooleanValue(interpolate));
+        mobility->SetSatellite(satellite);
+        mobility->SetStartTime(satellite->GetTleEpoch());
+        return mobility;
+    }
+
+    void Check() {
+        JulianDate t = m_satellite->GetTleEpoch() + Simulator::Now();
+        Vector position = m_satellite->GetPosition(t);
+        Vector velocity = m_satellite->GetVelocity(t);
+
+        // Resolution 0: the plain SGP4 result, also when queried again at the same instant
+        for (int i = 0; i < 2; i++) {
+            Vector p = m_exact->GetPosition();
+            Vector v = m_exact->GetVelocity();
+            m_n_not_identical += p.x == position.x && p.y == position.y && p.z == position.z
+                                 && v.x == velocity.x && v.y == velocity.y && v.z == velocity.z ? 0 : 1;
+        }
+
+        // Hermite interpolation between samples 1 s apart
+        m_max_position_error_m = std::max(m_max_position_error_m, CalculateDistance(position, m_interpolated->GetPosition()));
+        m_max_velocity_error_m_s = std::max(m_max_velocity_error_m_s, CalculateDistance(velocity, m_interpolated->GetVelocity()));
+
+        // Without interpolation: the previous sample
+        int64_t k = Simulator::Now().GetTimeStep() / Seconds(1).GetTimeStep();
+        Vector sample = m_satellite->GetPosition(m_satellite->GetTleEpoch() + Seconds(1) * k);
+        Vector p = m_sampled->GetPosition();
+        m_n_not_sampled += p.x == sample.x && p.y == sample.y && p.z == sample.z ? 0 : 1;
+    }
+
+    void DoRun () {
+
+        m_satellite = CreateObject<Satellite>();
+        m_satellite->SetName("Starlink-550");
+        m_satellite->SetTleInfo(
+                "1 00001U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    04",
+                "2 00001  53.0000   0.0000 0000001   0.0000   0.0000 15.19000000    08");
+        m_exact = CreateMobility(m_satellite, Seconds(0), true);
+        m_interpolated = CreateMobility(m_satellite, Seconds(1), true);
+        m_sampled = CreateMobility(m_satellite, Seconds(1), false);
+
+        // Every 7 ms for 140 seconds, i.e. at many points within each interval of 1 s
+        m_n_not_identical = 0;
+        m_n_not_sampled = 0;
+        m_max_position_error_m = 0;
+        m_max_velocity_error_m_s = 0;
+        for (int64_t t = 0; t < 140000; t += 7) {
+            Simulator::Schedule(MilliSeconds(t), &SatellitePositionCacheTestCase::Check, this);
+        }
+        Simulator::Run();
+        Simulator::Destroy();
+
+        ASSERT_EQUAL(m_n_not_identical, 0);
+        ASSERT_EQUAL(m_n_not_sampled, 0);
+        ASSERT_TRUE(m_max_position_error_m > 0);
+        ASSERT_TRUE(m_max_position_error_m <= 0.025);
+        ASSERT_TRUE(m_max_velocity_error_m_s <= 0.05);
+
+    }
+
+private:
+    Ptr<Satellite> m_satellite;
+    Ptr<SatellitePositionMobilityModel> m_exact;
+    Ptr<SatellitePositionMobilityModel> m_interpolated;
+    Ptr<SatellitePositionMobilityModel> m_sampled;
+    int64_t m_n_not_identical;
+    int64_t m_n_not_sampled;
+    double m_max_position_error_m;
+    double m_max_velocity_error_m_s;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
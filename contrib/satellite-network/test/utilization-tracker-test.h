@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+#include "ns3/simulator.h"
+#include "ns3/utilization-tracker.h"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-writer.hpp"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class UtilizationTrackerTestCase : public TestCase {
+public:
+    UtilizationTrackerTestCase () : TestCase ("utilization-tracker") {};
+
+    void DoRun () {
+        std::string link_file = ".tmp-utilization-links.bin";
+        std::string group_file = ".tmp-utilization-groups.bin";
+
+        // Three ISLs of an orbit and the GSL of a ground station, 1 us intervals
+        Ptr<UtilizationTracker> tracker = Create<UtilizationTracker>(1000);
+        uint32_t orbit = tracker->GetGroup("isl-orbit-0");
+        uint32_t gs = tracker->GetGroup("gsl-gs-0");
+        ASSERT_EQUAL(tracker->GetGroup("isl-orbit-0"), orbit);
+        uint32_t isl_0_1 = tracker->AddLink(0, 1, orbit);
+        uint32_t isl_1_0 = tracker->AddLink(1, 0, orbit);
+        tracker->AddLink(1, 2, orbit);
+        uint32_t gsl = tracker->AddLink(5, -1, gs);
+        tracker->SetOutput(link_file, group_file);
+
+        Busy(tracker, isl_0_1, 100, 600);
+        Busy(tracker, isl_1_0, 800, 2300);  // Over two interval ends
+        Busy(tracker, gsl, 1000, 1250);     // Starting at an interval end
+        Simulator::Stop(NanoSeconds(3000));
+        Simulator::ScheduleDestroy(&UtilizationTracker::Finalize, tracker);
+        Simulator::Run();
+        Simulator::Destroy();
+
+        // The interval ending with the simulation is written as well
+        ASSERT_EQUAL(tracker->GetNIntervals(), 3);
+
+        // Idle links are left out
+        std::ostringstream links;
+        ndn::TraceWriter::ConvertToText(link_file, links);
+        ASSERT_EQUAL(links.str(), "IntervalStart\tFrom\tTo\tUtilization\n"
+                                  "0\t0\t1\t0.5\n"
+                                  "0\t1\t0\t0.2\n"
+                                  "1000\t1\t0\t1\n"
+                                  "1000\t5\t-1\t0.25\n"
+                                  "2000\t1\t0\t0.3\n");
+
+        // Percentiles count the idle links of the group as 0
+        std::ostringstream groups;
+        ndn::TraceWriter::ConvertToText(group_file, groups);
+        ASSERT_EQUAL(groups.str(), "IntervalStart\tGroup\tActive\tMean\tP50\tP90\tP99\tMax\n"
+                                   "0\tisl-orbit-0\t2\t0.233333\t0.2\t0.5\t0.5\t0.5\n"
+                                   "1000\tisl-orbit-0\t1\t0.333333\t0\t1\t1\t1\n"
+                                   "1000\tgsl-gs-0\t1\t0.25\t0.25\t0.25\t0.25\t0.25\n"
+                                   "2000\tisl-orbit-0\t1\t0.1\t0\t0.3\t0.3\t0.3\n");
+
+        unlink(link_file.c_str());
+        unlink(group_file.c_str());
+    }
+
+    void Busy(Ptr<UtilizationTracker> tracker, uint32_t link, int64_t from_ns, int64_t to_ns) {
+        Simulator::Schedule(NanoSeconds(from_ns), &UtilizationTracker::SetBusy, tracker, link, true);
+        Simulator::Schedule(NanoSeconds(to_ns), &UtilizationTracker::SetBusy, tracker, link, false);
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
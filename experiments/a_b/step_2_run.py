@@ -21,6 +21,7 @@
 # SOFTWARE.
 
 import exputil
+import os
 import time
 
 try:
@@ -31,6 +32,23 @@ except (ImportError, SystemError):
 local_shell = exputil.LocalShell()
 max_num_processes = 4
 
+# Run the runs which only differ in name, from_id, to_id and ndn_client from one a_b_sweep
+# process, which sets up the constellation and the dynamic state once and forks a child per
+# run. Runs differing in anything else (e.g. error rates or satellite network) are grouped,
+# one a_b_sweep per group; a run alone in its group uses its own binary.
+# Set to False to start a separate ./waf --run per run instead.
+use_sweep_runner = True
+sweep_keys = ["name", "from_id", "to_id", "ndn_client"]
+
+# Binary per ndn_client, see run_list.py
+run_binaries = {
+    "Ping": "a_b_ping",
+    "PingInstantRetx": "a_b_ping_instant_retx",
+    "PingNackRetx": "a_b_ping_nack_retx",  # NS_LOG=ndn-cxx.nfd.NackRetxStrategy
+    "FixedWindow": "a_b_fixed_window",
+    "FixedWindowRetx": "a_b_fixed_window_retx",
+}
+
 # Check that no screen is running
 if local_shell.count_screens() != 0:
     print("There is a screen already running. "
@@ -41,40 +59,31 @@ if local_shell.count_screens() != 0:
 
 commands_to_run = []
 
+groups = {}
 for run in get_ndn_run_list():
     logs_ns3_dir = "runs/" + run["name"] + "/logs_ns3"
     local_shell.remove_force_recursive(logs_ns3_dir)
     local_shell.make_full_dir(logs_ns3_dir)
-    if (run["ndn_client"] == "Ping"):
-        commands_to_run.append(
-            "cd ../../; "
-            "./waf --run=\"a_b_ping --run_dir='" + run["name"] + "'\" "
-            "2>&1 | tee '" + 'experiments/a_b/' + logs_ns3_dir + "/console.txt'"
-        )
-    elif (run["ndn_client"] == "PingInstantRetx"):
-        commands_to_run.append(
-            "cd ../../; "
-            "./waf --run=\"a_b_ping_instant_retx --run_dir='" + run["name"] + "'\" "
-            "2>&1 | tee '" + 'experiments/a_b/' + logs_ns3_dir + "/console.txt'"
-        )
-    elif (run["ndn_client"] == "PingNackRetx"):
-        commands_to_run.append(
-            "cd ../../; "
-            "./waf --run=\"a_b_ping_nack_retx --run_dir='" + run["name"] + "'\" "
-            "2>&1 | tee '" + 'experiments/a_b/' + logs_ns3_dir + "/console.txt'"
-        ) #NS_LOG=ndn-cxx.nfd.NackRetxStrategy
-    elif (run["ndn_client"] == "FixedWindow"):
-        commands_to_run.append(
-            "cd ../../; "
-            "./waf --run=\"a_b_fixed_window --run_dir='" + run["name"] + "'\" "
-            "2>&1 | tee '" + 'experiments/a_b/' + logs_ns3_dir + "/console.txt'"
-        )
-    elif (run["ndn_client"] == "FixedWindowRetx"):
+    setup = tuple(sorted((key, str(value)) for key, value in run.items() if key not in sweep_keys))
+    groups.setdefault(setup if use_sweep_runner else run["name"], []).append(run)
+
+# Every sweep forks up to this many runs, so that the parallel commands share the cores
+sweep_max_processes = max(1, (os.cpu_count() or 1) // max_num_processes)
+for group_index, runs in enumerate(groups.values()):
+    if len(runs) > 1:
         commands_to_run.append(
             "cd ../../; "
-            "./waf --run=\"a_b_fixed_window_retx --run_dir='" + run["name"] + "'\" "
-            "2>&1 | tee '" + 'experiments/a_b/' + logs_ns3_dir + "/console.txt'"
+            "./waf --run=\"a_b_sweep --run_dirs='" + ",".join(run["name"] for run in runs) + "' "
+            "--max_processes=" + str(sweep_max_processes) + "\" "
+            "2>&1 | tee 'experiments/a_b/runs/sweep_" + str(group_index) + "_console.txt'"
         )
+        continue
+    run = runs[0]
+    commands_to_run.append(
+        "cd ../../; "
+        "./waf --run=\"" + run_binaries[run["ndn_client"]] + " --run_dir='" + run["name"] + "'\" "
+        "2>&1 | tee 'experiments/a_b/runs/" + run["name"] + "/logs_ns3/console.txt'"
+    )
 
 # Compiling
 print("Compiling")
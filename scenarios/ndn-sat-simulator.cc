@@ -43,11 +43,12 @@
 #include "ns3/ndnSIM/apps/ndn-consumer.hpp"
 #include "ndn-sat-simulator.h"
 #include "ns3/nack-retx-strategy.h"
+#include "ns3/ndn-pit-retransmit-helper.h"
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
 
 namespace ns3 {
 
 double HANDOVER_DURATION = 0.000000001; // in seconds
-double DELAYED_REMOVAL = 0.000000002; // in seconds
 double MAX_GSL_LENGTH_M = 1089686.4181956202;
 
 void printFibTable(Ptr<Node> node) {
@@ -62,67 +63,19 @@ void printFibTable(Ptr<Node> node) {
   }
 }
 
-void retransmitPitTable(Ptr<Node> node, string prefix) {
-  Ptr<ns3::ndn::L3Protocol> ndn = node->GetObject<ns3::ndn::L3Protocol>();
-  // std::shared_ptr<nfd::Forwarder> fw = ndn->getForwarder();
-  // ndn::nfd::pit::Pit pit = fw->getPit();
-  // ndn::nfd::fib::Fib fib = fw->getFib();
-
-  auto fw = ndn->getForwarder();
-  auto &pit = fw->getPit();
-  auto &fib = fw->getFib();
-  ndn::Name pf(prefix);
+void retransmitPitTable(Ptr<Node> node, const ndn::Name& prefix) {
+  auto &pit = node->GetObject<ns3::ndn::L3Protocol>()->getForwarder()->getPit();
   if (pit.size() <= 1) return;
   cout << Simulator::Now().GetSeconds() << " -- Retx Node: " << node->GetId() << endl;
-  for (auto it = pit.begin(); it != pit.end(); it++) {
-    // Don't do anything if we're not interested in that entry
-    ndn::Name fullName(it->getName());
-    if (!pf.isPrefixOf(fullName)) {
-      continue;
-    }
-    // Default life time is 2s
-    ndn::time::milliseconds interestLifeTime(2000);
-    // Remove all out records
-    it->clearOutRecords();
-    // for (auto i = it->getOutRecords().begin(); i != it->getOutRecords().end(); i++) {
-    //   cout << "  PIT REMOVED - " << fullName << "," << i->getFace().getId() << endl;
-    //   cout << "REMOVED?" << endl;
-    //   it->deleteOutRecord(i->getFace());
-    //   cout << "REMOVED!" << endl;
-    // }
-    // cout << "  PIT CLEARED" << endl;
-    // Find the match in the fib, return empty if no match so don't have to check
-    auto &fi = fib.findLongestPrefixMatch(fullName);
-    // Re-add out records from FIB
-    for (auto i : fi.getNextHops()) {
-      cout << "  PIT ADDED - " << fullName << "," << i.getFace().getId() << endl;
-      ndn::Interest interest = ndn::Interest(fullName, interestLifeTime);
-      it->insertOrUpdateOutRecord(i.getFace(), interest);
-      // Retransmit interest based on what's left in the pit with new face from fib.
-      i.getFace().sendInterest(interest);
-    }
-  }
+  // Only the pending interests under the prefix are visited, see PitRetransmitHelper
+  ndn::PitRetransmitHelper::Retransmit(node, prefix);
 }
 
-void sendNackOrRetransmit(Ptr<Node> node, const ndn::nfd::FaceEndpoint& faceEndPoint, string prefix) {
-  Ptr<ns3::ndn::L3Protocol> ndn = node->GetObject<ns3::ndn::L3Protocol>();
-  auto fw = ndn->getForwarder();
-  auto &pit = fw->getPit();
-  auto &fib = fw->getFib();
-  ndn::Name pf(prefix);
+void sendNackOrRetransmit(Ptr<Node> node, const ndn::nfd::FaceEndpoint& faceEndPoint, const ndn::Name& prefix) {
+  auto &pit = node->GetObject<ns3::ndn::L3Protocol>()->getForwarder()->getPit();
   if (pit.size() <= 1) return;
   cout << Simulator::Now().GetSeconds() << " -- Retx Node: " << node->GetId() << endl;
-  for (ndn::nfd::Pit::const_iterator it = pit.begin(); it != pit.end(); it++) {
-    // Don't do anything if we're not interested in that entry
-    ndn::Name fullName(it->getName());
-    if (!pf.isPrefixOf(fullName)) {
-      continue;
-    }
-    nfd::fw::NackRetxStrategy strat(*fw, "/localhost/nfd/strategy/nack-retx");
-    // shared_ptr<ndn::nfd::pit::Entry> entry = (*it);
-    strat.sendNackOrForward(it->getInterest(), faceEndPoint, pit.find(it->getInterest()));
-  }
-
+  ndn::PitRetransmitHelper::SendNackOrForward(node, faceEndPoint, prefix);
 }
 
 void
@@ -133,21 +86,101 @@ InstallRegionTable(NodeContainer allNodes) {
   }
 }
 
-NDNSatSimulator::NDNSatSimulator(string config) {
+void
+ReportDelayTableValidation() {
+  std::cout << "  > Delay table validation...... max deviation "
+            << PropagationDelayTable::GetGlobalMaxError().GetNanoSeconds() << " ns over "
+            << PropagationDelayTable::GetGlobalNValidated() << " packets" << std::endl;
+}
+
+NDNSatSimulator::NDNSatSimulator(string config) : m_instant_retx(true) {
   ReadConfig(config);
   // setting default parameters for PointToPoint links and channels
   Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
   Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
   Config::SetDefault("ns3::DropTailQueue<Packet>::MaxSize", StringValue("20p"));
 
+  // Propagation delay tables (0 = exact delay for every packet)
+  int64_t delay_table_resolution_ns = parse_positive_int64(getConfigParamOrDefault("delay_table_resolution_ns", "0"));
+  int64_t delay_table_error_bound_ns = parse_positive_int64(getConfigParamOrDefault("delay_table_error_bound_ns", "1"));
+  bool delay_table_validation = parse_boolean(getConfigParamOrDefault("delay_table_validation", "false"));
+  for (std::string channel : {"ns3::PointToPointLaserChannel", "ns3::GSLChannel"}) {
+    Config::SetDefault(channel + "::DelayTableResolution", TimeValue(NanoSeconds(delay_table_resolution_ns)));
+    Config::SetDefault(channel + "::DelayTableErrorBound", TimeValue(NanoSeconds(delay_table_error_bound_ns)));
+    Config::SetDefault(channel + "::DelayTableValidation", BooleanValue(delay_table_validation));
+  }
+  if (delay_table_resolution_ns > 0) {
+    std::cout << "  > Delay table resolution...... " << delay_table_resolution_ns << " ns" << std::endl;
+    if (delay_table_validation) {
+      Simulator::ScheduleDestroy(&ReportDelayTableValidation);
+    }
+  }
+
+  // Batched transmission: the packets a device queues in one instant go out in one pass
+  bool transmit_batching = parse_boolean(getConfigParamOrDefault("enable_transmit_batching", "false"));
+  for (std::string device : {"ns3::PointToPointLaserNetDevice", "ns3::GSLNetDevice"}) {
+    Config::SetDefault(device + "::TransmitBatching", BooleanValue(transmit_batching));
+  }
+  if (transmit_batching) {
+    std::cout << "  > Transmit batching........... enabled" << std::endl;
+  }
+
+  // Event scheduler, optionally recording its operations for scheduler-benchmark
+  std::string scheduler_type = getConfigParamOrDefault("scheduler_type", "ns3::MapScheduler");
+  std::string scheduler_trace_file = getConfigParamOrDefault("scheduler_trace_file", "");
+  ObjectFactory scheduler_factory(scheduler_type);
+  if (!scheduler_trace_file.empty()) {
+    if (MpiInterface::IsEnabled()) {
+      scheduler_trace_file += "_rank" + std::to_string(MpiInterface::GetSystemId());
+    }
+    scheduler_factory = ObjectFactory("ns3::RecordingScheduler", "SchedulerType", TypeIdValue(scheduler_factory.GetTypeId()),
+                                      "TraceFile", StringValue(scheduler_trace_file));
+    std::cout << "  > Scheduler trace............. " << scheduler_trace_file << std::endl;
+  }
+  if (scheduler_type != "ns3::MapScheduler" || !scheduler_trace_file.empty()) {
+    Simulator::SetScheduler(scheduler_factory);
+    std::cout << "  > Scheduler................... " << scheduler_type << std::endl;
+  }
+
+  // Progress, event rate and time per type of event of the run, every interval of wall-clock time
+  std::string event_profile_file = getConfigParamOrDefault("event_profile_file", "");
+  if (!event_profile_file.empty()) {
+    Ptr<DefaultSimulatorImpl> impl = DynamicCast<DefaultSimulatorImpl>(Simulator::GetImplementation());
+    if (impl == nullptr) {
+      std::cout << "  > Event profile............... not available with this simulator implementation" << std::endl;
+    } else {
+      double interval_s = parse_positive_double(getConfigParamOrDefault("event_profile_interval_s", "10"));
+      m_event_profiler = Create<EventProfiler>(event_profile_file, interval_s,
+                                               parse_positive_int64(getConfigParamOrDefault("event_profile_top", "10")));
+      m_event_profiler->SetProgressStream(&std::cout);
+      impl->SetEventProfiler(m_event_profiler);
+      std::cout << "  > Event profile............... " << event_profile_file << " every " << interval_s << " s" << std::endl;
+    }
+  }
+
+  // Wall time, memory and object counts per setup phase and per simulated second, written
+  // next to the configuration when the simulation is destroyed
+  if (parse_boolean(getConfigParamOrDefault("phase_profiling", "false"))) {
+    std::string profile_file = getConfigParamOrDefault("phase_profile_file",
+                                                       (std::filesystem::path(config).parent_path() / "phase_profile.csv").string());
+    if (MpiInterface::IsEnabled()) {
+      profile_file += "_rank" + std::to_string(MpiInterface::GetSystemId());
+    }
+    m_profiler = Create<PhaseProfiler>(profile_file);
+    m_profiler->StartSampling(Seconds(1));
+    std::cout << "  > Phase profile............... " << profile_file << std::endl;
+  }
+
   // Configuration
   // string ns3_config = "scenarios/config/run.properties";
 
   // Reading nodes
   
   ReadSatellites();
+  EndPhase("read_satellites");
 
   ReadGroundStations();
+  EndPhase("read_ground_stations");
 
   // Only ground stations are valid endpoints
   for (uint32_t i = 0; i < m_groundStations.size(); i++) {
@@ -166,27 +199,70 @@ NDNSatSimulator::NDNSatSimulator(string config) {
   m_gsl_max_queue_size_pkts = parse_positive_int64(getConfigParamOrDefault("gsl_max_queue_size_pkts", "10000"));
   m_isl_error_rate = parse_positive_double(getConfigParamOrDefault("isl_error_rate", "0"));
   m_gsl_error_rate = parse_positive_double(getConfigParamOrDefault("gsl_error_rate", "0"));
+
+  // Utilization tracking, streamed to the run directory
+  m_enable_isl_utilization_tracking = parse_boolean(getConfigParamOrDefault("enable_isl_utilization_tracking", "false"));
+  m_enable_gsl_utilization_tracking = parse_boolean(getConfigParamOrDefault("enable_gsl_utilization_tracking", "false"));
+  if (m_enable_isl_utilization_tracking || m_enable_gsl_utilization_tracking) {
+    int64_t interval_ns = parse_positive_int64(getConfigParamOrDefault("utilization_tracking_interval_ns",
+                                                                       getConfigParamOrDefault("isl_utilization_tracking_interval_ns", "100000000")));
+    m_utilization_tracker = Create<UtilizationTracker>(interval_ns);
+    SetUtilizationOutput(std::filesystem::path(config).parent_path().string());
+    Simulator::ScheduleDestroy(&UtilizationTracker::Finalize, m_utilization_tracker);
+    std::cout << "  > Utilization tracking........ every " << interval_ns << " ns" << std::endl;
+  }
   // Default to 100ms
 
   ReadISLs();
+  EndPhase("read_isls");
 
   AddGSLs();
+  EndPhase("add_gsls");
+
+  // Expected load of the distributed run, before it starts
+  if (m_partition != nullptr && MpiInterface::GetSystemId() == 0) {
+    m_partition->PrintReport(std::cout, m_satelliteNodes, 299792458.0);
+  }
+
   // Install NDN stack on all nodes
   ndn::LeoStackHelper ndnHelper;
 
   // Set content store size
   ndnHelper.setCsSize(10000);
 
+  // Forwarders without management and RIB (routes and strategies are set in place)
+  bool headless = parse_boolean(getConfigParamOrDefault("ndn_headless", "false"));
+  ndnHelper.setHeadless(headless);
+
   // ndnHelper.SetDefaultRoutes(true);
+  int64_t memory_before = MemUsage::Get();
   ndnHelper.Install(m_allNodes);
+  int64_t memory_per_node = (MemUsage::Get() - memory_before) / std::max<uint32_t>(1, m_allNodes.GetN());
 
-  std::cout << "  > Installed NDN stacks" << std::endl;
+  std::cout << "  > Installed NDN stacks" << (headless ? " (headless)" : "") << std::endl;
+  std::cout << "  > NDN stack memory............ " << memory_per_node / 1024.0 << " KiB per node" << std::endl;
+  EndPhase("install_ndn_stacks");
 
   // InstallRegionTable(m_allNodes);
 
   std::cout << "  > Installed region table" << std::endl;
 }
 
+void NDNSatSimulator::EndPhase(std::string name) {
+  if (m_profiler == nullptr) {
+    return;
+  }
+  const PhaseProfiler::Record& record = m_profiler->EndPhase(name);
+  std::cout << "  > Phase " << name << " took " << record.wallS << " s, "
+            << (record.rssDeltaMb >= 0 ? "+" : "") << record.rssDeltaMb << " MB" << std::endl;
+}
+
+void NDNSatSimulator::StartEventProfile() {
+  if (m_event_profiler != nullptr) {
+    m_event_profiler->Start();
+  }
+}
+
 std::string NDNSatSimulator::getConfigParamOrDefault(std::string key, std::string default_value) {
   auto it = m_config.find(key);
   if (it != m_config.end())
@@ -203,6 +279,11 @@ void NDNSatSimulator::ReadConfig(std::string conf) {
   m_node1_id = stoi(getConfigParamOrDefault("from_id", "0"));
   m_node2_id = stoi(getConfigParamOrDefault("to_id", "0"));
   m_name = getConfigParamOrDefault("name", "run");
+  m_route_engine_enabled = parse_boolean(getConfigParamOrDefault("route_engine", "false"));
+  m_route_engine_incremental = parse_boolean(getConfigParamOrDefault("route_engine_incremental", "true"));
+  m_route_engine_interval_ns = parse_positive_int64(getConfigParamOrDefault("route_engine_interval_ns", "100000000"));
+  m_route_engine_threads = parse_positive_int64(getConfigParamOrDefault("route_engine_threads", "1"));
+  NS_ABORT_MSG_IF(m_route_engine_threads < 1, "route_engine_threads must be at least 1, got " << m_route_engine_threads);
 
   // Print full config
   printf("CONFIGURATION\n-----\nKEY                                       VALUE\n");
@@ -227,8 +308,35 @@ void NDNSatSimulator::ReadSatellites()
   std::vector<std::string> res = split_string(orbits_and_n_sats_per_orbit, " ", 2);
   int64_t num_orbits = parse_positive_int64(res[0]);
   int64_t satellites_per_orbit = parse_positive_int64(res[1]);
-  // Create the nodes
-  m_satelliteNodes.Create(num_orbits * satellites_per_orbit);
+  m_satellites_per_orbit = satellites_per_orbit;
+  // Create the nodes, on their rank when distributed
+  if (MpiInterface::IsEnabled()) {
+    m_partition = make_shared<ConstellationPartitionHelper>(m_satellite_network_dir, MpiInterface::GetSize());
+    std::string partitioning = getConfigParamOrDefault("distributed_partitioning", "orbital_plane");
+    if (partitioning == "min_cut") {
+      EstimateISLTraffic(num_orbits * satellites_per_orbit);
+      m_partition->PartitionMinCut(parse_positive_double(getConfigParamOrDefault("distributed_imbalance", "0.05")));
+    } else if (partitioning != "orbital_plane") {
+      throw std::runtime_error("Unknown distributed_partitioning: " + partitioning);
+    }
+    std::cout << "  > Partitioning............... " << partitioning << " over " << MpiInterface::GetSize() << " ranks" << std::endl;
+    for (int64_t sid = 0; sid < num_orbits * satellites_per_orbit; sid++) {
+      m_satelliteNodes.Create(1, m_partition->GetSatelliteSystemId(sid));
+    }
+  } else {
+    m_satelliteNodes.Create(num_orbits * satellites_per_orbit);
+  }
+
+  // Orbit samples on a grid of simulated time (0 = exact position at every instant). Only
+  // with a grid do all satellites ask for the same instants, so that propagating the whole
+  // constellation at once pays off
+  int64_t position_resolution_ns = parse_positive_int64(getConfigParamOrDefault("satellite_position_resolution_ns", "0"));
+  bool position_interpolation = parse_boolean(getConfigParamOrDefault("satellite_position_interpolation", "true"));
+  if (position_resolution_ns > 0 && !m_satellite_network_force_static) {
+    m_constellation = CreateObject<SatelliteConstellation>();
+    std::cout << "  > Satellite position grid..... " << position_resolution_ns << " ns"
+              << (position_interpolation ? " (interpolated)" : "") << std::endl;
+  }
 
   // Associate satellite mobility model with each node
   int64_t counter = 0;
@@ -260,9 +368,17 @@ void NDNSatSimulator::ReadSatellites()
       mobility.SetMobilityModel(
               "ns3::SatellitePositionMobilityModel",
               "SatellitePositionHelper",
-              SatellitePositionHelperValue(SatellitePositionHelper(satellite))
+              SatellitePositionHelperValue(SatellitePositionHelper(satellite)),
+              "CacheResolution",
+              TimeValue(NanoSeconds(position_resolution_ns)),
+              "CacheInterpolation",
+              BooleanValue(position_interpolation)
       );
       mobility.Install(m_satelliteNodes.Get(counter));
+      if (m_constellation != nullptr) {
+        m_satelliteNodes.Get(counter)->GetObject<SatellitePositionMobilityModel>()->SetConstellation(
+                m_constellation, m_constellation->Add(satellite));
+      }
     }
 
     // Add to all satellites present
@@ -306,20 +422,32 @@ void NDNSatSimulator::ReadGroundStations()
     Ptr<GroundStation> gs = CreateObject<GroundStation>(
       gid, name, latitude, longitude, elevation, cartesian_position
     );
+    if (m_groundStations.size() != gid) {
+      throw std::runtime_error("GID is not incremented each line");
+    }
     m_groundStations.push_back(gs);
+  }
 
-    // Create the node
-    m_groundStationNodes.Create(1);
-    if (m_groundStationNodes.GetN() != gid + 1) {
-      throw std::runtime_error("GID is not incremented each line");
+  // Ground stations go to the rank of the satellites they see (the satellites are created first)
+  std::vector<uint32_t> systems(m_groundStations.size(), 0);
+  if (m_partition != nullptr) {
+    std::vector<Vector> positions;
+    for (Ptr<GroundStation> gs : m_groundStations) {
+      positions.push_back(gs->GetCartesianPosition());
     }
+    systems = m_partition->AssignGroundStations(m_satelliteNodes, positions, MAX_GSL_LENGTH_M);
+  }
+
+  for (uint32_t gid = 0; gid < m_groundStations.size(); gid++) {
+    // Create the node
+    m_groundStationNodes.Create(1, systems[gid]);
 
     // Install the constant mobility model on the node
     MobilityHelper mobility;
     mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
     mobility.Install(m_groundStationNodes.Get(gid));
     Ptr<MobilityModel> mobilityModel = m_groundStationNodes.Get(gid)->GetObject<MobilityModel>();
-    mobilityModel->SetPosition(cartesian_position);
+    mobilityModel->SetPosition(m_groundStations[gid]->GetCartesianPosition());
   }
 
   fs.close();
@@ -365,13 +493,8 @@ void NDNSatSimulator::ReadISLs()
 
         // Utilization tracking
         if (m_enable_isl_utilization_tracking) {
-            netDevices.Get(0)->GetObject<PointToPointLaserNetDevice>()->EnableUtilizationTracking(m_isl_utilization_tracking_interval_ns);
-            netDevices.Get(1)->GetObject<PointToPointLaserNetDevice>()->EnableUtilizationTracking(m_isl_utilization_tracking_interval_ns);
-
-            m_islNetDevices.Add(netDevices.Get(0));
-            m_islFromTo.push_back(std::make_pair(sat0_id, sat1_id));
-            m_islNetDevices.Add(netDevices.Get(1));
-            m_islFromTo.push_back(std::make_pair(sat1_id, sat0_id));
+            TrackUtilization(netDevices.Get(0), sat1_id);
+            TrackUtilization(netDevices.Get(1), sat0_id);
         }
 
         counter += 1;
@@ -382,223 +505,43 @@ void NDNSatSimulator::ReadISLs()
     std::cout << "    >> Created " << std::to_string(counter) << " ISL(s)" << std::endl;
 }
 
-void RemoveNextHop(ns3::ndn::NetDeviceTransport* ts, Address dest) {
-  ts->RemoveNextHop(dest);
-}
-
-void AddRouteCustom(ns3::Ptr<ns3::Node> node, string prefix, shared_ptr<ns3::ndn::Face> face, int32_t metric) {
-  ns3::ndn::FibHelper::AddRoute(node, prefix, face, metric);
-}
-
-void RemoveExistingLink(Ptr<Node> node, string prefix, shared_ptr<ns3::ndn::Face> nextHop, shared_ptr<ns3::ndn::Face> prevCurFace, shared_ptr<ns3::ndn::Face> prevNextFace, Address dest) {
-  // Remove route when we strictly want one FIB entry
-  if (prevCurFace->getId() != nextHop->getId()) {
-    ns3::ndn::FibHelper::RemoveRoute(node, prefix, prevCurFace);
-  }
-  // Remove additional GSl hardware routes
-  // if (prevCurFace->getLinkType() == ::ndn::nfd::LINK_TYPE_AD_HOC) {
-  //   ns3::ndn::NetDeviceTransport* ts = dynamic_cast<ns3::ndn::NetDeviceTransport*>(prevNextFace->getTransport());
-  //   ts->RemoveNextDataHop(dest);
-  //   ns3::Simulator::Schedule(ns3::MilliSeconds(1), &sendNackOrRetransmit, node, ndn::nfd::FaceEndpoint(*prevCurFace, prevCurFace->getId()), prefix);
-  //   // ns3::Simulator::Schedule(ns3::MilliSeconds(1), &retransmitPitTable, node, prefix);
-  //   // ns3::Simulator::Schedule(ns3::Seconds(0), &RemoveNextDataHop, ts, dest);
-  // }
-}
-
-void AddRouteISL(ns3::Ptr<ns3::Node> node, int deviceId,
-                string prefix, ns3::Ptr<ns3::Node> otherNode, int otherDeviceId, shared_ptr<map<pair<uint32_t, string>, tuple<shared_ptr<ns3::ndn::Face>, shared_ptr<ns3::ndn::Face>, Address> >> curNextHop)
-{
-  NS_ASSERT_MSG(deviceId < node->GetNDevices(), "Sorce device ID must be valid");
-  NS_ASSERT_MSG(otherDeviceId < otherNode->GetNDevices(), "Next hop device ID must be valid");
-
-  Ptr<PointToPointLaserNetDevice> netDevice = DynamicCast<PointToPointLaserNetDevice>(node->GetDevice(deviceId));
-  Ptr<PointToPointLaserNetDevice> remoteNetDevice = DynamicCast<PointToPointLaserNetDevice>(otherNode->GetDevice(otherDeviceId));
-  Ptr<ns3::ndn::L3Protocol> ndn = node->GetObject<ns3::ndn::L3Protocol>();
-  Ptr<ns3::ndn::L3Protocol> remoteNdn = otherNode->GetObject<ns3::ndn::L3Protocol>();
-  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
-
-  shared_ptr<ns3::ndn::Face> face = ndn->getFaceByNetDevice(netDevice);
-  shared_ptr<ns3::ndn::Face> remoteFace = remoteNdn->getFaceByNetDevice(remoteNetDevice);
-  NS_ASSERT_MSG(face != 0, "There is no face associated with the p2p link");
-  // Removing existing route
-  // Remove route -> Add route -> Remove backward link
-  auto p = make_pair(node->GetId(), prefix);
-  if (curNextHop->find(p) != curNextHop->end()) {
-    shared_ptr<ns3::ndn::Face> prevCurFace, prevNextFace;
-    Address prevDest;
-    tie(prevCurFace, prevNextFace, prevDest) = (*curNextHop)[p];
-    ns3::Simulator::Schedule(ns3::Seconds(DELAYED_REMOVAL), &RemoveExistingLink, node, prefix, face, prevCurFace, prevNextFace, prevDest);
-  }
-  // Get delay value
-  Ptr<MobilityModel> senderMobility = node->GetObject<MobilityModel>();
-  Ptr<MobilityModel> receiverMobility = otherNode->GetObject<MobilityModel>();
-  double distance = senderMobility->GetDistanceFrom(receiverMobility);
-  ns3::Simulator::Schedule(ns3::Seconds(HANDOVER_DURATION), &AddRouteCustom, node, prefix, face, distance);
-  // ns3::ndn::FibHelper::AddRoute(node, prefix, face, 1);
-  // Add the current route for future removal
-  (*curNextHop)[p] = make_tuple(face, remoteFace, netDevice->GetAddress());
-}
-
-void SetRouteISL(ns3::Ptr<ns3::Node> node, int deviceId,
-                string prefix, ns3::Ptr<ns3::Node> otherNode, int otherDeviceId)
+void NDNSatSimulator::EstimateISLTraffic(int64_t num_satellites)
 {
-  NS_ASSERT_MSG(deviceId < node->GetNDevices(), "Sorce device ID must be valid");
-  NS_ASSERT_MSG(otherDeviceId < otherNode->GetNDevices(), "Next hop device ID must be valid");
-
-  Ptr<PointToPointLaserNetDevice> netDevice = DynamicCast<PointToPointLaserNetDevice>(node->GetDevice(deviceId));
-  Ptr<PointToPointLaserNetDevice> remoteNetDevice = DynamicCast<PointToPointLaserNetDevice>(otherNode->GetDevice(otherDeviceId));
-  Ptr<ns3::ndn::L3Protocol> ndn = node->GetObject<ns3::ndn::L3Protocol>();
-  Ptr<ns3::ndn::L3Protocol> remoteNdn = otherNode->GetObject<ns3::ndn::L3Protocol>();
-  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
-
-  shared_ptr<ns3::ndn::Face> face = ndn->getFaceByNetDevice(netDevice);
-  shared_ptr<ns3::ndn::Face> remoteFace = remoteNdn->getFaceByNetDevice(remoteNetDevice);
-  NS_ASSERT_MSG(face != 0, "There is no face associated with the p2p link");
-  // Removing existing route
-  // Remove route -> Add route -> Remove backward link
-  auto p = make_pair(node->GetId(), prefix);
-  // Get delay value
-  Ptr<MobilityModel> senderMobility = node->GetObject<MobilityModel>();
-  Ptr<MobilityModel> receiverMobility = otherNode->GetObject<MobilityModel>();
-  double distance = senderMobility->GetDistanceFrom(receiverMobility);
-  ns3::Simulator::Schedule(ns3::Seconds(HANDOVER_DURATION), &AddRouteCustom, node, prefix, face, distance);
-}
-
-void AddRouteGSL(ns3::Ptr<ns3::Node> node, int deviceId,
-                string prefix, ns3::Ptr<ns3::Node> otherNode, int otherDeviceId, shared_ptr<map<pair<uint32_t, string>, tuple<shared_ptr<ns3::ndn::Face>, shared_ptr<ns3::ndn::Face>, Address> >> curNextHop)
-{
-  // Prevent legacy dynamic state to create more GSLs than needed
-  if (deviceId >= node->GetNDevices()) {
-    deviceId = node->GetNDevices() - 1;
-  }
-  if (otherDeviceId >= otherNode->GetNDevices()) {
-    otherDeviceId = otherNode->GetNDevices() - 1;
-  }
-  NS_ASSERT_MSG(deviceId < node->GetNDevices(), "Source device ID must be valid");
-  NS_ASSERT_MSG(otherDeviceId < otherNode->GetNDevices(), "Next hop device ID must be valid");
-  // Removing existing route
-  ns3::Ptr<ns3::Node> gsNode;
-  ns3::Ptr<ns3::Node> satNode;
-  Ptr<GSLNetDevice> gsNetDevice;
-  Ptr<GSLNetDevice> satNetDevice;
-  // src node is satellite
-  if (node->GetId() < otherNode->GetId()) {
-    satNode = node;
-    gsNode = otherNode;
-    satNetDevice = DynamicCast<GSLNetDevice>(node->GetDevice(deviceId));
-    gsNetDevice = DynamicCast<GSLNetDevice>(otherNode->GetDevice(otherDeviceId));
-  } else {
-    satNode = otherNode;
-    gsNode = node;
-    satNetDevice = DynamicCast<GSLNetDevice>(otherNode->GetDevice(otherDeviceId));
-    gsNetDevice = DynamicCast<GSLNetDevice>(node->GetDevice(deviceId));
+  // Every destination routed over an ISL at t=0 counts as one unit of traffic on it
+  string binary_path = FstateBinaryFile::FindInDirectory(m_satellite_network_routes_dir);
+  if (!binary_path.empty()) {
+    Ptr<FstateBinaryFile> fstate = Create<FstateBinaryFile>(binary_path);
+    if (fstate->GetNEpochs() > 0) {
+      const FstateRecord* records = fstate->GetRecords(0);
+      for (uint64_t i = 0; i < fstate->GetEpoch(0).numRecords; i++) {
+        if (records[i].current < num_satellites && records[i].nextHop >= 0 && records[i].nextHop < num_satellites) {
+          m_partition->AddIslTraffic(records[i].current, records[i].nextHop, 1);
+        }
+      }
+    }
+    return;
   }
 
-  // Get GS Information
-  
-  Ptr<ns3::ndn::L3Protocol> gsNdn = gsNode->GetObject<ns3::ndn::L3Protocol>();
-  NS_ASSERT_MSG(gsNdn != 0, "Ndn stack should be installed on the ground station node");
-  shared_ptr<ns3::ndn::Face> gsFace = gsNdn->getFaceByNetDevice(gsNetDevice);
-  NS_ASSERT_MSG(gsFace != 0, "There is no face associated with the gsl link");
-  ns3::ndn::NetDeviceTransport* gsTransport = dynamic_cast<ns3::ndn::NetDeviceTransport*>(gsFace->getTransport());
-  NS_ASSERT_MSG(gsTransport != 0, "There is no valid transport associated with the ground station face");
-
-  // Get Sat Information
-  Ptr<ns3::ndn::L3Protocol> satNdn = satNode->GetObject<ns3::ndn::L3Protocol>();
-  NS_ASSERT_MSG(satNdn != 0, "Ndn stack should be installed on the satellite node");
-  shared_ptr<ns3::ndn::Face> satFace = satNdn->getFaceByNetDevice(satNetDevice);
-  NS_ASSERT_MSG(satFace != 0, "There is no face associated with the gsl link");
-  ns3::ndn::NetDeviceTransport* satTransport = dynamic_cast<ns3::ndn::NetDeviceTransport*>(satFace->getTransport());
-  NS_ASSERT_MSG(satTransport != 0, "There is no valid transport associated with the ground station face");
-  
-  // Remove route -> Add route -> Remove backward link
-  auto p = make_pair(node->GetId(), prefix);
-  shared_ptr<ns3::ndn::Face> prevCurFace, prevNextFace;
-  Address prevDest;
-  // Get delay value
-  Ptr<MobilityModel> senderMobility = node->GetObject<MobilityModel>();
-  Ptr<MobilityModel> receiverMobility = otherNode->GetObject<MobilityModel>();
-  double distance = senderMobility->GetDistanceFrom(receiverMobility);
-
-  if (node == gsNode) {
-    // gs -> sat
-    // Remove existing route
-    if (curNextHop->find(p) != curNextHop->end()) {
-      tie(prevCurFace, prevNextFace, prevDest) = (*curNextHop)[p];
-      ns3::Simulator::Schedule(ns3::Seconds(DELAYED_REMOVAL), &RemoveExistingLink, node, prefix, gsFace, prevCurFace, prevNextFace, prevDest);
-    }
-    ns3::Simulator::Schedule(ns3::Seconds(HANDOVER_DURATION), &AddRouteCustom, node, prefix, gsFace, distance);
-    // Add the current route for future removal
-    (*curNextHop)[p] = make_tuple(gsFace, satFace, gsNetDevice->GetAddress());
-  } else {
-    // sat -> gs
-    if (curNextHop->find(p) != curNextHop->end()) {
-      tie(prevCurFace, prevNextFace, prevDest) = (*curNextHop)[p];
-      // ns3::ndn::FibHelper::RemoveRoute(node, prefix, prevCurFace);
-      ns3::Simulator::Schedule(ns3::Seconds(DELAYED_REMOVAL), &RemoveExistingLink, node, prefix, satFace, prevCurFace, prevNextFace, prevDest);
+  std::ifstream fs(m_satellite_network_routes_dir + "/fstate_0.txt");
+  NS_ABORT_MSG_UNLESS(fs.is_open(), "Min-cut partitioning needs the routes at t=0 (fstate_0.txt)");
+  std::string line;
+  while (std::getline(fs, line)) {
+    std::vector<std::string> res = split_string(line, ",");
+    int64_t current_node = stoi(res.at(0));
+    int64_t next_hop = stoi(res.at(2));
+    if (current_node < num_satellites && next_hop >= 0 && next_hop < num_satellites) {
+      m_partition->AddIslTraffic(current_node, next_hop, 1);
     }
-    ns3::Simulator::Schedule(ns3::Seconds(HANDOVER_DURATION), &AddRouteCustom, node, prefix, satFace, distance);
-    // Add the current route for future removal
-    (*curNextHop)[p] = make_tuple(satFace, gsFace, satNetDevice->GetAddress());
   }
 }
 
-void SetRouteGSL(ns3::Ptr<ns3::Node> node, int deviceId,
-                string prefix, ns3::Ptr<ns3::Node> otherNode, int otherDeviceId)
+bool NDNSatSimulator::IsLocal(Ptr<Node> node) const
 {
-  NS_ASSERT_MSG(deviceId < node->GetNDevices(), "Sorce device ID must be valid");
-  NS_ASSERT_MSG(otherDeviceId < otherNode->GetNDevices(), "Next hop device ID must be valid");
-  // Removing existing route
-  ns3::Ptr<ns3::Node> gsNode;
-  ns3::Ptr<ns3::Node> satNode;
-  Ptr<GSLNetDevice> gsNetDevice;
-  Ptr<GSLNetDevice> satNetDevice;
-  // src node is satellite
-  if (node->GetId() < otherNode->GetId()) {
-    satNode = node;
-    gsNode = otherNode;
-    satNetDevice = DynamicCast<GSLNetDevice>(node->GetDevice(deviceId));
-    gsNetDevice = DynamicCast<GSLNetDevice>(otherNode->GetDevice(otherDeviceId));
-  } else {
-    satNode = otherNode;
-    gsNode = node;
-    satNetDevice = DynamicCast<GSLNetDevice>(otherNode->GetDevice(otherDeviceId));
-    gsNetDevice = DynamicCast<GSLNetDevice>(node->GetDevice(deviceId));
-  }
+  return !MpiInterface::IsEnabled() || node->GetSystemId() == MpiInterface::GetSystemId();
+}
 
-  // Get GS Information
-  
-  Ptr<ns3::ndn::L3Protocol> gsNdn = gsNode->GetObject<ns3::ndn::L3Protocol>();
-  NS_ASSERT_MSG(gsNdn != 0, "Ndn stack should be installed on the ground station node");
-  shared_ptr<ns3::ndn::Face> gsFace = gsNdn->getFaceByNetDevice(gsNetDevice);
-  NS_ASSERT_MSG(gsFace != 0, "There is no face associated with the gsl link");
-  ns3::ndn::NetDeviceTransport* gsTransport = dynamic_cast<ns3::ndn::NetDeviceTransport*>(gsFace->getTransport());
-  NS_ASSERT_MSG(gsTransport != 0, "There is no valid transport associated with the ground station face");
-
-  // Get Sat Information
-  Ptr<ns3::ndn::L3Protocol> satNdn = satNode->GetObject<ns3::ndn::L3Protocol>();
-  NS_ASSERT_MSG(satNdn != 0, "Ndn stack should be installed on the satellite node");
-  shared_ptr<ns3::ndn::Face> satFace = satNdn->getFaceByNetDevice(satNetDevice);
-  NS_ASSERT_MSG(satFace != 0, "There is no face associated with the gsl link");
-  ns3::ndn::NetDeviceTransport* satTransport = dynamic_cast<ns3::ndn::NetDeviceTransport*>(satFace->getTransport());
-  NS_ASSERT_MSG(satTransport != 0, "There is no valid transport associated with the ground station face");
-  
-  // Remove route -> Add route -> Remove backward link
-  auto p = make_pair(node->GetId(), prefix);
-  shared_ptr<ns3::ndn::Face> prevCurFace, prevNextFace;
-  Address prevDest;
-  // Get delay value
-  Ptr<MobilityModel> senderMobility = node->GetObject<MobilityModel>();
-  Ptr<MobilityModel> receiverMobility = otherNode->GetObject<MobilityModel>();
-  double distance = senderMobility->GetDistanceFrom(receiverMobility);
-
-  if (node == gsNode) {
-    // gs -> sat
-    ns3::Simulator::Schedule(ns3::Seconds(HANDOVER_DURATION), &AddRouteCustom, node, prefix, gsFace, distance);
-  } else {
-    // sat -> gs
-    ns3::Simulator::Schedule(ns3::Seconds(HANDOVER_DURATION), &AddRouteCustom, node, prefix, satFace, distance);
-  }
+void RemoveNextHop(ns3::ndn::NetDeviceTransport* ts, Address dest) {
+  ts->RemoveNextHop(dest);
 }
 
 void NDNSatSimulator::AddGSLs() {
@@ -662,68 +605,101 @@ void NDNSatSimulator::AddGSLs() {
   // Check that all interfaces were created
   NS_ABORT_MSG_IF(total_num_gsl_ifs != devices.GetN(), "Not the expected amount of interfaces has been created.");
 
+  // Utilization tracking
+  if (m_enable_gsl_utilization_tracking) {
+    for (uint32_t i = 0; i < devices.GetN(); i++) {
+      TrackUtilization(devices.Get(i), -1);
+    }
+  }
+
   std::cout << "    >> GSL interfaces are setup" << std::endl;
 
 }
 
-void ReinstallGSL(ns3::NodeContainer gsNodes, ns3::NodeContainer satNodes) {
-  map<int, pair<double, Address> > nearestSat;
-  for (Ptr<Node> satNode : satNodes) {
-    Ptr<ns3::ndn::L3Protocol> satNdn = satNode->GetObject<ns3::ndn::L3Protocol>();
-    NS_ASSERT_MSG(satNdn != 0, "Ndn stack should be installed on the satellite node");
-    shared_ptr<ns3::ndn::Face> satFace;
-    // Find the GSL face among all, starting from the last index to optimize
-    int i = satNode->GetNDevices() - 1;
-    while (i >= 0) {
-      satFace = satNdn->getFaceByNetDevice(satNode->GetDevice(i));
-      if (satFace->getLinkType() == ::ndn::nfd::LINK_TYPE_AD_HOC) {
-        break;
-      }
-      i--;
-    }
-    // std::cout << "sat net id: " << i << " / " << satNode->GetNDevices() << std::endl;
-    NS_ASSERT_MSG(satFace != 0, "There is no face associated with the gsl link");
-    ns3::ndn::NetDeviceTransport* satTransport = dynamic_cast<ns3::ndn::NetDeviceTransport*>(satFace->getTransport());
+void NDNSatSimulator::TrackUtilization(Ptr<NetDevice> device, int32_t to) {
+  Ptr<Node> node = device->GetNode();
+  if (!IsLocal(node)) {
+    return;
+  }
+  // Grouped per orbit for satellites, per ground station otherwise
+  int32_t from = node->GetId();
+  std::string group = from < (int32_t) m_satelliteNodes.GetN() ? "orbit-" + std::to_string(from / m_satellites_per_orbit)
+                                                               : "gs-" + std::to_string(from - m_satelliteNodes.GetN());
+  Ptr<PointToPointLaserNetDevice> isl = DynamicCast<PointToPointLaserNetDevice>(device);
+  if (isl != nullptr) {
+    isl->SetUtilizationTracker(m_utilization_tracker, m_utilization_tracker->AddLink(from, to, m_utilization_tracker->GetGroup("isl-" + group)));
+  } else {
+    Ptr<GSLNetDevice> gsl = DynamicCast<GSLNetDevice>(device);
+    NS_ABORT_MSG_IF(gsl == nullptr, "Utilization is only tracked for ISL and GSL devices");
+    gsl->SetUtilizationTracker(m_utilization_tracker, m_utilization_tracker->AddLink(from, to, m_utilization_tracker->GetGroup("gsl-" + group)));
+  }
+}
+
+void NDNSatSimulator::SetUtilizationOutput(std::string dir) {
+  // One pair of files per rank when distributed
+  std::string suffix = m_partition != nullptr ? "_rank" + std::to_string(MpiInterface::GetSystemId()) : "";
+  bool per_link = parse_boolean(getConfigParamOrDefault("utilization_per_link", "true"));
+  bool per_group = parse_boolean(getConfigParamOrDefault("utilization_per_group", "false"));
+  m_utilization_tracker->SetOutput(per_link ? dir + "/utilization_links" + suffix + ".bin" : "",
+                                   per_group ? dir + "/utilization_groups" + suffix + ".bin" : "");
+}
+
+void NDNSatSimulator::InitFaceTable() {
+  // One table of the faces for the FIB updates and the GSL updates, built once the stacks are installed
+  if (m_face_table == nullptr) {
+    m_face_table = Create<ns3::ndn::LeoFaceTable>(m_allNodes);
+  }
+}
+
+void NDNSatSimulator::InitGSLVisibility() {
+  // Cache the GSL transport of every node, so epochs do not search the face tables
+  InitFaceTable();
+  for (Ptr<Node> satNode : m_satelliteNodes) {
+    int32_t gslDeviceId = m_face_table->GetGslDeviceId(satNode->GetId());
+    NS_ASSERT_MSG(gslDeviceId >= 0, "There is no face associated with the gsl link");
+    ns3::ndn::NetDeviceTransport* satTransport = m_face_table->GetTransport(satNode->GetId(), gslDeviceId);
     NS_ASSERT_MSG(satTransport != 0, "There is no valid transport associated with the satellite face");
+    m_sat_gsl.push_back({satTransport, satTransport->GetNetDevice()->GetAddress(), satNode->GetObject<MobilityModel>()});
+  }
+
+  // Ground stations do not move, so index them once
+  m_gs_grid = make_shared<GroundStationGrid>(MAX_GSL_LENGTH_M);
+  for (Ptr<Node> gsNode : m_groundStationNodes) {
+    ns3::ndn::NetDeviceTransport* gsTransport = m_face_table->GetTransport(gsNode->GetId(), 0);
+    NS_ASSERT_MSG(gsTransport != 0, "There is no valid transport associated with the ground station face");
+    Ptr<MobilityModel> gsMobility = gsNode->GetObject<MobilityModel>();
+    m_gs_grid->Add(m_gs_gsl.size(), gsMobility->GetPosition());
+    m_gs_gsl.push_back({gsTransport, gsTransport->GetNetDevice()->GetAddress(), gsMobility});
+  }
+}
+
+void NDNSatSimulator::ReinstallGSL() {
+  if (m_gs_grid == nullptr) {
+    InitGSLVisibility();
+  }
+  // Nearest satellite (distance, satellite index) per ground station, -1 if none in range
+  vector<pair<double, int32_t> > nearestSat(m_gs_gsl.size(), make_pair(0.0, -1));
+  vector<pair<uint32_t, double> > visible;
+  for (uint32_t s = 0; s < m_sat_gsl.size(); s++) {
+    const GslHandle& sat = m_sat_gsl[s];
     // Clear the next data hop
-    satTransport->ClearNextHop();
-    Ptr<MobilityModel> satMobility = satNode->GetObject<MobilityModel>();
-    Ptr<MobilityModel> gsMobility;
-    for (Ptr<Node> gsNode : gsNodes) {
-      Ptr<ns3::ndn::L3Protocol> gsNdn = gsNode->GetObject<ns3::ndn::L3Protocol>();
-      NS_ASSERT_MSG(gsNdn != 0, "Ndn stack should be installed on the gs node");
-      shared_ptr<ns3::ndn::Face> gsFace = gsNdn->getFaceByNetDevice(gsNode->GetDevice(0));
-      NS_ASSERT_MSG(gsFace != 0, "There is no face associated with the gsl link");
-      ns3::ndn::NetDeviceTransport* gsTransport = dynamic_cast<ns3::ndn::NetDeviceTransport*>(gsFace->getTransport());
-      NS_ASSERT_MSG(satTransport != 0, "There is no valid transport associated with the ground station face");
-      gsMobility = gsNode->GetObject<MobilityModel>();
-      // Calculate the GSL distance
-      double distance = satMobility->GetDistanceFrom(gsMobility);
-      if (distance <= MAX_GSL_LENGTH_M) {
-        // Add/set next hop for interest and data when they are in rance
-        satTransport->AddNextHop(gsTransport->GetNetDevice()->GetAddress());
-        // Add to the map if the entry doesn't exist
-        if (nearestSat.find(gsNode->GetId()) == nearestSat.end()) {
-          nearestSat[gsNode->GetId()] = make_pair(distance, satTransport->GetNetDevice()->GetAddress());
-        } else {
-          // Update the distance and the nearest satellite's address
-          if (nearestSat[gsNode->GetId()].first > distance) {
-            nearestSat[gsNode->GetId()] = make_pair(distance, satTransport->GetNetDevice()->GetAddress());
-          }
-        }
+    sat.transport->ClearNextHop();
+    m_gs_grid->Query(sat.mobility->GetPosition(), MAX_GSL_LENGTH_M, visible);
+    for (const auto& gs : visible) {
+      // Add/set next hop for interest and data when they are in range
+      sat.transport->AddNextHop(m_gs_gsl[gs.first].address);
+      // Update the distance and the nearest satellite (first one wins on ties)
+      pair<double, int32_t>& nearest = nearestSat[gs.first];
+      if (nearest.second < 0 || nearest.first > gs.second) {
+        nearest = make_pair(gs.second, (int32_t) s);
       }
     }
   }
   // Set ground station's next hop based on the nearest satellite
-  for (auto it = nearestSat.begin(); it != nearestSat.end(); it++) {
-    Ptr<Node> gsNode = gsNodes.Get(it->first - satNodes.GetN());
-    NS_ASSERT_MSG(gsNode != 0, "Invalid ground station node");
-    Ptr<ns3::ndn::L3Protocol> gsNdn = gsNode->GetObject<ns3::ndn::L3Protocol>();
-    NS_ASSERT_MSG(gsNdn != 0, "Ndn stack should be installed on the gs node");
-    shared_ptr<ns3::ndn::Face> gsFace = gsNdn->getFaceByNetDevice(gsNode->GetDevice(0));
-    NS_ASSERT_MSG(gsFace != 0, "There is no face associated with the gsl link");
-    ns3::ndn::NetDeviceTransport* gsTransport = dynamic_cast<ns3::ndn::NetDeviceTransport*>(gsFace->getTransport());
-    gsTransport->SetNextHop(it->second.second);
+  for (uint32_t g = 0; g < nearestSat.size(); g++) {
+    if (nearestSat[g].second >= 0) {
+      m_gs_gsl[g].transport->SetNextHop(m_sat_gsl[nearestSat[g].second].address);
+    }
   }
 }
 
@@ -732,8 +708,38 @@ void NDNSatSimulator::ImportDynamicStateSat(ns3::NodeContainer nodes, string dna
 }
 
 void NDNSatSimulator::ImportDynamicStateSat(ns3::NodeContainer nodes, string dname, int retx, bool complete, double limit) {
-  // Construct a  link inference from dynamic state
-  m_cur_next_hop = make_shared<map<pair<uint32_t, string>, tuple<shared_ptr<ns3::ndn::Face>, shared_ptr<ns3::ndn::Face>, Address> >> ();
+  // Next hops per (node, destination), replaced (or only added when complete) epoch by epoch
+  InitFaceTable();
+  m_fib_table = Create<ns3::ndn::LeoFibTable>(nodes, m_face_table, !complete);
+  // FIB changes in place, or through FIB manager command Interests as before
+  if (!parse_boolean(getConfigParamOrDefault("fib_updates_in_place", "true"))) {
+    m_fib_table->SetInPlace(false);
+    std::cout << "  > FIB updates................. command Interests" << std::endl;
+  }
+  // Compute the forwarding state in the simulation instead of replaying it
+  if (m_route_engine_enabled) {
+    m_route_engine = Create<LeoRouteEngine>(m_satelliteNodes, m_groundStationNodes, MAX_GSL_LENGTH_M);
+    m_route_engine->SetIncremental(m_route_engine_incremental);
+    m_route_engine->SetNThreads(m_route_engine_threads);
+    std::cout << "  > Computing routes every " << m_route_engine_interval_ns / 1000000.0 << " ms"
+              << (m_route_engine_incremental ? " (incremental)" : "") << " over "
+              << m_route_engine->GetNThreads() << " thread(s)" << std::endl;
+    ns3::Simulator::Schedule(ns3::Seconds(0), &NDNSatSimulator::ComputeRoutes, this, nodes, retx, limit);
+    ImportDone();
+    return;
+  }
+  // Replay a converted (binary) dynamic state lazily, one epoch at a time
+  string binary_path = FstateBinaryFile::FindInDirectory(dname);
+  if (!binary_path.empty()) {
+    m_fstate_binary = Create<FstateBinaryFile>(binary_path);
+    std::cout << "  > Replaying " << m_fstate_binary->GetNEpochs() << " epochs from " << binary_path << std::endl;
+    if (m_fstate_binary->GetNEpochs() > 0) {
+      ns3::Simulator::Schedule(ns3::NanoSeconds(m_fstate_binary->GetEpoch(0).timeNs), &NDNSatSimulator::LoadFstateEpoch,
+                               this, 0, nodes, retx, complete, limit);
+    }
+    ImportDone();
+    return;
+  }
   // Iterate through the dynamic state directory
   for (const auto & entry : filesystem::directory_iterator(dname)) {
     // Extract nanoseconds from file name
@@ -750,13 +756,13 @@ void NDNSatSimulator::ImportDynamicStateSat(ns3::NodeContainer nodes, string dna
       continue;
     } 
     int64_t current_node;
-    // int destination_node;
-    string prefix;
+    int64_t destination_node;
     int64_t next_hop;
 
-    ns3::Simulator::Schedule(ns3::MilliSeconds(ms), &ReinstallGSL, m_groundStationNodes, m_satelliteNodes);
+    ns3::Simulator::Schedule(ns3::MilliSeconds(ms), &NDNSatSimulator::ReinstallGSL, this);
   
-    // Read each file
+    // Read each file into one batch, applied right after the GSLs of the epoch
+    Ptr<ns3::ndn::LeoFibTable::Batch> batch = Create<ns3::ndn::LeoFibTable::Batch>();
     ifstream input(full_path);
     string line;
     while(getline(input, line))
@@ -764,40 +770,107 @@ void NDNSatSimulator::ImportDynamicStateSat(ns3::NodeContainer nodes, string dna
       vector<string> result;
       boost::split(result, line, boost::is_any_of(","));
       current_node = stoi(result[0]);
-      // destination_node = stoi(result[1]);
-      next_hop = stoi(result[2]);;
-      // Add AddRoute schedule
-      prefix = "/leo/uid-" + result[1];
+      // Other ranks keep the forwarding state of their own nodes
+      if (!IsLocal(nodes.Get(current_node))) {
+        continue;
+      }
+      destination_node = stoi(result[1]);
+      next_hop = stoi(result[2]);
 
       // Do client instant retransmission
       if (current_node >= m_satelliteNodes.GetN() && retx == 1) {
-        ns3::Simulator::ScheduleWithContext(current_node, ns3::MilliSeconds(ms + 1), &retransmitPitTable, nodes.Get(current_node), prefix);
+        ns3::Simulator::ScheduleWithContext(current_node, ns3::MilliSeconds(ms + 1), &NDNSatSimulator::InstantRetransmit, this,
+                                            nodes.Get(current_node), m_fib_table->GetPrefix(destination_node));
       }
-      // cout << ms / 1000 << "Add Route: " << current_node << "," << prefix << "," << next_hop << endl;
-
-      if (complete) {
-        if (current_node >= m_satelliteNodes.GetN() || next_hop >= m_satelliteNodes.GetN()) {
-          ns3::Simulator::Schedule(ns3::MilliSeconds(ms), &SetRouteGSL, nodes.Get(current_node), stoi(result[3]),
-                                  prefix, nodes.Get(next_hop), stoi(result[4]));
-        } else {
-          ns3::Simulator::Schedule(ns3::MilliSeconds(ms), &SetRouteISL, nodes.Get(current_node), stoi(result[3]),
-                                  prefix, nodes.Get(next_hop), stoi(result[4]));
-        }
+      // cout << ms / 1000 << "Add Route: " << current_node << "," << destination_node << "," << next_hop << endl;
+
+      if (next_hop < 0) {
+        batch->Remove(current_node, destination_node);
       } else {
-        if (current_node >= m_satelliteNodes.GetN() || next_hop >= m_satelliteNodes.GetN()) {
-          ns3::Simulator::Schedule(ns3::MilliSeconds(ms), &AddRouteGSL, nodes.Get(current_node), stoi(result[3]),
-                                  prefix, nodes.Get(next_hop), stoi(result[4]), m_cur_next_hop);
-        } else {
-          ns3::Simulator::Schedule(ns3::MilliSeconds(ms), &AddRouteISL, nodes.Get(current_node), stoi(result[3]),
-                                  prefix, nodes.Get(next_hop), stoi(result[4]), m_cur_next_hop);
-        }
+        batch->Add(current_node, destination_node, next_hop, stoi(result[3]));
       }
     }
+    m_fib_table->Schedule(batch, ns3::MilliSeconds(ms) + ns3::Seconds(HANDOVER_DURATION));
   }
+  ImportDone();
+}
+
+void NDNSatSimulator::ImportDone() {
+  EndPhase("import_dynamic_state");
   std::cout << "Import success" << std::endl;
   std::cout << std::endl;
 }
 
+void NDNSatSimulator::LoadFstateEpoch(uint32_t epoch, ns3::NodeContainer nodes, int retx, bool complete, double limit) {
+  const FstateEpoch& info = m_fstate_binary->GetEpoch(epoch);
+  // Epochs are sorted by time, so the first skipped epoch ends the replay
+  if (m_satellite_network_force_static && info.timeNs != 0) {
+    return;
+  }
+  double ms = info.timeNs / 1000000.0;
+  if (limit >= 0 && ms > limit * 1000) {
+    return;
+  }
+
+  ReinstallGSL();
+
+  ApplyFstateRecords(m_fstate_binary->GetRecords(epoch), info.numRecords, nodes, retx);
+
+  // Only the next epoch is ever pending in the event queue
+  if (epoch + 1 < m_fstate_binary->GetNEpochs()) {
+    Time next = ns3::NanoSeconds(m_fstate_binary->GetEpoch(epoch + 1).timeNs);
+    ns3::Simulator::Schedule(next - ns3::Simulator::Now(), &NDNSatSimulator::LoadFstateEpoch,
+                             this, epoch + 1, nodes, retx, complete, limit);
+  }
+}
+
+void NDNSatSimulator::ComputeRoutes(ns3::NodeContainer nodes, int retx, double limit) {
+  ReinstallGSL();
+
+  const std::vector<FstateRecord>& changes = m_route_engine->Update();
+  ApplyFstateRecords(changes.data(), changes.size(), nodes, retx);
+
+  // A static network keeps the forwarding state of t=0
+  if (m_satellite_network_force_static) {
+    return;
+  }
+  Time next = ns3::Simulator::Now() + ns3::NanoSeconds(m_route_engine_interval_ns);
+  if (limit >= 0 && next > ns3::Seconds(limit)) {
+    return;
+  }
+  ns3::Simulator::Schedule(ns3::NanoSeconds(m_route_engine_interval_ns), &NDNSatSimulator::ComputeRoutes,
+                           this, nodes, retx, limit);
+}
+
+void NDNSatSimulator::ApplyFstateRecords(const FstateRecord* records, uint64_t n, ns3::NodeContainer nodes, int retx) {
+  Ptr<ns3::ndn::LeoFibTable::Batch> batch = Create<ns3::ndn::LeoFibTable::Batch>();
+  for (uint64_t i = 0; i < n; i++) {
+    const FstateRecord& r = records[i];
+    if (!IsLocal(nodes.Get(r.current))) {
+      continue;
+    }
+
+    // Do client instant retransmission
+    if (r.current >= (int32_t) m_satelliteNodes.GetN() && retx == 1) {
+      ns3::Simulator::ScheduleWithContext(r.current, ns3::MilliSeconds(1), &NDNSatSimulator::InstantRetransmit, this,
+                                          nodes.Get(r.current), m_fib_table->GetPrefix(r.destination));
+    }
+
+    if (r.nextHop < 0) {
+      batch->Remove(r.current, r.destination);
+    } else {
+      batch->Add(r.current, r.destination, r.nextHop, r.currentIf);
+    }
+  }
+  m_fib_table->Schedule(batch, ns3::Seconds(HANDOVER_DURATION));
+}
+
+void NDNSatSimulator::InstantRetransmit(Ptr<Node> node, ndn::Name prefix) {
+  if (m_instant_retx) {
+    retransmitPitTable(node, prefix);
+  }
+}
+
 void ForceTimeout(Ptr<ndn::Consumer> app) {
   app->ForceTimeout();
 }
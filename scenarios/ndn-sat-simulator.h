@@ -24,6 +24,7 @@
 #include "ns3/ground-station.h"
 #include "ns3/satellite-position-helper.h"
 #include "ns3/satellite-position-mobility-model.h"
+#include "ns3/satellite-constellation.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/string.h"
 #include "ns3/type-id.h"
@@ -42,6 +43,18 @@
 #include "ns3/ndnSIM/model/ndn-net-device-transport.hpp"
 // #include "ns3/ndn-multicast-net-device-transport.h"
 #include "ns3/ndn-leo-stack-helper.h"
+#include "ns3/ndn-leo-fib-table.h"
+#include "ns3/ndn-leo-face-table.h"
+#include "ns3/fstate-binary.h"
+#include "ns3/ground-station-grid.h"
+#include "ns3/propagation-delay-table.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/constellation-partition-helper.h"
+#include "ns3/leo-route-engine.h"
+#include "ns3/utilization-tracker.h"
+#include "ns3/phase-profiler.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/event-profiler.h"
 
 namespace ns3 {
 
@@ -54,6 +67,13 @@ public:
 
   std::string getConfigParamOrDefault(std::string key, std::string default_value);
 
+  // Records the setup phase which has just completed (if phase profiling is enabled)
+  void EndPhase(std::string name);
+
+  // Starts the event profile over (if event profiling is enabled), leaving out the warm-up
+  // runs of the setup; called right before the Simulator::Run of the simulation
+  void StartEventProfile();
+
   void ReadConfig(std::string conf);
 
   void ReadSatellites();
@@ -62,16 +82,53 @@ public:
 
   void ReadISLs();
 
+  // Estimates the traffic of every ISL from the routes of the first epoch (min-cut partitioning)
+  void EstimateISLTraffic(int64_t num_satellites);
+
+  // True if the node is simulated by this rank (always true unless distributed)
+  bool IsLocal(Ptr<Node> node) const;
+
   // void AddRouteISL(ns3::Ptr<ns3::Node> node, string prefix, ns3::Ptr<ns3::Node> otherNode, int metric);
 
   // void AddRouteGSL(ns3::Ptr<ns3::Node> node, string prefix, ns3::Ptr<ns3::Node> otherNode, int metric);
 
   void AddGSLs();
 
+  // Reports the busy periods of a local ISL or GSL device to the utilization tracker
+  void TrackUtilization(Ptr<NetDevice> device, int32_t to);
+
+  // Writes the utilization of the next run to <dir>/utilization_links.bin and utilization_groups.bin
+  void SetUtilizationOutput(std::string dir);
+
+  // Builds m_face_table, shared by the FIB and GSL updates (done on first use)
+  void InitFaceTable();
+
+  // Caches the GSL transports and indexes the ground stations (done on first use)
+  void InitGSLVisibility();
+
+  // Recomputes which ground stations each satellite can reach over its GSL
+  void ReinstallGSL();
+
   void ImportDynamicStateSat(ns3::NodeContainer nodes, string dname, int retx, bool complete);
 
   void ImportDynamicStateSat(ns3::NodeContainer nodes, string dname, int retx, bool complete, double limit);
 
+  // Ends the import of the dynamic state, whichever way it is replayed or computed
+  void ImportDone();
+
+  // Applies one epoch of a binary fstate file and schedules the next one
+  void LoadFstateEpoch(uint32_t epoch, ns3::NodeContainer nodes, int retx, bool complete, double limit);
+
+  // Computes the forwarding state of the current epoch in the simulation and schedules the next one
+  void ComputeRoutes(ns3::NodeContainer nodes, int retx, double limit);
+
+  // Applies forwarding state changes (fstate records) right after the GSLs of the epoch
+  void ApplyFstateRecords(const FstateRecord* records, uint64_t n, ns3::NodeContainer nodes, int retx);
+
+  // Instant retransmission of the pending interests of a ground station after a handover
+  // (scheduled when importing the dynamic state with retx = 1, skipped if m_instant_retx is off)
+  void InstantRetransmit(Ptr<Node> node, ndn::Name prefix);
+
   // Input
   std::string m_satellite_network_dir;          //<! Directory containing satellite network information
   std::string m_satellite_network_routes_dir;   //<! Directory containing the routes over time of the network
@@ -79,6 +136,7 @@ public:
                                               //   it static at t=0 (like a static network)
   std::string m_prefix;                         // NDN's prefix
   std::string m_name;
+  bool m_instant_retx;                          //<! False to ignore the scheduled instant retransmissions
 
   // Generated state
   NodeContainer m_allNodes;                           //!< All nodes
@@ -86,15 +144,31 @@ public:
   NodeContainer m_satelliteNodes;                     //!< Satellite nodes
   std::vector<Ptr<GroundStation> > m_groundStations;  //!< Ground stations
   std::vector<Ptr<Satellite>> m_satellites;           //<! Satellites
+  Ptr<SatelliteConstellation> m_constellation;        //<! Propagates all satellites at once (with a position grid)
   std::set<int64_t> m_endpoints;                      //<! Endpoint ids = ground station ids
-  std::shared_ptr<map<pair<uint32_t, string>, tuple<shared_ptr<ns3::ndn::Face>, shared_ptr<ns3::ndn::Face>, Address> > > m_cur_next_hop;
+  Ptr<ns3::ndn::LeoFibTable> m_fib_table;            //<! Next hop per (node, destination)
+  Ptr<ns3::ndn::LeoFaceTable> m_face_table;          //<! Face per (node, device)
   std::shared_ptr<map<pair<uint32_t, string>, pair<shared_ptr<ns3::ndn::Face>, Address > > > m_active_hop_count;
+  Ptr<FstateBinaryFile> m_fstate_binary;              //<! Memory-mapped dynamic state (if converted)
+  std::shared_ptr<ConstellationPartitionHelper> m_partition;  //<! Assignment of the nodes to ranks (if distributed)
+  Ptr<LeoRouteEngine> m_route_engine;                //<! Forwarding state computed in the simulation (if enabled)
+  Ptr<UtilizationTracker> m_utilization_tracker;     //<! Busy fraction of the ISLs and GSLs (if tracking is enabled)
+  Ptr<PhaseProfiler> m_profiler;                     //<! Time and memory per setup phase (if profiling is enabled)
+  Ptr<EventProfiler> m_event_profiler;               //<! Time per type of event of the run (if profiling is enabled)
+
+  // GSL visibility
+  struct GslHandle {
+    ns3::ndn::NetDeviceTransport* transport;
+    Address address;
+    Ptr<MobilityModel> mobility;
+  };
+  std::vector<GslHandle> m_sat_gsl;                   //<! GSL transport per satellite
+  std::vector<GslHandle> m_gs_gsl;                    //<! GSL transport per ground station
+  std::shared_ptr<GroundStationGrid> m_gs_grid;       //<! Spatial index over ground stations
   // std::vector<std::tuple<double, Ptr<Node>, string, Ptr<PointToPointLaserNetDevice> > > m_pending_fib;
 
   // ISL devices
   Ipv4AddressHelper m_ipv4_helper;
-  NetDeviceContainer m_islNetDevices;
-  std::vector<std::pair<int32_t, int32_t>> m_islFromTo;
   std::map<std::string, std::string> m_config;
 
   // Values
@@ -105,9 +179,14 @@ public:
   double m_isl_error_rate;
   double m_gsl_error_rate;
   bool m_enable_isl_utilization_tracking;
-  int64_t m_isl_utilization_tracking_interval_ns;
+  bool m_enable_gsl_utilization_tracking;
+  int64_t m_satellites_per_orbit;
   int64_t m_node1_id;
   int64_t m_node2_id;
+  bool m_route_engine_enabled;
+  bool m_route_engine_incremental;
+  int64_t m_route_engine_interval_ns;
+  int64_t m_route_engine_threads;                     //<! Worker threads of the route engine (at least 1)
 };
 
 }
@@ -24,14 +24,18 @@ public:
     consumerHelper.SetPrefix(m_prefix);
     consumerHelper.SetAttribute("Frequency", StringValue("1000"));
     consumerHelper.SetAttribute("RetxTimer", StringValue("10000s"));
-    consumerHelper.Install(node1).Start(Seconds(0.5)); // first node
+    if (IsLocal(node1)) {
+      consumerHelper.Install(node1).Start(Seconds(0.5)); // first node
+    }
 
     // Producer
     ndn::AppHelper producerHelper("ns3::ndn::Producer");
     // Producer will reply to all requests starting with prefix
     producerHelper.SetPrefix(m_prefix);
     producerHelper.SetAttribute("PayloadSize", StringValue("0"));
-    producerHelper.Install(node2).Start(Seconds(0.5)); // last node
+    if (IsLocal(node2)) {
+      producerHelper.Install(node2).Start(Seconds(0.5)); // last node
+    }
 
     cout << "Setting up FIB schedules..."  << endl;
 
@@ -49,7 +53,11 @@ public:
     // }
     // string run_dir = m_satellite_network_dir.substr(start_index);
     // cout << "experiments/a_b/runs/" + m_name + "/app-delays-trace.txt" << endl;
-    ndn::AppDelayTracer::InstallAll("experiments/a_b/runs/" + m_name + "/app-delays-trace.txt");
+    // Only the consumer's rank has delays to trace
+    if (IsLocal(node1)) {
+      ndn::AppDelayTracer::InstallAll("experiments/a_b/runs/" + m_name + "/app-delays-trace.txt");
+    }
+    StartEventProfile();
     Simulator::Run();
     Simulator::Destroy();
   }
@@ -66,15 +74,24 @@ main(int argc, char* argv[])
   // Retrieve run directory
   ns3::CommandLine cmd;
   std::string run_dir = "";
+  bool distributed = false;
   cmd.Usage("Usage: ./waf --run=\"run --run_dir='<path/to/run/directory>'\"");
   cmd.AddValue("run_dir",  "Run directory", run_dir);
+  cmd.AddValue("distributed", "Distribute the nodes over the MPI ranks (mpirun -np <ranks>)", distributed);
   cmd.Parse(argc, argv);
   if (run_dir.compare("") == 0) {
       printf("Usage: ./waf --run=\"run --run_dir='<path/to/run/directory>'\"");
       return 0;
   }
+  if (distributed) {
+    ns3::GlobalValue::Bind("SimulatorImplementationType", ns3::StringValue("ns3::DistributedSimulatorImpl"));
+    ns3::MpiInterface::Enable(&argc, &argv);
+  }
   string ns3_config = "experiments/a_b/runs/" + run_dir + "/config_ns3.properties";
   ns3::ScenarioSim sim = ns3::ScenarioSim(ns3_config);
   sim.Run();
+  if (distributed) {
+    ns3::MpiInterface::Disable();
+  }
   return 0;
 }
@@ -0,0 +1,204 @@
+// a_b_sweep.cc
+// Runs several a_b run directories from one process: the constellation, the NDN stacks
+// and the dynamic state are set up once, then every run is simulated in a forked child
+// (sharing the setup copy-on-write), at most one per core at a time.
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <thread>
+#include "../ndn-sat-simulator.h"
+#include "ns3/basic-simulation.h"
+
+namespace ns3 {
+
+// The per-run parameters; every other key of the run configs must be equal
+struct SweepPoint {
+  std::string name;
+  int64_t from_id;
+  int64_t to_id;
+  std::string ndn_client;
+};
+
+static const std::set<std::string> SWEEP_KEYS = {"name", "from_id", "to_id", "ndn_client"};
+
+// Clients with instant retransmission on handover (see experiments/a_b/run_list.py)
+static bool UsesInstantRetx(const std::string& ndn_client) {
+  return ndn_client == "PingInstantRetx" || ndn_client == "FixedWindowRetx";
+}
+
+class ScenarioSim : public NDNSatSimulator {
+public:
+  using NDNSatSimulator::NDNSatSimulator;
+
+  void Setup(bool instant_retx) {
+    cout << "Setting up FIB schedules..."  << endl;
+    ImportDynamicStateSat(m_allNodes, m_satellite_network_routes_dir, instant_retx ? 1 : 0, false);
+  }
+
+  // Same applications and strategies as the a_b_<client>.cc runs
+  void Run(const SweepPoint& point) {
+    m_name = point.name;
+    m_node1_id = point.from_id;
+    m_node2_id = point.to_id;
+    m_instant_retx = UsesInstantRetx(point.ndn_client);
+    if (m_utilization_tracker != nullptr) {
+      SetUtilizationOutput("experiments/a_b/runs/" + m_name);
+    }
+    if (m_profiler != nullptr) {
+      m_profiler->SetFile("experiments/a_b/runs/" + m_name + "/phase_profile.csv");
+    }
+    if (m_event_profiler != nullptr) {
+      m_event_profiler->SetFile("experiments/a_b/runs/" + m_name + "/event_profile.csv");
+    }
+    bool fixed_window = point.ndn_client == "FixedWindow" || point.ndn_client == "FixedWindowRetx";
+    bool nack_retx = point.ndn_client == "PingNackRetx" || point.ndn_client == "FixedWindowRetx";
+
+    // Choosing forwarding strategy
+    std::cout << "  > Installing forwarding strategy" << std::endl;
+    ndn::StrategyChoiceHelper::Install(m_allNodes, "/", nack_retx ? "/localhost/nfd/strategy/nack-retx"
+                                                                  : "/localhost/nfd/strategy/best-route");
+    std::string prefix = "/leo/uid-";
+    Ptr<Node> node1 = m_allNodes.Get(m_node1_id);
+    Ptr<Node> node2 = m_allNodes.Get(m_node2_id);
+    m_prefix = prefix + to_string(m_node2_id);
+
+    // Consumer
+    ndn::AppHelper consumerHelper(fixed_window ? "ns3::ndn::ConsumerFixedWindow" : "ns3::ndn::ConsumerPing");
+    consumerHelper.SetPrefix(m_prefix);
+    if (fixed_window) {
+      consumerHelper.SetAttribute("Window", StringValue("10"));
+      consumerHelper.SetAttribute("PayloadSize", StringValue("1380"));
+    } else {
+      consumerHelper.SetAttribute("Frequency", StringValue("1000"));
+      consumerHelper.SetAttribute("RetxTimer", StringValue("10000s"));
+    }
+    consumerHelper.Install(node1).Start(Seconds(0.5));
+
+    // Producer
+    ndn::AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix(m_prefix);
+    producerHelper.SetAttribute("PayloadSize", StringValue(fixed_window ? "1380" : (nack_retx ? "1" : "0")));
+    producerHelper.Install(node2).Start(Seconds(0.5));
+
+    cout << "Starting the simulation"  << endl;
+    Simulator::Stop(Seconds(200));
+    ndn::AppDelayTracer::InstallAll("experiments/a_b/runs/" + m_name + "/app-delays-trace.txt");
+    StartEventProfile();
+    Simulator::Run();
+    Simulator::Destroy();
+  }
+};
+
+static std::string ConfigPath(const std::string& run_dir) {
+  return "experiments/a_b/runs/" + run_dir + "/config_ns3.properties";
+}
+
+static std::vector<SweepPoint> ReadSweepPoints(const std::vector<std::string>& run_dirs) {
+  std::map<std::string, std::string> reference = read_config(ConfigPath(run_dirs[0]));
+  // The recording scheduler is set up (with the events of the setup) before the runs are
+  // forked, so they would all write to its one trace file
+  if (reference.count("scheduler_trace_file") != 0 && !reference["scheduler_trace_file"].empty()) {
+    throw std::runtime_error("scheduler_trace_file is not supported by a_b_sweep, record the trace with a single run instead");
+  }
+  std::vector<SweepPoint> points;
+  for (const std::string& run_dir : run_dirs) {
+    std::map<std::string, std::string> config = read_config(ConfigPath(run_dir));
+    // Both ways, so that a key only set by this run is found as well
+    std::set<std::string> keys;
+    for (const auto& entry : reference) {
+      keys.insert(entry.first);
+    }
+    for (const auto& entry : config) {
+      keys.insert(entry.first);
+    }
+    for (const std::string& key : keys) {
+      if (SWEEP_KEYS.count(key) == 0
+          && (reference.count(key) == 0 || config.count(key) == 0 || config[key] != reference[key])) {
+        throw std::runtime_error("Run " + run_dir + " differs from the first run in " + key);
+      }
+    }
+    SweepPoint point;
+    point.name = config.count("name") ? config["name"] : run_dir;
+    point.from_id = stoi(config["from_id"]);
+    point.to_id = stoi(config["to_id"]);
+    point.ndn_client = config["ndn_client"];
+    points.push_back(point);
+  }
+  return points;
+}
+
+}
+
+int
+main(int argc, char* argv[])
+{
+  // No buffering of printf
+  setbuf(stdout, nullptr);
+  // Retrieve run directories
+  ns3::CommandLine cmd;
+  std::string run_dirs = "";
+  uint32_t max_processes = std::max(1u, std::thread::hardware_concurrency());
+  cmd.Usage("Usage: ./waf --run=\"a_b_sweep --run_dirs='<run directory>,<run directory>,...'\"");
+  cmd.AddValue("run_dirs", "Comma-separated run directories (in experiments/a_b/runs), differing only in "
+               "name, from_id, to_id and ndn_client", run_dirs);
+  cmd.AddValue("max_processes", "Maximum number of runs simulated at the same time (default: one per core)", max_processes);
+  cmd.Parse(argc, argv);
+  if (run_dirs.compare("") == 0 || max_processes == 0) {
+      printf("Usage: ./waf --run=\"a_b_sweep --run_dirs='<run directory>,<run directory>,...'\"");
+      return 0;
+  }
+
+  // The first run describes the shared setup
+  std::vector<std::string> dirs;
+  boost::split(dirs, run_dirs, boost::is_any_of(","));
+  std::vector<ns3::SweepPoint> points = ns3::ReadSweepPoints(dirs);
+  bool instant_retx = false;
+  for (const ns3::SweepPoint& point : points) {
+    instant_retx = instant_retx || ns3::UsesInstantRetx(point.ndn_client);
+  }
+
+  ns3::ScenarioSim sim = ns3::ScenarioSim(ns3::ConfigPath(dirs[0]));
+  sim.Setup(instant_retx);
+
+  // One child per run, each logging to its own console.txt
+  std::map<pid_t, std::string> running;
+  int failed = 0;
+  auto wait_one = [&running, &failed]() {
+    int status;
+    pid_t pid = waitpid(-1, &status, 0);
+    bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    printf("%s run %s\n", ok ? "Finished" : "FAILED", running[pid].c_str());
+    failed += ok ? 0 : 1;
+    running.erase(pid);
+  };
+  for (uint32_t i = 0; i < points.size(); i++) {
+    if (running.size() >= max_processes) {
+      wait_one();
+    }
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid < 0) {
+      perror("fork");
+      return 1;
+    }
+    if (pid == 0) {
+      std::string logs_dir = "experiments/a_b/runs/" + points[i].name + "/logs_ns3";
+      std::filesystem::create_directories(logs_dir);
+      if (freopen((logs_dir + "/console.txt").c_str(), "w", stdout) == nullptr) {
+        _exit(1);
+      }
+      dup2(fileno(stdout), fileno(stderr));
+      sim.Run(points[i]);
+      // _exit: the atexit handlers and static destructors belong to the parent's setup
+      std::cout.flush();
+      fflush(stdout);
+      _exit(0);
+    }
+    running[pid] = points[i].name;
+    printf("Started run %d out of %d: %s\n", i + 1, (int) points.size(), points[i].name.c_str());
+  }
+  while (!running.empty()) {
+    wait_one();
+  }
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+// startup_profile.cc
+// Regression benchmark of the setup of the bundled Starlink dataset (1584 satellites, 12
+// ground stations) followed by one simulated second of ping, with phase profiling on. The
+// wall time and memory of every setup phase are compared with those of a baseline report:
+//
+// ./waf --run="startup_profile"                                   (writes startup_profile.csv)
+// ./waf --run="startup_profile --baseline=startup_profile_base.csv --tolerance=0.2"
+//
+// Exits with 1 if a phase, or the whole run, took more time or memory than the baseline
+// by more than the tolerance (and than the noise floor).
+#include "../ndn-sat-simulator.h"
+#include "ns3/basic-simulation.h"
+
+namespace ns3 {
+
+// Below these, differences are measurement noise
+static const double MIN_WALL_S = 0.05;
+static const double MIN_RSS_MB = 5;
+
+class ScenarioSim : public NDNSatSimulator {
+public:
+  using NDNSatSimulator::NDNSatSimulator;
+  void Run() {
+    NS_ABORT_MSG_IF(m_profiler == nullptr, "startup_profile needs phase_profiling=true");
+    ndn::StrategyChoiceHelper::Install(m_allNodes, "/", "/localhost/nfd/strategy/best-route");
+    m_prefix = "/leo/uid-" + to_string(m_node2_id);
+
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerPing");
+    consumerHelper.SetPrefix(m_prefix);
+    consumerHelper.SetAttribute("Frequency", StringValue("1000"));
+    consumerHelper.SetAttribute("RetxTimer", StringValue("10000s"));
+    consumerHelper.Install(m_allNodes.Get(m_node1_id)).Start(Seconds(0.5));
+
+    ndn::AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix(m_prefix);
+    producerHelper.SetAttribute("PayloadSize", StringValue("0"));
+    producerHelper.Install(m_allNodes.Get(m_node2_id)).Start(Seconds(0.5));
+    EndPhase("install_apps");
+
+    ImportDynamicStateSat(m_allNodes, m_satellite_network_routes_dir, 0, false);
+
+    cout << "Starting the simulation"  << endl;
+    Simulator::Stop(NanoSeconds(parse_positive_int64(getConfigParamOrDefault("simulation_end_time_ns", "1000000000"))));
+    StartEventProfile();
+    Simulator::Run();
+    // Takes the last record and writes the report
+    Simulator::Destroy();
+  }
+};
+
+static bool Regressed(double value, double baseline, double tolerance, double floor) {
+  return value > baseline * (1 + tolerance) && value - baseline > floor;
+}
+
+// Prints the phases of the report and compares them with the baseline (if any)
+static int Compare(const std::vector<PhaseProfiler::Record>& report, const std::vector<PhaseProfiler::Record>& baseline,
+                   double tolerance) {
+  std::map<std::string, const PhaseProfiler::Record*> base;
+  for (const PhaseProfiler::Record& r : baseline) {
+    if (r.kind == "phase" || r.name == "end") {
+      base[r.name] = &r;
+    }
+  }
+  int regressions = 0;
+  printf("%-24s %12s %12s %12s %12s\n", "phase", "wall (s)", "base (s)", "RSS +(MB)", "base (MB)");
+  for (const PhaseProfiler::Record& r : report) {
+    if (r.kind != "phase" && r.name != "end") {
+      continue;
+    }
+    // The whole run is compared on its totals
+    double wall = r.name == "end" ? r.wallTotalS : r.wallS;
+    double rss = r.name == "end" ? r.rssMb : r.rssDeltaMb;
+    auto it = base.find(r.name);
+    if (it == base.end()) {
+      printf("%-24s %12.3f %12s %12.1f %12s\n", r.name.c_str(), wall, "-", rss, "-");
+      continue;
+    }
+    double base_wall = r.name == "end" ? it->second->wallTotalS : it->second->wallS;
+    double base_rss = r.name == "end" ? it->second->rssMb : it->second->rssDeltaMb;
+    bool regressed = Regressed(wall, base_wall, tolerance, MIN_WALL_S) || Regressed(rss, base_rss, tolerance, MIN_RSS_MB);
+    regressions += regressed ? 1 : 0;
+    printf("%-24s %12.3f %12.3f %12.1f %12.1f%s\n", r.name.c_str(), wall, base_wall, rss, base_rss,
+           regressed ? "  REGRESSION" : "");
+  }
+  return regressions;
+}
+
+}
+
+int
+main(int argc, char* argv[])
+{
+  // No buffering of printf
+  setbuf(stdout, nullptr);
+  ns3::CommandLine cmd;
+  std::string config = "scenarios/config/startup_profile.properties";
+  std::string baseline = "";
+  double tolerance = 0.2;
+  cmd.Usage("Usage: ./waf --run=\"startup_profile [--baseline='<report.csv>'] [--tolerance=0.2]\"");
+  cmd.AddValue("config", "Configuration of the run (with phase_profiling=true)", config);
+  cmd.AddValue("baseline", "Report of a previous run to compare with (empty: only print the report)", baseline);
+  cmd.AddValue("tolerance", "Relative increase of the wall time or memory of a phase counted as a regression", tolerance);
+  cmd.Parse(argc, argv);
+
+  ns3::ScenarioSim sim = ns3::ScenarioSim(config);
+  sim.Run();
+
+  std::vector<ns3::PhaseProfiler::Record> report = ns3::PhaseProfiler::ReadReport(sim.m_profiler->GetFile());
+  std::vector<ns3::PhaseProfiler::Record> base;
+  if (!baseline.empty()) {
+    base = ns3::PhaseProfiler::ReadReport(baseline);
+  }
+  printf("\nReport: %s\n", sim.m_profiler->GetFile().c_str());
+  int regressions = ns3::Compare(report, base, tolerance);
+  if (regressions > 0) {
+    printf("%d regression(s) over %s (tolerance %.0f %%)\n", regressions, baseline.c_str(), tolerance * 100);
+    return 1;
+  }
+  return 0;
+}
@@ -99,6 +99,11 @@ void
 DefaultSimulatorImpl::Destroy ()
 {
   NS_LOG_FUNCTION (this);
+  if (m_eventProfiler != 0)
+    {
+      m_eventProfiler->Flush ();
+      m_eventProfiler = 0;
+    }
   while (!m_destroyEvents.empty ())
     {
       Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
@@ -128,6 +133,13 @@ DefaultSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
   m_events = scheduler;
 }
 
+void
+DefaultSimulatorImpl::SetEventProfiler (Ptr<EventProfiler> profiler)
+{
+  NS_LOG_FUNCTION (this << profiler);
+  m_eventProfiler = profiler;
+}
+
 // System ID for non-distributed simulation is always zero
 uint32_t
 DefaultSimulatorImpl::GetSystemId (void) const
@@ -148,7 +160,14 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
-  next.impl->Invoke ();
+  if (m_eventProfiler == 0)
+    {
+      next.impl->Invoke ();
+    }
+  else
+    {
+      m_eventProfiler->Invoke (next.impl, m_currentTs, m_unscheduledEvents);
+    }
   next.impl->Unref ();
 
   ProcessEventsWithContext ();
@@ -418,4 +437,10 @@ DefaultSimulatorImpl::GetEventCount (void) const
   return m_eventCount;
 }
 
+uint64_t
+DefaultSimulatorImpl::GetPendingEventCount (void) const
+{
+  return m_unscheduledEvents;
+}
+
 } // namespace ns3
@@ -24,6 +24,7 @@
 #include "simulator-impl.h"
 #include "scheduler.h"
 #include "event-impl.h"
+#include "event-profiler.h"
 #include "system-thread.h"
 #include "system-mutex.h"
 
@@ -78,6 +79,15 @@ public:
   virtual uint32_t GetSystemId (void) const;
   virtual uint32_t GetContext (void) const;
   virtual uint64_t GetEventCount (void) const;
+  virtual uint64_t GetPendingEventCount (void) const;
+
+  /**
+   * Time every event from now on with a profiler, until the simulation is
+   * destroyed (when the profiler is flushed).
+   *
+   * \param [in] profiler The profiler, or 0 to stop profiling.
+   */
+  void SetEventProfiler (Ptr<EventProfiler> profiler);
 
 private:
   virtual void DoDispose (void);
@@ -134,6 +144,9 @@ private:
    */
   int m_unscheduledEvents;
 
+  /** Times the events, if set. */
+  Ptr<EventProfiler> m_eventProfiler;
+
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
 };
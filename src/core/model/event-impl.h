@@ -65,6 +65,12 @@ public:
    * Checked by the simulation engine before calling Invoke().
    */
   bool IsCancelled (void);
+  /**
+   * \returns The address of the function or class method which the event
+   * invokes, or 0 if unknown (e.g., for an std::function). Used to tell
+   * the events apart when profiling (see EventProfiler).
+   */
+  virtual const void * GetFunction (void);
 
 protected:
   /**
@@ -0,0 +1,343 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+#include "event-impl.h"
+#include "abort.h"
+#include "log.h"
+#include "nstime.h"
+#include "ns3/core-config.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#if (__GNUC__ >= 3)
+#include <cxxabi.h>
+#endif
+#ifdef HAVE_EXECINFO_H
+#include <execinfo.h>
+#endif
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventProfiler");
+
+namespace {
+
+/**
+ * \param [in] mangled A mangled C++ name.
+ * \returns The demangled name, or \p mangled if it cannot be demangled.
+ */
+std::string
+Demangle (const char *mangled)
+{
+  std::string name = mangled;
+#if (__GNUC__ >= 3)
+  int status;
+  char *demangled = abi::__cxa_demangle (mangled, NULL, NULL, &status);
+  if (status == 0)
+    {
+      name = demangled;
+    }
+  std::free (demangled);
+#endif
+  return name;
+}
+
+/**
+ * \param [in] name A demangled function name.
+ * \returns The name without the arguments, e.g. "ns3::A<int>::F" for
+ *          "ns3::A<int>::F(int, double)".
+ */
+std::string
+StripArguments (const std::string &name)
+{
+  int depth = 0;
+  for (std::size_t i = 0; i < name.size (); i++)
+    {
+      depth += name[i] == '<' ? 1 : name[i] == '>' ? -1 : 0;
+      if (name[i] == '(' && depth == 0 && i > 0)
+        {
+          return name.substr (0, i);
+        }
+    }
+  return name;
+}
+
+/**
+ * \param [in] address The address of a function.
+ * \returns The name of the exported symbol at exactly this address, or
+ *          an empty string.
+ */
+std::string
+LookUpSymbol (const void *address)
+{
+  std::string name;
+#ifdef HAVE_EXECINFO_H
+  // "<object>(<mangled name>+<offset>) [<address>]", only functions which
+  // start at the address are the ones looked for
+  void *addresses[1] = {const_cast<void *> (address)};
+  char **symbols = backtrace_symbols (addresses, 1);
+  if (symbols != 0)
+    {
+      const char *open = std::strchr (symbols[0], '(');
+      const char *plus = open == 0 ? 0 : std::strchr (open, '+');
+      char *end = 0;
+      if (plus != 0 && plus > open + 1 && std::strtoul (plus + 1, &end, 0) == 0 && *end == ')')
+        {
+          name = StripArguments (Demangle (std::string (open + 1, plus).c_str ()));
+        }
+      std::free (symbols);
+    }
+#endif
+  return name;
+}
+
+} // unnamed namespace
+
+EventProfiler::EventProfiler (const std::string &file, double intervalS, uint32_t nTop)
+  : m_progress (0),
+    m_interval (std::chrono::duration_cast<std::chrono::steady_clock::duration> (std::chrono::duration<double> (intervalS))),
+    m_nTop (nTop),
+    m_flushed (false),
+    m_started (false),
+    m_start (std::chrono::steady_clock::now ()),
+    m_intervalStart (m_start),
+    m_intervalStartTs (0),
+    m_ts (0),
+    m_pending (0),
+    m_intervalEvents (0)
+{
+  NS_LOG_FUNCTION (this << file << intervalS << nTop);
+  Open (file);
+}
+
+EventProfiler::~EventProfiler ()
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+}
+
+void
+EventProfiler::SetProgressStream (std::ostream *os)
+{
+  NS_LOG_FUNCTION (this << os);
+  m_progress = os;
+}
+
+void
+EventProfiler::Start (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (m_flushed, "The event profile has already been written");
+  // The timers are set by the next event
+  m_started = false;
+  m_ts = 0;
+  m_pending = 0;
+  m_intervalEvents = 0;
+  m_types.clear ();
+  m_typeIndex.clear ();
+  m_intervalTypes.clear ();
+}
+
+void
+EventProfiler::SetFile (const std::string &file)
+{
+  NS_LOG_FUNCTION (this << file);
+  NS_ABORT_MSG_IF (m_flushed, "The event profile has already been written");
+  m_out.close ();
+  Open (file);
+  Start ();
+}
+
+void
+EventProfiler::Open (const std::string &file)
+{
+  m_out.open (file.c_str (), std::ios::trunc);
+  NS_ABORT_MSG_UNLESS (m_out.is_open (), "File " << file << " could not be created");
+  m_out << "kind,wall_s,sim_time_s,sim_s_per_wall_s,events_per_s,pending_events,rank,event,count,time_s" << std::endl;
+}
+
+std::string
+EventProfiler::GetEventName (EventImpl *event)
+{
+  NS_LOG_FUNCTION (event);
+  const void *function = event->GetFunction ();
+  if (function != 0)
+    {
+      std::string name = LookUpSymbol (function);
+      if (!name.empty ())
+        {
+          return name;
+        }
+    }
+  // The type of event, made of the signature of the function or method
+  std::ostringstream oss;
+  oss << Demangle (typeid (*event).name ());
+  if (function != 0)
+    {
+      oss << "@" << function;
+    }
+  return oss.str ();
+}
+
+uint32_t
+EventProfiler::GetType (EventImpl *event)
+{
+  Key key (&typeid (*event), event->GetFunction ());
+  auto it = m_typeIndex.find (key);
+  if (it != m_typeIndex.end ())
+    {
+      return it->second;
+    }
+  m_types.push_back ({GetEventName (event), 0, 0, 0, 0});
+  m_typeIndex[key] = m_types.size () - 1;
+  return m_types.size () - 1;
+}
+
+void
+EventProfiler::Invoke (EventImpl *event, uint64_t ts, uint64_t pending)
+{
+  // A cancelled event does nothing: neither counted nor looked up
+  if (m_flushed || event->IsCancelled ())
+    {
+      event->Invoke ();
+      return;
+    }
+  if (!m_started)
+    {
+      // Leave the setup of the simulation (or the time since Start) out
+      m_started = true;
+      m_start = std::chrono::steady_clock::now ();
+      m_intervalStart = m_start;
+      m_intervalStartTs = ts;
+    }
+  uint32_t index = GetType (event);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+  event->Invoke ();
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+
+  Type &type = m_types[index];
+  if (type.count++ == 0)
+    {
+      m_intervalTypes.push_back (index);
+    }
+  type.seconds += std::chrono::duration<double> (end - start).count ();
+  m_intervalEvents++;
+  m_ts = ts;
+  m_pending = pending;
+  if (end - m_intervalStart >= m_interval)
+    {
+      Report (end);
+    }
+}
+
+void
+EventProfiler::Report (std::chrono::steady_clock::time_point now)
+{
+  double wallS = std::chrono::duration<double> (now - m_intervalStart).count ();
+  double simS = TimeStep (m_ts - m_intervalStartTs).GetSeconds ();
+  double totalWallS = std::chrono::duration<double> (now - m_start).count ();
+  double simTimeS = TimeStep (m_ts).GetSeconds ();
+  double eventsPerS = wallS > 0 ? m_intervalEvents / wallS : 0;
+
+  std::sort (m_intervalTypes.begin (), m_intervalTypes.end (),
+             [this] (uint32_t a, uint32_t b) { return m_types[a].seconds > m_types[b].seconds; });
+  std::ostringstream columns;
+  columns << "interval," << totalWallS << "," << simTimeS << "," << (wallS > 0 ? simS / wallS : 0) << ","
+          << eventsPerS << "," << m_pending << ",";
+  if (m_intervalTypes.empty ())
+    {
+      m_out << columns.str () << "0,\"\",0,0" << std::endl;
+    }
+  for (uint32_t rank = 0; rank < m_intervalTypes.size () && rank < m_nTop; rank++)
+    {
+      const Type &type = m_types[m_intervalTypes[rank]];
+      m_out << columns.str () << rank + 1 << ",\"" << type.name << "\"," << type.count << "," << type.seconds << std::endl;
+    }
+
+  if (m_progress != 0)
+    {
+      *m_progress << "Event profile: " << simTimeS << " s simulated in " << totalWallS << " s ("
+                  << (wallS > 0 ? simS / wallS : 0) << " s/s), " << eventsPerS << " events/s, "
+                  << m_pending << " pending";
+      if (!m_intervalTypes.empty ())
+        {
+          const Type &top = m_types[m_intervalTypes[0]];
+          *m_progress << ", top " << top.name << " (" << (wallS > 0 ? 100 * top.seconds / wallS : 0) << " %)";
+        }
+      *m_progress << std::endl;
+    }
+
+  for (uint32_t index : m_intervalTypes)
+    {
+      Type &type = m_types[index];
+      type.totalCount += type.count;
+      type.totalSeconds += type.seconds;
+      type.count = 0;
+      type.seconds = 0;
+    }
+  m_intervalTypes.clear ();
+  m_intervalEvents = 0;
+  m_intervalStart = now;
+  m_intervalStartTs = m_ts;
+}
+
+void
+EventProfiler::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_flushed)
+    {
+      return;
+    }
+  m_flushed = true;
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now ();
+  if (m_intervalEvents > 0)
+    {
+      Report (now);
+    }
+
+  double wallS = std::chrono::duration<double> (now - m_start).count ();
+  double simS = TimeStep (m_ts).GetSeconds ();
+  uint64_t events = 0;
+  std::vector<uint32_t> order;
+  for (uint32_t index = 0; index < m_types.size (); index++)
+    {
+      events += m_types[index].totalCount;
+      order.push_back (index);
+    }
+  std::sort (order.begin (), order.end (),
+             [this] (uint32_t a, uint32_t b) { return m_types[a].totalSeconds > m_types[b].totalSeconds; });
+  for (uint32_t rank = 0; rank < order.size (); rank++)
+    {
+      const Type &type = m_types[order[rank]];
+      m_out << "total," << wallS << "," << simS << "," << (wallS > 0 ? simS / wallS : 0) << ","
+            << (wallS > 0 ? events / wallS : 0) << "," << m_pending << "," << rank + 1 << ",\""
+            << type.name << "\"," << type.totalCount << "," << type.totalSeconds << std::endl;
+    }
+  m_out.close ();
+}
+
+} // namespace ns3
@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include "simple-ref-count.h"
+#include <chrono>
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup events
+ * \brief Progress, event rate and time spent per type of event
+ *
+ * Given to DefaultSimulatorImpl::SetEventProfiler, the profiler times
+ * every event the simulator invokes, except the cancelled ones. The
+ * events are told apart by the function or class method they invoke
+ * (EventImpl::GetFunction) and named after it, e.g.
+ * "ns3::PointToPointLaserNetDevice::TransmitComplete", when its symbol
+ * can be looked up (i.e., it is exported); otherwise by the type of the
+ * event.
+ *
+ * Every interval of wall-clock time from the first event after Start
+ * on, a report is written as CSV lines:
+ *
+ *     kind,wall_s,sim_time_s,sim_s_per_wall_s,events_per_s,pending_events,rank,event,count,time_s
+ *
+ * with one "interval" line for each of the event types which took the
+ * most time during the interval (by decreasing time), the other columns
+ * describing the interval. Flush reports the interval in progress and
+ * adds "total" lines for every event type over the whole run. A one-line
+ * summary of each interval can be printed as well (SetProgressStream).
+ *
+ * When no profiler is set, the simulator only checks for one per event.
+ */
+class EventProfiler : public SimpleRefCount<EventProfiler>
+{
+public:
+  /**
+   * \param [in] file The CSV output.
+   * \param [in] intervalS The wall-clock time between two reports, in seconds.
+   * \param [in] nTop The number of event types reported per interval.
+   */
+  EventProfiler (const std::string &file, double intervalS, uint32_t nTop);
+  /** Destructor: flushes the report. */
+  ~EventProfiler ();
+
+  /**
+   * \param [in] os Where a summary of each interval is printed (0 for none).
+   */
+  void SetProgressStream (std::ostream *os);
+
+  /**
+   * Forget the events invoked so far, e.g. by the warm-up runs of the
+   * setup, and start timing at the next event. To be called right before
+   * the Simulator::Run of the simulation.
+   */
+  void Start (void);
+
+  /**
+   * Write the report to another file from now on, e.g. per run in a
+   * forked child process. The current file is closed as it is, and the
+   * profile starts over (Start).
+   *
+   * \param [in] file The CSV output.
+   */
+  void SetFile (const std::string &file);
+
+  /**
+   * Invoke an event and account for it (unless it is cancelled).
+   *
+   * \param [in] event The event.
+   * \param [in] ts The simulation time of the event, in time steps.
+   * \param [in] pending The number of events still pending.
+   */
+  void Invoke (EventImpl *event, uint64_t ts, uint64_t pending);
+
+  /**
+   * Report the interval in progress and the totals, and close the output.
+   * Further events are not accounted for.
+   */
+  void Flush (void);
+
+  /**
+   * \param [in] event An event.
+   * \returns The name of the function or class method which the event
+   *          invokes (without its arguments), or of the type of the event.
+   */
+  static std::string GetEventName (EventImpl *event);
+
+private:
+  /** Type of event: the dynamic type of the EventImpl and the function it invokes. */
+  typedef std::pair<const std::type_info *, const void *> Key;
+
+  /** Hash of a Key. */
+  struct KeyHash
+  {
+    /**
+     * \param [in] key The key.
+     * \returns The hash.
+     */
+    std::size_t operator() (const Key &key) const
+    {
+      return std::hash<const void *> () (key.first) * 31 + std::hash<const void *> () (key.second);
+    }
+  };
+
+  /** Counters of a type of event. */
+  struct Type
+  {
+    std::string name;      //!< Name of the function or of the type.
+    uint64_t count;        //!< Events in the interval.
+    double seconds;        //!< Wall-clock time in the interval.
+    uint64_t totalCount;   //!< Events in the previous intervals.
+    double totalSeconds;   //!< Wall-clock time in the previous intervals.
+  };
+
+  /**
+   * \param [in] event An event.
+   * \returns The index of the type of the event in m_types.
+   */
+  uint32_t GetType (EventImpl *event);
+
+  /**
+   * Open the output and write the header line.
+   * \param [in] file The CSV output.
+   */
+  void Open (const std::string &file);
+
+  /**
+   * Write the report of the current interval and start the next one.
+   * \param [in] now The wall-clock time.
+   */
+  void Report (std::chrono::steady_clock::time_point now);
+
+  std::ofstream m_out;                                    //!< CSV output.
+  std::ostream *m_progress;                               //!< Summary per interval.
+  std::chrono::steady_clock::duration m_interval;         //!< Time between reports.
+  uint32_t m_nTop;                                        //!< Types reported per interval.
+  bool m_flushed;                                         //!< Flush was called.
+  bool m_started;                                         //!< An event was invoked since Start.
+  std::chrono::steady_clock::time_point m_start;          //!< First event since Start.
+  std::chrono::steady_clock::time_point m_intervalStart;  //!< Start of the interval.
+  uint64_t m_intervalStartTs;                             //!< Simulation time at the start of the interval.
+  uint64_t m_ts;                                          //!< Simulation time of the last event.
+  uint64_t m_pending;                                     //!< Events pending after the last event.
+  uint64_t m_intervalEvents;                              //!< Events in the interval.
+  std::vector<Type> m_types;                              //!< Event types, in order of appearance.
+  std::unordered_map<Key, uint32_t, KeyHash> m_typeIndex; //!< Index in m_types.
+  std::vector<uint32_t> m_intervalTypes;                  //!< Types of events seen in the interval.
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
@@ -0,0 +1,337 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+#include "uinteger.h"
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::LadderScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderScheduler> ()
+    .AddAttribute ("Threshold",
+                   "Number of events in a bucket above which it is split into a finer rung.",
+                   UintegerValue (50),
+                   MakeUintegerAccessor (&LadderScheduler::m_threshold),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("MaxRungs",
+                   "Maximum number of rungs of the ladder.",
+                   UintegerValue (8),
+                   MakeUintegerAccessor (&LadderScheduler::m_maxRungs),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_threshold (50),
+    m_maxRungs (8),
+    m_topStart (0),
+    m_topMin (0),
+    m_topMax (0),
+    m_nRungs (0),
+    m_bottomHead (0),
+    m_size (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+std::size_t
+LadderScheduler::FindRung (uint64_t ts) const
+{
+  for (std::size_t i = 0; i < m_nRungs; i++)
+    {
+      const Rung &rung = m_rungs[i];
+      if (ts >= rung.start + rung.current * rung.width)
+        {
+          return i;
+        }
+    }
+  return m_nRungs;
+}
+
+void
+LadderScheduler::AddRung (Bucket &events, uint64_t start, uint64_t span)
+{
+  NS_LOG_FUNCTION (this << events.size () << start << span);
+  NS_ASSERT (!events.empty () && span > 0);
+
+  uint64_t n = events.size ();
+  uint64_t width = span / n + (span % n != 0 ? 1 : 0);
+  std::size_t nBuckets = span / width + (span % width != 0 ? 1 : 0);
+
+  if (m_nRungs == m_rungs.size ())
+    {
+      m_rungs.push_back (Rung ());
+    }
+  Rung &rung = m_rungs[m_nRungs++];
+  rung.start = start;
+  rung.width = width;
+  rung.current = 0;
+  rung.count = events.size ();
+  // The buckets of a rung are all empty by the time it is dropped
+  rung.buckets.resize (nBuckets);
+  for (const Scheduler::Event &ev : events)
+    {
+      rung.buckets[(ev.key.m_ts - start) / width].push_back (ev);
+    }
+  Bucket ().swap (events);
+}
+
+void
+LadderScheduler::FillBottom (Bucket &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  NS_ASSERT (m_bottom.empty ());
+
+  m_bottom.swap (events);
+  m_bottomHead = 0;
+  // Events of the same instant mostly arrive in order of their uid
+  if (!std::is_sorted (m_bottom.begin (), m_bottom.end ()))
+    {
+      std::sort (m_bottom.begin (), m_bottom.end ());
+    }
+}
+
+void
+LadderScheduler::Refill (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_bottom.clear ();
+  m_bottomHead = 0;
+
+  while (m_size > 0 && m_bottom.empty ())
+    {
+      if (m_nRungs == 0)
+        {
+          // Everything is in Top
+          if (m_top.size () <= m_threshold || m_topMin == m_topMax)
+            {
+              m_topStart = m_topMax + 1;
+              FillBottom (m_top);
+            }
+          else
+            {
+              AddRung (m_top, m_topMin, m_topMax - m_topMin + 1);
+              m_topStart = m_rungs[0].start + m_rungs[0].width * m_rungs[0].buckets.size ();
+            }
+          continue;
+        }
+
+      Rung &rung = m_rungs[m_nRungs - 1];
+      if (rung.count == 0)
+        {
+          m_nRungs--;
+          continue;
+        }
+      while (rung.buckets[rung.current].empty ())
+        {
+          rung.current++;
+        }
+
+      std::size_t index = rung.current++;
+      uint64_t start = rung.start + index * rung.width;
+      uint64_t width = rung.width;
+      // Buckets give their storage away, not to hold on to the memory of a burst
+      Bucket events;
+      events.swap (rung.buckets[index]);
+      rung.count -= events.size ();
+
+      bool split = events.size () > m_threshold && m_nRungs < m_maxRungs && width > 1;
+      if (split)
+        {
+          // Events of a single instant cannot be split any further
+          uint64_t ts = events.front ().key.m_ts;
+          split = std::any_of (events.begin (), events.end (),
+                               [ts] (const Scheduler::Event &ev) { return ev.key.m_ts != ts; });
+        }
+      if (split)
+        {
+          AddRung (events, start, width);
+        }
+      else
+        {
+          FillBottom (events);
+        }
+    }
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+
+  if (m_size++ == 0)
+    {
+      m_nRungs = 0;
+      m_topStart = ts + 1;
+      m_bottom.clear ();
+      m_bottomHead = 0;
+      m_bottom.push_back (ev);
+      return;
+    }
+
+  if (ts >= m_topStart)
+    {
+      if (m_top.empty ())
+        {
+          m_topMin = ts;
+          m_topMax = ts;
+        }
+      m_topMin = std::min (m_topMin, ts);
+      m_topMax = std::max (m_topMax, ts);
+      m_top.push_back (ev);
+      return;
+    }
+
+  std::size_t r = FindRung (ts);
+  if (r < m_nRungs)
+    {
+      Rung &rung = m_rungs[r];
+      rung.buckets[(ts - rung.start) / rung.width].push_back (ev);
+      rung.count++;
+      return;
+    }
+
+  // In the range of Bottom: mostly after everything in it (e.g., at the current time)
+  if (!(ev < m_bottom.back ()))
+    {
+      m_bottom.push_back (ev);
+      return;
+    }
+  Bucket::iterator it = std::upper_bound (m_bottom.begin () + m_bottomHead, m_bottom.end (), ev);
+  if (it == m_bottom.begin () + m_bottomHead && m_bottomHead > 0)
+    {
+      m_bottom[--m_bottomHead] = ev;
+      return;
+    }
+  m_bottom.insert (it, ev);
+
+  // A long Bottom with distinct timestamps is turned into a rung, so that
+  // later insertions do not have to shift it
+  std::size_t n = m_bottom.size () - m_bottomHead;
+  if (n > m_threshold && m_nRungs < m_maxRungs
+      && m_bottom[m_bottomHead].key.m_ts != m_bottom.back ().key.m_ts)
+    {
+      uint64_t start = m_bottom[m_bottomHead].key.m_ts;
+      uint64_t end = m_nRungs > 0 ? m_rungs[m_nRungs - 1].start
+        + m_rungs[m_nRungs - 1].current * m_rungs[m_nRungs - 1].width : m_topStart;
+      Bucket events (m_bottom.begin () + m_bottomHead, m_bottom.end ());
+      AddRung (events, start, end - start);
+      Refill ();
+    }
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  return m_bottom[m_bottomHead];
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Scheduler::Event ev = m_bottom[m_bottomHead++];
+  m_size--;
+  if (m_bottomHead == m_bottom.size ())
+    {
+      Refill ();
+    }
+  return ev;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  uint64_t ts = ev.key.m_ts;
+  m_size--;
+
+  if (ts >= m_topStart)
+    {
+      Bucket::iterator it = std::find (m_top.begin (), m_top.end (), ev);
+      NS_ASSERT (it != m_top.end ());
+      *it = m_top.back ();
+      m_top.pop_back ();
+      return;
+    }
+
+  std::size_t r = FindRung (ts);
+  if (r < m_nRungs)
+    {
+      Rung &rung = m_rungs[r];
+      Bucket &bucket = rung.buckets[(ts - rung.start) / rung.width];
+      Bucket::iterator it = std::find (bucket.begin (), bucket.end (), ev);
+      NS_ASSERT (it != bucket.end ());
+      *it = bucket.back ();
+      bucket.pop_back ();
+      rung.count--;
+      return;
+    }
+
+  Bucket::iterator it = std::lower_bound (m_bottom.begin () + m_bottomHead, m_bottom.end (), ev);
+  NS_ASSERT (it != m_bottom.end () && *it == ev);
+  if (it == m_bottom.begin () + m_bottomHead)
+    {
+      m_bottomHead++;
+    }
+  else
+    {
+      m_bottom.erase (it);
+    }
+  if (m_bottomHead == m_bottom.size ())
+    {
+      Refill ();
+    }
+}
+
+} // namespace ns3
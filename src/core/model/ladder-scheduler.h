@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This scheduler follows the ladder queue of
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Tang, Goh and Thng][Tang], with three tiers:
+ *
+ *  - Top: an unsorted vector of the events beyond the range of the ladder.
+ *  - Rungs: each rung splits a time range into buckets of equal width,
+ *    holding unsorted vectors of events. The first rung is created from
+ *    Top, and a bucket holding more than Threshold events is split into
+ *    a finer rung below it (at most MaxRungs rungs).
+ *  - Bottom: a sorted vector of the earliest events, filled from the
+ *    first non-empty bucket of the lowest rung when it runs empty.
+ *
+ * Events are only sorted when their bucket reaches Bottom. A bucket whose
+ * events all have the same timestamp (e.g., thousands of events scheduled
+ * for the same instant) is not split further but moved to Bottom directly,
+ * ordered by uid, which is mostly the order of insertion already and only
+ * costs a linear check. Events inserted within the range of Bottom, such
+ * as events scheduled for the current time, are appended to Bottom when
+ * they come after everything in it.
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to Top or a bucket; sorted insertion in Bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Bottom kept non-empty
+ * Remove()     | Linear in the bucket | Search in the tier holding the event
+ * RemoveNext() | ~Constant       | Refill of Bottom from the lowest rung
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | Vectors of the rungs and buckets | Kept for reuse
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderScheduler ();
+  /** Destructor. */
+  virtual ~LadderScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Bucket type: unsorted events. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /** A rung of the ladder. */
+  struct Rung
+  {
+    uint64_t start;               /**< Start time of the first bucket. */
+    uint64_t width;               /**< Time span of each bucket. */
+    std::size_t current;          /**< First bucket which may hold events. */
+    std::size_t count;            /**< Number of events in the rung. */
+    std::vector<Bucket> buckets;  /**< Buckets in time order. */
+  };
+
+  /**
+   * Find the rung whose range holds a timestamp.
+   *
+   * \param [in] ts The timestamp.
+   * \returns The index of the rung, or the number of rungs if the
+   *          timestamp is before the current bucket of the lowest rung
+   *          (i.e., in the range of Bottom).
+   */
+  std::size_t FindRung (uint64_t ts) const;
+  /**
+   * Spread events over the buckets of a new rung below the existing ones.
+   *
+   * \param [in,out] events The events, left empty.
+   * \param [in] start The start of the range of the new rung.
+   * \param [in] span The length of the range of the new rung.
+   */
+  void AddRung (Bucket &events, uint64_t start, uint64_t span);
+  /**
+   * Move events to Bottom, which must be empty, and sort them.
+   *
+   * \param [in,out] events The events, left empty.
+   */
+  void FillBottom (Bucket &events);
+  /** Refill Bottom from the rungs or Top, if it is empty. */
+  void Refill (void);
+
+  /** Number of events in a bucket above which it is split into a new rung. */
+  uint32_t m_threshold;
+  /** Maximum number of rungs. */
+  uint32_t m_maxRungs;
+
+  /** Events with a timestamp at or after m_topStart. */
+  Bucket m_top;
+  /** Start of the range of Top. */
+  uint64_t m_topStart;
+  /** Smallest timestamp in Top. */
+  uint64_t m_topMin;
+  /** Largest timestamp in Top. */
+  uint64_t m_topMax;
+
+  /** The rungs, from the coarsest; rungs beyond m_nRungs are kept for reuse. */
+  std::vector<Rung> m_rungs;
+  /** Number of rungs in use. */
+  std::size_t m_nRungs;
+
+  /** Earliest events in order, starting at m_bottomHead. */
+  Bucket m_bottom;
+  /** Index of the next event in m_bottom. */
+  std::size_t m_bottomHead;
+
+  /** Number of events. */
+  std::size_t m_size;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
@@ -20,6 +20,9 @@
 #include "make-event.h"
 #include "log.h"
 
+#include <cstdint>
+#include <cstring>
+
 /**
  * \file
  * \ingroup events
@@ -51,6 +54,10 @@ EventImpl * MakeEvent (void (*f)(void))
     {
       (*m_function)();
     }
+    virtual const void * GetFunction (void)
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
 
   private:
     F m_function;
@@ -58,6 +65,41 @@ EventImpl * MakeEvent (void (*f)(void))
   return ev;
 }
 
+const void * MakeEventMemberAddress (const void *obj, const void *mem_ptr, std::size_t size)
+{
+  NS_LOG_FUNCTION (obj << mem_ptr << size);
+#if defined(__GNUC__)
+  // Itanium C++ ABI: the address of the code, or 1 + the offset of the method in the
+  // vtable, then the adjustment of the object pointer. The ARM variant flags virtual
+  // methods in the lowest bit of the adjustment instead.
+  uintptr_t ptr;
+  ptrdiff_t adj;
+  if (size != sizeof (ptr) + sizeof (adj))
+    {
+      return 0;
+    }
+  std::memcpy (&ptr, mem_ptr, sizeof (ptr));
+  std::memcpy (&adj, static_cast<const char *> (mem_ptr) + sizeof (ptr), sizeof (adj));
+#if defined(__arm__) || defined(__aarch64__)
+  bool isVirtual = adj & 1;
+  adj >>= 1;
+  uintptr_t offset = ptr;
+#else
+  bool isVirtual = ptr & 1;
+  uintptr_t offset = ptr - 1;
+#endif
+  if (!isVirtual)
+    {
+      return reinterpret_cast<const void *> (ptr);
+    }
+  const char *self = static_cast<const char *> (obj) + adj;
+  const char *vtable = *reinterpret_cast<const char * const *> (self);
+  return *reinterpret_cast<const void * const *> (vtable + offset);
+#else
+  return 0;
+#endif
+}
+
 EventImpl * MakeEvent (std::function<void()> function)
 {
   class EventMemberImplStdFunction : public EventImpl
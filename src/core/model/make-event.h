@@ -20,6 +20,7 @@
 #ifndef MAKE_EVENT_H
 #define MAKE_EVENT_H
 
+#include <cstddef>
 #include <functional>
 
 /**
@@ -376,6 +377,61 @@ struct EventMemberImplObjTraits<std::function<void()>> {
   }
 };
 
+/**
+ * \ingroup makeeventmemptr
+ * Helper for EventImpl::GetFunction of the events which invoke a class method.
+ *
+ * \param [in] obj The object of the class holding the method.
+ * \param [in] mem_ptr The class method pointer, \c sizeof (mem_ptr) bytes.
+ * \param [in] size The size of the class method pointer.
+ * \returns The address of the code invoked on \p obj, looked up in its
+ *          vtable for a virtual method, or 0 for an unknown C++ ABI.
+ */
+const void * MakeEventMemberAddress (const void *obj, const void *mem_ptr, std::size_t size);
+
+/**
+ * \ingroup makeeventmemptr
+ * Address of the code which a class method pointer invokes on an object.
+ *
+ * \tparam R \deduced The return type of the method.
+ * \tparam C \deduced The class holding the method.
+ * \tparam Args \deduced The argument types of the method.
+ * \tparam T \deduced The class type of the object.
+ * \param [in] obj The object.
+ * \param [in] mem_ptr The class method pointer.
+ * \returns The address, or 0 if unknown.
+ */
+template <typename R, typename C, typename... Args, typename T>
+const void * EventMemberAddress (T &obj, R (C::*mem_ptr)(Args...))
+{
+  // The method pointer applies to the C part of the object
+  return MakeEventMemberAddress (&static_cast<const C &> (obj), &mem_ptr, sizeof (mem_ptr));
+}
+
+/**
+ * \ingroup makeeventmemptr
+ * \copydoc EventMemberAddress(T&,R(C::*)(Args...))
+ */
+template <typename R, typename C, typename... Args, typename T>
+const void * EventMemberAddress (T &obj, R (C::*mem_ptr)(Args...) const)
+{
+  return MakeEventMemberAddress (&static_cast<const C &> (obj), &mem_ptr, sizeof (mem_ptr));
+}
+
+/**
+ * \ingroup makeeventmemptr
+ * Fallback for the other callables: the address is unknown.
+ *
+ * \tparam MEM \deduced The callable type.
+ * \tparam T \deduced The class type of the object.
+ * \returns 0.
+ */
+template <typename MEM, typename T>
+const void * EventMemberAddress (T &, MEM)
+{
+  return 0;
+}
+
 template <typename MEM, typename OBJ>
 EventImpl * MakeEvent (MEM mem_ptr, OBJ obj)
 {
@@ -395,6 +451,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)();
     }
+    virtual const void * GetFunction (void)
+    {
+      return EventMemberAddress (EventMemberImplObjTraits<OBJ>::GetReference (m_obj), m_function);
+    }
     OBJ m_obj;
     MEM m_function;
   } *ev = new EventMemberImpl0 (obj, mem_ptr);
@@ -425,6 +485,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1);
     }
+    virtual const void * GetFunction (void)
+    {
+      return EventMemberAddress (EventMemberImplObjTraits<OBJ>::GetReference (m_obj), m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -456,6 +520,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2);
     }
+    virtual const void * GetFunction (void)
+    {
+      return EventMemberAddress (EventMemberImplObjTraits<OBJ>::GetReference (m_obj), m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -489,6 +557,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual const void * GetFunction (void)
+    {
+      return EventMemberAddress (EventMemberImplObjTraits<OBJ>::GetReference (m_obj), m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -524,6 +596,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual const void * GetFunction (void)
+    {
+      return EventMemberAddress (EventMemberImplObjTraits<OBJ>::GetReference (m_obj), m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -562,6 +638,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual const void * GetFunction (void)
+    {
+      return EventMemberAddress (EventMemberImplObjTraits<OBJ>::GetReference (m_obj), m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -602,6 +682,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
+    virtual const void * GetFunction (void)
+    {
+      return EventMemberAddress (EventMemberImplObjTraits<OBJ>::GetReference (m_obj), m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -637,6 +721,10 @@ EventImpl * MakeEvent (void (*f)(U1), T1 a1)
     {
       (*m_function)(m_a1);
     }
+    virtual const void * GetFunction (void)
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
   } *ev = new EventFunctionImpl1 (f, a1);
@@ -667,6 +755,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2), T1 a1, T2 a2)
     {
       (*m_function)(m_a1, m_a2);
     }
+    virtual const void * GetFunction (void)
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -700,6 +792,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3), T1 a1, T2 a2, T3 a3)
     {
       (*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual const void * GetFunction (void)
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -735,6 +831,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4), T1 a1, T2 a2, T3 a3, T4 a4)
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual const void * GetFunction (void)
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -772,6 +872,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5), T1 a1, T2 a2, T3 a3, T4 a4, T5
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual const void * GetFunction (void)
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -811,6 +915,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
+    virtual const void * GetFunction (void)
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
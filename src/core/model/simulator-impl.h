@@ -101,6 +101,8 @@ public:
   virtual uint32_t GetContext (void) const = 0;
   /** \copydoc Simulator::GetEventCount */
   virtual uint64_t GetEventCount (void) const = 0;
+  /** \copydoc Simulator::GetPendingEventCount */
+  virtual uint64_t GetPendingEventCount (void) const = 0;
 
 };
 
@@ -308,6 +308,12 @@ Simulator::GetEventCount (void)
   return GetImpl ()->GetEventCount ();
 }
 
+uint64_t
+Simulator::GetPendingEventCount (void)
+{
+  return GetImpl ()->GetPendingEventCount ();
+}
+
 uint32_t
 Simulator::GetSystemId (void)
 {
@@ -205,6 +205,15 @@ public:
    */
   static uint64_t GetEventCount (void);
 
+  /**
+   * Get the number of events scheduled and not yet executed or removed.
+   * Events cancelled with Cancel() stay in the scheduler until their
+   * time comes and are included; events removed with Remove() are not.
+   * Destroy events are not included.
+   * \returns The number of pending events.
+   */
+  static uint64_t GetPendingEventCount (void);
+
 
   /**
    * @name Schedule events (in the same context) to run at a future time.
@@ -24,6 +24,13 @@
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/ladder-scheduler.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/event-profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <vector>
 
 using namespace ns3;
 
@@ -465,6 +472,262 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SchedulerOrderTestCase : public TestCase
+{
+public:
+  SchedulerOrderTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  uint32_t Random (uint32_t n);
+  uint64_t m_seed;
+  ObjectFactory m_schedulerFactory;
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check the order of bursts of events at equal times with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_seed (1),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+uint32_t
+SchedulerOrderTestCase::Random (uint32_t n)
+{
+  m_seed = m_seed * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (m_seed >> 33) % n;
+}
+
+void
+SchedulerOrderTestCase::DoRun (void)
+{
+  // Drive the scheduler directly against a MapScheduler, with bursts at
+  // the current time, short delays, far timers and removals
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  Ptr<Scheduler> reference = CreateObject<MapScheduler> ();
+  std::vector<Scheduler::Event> pending;
+  uint64_t now = 0;
+  uint32_t uid = 0;
+
+  for (uint32_t step = 0; step < 5000; step++)
+    {
+      uint32_t op = Random (10);
+      if (op < 6 || reference->IsEmpty ())
+        {
+          uint32_t n = Random (20) == 0 ? 1 + Random (500) : 1;
+          uint64_t delay = Random (3) == 0 ? 0 : Random (4) == 0 ? 1000000 + Random (1000000000) : Random (10000);
+          for (uint32_t i = 0; i < n; i++)
+            {
+              Scheduler::Event ev;
+              ev.impl = 0;
+              ev.key.m_ts = now + delay;
+              ev.key.m_uid = uid++;
+              ev.key.m_context = 0;
+              scheduler->Insert (ev);
+              reference->Insert (ev);
+              pending.push_back (ev);
+            }
+        }
+      else if (op < 9)
+        {
+          Scheduler::Event expected = reference->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (scheduler->PeekNext ().key.m_uid, expected.key.m_uid, "Wrong next event");
+          Scheduler::Event ev = scheduler->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (ev.key.m_uid, expected.key.m_uid, "Wrong next event");
+          now = ev.key.m_ts;
+          pending.erase (std::find (pending.begin (), pending.end (), ev));
+        }
+      else
+        {
+          std::size_t i = Random (pending.size ());
+          scheduler->Remove (pending[i]);
+          reference->Remove (pending[i]);
+          pending[i] = pending.back ();
+          pending.pop_back ();
+        }
+    }
+  while (!reference->IsEmpty ())
+    {
+      NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), false, "Missing events");
+      NS_TEST_ASSERT_MSG_EQ (scheduler->RemoveNext ().key.m_uid, reference->RemoveNext ().key.m_uid, "Wrong next event");
+    }
+  NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), true, "Extra events");
+}
+
+class PendingEventCountTestCase : public TestCase
+{
+public:
+  PendingEventCountTestCase ();
+  virtual void DoRun (void);
+  void Event (void);
+};
+
+PendingEventCountTestCase::PendingEventCountTestCase ()
+  : TestCase ("Check the count of pending events")
+{}
+
+void
+PendingEventCountTestCase::Event (void)
+{}
+
+void
+PendingEventCountTestCase::DoRun (void)
+{
+  EventId a = Simulator::Schedule (MicroSeconds (10), &PendingEventCountTestCase::Event, this);
+  Simulator::Schedule (MicroSeconds (11), &PendingEventCountTestCase::Event, this);
+  Simulator::Schedule (MicroSeconds (12), &PendingEventCountTestCase::Event, this);
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetPendingEventCount (), 3, "Three events are pending");
+  Simulator::Cancel (a);
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetPendingEventCount (), 3, "A cancelled event stays in the queue");
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetPendingEventCount (), 0, "No event should be pending");
+
+  EventId b = Simulator::Schedule (MicroSeconds (10), &PendingEventCountTestCase::Event, this);
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetPendingEventCount (), 1, "One event is pending");
+  Simulator::Remove (b);
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetPendingEventCount (), 0, "A removed event is not pending");
+
+  Simulator::ScheduleDestroy (&PendingEventCountTestCase::Event, this);
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetPendingEventCount (), 0, "Destroy events are not counted");
+  Simulator::Destroy ();
+}
+
+class EventProfilerBase
+{
+public:
+  virtual ~EventProfilerBase ()
+  {}
+  virtual void Handle (void)
+  {}
+};
+
+class EventProfilerDerived : public EventProfilerBase
+{
+public:
+  virtual void Handle (void)
+  {}
+};
+
+static void
+EventProfilerFunction (int)
+{}
+
+class EventProfilerTestCase : public TestCase
+{
+public:
+  EventProfilerTestCase ();
+  virtual void DoRun (void);
+  void A (void);
+  void B (void);
+  const void * GetFunction (EventImpl *event);
+};
+
+EventProfilerTestCase::EventProfilerTestCase ()
+  : TestCase ("Check that the event profiler tells events apart by the function they invoke")
+{}
+
+void
+EventProfilerTestCase::A (void)
+{}
+
+void
+EventProfilerTestCase::B (void)
+{}
+
+const void *
+EventProfilerTestCase::GetFunction (EventImpl *event)
+{
+  const void *function = event->GetFunction ();
+  event->Unref ();
+  return function;
+}
+
+void
+EventProfilerTestCase::DoRun (void)
+{
+  // Methods of the same signature differ, a virtual method is the override of the object
+  EventProfilerBase base;
+  EventProfilerDerived derived;
+  const void *a = GetFunction (MakeEvent (&EventProfilerTestCase::A, this));
+  NS_TEST_ASSERT_MSG_NE (a, (const void *) 0, "Unknown method");
+  NS_TEST_ASSERT_MSG_EQ (GetFunction (MakeEvent (&EventProfilerTestCase::A, this)), a, "Not the same method");
+  NS_TEST_ASSERT_MSG_NE (GetFunction (MakeEvent (&EventProfilerTestCase::B, this)), a, "Methods not told apart");
+  NS_TEST_ASSERT_MSG_EQ (GetFunction (MakeEvent (&EventProfilerBase::Handle, &derived)),
+                         GetFunction (MakeEvent (&EventProfilerDerived::Handle, &derived)), "Override not found");
+  NS_TEST_ASSERT_MSG_NE (GetFunction (MakeEvent (&EventProfilerBase::Handle, &base)),
+                         GetFunction (MakeEvent (&EventProfilerDerived::Handle, &derived)), "Virtual methods not told apart");
+  NS_TEST_ASSERT_MSG_EQ (GetFunction (MakeEvent (&EventProfilerFunction, 1)),
+                         (const void *) &EventProfilerFunction, "Wrong function");
+
+  Ptr<DefaultSimulatorImpl> impl = DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl == 0)
+    {
+      Simulator::Destroy ();
+      return;
+    }
+  // The report goes to the last file set, and leaves out the warm-up runs
+  // (with a stop at the current time) before SetFile or Start
+  std::string setupFile = CreateTempDirFilename ("event-profile-setup.csv");
+  std::string file = CreateTempDirFilename ("event-profile.csv");
+  Ptr<EventProfiler> profiler = Create<EventProfiler> (setupFile, 1000, 10);
+  impl->SetEventProfiler (profiler);
+  Simulator::ScheduleNow (&EventProfilerDerived::Handle, &derived);
+  Simulator::Stop (Seconds (0));
+  Simulator::Run ();
+  profiler->SetFile (file);
+  Simulator::ScheduleNow (&EventProfilerTestCase::A, this);
+  Simulator::ScheduleNow (&EventProfilerBase::Handle, &base);
+  Simulator::Stop (Seconds (0));
+  Simulator::Run ();
+  profiler->Start ();
+  profiler = 0;
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Simulator::Schedule (MicroSeconds (i), &EventProfilerTestCase::A, this);
+    }
+  Simulator::Schedule (MicroSeconds (1), &EventProfilerTestCase::B, this);
+  Simulator::Schedule (MicroSeconds (2), &EventProfilerTestCase::B, this);
+  Simulator::Schedule (MicroSeconds (3), &EventProfilerFunction, 0);
+  // Cancelled events are left out, even of a type not seen otherwise
+  Simulator::Cancel (Simulator::Schedule (MicroSeconds (2), &EventProfilerTestCase::A, this));
+  Simulator::Cancel (Simulator::Schedule (MicroSeconds (2), &EventProfilerDerived::Handle, &derived));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::ifstream setup (setupFile.c_str ());
+  std::string line;
+  uint32_t setupLines = 0;
+  while (std::getline (setup, line))
+    {
+      setupLines++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (setupLines, 1, "Report not moved to the new file");
+
+  // One interval (ending at 3 us) and the totals, one line per type of event
+  std::ifstream in (file.c_str ());
+  std::getline (in, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "kind,wall_s,sim_time_s,sim_s_per_wall_s,events_per_s,pending_events,rank,event,count,time_s",
+                         "Wrong header");
+  std::map<std::string, std::vector<uint64_t> > counts;
+  while (std::getline (in, line))
+    {
+      std::size_t comma = line.rfind (',');
+      std::size_t before = line.rfind (',', comma - 1);
+      counts[line.substr (0, line.find (','))].push_back (std::stoull (line.substr (before + 1, comma - before - 1)));
+      NS_TEST_ASSERT_MSG_EQ (line.find (",\"\","), std::string::npos, "Unnamed event");
+      if (line.compare (0, 9, "interval,") == 0)
+        {
+          NS_TEST_ASSERT_MSG_NE (line.find (",3e-06,"), std::string::npos, "Wrong simulation time");
+        }
+    }
+  for (std::string kind : {"interval", "total"})
+    {
+      std::sort (counts[kind].begin (), counts[kind].end ());
+      NS_TEST_ASSERT_MSG_EQ (counts[kind].size (), 3, "Wrong number of event types");
+      NS_TEST_ASSERT_MSG_EQ (counts[kind][0], 1, "Wrong count");
+      NS_TEST_ASSERT_MSG_EQ (counts[kind][1], 2, "Wrong count");
+      NS_TEST_ASSERT_MSG_EQ (counts[kind][2], 3, "Wrong count");
+    }
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -483,5 +746,10 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+    AddTestCase (new PendingEventCountTestCase (), TestCase::QUICK);
+    AddTestCase (new EventProfilerTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
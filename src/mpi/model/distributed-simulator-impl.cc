@@ -39,6 +39,7 @@
 
 #include <mpi.h>
 #include <cmath>
+#include <set>
 
 namespace ns3 {
 
@@ -164,6 +165,33 @@ DistributedSimulatorImpl::Destroy ()
 }
 
 
+/**
+ * \brief Check whether a multi-access channel has devices on other systems
+ *
+ * Channels without a "Delay" attribute (e.g. wireless channels) are ignored,
+ * as their devices cannot be reached through MpiInterface::SendPacket.
+ *
+ * \param channel the channel
+ * \return true if a node attached to the channel belongs to another system
+ */
+static bool
+HasRemoteDevice (Ptr<Channel> channel)
+{
+  struct TypeId::AttributeInformation info;
+  if (!channel->GetInstanceTypeId ().LookupAttributeByName ("Delay", &info))
+    {
+      return false;
+    }
+  for (std::size_t j = 0; j < channel->GetNDevices (); ++j)
+    {
+      if (channel->GetDevice (j)->GetNode ()->GetSystemId () != MpiInterface::GetSystemId ())
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
 void
 DistributedSimulatorImpl::CalculateLookAhead (void)
 {
@@ -177,6 +205,7 @@ DistributedSimulatorImpl::CalculateLookAhead (void)
   else
     {
       NodeContainer c = NodeContainer::GetGlobal ();
+      std::set<uint32_t> visitedChannels;
       for (NodeContainer::Iterator iter = c.Begin (); iter != c.End (); ++iter)
         {
           if ((*iter)->GetSystemId () != MpiInterface::GetSystemId ())
@@ -187,14 +216,29 @@ DistributedSimulatorImpl::CalculateLookAhead (void)
           for (uint32_t i = 0; i < (*iter)->GetNDevices (); ++i)
             {
               Ptr<NetDevice> localNetDevice = (*iter)->GetDevice (i);
-              // only works for p2p links currently
-              if (!localNetDevice->IsPointToPoint ())
+              Ptr<Channel> channel = localNetDevice->GetChannel ();
+              if (channel == 0)
                 {
                   continue;
                 }
-              Ptr<Channel> channel = localNetDevice->GetChannel ();
-              if (channel == 0)
+
+              // a multi-access channel (e.g. a GSL channel) reaches the
+              // nodes of all its devices; its "Delay" attribute must be a
+              // lower bound over all of them
+              if (!localNetDevice->IsPointToPoint ())
                 {
+                  if (!visitedChannels.insert (channel->GetId ()).second
+                      || !HasRemoteDevice (channel))
+                    {
+                      continue;
+                    }
+
+                  TimeValue delay;
+                  channel->GetAttribute ("Delay", delay);
+                  if (delay.Get () < m_lookAhead)
+                    {
+                      m_lookAhead = delay.Get ();
+                    }
                   continue;
                 }
 
@@ -646,4 +690,10 @@ DistributedSimulatorImpl::GetEventCount (void) const
   return m_eventCount;
 }
 
+uint64_t
+DistributedSimulatorImpl::GetPendingEventCount (void) const
+{
+  return m_unscheduledEvents;
+}
+
 } // namespace ns3
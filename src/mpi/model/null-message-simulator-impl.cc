@@ -45,6 +45,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <set>
 #include <fstream>
 #include <iomanip>
 
@@ -137,6 +138,46 @@ NullMessageSimulatorImpl::Destroy ()
   MpiInterface::Destroy ();
 }
 
+/**
+ * \brief Add a multi-access channel to the bundles of the systems it reaches
+ *
+ * Channels without a "Delay" attribute (e.g. wireless channels) are ignored,
+ * as their devices cannot be reached through MpiInterface::SendPacket.
+ *
+ * \param channel the channel
+ */
+static void
+AddMultiAccessChannel (Ptr<Channel> channel)
+{
+  struct TypeId::AttributeInformation info;
+  if (!channel->GetInstanceTypeId ().LookupAttributeByName ("Delay", &info))
+    {
+      return;
+    }
+
+  std::set<uint32_t> remoteSystemIds;
+  for (std::size_t j = 0; j < channel->GetNDevices (); ++j)
+    {
+      uint32_t systemId = channel->GetDevice (j)->GetNode ()->GetSystemId ();
+      if (systemId != MpiInterface::GetSystemId ())
+        {
+          remoteSystemIds.insert (systemId);
+        }
+    }
+
+  TimeValue delay;
+  channel->GetAttribute ("Delay", delay);
+  for (uint32_t systemId : remoteSystemIds)
+    {
+      Ptr<RemoteChannelBundle> remoteChannelBundle = RemoteChannelBundleManager::Find (systemId);
+      if (!remoteChannelBundle)
+        {
+          remoteChannelBundle = RemoteChannelBundleManager::Add (systemId);
+        }
+      remoteChannelBundle->AddChannel (channel, delay.Get ());
+    }
+}
+
 void
 NullMessageSimulatorImpl::CalculateLookAhead (void)
 {
@@ -147,6 +188,7 @@ NullMessageSimulatorImpl::CalculateLookAhead (void)
   if (MpiInterface::GetSize () > 1)
     {
       NodeContainer c = NodeContainer::GetGlobal ();
+      std::set<uint32_t> visitedChannels;
       for (NodeContainer::Iterator iter = c.Begin (); iter != c.End (); ++iter)
         {
           if ((*iter)->GetSystemId () != MpiInterface::GetSystemId ())
@@ -159,14 +201,21 @@ NullMessageSimulatorImpl::CalculateLookAhead (void)
           for (uint32_t i = 0; i < (*iter)->GetNDevices (); ++i)
             {
               Ptr<NetDevice> localNetDevice = (*iter)->GetDevice (i);
-              // only works for p2p links currently
-              if (!localNetDevice->IsPointToPoint ())
+              Ptr<Channel> channel = localNetDevice->GetChannel ();
+              if (channel == 0)
                 {
                   continue;
                 }
-              Ptr<Channel> channel = localNetDevice->GetChannel ();
-              if (channel == 0)
+
+              // a multi-access channel (e.g. a GSL channel) reaches the
+              // nodes of all its devices: add it to the bundle of every
+              // other system attached to it
+              if (!localNetDevice->IsPointToPoint ())
                 {
+                  if (visitedChannels.insert (channel->GetId ()).second)
+                    {
+                      AddMultiAccessChannel (channel);
+                    }
                   continue;
                 }
 
@@ -576,6 +625,12 @@ NullMessageSimulatorImpl::GetEventCount (void) const
   return m_eventCount;
 }
 
+uint64_t
+NullMessageSimulatorImpl::GetPendingEventCount (void) const
+{
+  return m_unscheduledEvents;
+}
+
 Time NullMessageSimulatorImpl::CalculateGuaranteeTime (uint32_t nodeSysId)
 {
   Ptr<RemoteChannelBundle> bundle = RemoteChannelBundleManager::Find (nodeSysId);
@@ -37,6 +37,8 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/ref.hpp>
 
+#include <algorithm>
+
 NS_LOG_COMPONENT_DEFINE("ndn.Consumer");
 
 namespace ns3 {
@@ -82,6 +84,9 @@ Consumer::Consumer()
   : m_rand(CreateObject<UniformRandomVariable>())
   , m_seq(0)
   , m_seqMax(0) // don't request anything
+  , m_staleSeqTimeouts(0)
+  , m_seqTimeoutGeneration(0)
+  , m_lastRetxCheck(Seconds(-1))
 {
   NS_LOG_FUNCTION_NOARGS();
 
@@ -92,13 +97,14 @@ void
 Consumer::SetRetxTimer(Time retxTimer)
 {
   m_retxTimer = retxTimer;
+  m_retxTimerStart = Simulator::Now();
   if (m_retxEvent.IsRunning()) {
     // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
     Simulator::Remove(m_retxEvent); // slower, but better for memory
   }
 
   // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  ScheduleRetxCheck();
 }
 
 Time
@@ -111,10 +117,14 @@ void
 Consumer::ForceTimeout()
 {
   while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    uint32_t seqNo = entry->seq;
-    m_seqTimeouts.get<i_timestamp>().erase(entry);
+    SeqTimeout entry = m_seqTimeouts.front();
+    m_seqTimeouts.pop_front();
+    SeqState* state = m_seqStates.Find(entry.seq);
+    if (state == nullptr || !state->timing || state->timeoutGeneration != entry.generation) {
+      continue; // Data received in the meantime
+    }
+    state->timing = false;
+    uint32_t seqNo = entry.seq;
     m_retxSeqs.insert(seqNo);
     // OnTimeout(seqNo);
     // m_rtt->IncreaseMultiplier(); // Double the next RTO
@@ -123,6 +133,8 @@ Consumer::ForceTimeout()
     // m_retxSeqs.insert(seqNo);
     Simulator::Schedule(MilliSeconds(1), &Consumer::SendPacket, this);
   }
+  m_staleSeqTimeouts = 0;
+  ScheduleRetxCheck();
 }
 
 void
@@ -136,22 +148,63 @@ Consumer::CheckRetxTimeout()
   // if (!m_seqTimeouts.empty()) {
   //   m_seqTimeouts.clear();
   // }
+  m_lastRetxCheck = now;
   while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    if (entry->time + rto <= now) // timeout expired?
+    const SeqTimeout& entry = m_seqTimeouts.front();
+    SeqState* state = m_seqStates.Find(entry.seq);
+    if (state == nullptr || !state->timing || state->timeoutGeneration != entry.generation) {
+      m_seqTimeouts.pop_front(); // Data received in the meantime
+      m_staleSeqTimeouts--;
+      continue;
+    }
+    if (entry.time + rto <= now) // timeout expired?
     {
-      uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
+      uint32_t seqNo = entry.seq;
+      state->timing = false;
+      m_seqTimeouts.pop_front();
       OnTimeout(seqNo);
     }
     else
       break; // nothing else to do. All later packets need not be retransmitted
   }
-  // no retransmit when timer < 0
-  if (m_retxTimer >= Seconds(0)) {
-    m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  ScheduleRetxCheck();
+}
+
+void
+Consumer::ScheduleRetxCheck()
+{
+  while (!m_seqTimeouts.empty()) {
+    const SeqTimeout& entry = m_seqTimeouts.front();
+    SeqState* state = m_seqStates.Find(entry.seq);
+    if (state != nullptr && state->timing && state->timeoutGeneration == entry.generation) {
+      break;
+    }
+    m_seqTimeouts.pop_front();
+    m_staleSeqTimeouts--;
+  }
+
+  // no retransmit when timer <= 0
+  if (m_seqTimeouts.empty() || m_retxTimer <= Seconds(0)) {
+    m_retxEvent.Cancel();
+    return;
+  }
+
+  // First check at or after the timeout, not at a time that was already checked
+  Time now = Simulator::Now();
+  Time earliest = m_seqTimeouts.front().time + m_rtt->RetransmitTimeout();
+  if (earliest < now || (earliest == now && m_lastRetxCheck == now)) {
+    earliest = m_lastRetxCheck == now ? now + TimeStep(1) : now;
   }
+  int64_t period = m_retxTimer.GetTimeStep();
+  int64_t periods = std::max<int64_t>(1, ((earliest - m_retxTimerStart).GetTimeStep() + period - 1) / period);
+  Time check = m_retxTimerStart + TimeStep(periods * period);
+
+  if (m_retxEvent.IsRunning() && m_retxCheckTime == check) {
+    return;
+  }
+  m_retxEvent.Cancel();
+  m_retxEvent = Simulator::Schedule(check - now, &Consumer::CheckRetxTimeout, this);
+  m_retxCheckTime = check;
 }
 
 // Application Methods
@@ -259,25 +312,37 @@ Consumer::OnData(shared_ptr<const Data> data)
   }
   NS_LOG_DEBUG("Hop count: " << hopCount);
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
-  if (entry != m_seqLastDelay.end()) {
-    // std::cout << GetNode()->GetId() << "," << GetId() << "," << Now().GetNanoSeconds() << "," << seq * 1380 << "," << (Simulator::Now() - entry->time).GetNanoSeconds() / 1000000.00 << std::endl;
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
-  }
+  SeqState* state = m_seqStates.Find(seq);
+  if (state != nullptr) {
+    // std::cout << GetNode()->GetId() << "," << GetId() << "," << Now().GetNanoSeconds() << "," << seq * 1380 << "," << (Simulator::Now() - state->lastSent).GetNanoSeconds() / 1000000.00 << std::endl;
+    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - state->lastSent, hopCount);
+    m_firstInterestDataDelay(this, seq, Simulator::Now() - state->firstSent, state->retxCount, hopCount);
 
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end()) {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
+    // the timeout entry is dropped when it reaches the front
+    if (state->timing) {
+      m_staleSeqTimeouts++;
+    }
+    m_seqStates.Erase(seq);
   }
 
-  m_seqRetxCounts.erase(seq);
-  m_seqFullDelay.erase(seq);
-  m_seqLastDelay.erase(seq);
-
-  m_seqTimeouts.erase(seq);
   m_retxSeqs.erase(seq);
 
   m_rtt->AckSeq(SequenceNumber32(seq));
+
+  // Compact when mostly stale (e.g., behind an Interest that never got Data)
+  if (m_staleSeqTimeouts > 1024 && m_staleSeqTimeouts > m_seqTimeouts.size() / 2) {
+    std::deque<SeqTimeout> pending;
+    for (const SeqTimeout& entry : m_seqTimeouts) {
+      SeqState* pendingState = m_seqStates.Find(entry.seq);
+      if (pendingState != nullptr && pendingState->timing
+          && pendingState->timeoutGeneration == entry.generation) {
+        pending.push_back(entry);
+      }
+    }
+    m_seqTimeouts.swap(pending);
+    m_staleSeqTimeouts = 0;
+  }
+  ScheduleRetxCheck();
 }
 
 void
@@ -308,17 +373,148 @@ void
 Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
+                                << m_seqStates.Size() << " items");
 
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+  SeqState& state = m_seqStates.Insert(sequenceNumber);
+  if (state.retxCount == 0) {
+    state.firstSent = Simulator::Now();
+  }
+  state.lastSent = Simulator::Now();
+  state.retxCount++;
+
+  // a pending timeout keeps counting from the Interest it was started for
+  if (!state.timing) {
+    state.timing = true;
+    state.timeoutGeneration = ++m_seqTimeoutGeneration;
+    m_seqTimeouts.push_back(SeqTimeout(sequenceNumber, Simulator::Now(), state.timeoutGeneration));
+  }
 
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+  m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
 
-  m_seqRetxCounts[sequenceNumber]++;
+  ScheduleRetxCheck();
+}
 
-  m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
+Consumer::SeqStateRing::SeqStateRing()
+  : m_states(16)
+  , m_base(0)
+  , m_count(0)
+{
+}
+
+Consumer::SeqState*
+Consumer::SeqStateRing::Find(uint32_t seq)
+{
+  if (static_cast<uint32_t>(seq - m_base) < m_states.size()) {
+    SeqState& state = m_states[seq & (m_states.size() - 1)];
+    if (state.active) {
+      return &state;
+    }
+  }
+  if (!m_overflow.empty()) {
+    auto i = m_overflow.find(seq);
+    if (i != m_overflow.end()) {
+      return &i->second;
+    }
+  }
+  return nullptr;
+}
+
+Consumer::SeqState&
+Consumer::SeqStateRing::Insert(uint32_t seq)
+{
+  SeqState* found = Find(seq);
+  if (found != nullptr) {
+    return *found;
+  }
+
+  if (m_count == 0) {
+    m_base = seq;
+  }
+  uint32_t offset = seq - m_base;
+  if (offset >= m_states.size()) {
+    if (static_cast<int32_t>(offset) < 0) {
+      // before the window (e.g., random sequence numbers)
+      SeqState& state = m_overflow[seq];
+      state.active = true;
+      return state;
+    }
+    if (m_states.size() >= 4096 && m_count * 4 < m_states.size()) {
+      Advance(seq - m_states.size() + 1);
+    }
+    else {
+      size_t capacity = m_states.size();
+      while (offset >= capacity) {
+        capacity *= 2;
+      }
+      Resize(capacity);
+    }
+  }
+
+  SeqState& state = m_states[seq & (m_states.size() - 1)];
+  state = SeqState();
+  state.active = true;
+  m_count++;
+  return state;
+}
+
+void
+Consumer::SeqStateRing::Erase(uint32_t seq)
+{
+  if (static_cast<uint32_t>(seq - m_base) < m_states.size()) {
+    SeqState& state = m_states[seq & (m_states.size() - 1)];
+    if (state.active) {
+      state.active = false;
+      m_count--;
+      // move the window past sequence numbers that got their Data
+      while (m_count > 0 && !m_states[m_base & (m_states.size() - 1)].active) {
+        m_base++;
+      }
+      return;
+    }
+  }
+  m_overflow.erase(seq);
+}
+
+size_t
+Consumer::SeqStateRing::Size() const
+{
+  return m_count + m_overflow.size();
+}
+
+size_t
+Consumer::SeqStateRing::Capacity() const
+{
+  return m_states.size();
+}
+
+size_t
+Consumer::SeqStateRing::OverflowSize() const
+{
+  return m_overflow.size();
+}
+
+void
+Consumer::SeqStateRing::Resize(size_t capacity)
+{
+  std::vector<SeqState> states(capacity);
+  for (uint32_t offset = 0; offset < m_states.size(); offset++) {
+    uint32_t seq = m_base + offset;
+    states[seq & (capacity - 1)] = m_states[seq & (m_states.size() - 1)];
+  }
+  m_states.swap(states);
+}
+
+void
+Consumer::SeqStateRing::Advance(uint32_t base)
+{
+  for (; m_base != base; m_base++) {
+    SeqState& state = m_states[m_base & (m_states.size() - 1)];
+    if (state.active) {
+      m_overflow[m_base] = state;
+      state.active = false;
+      m_count--;
+    }
+  }
 }
 
 } // namespace ndn
@@ -31,13 +31,10 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
 
+#include <deque>
 #include <set>
 #include <map>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -123,6 +120,16 @@ protected:
   void
   CheckRetxTimeout();
 
+  /**
+   * \brief Schedules CheckRetxTimeout for the earliest retransmission timeout, if any
+   *
+   * Checks happen every RetxTimer from the time it was set, but only those at which a timeout
+   * can expire are scheduled. The event is only moved when the earliest timeout changes
+   * (a different oldest Interest, or a new RTO estimate).
+   */
+  void
+  ScheduleRetxCheck();
+
   /**
    * \brief Modifies the frequency of checking the retransmission timeouts
    * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
@@ -162,53 +169,108 @@ protected:
   RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
 
   /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
+   * \struct This struct contains the state of a sequence number between its first Interest and
+   * its Data
+   */
+  struct SeqState {
+    Time firstSent;                 ///< \brief first Interest (FirstInterestDataDelay)
+    Time lastSent;                  ///< \brief last Interest (LastRetransmittedInterestDataDelay)
+    uint32_t retxCount = 0;         ///< \brief number of Interests sent
+    uint32_t timeoutGeneration = 0; ///< \brief SeqTimeout entry of the pending timeout
+    bool active = false;            ///< \brief Interest sent, no Data yet
+    bool timing = false;            ///< \brief retransmission timeout pending
+  };
+
+  /**
+   * \brief Sequence-indexed ring buffer of SeqState
+   *
+   * Holds the states of a window of consecutive sequence numbers, which moves forward as the
+   * oldest ones get their Data and grows when needed. When the window becomes sparse (e.g., a
+   * few sequence numbers never get their Data), the oldest states move to an ordered map
+   * instead of growing the window further.
+   */
+  class SeqStateRing {
+  public:
+    SeqStateRing();
+
+    /**
+     * \brief State of an active sequence number, or nullptr
+     */
+    SeqState*
+    Find(uint32_t seq);
+
+    /**
+     * \brief State of a sequence number, newly activated if it was not active
+     *
+     * Invalidates the pointers returned before.
+     */
+    SeqState&
+    Insert(uint32_t seq);
+
+    void
+    Erase(uint32_t seq);
+
+    size_t
+    Size() const;
+
+    /**
+     * \brief Number of consecutive sequence numbers the window can hold
+     */
+    size_t
+    Capacity() const;
+
+    /**
+     * \brief Number of active states that were moved before the window
+     */
+    size_t
+    OverflowSize() const;
+
+  private:
+    void
+    Resize(size_t capacity);
+
+    void
+    Advance(uint32_t base);
+
+  private:
+    std::vector<SeqState> m_states; ///< \brief indexed by sequence number & (size - 1)
+    uint32_t m_base;                ///< \brief first sequence number of the window
+    size_t m_count;                 ///< \brief active states in the window
+    std::map<uint32_t, SeqState> m_overflow; ///< \brief active states before the window
+  };
+
+  /**
+   * \struct This struct contains a pair of packet sequence number and the time its
+   * retransmission timeout counts from
    */
   struct SeqTimeout {
-    SeqTimeout(uint32_t _seq, Time _time)
+    SeqTimeout(uint32_t _seq, Time _time, uint32_t _generation)
       : seq(_seq)
       , time(_time)
+      , generation(_generation)
     {
     }
 
     uint32_t seq;
     Time time;
+    uint32_t generation; ///< \brief stale if different from SeqState::timeoutGeneration
   };
-  /// @endcond
 
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
-  };
-  /// @endcond
+  SeqStateRing m_seqStates; ///< \brief in-flight state per sequence number
 
-  /// @cond include_hidden
   /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
+   * \brief Pending retransmission timeouts in the order they expire
+   *
+   * All timeouts use the same RTO, so they expire in the order the Interests were sent.
+   * Entries of sequence numbers that got their Data are skipped (and dropped) later.
    */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
-  };
-
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
+  std::deque<SeqTimeout> m_seqTimeouts;
+  size_t m_staleSeqTimeouts;
+  uint32_t m_seqTimeoutGeneration;
 
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  Time m_retxTimerStart; ///< \brief retransmission checks are at m_retxTimerStart + k * m_retxTimer
+  Time m_lastRetxCheck;  ///< \brief time of the last retransmission check
+  Time m_retxCheckTime;  ///< \brief time of m_retxEvent
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
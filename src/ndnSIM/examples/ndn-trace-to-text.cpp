@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+// ndn-trace-to-text.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * Converts a trace written by AppDelayTracer, L3RateTracer or CsTracer in binary form
+ * (file name ending with .bin) into the text format of the tracer:
+ *
+ *     ./waf --run="ndn-trace-to-text --input=app-delays-trace.bin --output=app-delays-trace.txt"
+ *
+ * Without --output, the text is written to the standard output.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string output = "-";
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Binary trace file", input);
+  cmd.AddValue("output", "Text trace file (- for the standard output)", output);
+  cmd.Parse(argc, argv);
+
+  if (input.empty()) {
+    std::cerr << "Usage: ./waf --run=\"ndn-trace-to-text --input=<file>.bin [--output=<file>]\""
+              << std::endl;
+    return 1;
+  }
+
+  try {
+    if (output == "-") {
+      ndn::TraceWriter::ConvertToText(input, std::cout);
+    }
+    else {
+      std::ofstream os(output.c_str(), std::ios_base::out | std::ios_base::trunc);
+      if (!os.is_open()) {
+        std::cerr << "File " << output << " cannot be opened for writing" << std::endl;
+        return 1;
+      }
+      ndn::TraceWriter::ConvertToText(input, os);
+    }
+  }
+  catch (const std::runtime_error& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
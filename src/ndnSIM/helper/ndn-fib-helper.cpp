@@ -50,6 +50,13 @@ NS_LOG_COMPONENT_DEFINE("ndn.FibHelper");
 void
 FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (l3protocol->isHeadless()) {
+    l3protocol->addNextHop(parameters.getName(), parameters.getFaceId(),
+                           parameters.hasCost() ? parameters.getCost() : 0);
+    return;
+  }
+
   Block encodedParameters(parameters.wireEncode());
 
   Name commandName("/localhost/nfd/fib");
@@ -63,13 +70,18 @@ FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
   // std::cout << command->getName() << std::endl;
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
 void
 FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (l3protocol->isHeadless()) {
+    l3protocol->removeNextHop(parameters.getName(), parameters.getFaceId());
+    return;
+  }
+
   Block encodedParameters(parameters.wireEncode());
 
   Name commandName("/localhost/nfd/fib");
@@ -86,7 +98,6 @@ FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
   StackHelper::getKeyChain().sign(*command);
 
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
@@ -262,6 +273,43 @@ FibHelper::RemoveRoute(const std::string& nodeName, const Name& prefix,
   RemoveRoute(node, prefix, otherNode);
 }
 
+void
+FibHelper::AddRouteInPlace(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, int32_t metric)
+{
+  NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << prefix << " via " << face->getLocalUri()
+                   << " metric " << metric << " (in place)");
+
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  ndn->addNextHop(prefix, face->getId(), metric);
+}
+
+void
+FibHelper::RemoveRouteInPlace(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face)
+{
+  NS_LOG_LOGIC("[" << node->GetId() << "]$ route del " << prefix << " via " << face->getLocalUri()
+                   << " (in place)");
+
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  ndn->removeNextHop(prefix, face->getId());
+}
+
+void
+FibHelper::ReplaceRouteInPlace(Ptr<Node> node, const Name& prefix, shared_ptr<Face> oldFace,
+                               shared_ptr<Face> face, int32_t metric)
+{
+  NS_LOG_LOGIC("[" << node->GetId() << "]$ route replace " << prefix << " via " << oldFace->getLocalUri()
+                   << " by " << face->getLocalUri() << " metric " << metric << " (in place)");
+
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  ndn->replaceNextHop(prefix, oldFace->getId(), face->getId(), metric);
+}
+
 } // namespace ndn
 
 } // namespace ns
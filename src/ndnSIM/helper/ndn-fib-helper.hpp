@@ -154,6 +154,45 @@ public:
   static void
   RemoveRoute(const std::string& nodeName, const Name& prefix, const std::string& otherNodeName);
 
+  /**
+   * \brief Add forwarding entry to FIB in place
+   *
+   * Unlike AddRoute, the FIB of the node is changed before the call returns
+   * (L3Protocol::addNextHop), without a signed command Interest to the FIB manager.
+   *
+   * \param node   Node
+   * \param prefix Routing prefix
+   * \param face   Face
+   * \param metric Routing metric
+   */
+  static void
+  AddRouteInPlace(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, int32_t metric);
+
+  /**
+   * \brief Remove forwarding entry in FIB in place (see AddRouteInPlace)
+   *
+   * \param node Node
+   * \param prefix Routing prefix
+   * \param face Face
+   */
+  static void
+  RemoveRouteInPlace(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face);
+
+  /**
+   * \brief Replace the face of a forwarding entry in place (see AddRouteInPlace)
+   *
+   * The route over the new face is added before the one over the old face is removed.
+   *
+   * \param node Node
+   * \param prefix Routing prefix
+   * \param oldFace Face of the replaced route
+   * \param face Face of the new route
+   * \param metric Routing metric of the new route
+   */
+  static void
+  ReplaceRouteInPlace(Ptr<Node> node, const Name& prefix, shared_ptr<Face> oldFace,
+                      shared_ptr<Face> face, int32_t metric);
+
 private:
   static void
   GenerateCommand(Interest& interest);
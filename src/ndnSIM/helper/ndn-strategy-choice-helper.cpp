@@ -22,6 +22,8 @@
 #include "ns3/log.h"
 
 #include "ndn-stack-helper.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -31,6 +33,18 @@ NS_LOG_COMPONENT_DEFINE("ndn.StrategyChoiceHelper");
 void
 StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (l3protocol->isHeadless()) {
+    NS_LOG_DEBUG("Strategy " << parameters.getStrategy() << " set in place for " << parameters.getName());
+    auto result = l3protocol->getForwarder()->getStrategyChoice().insert(parameters.getName(),
+                                                                         parameters.getStrategy());
+    if (!result) {
+      NS_FATAL_ERROR("Cannot set strategy " << parameters.getStrategy() << " for " << parameters.getName()
+                     << " on Node# " << node->GetId() << ": " << result);
+    }
+    return;
+  }
+
   NS_LOG_DEBUG("Strategy choice command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -42,7 +56,6 @@ StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node>
   command->setCanBePrefix(false);
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
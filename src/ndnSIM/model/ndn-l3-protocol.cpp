@@ -57,6 +57,8 @@
 
 #include <ndn-cxx/mgmt/dispatcher.hpp>
 
+#include <unordered_map>
+
 NS_LOG_COMPONENT_DEFINE("ndn.L3Protocol");
 
 namespace ns3 {
@@ -109,10 +111,11 @@ L3Protocol::GetTypeId(void)
   return tid;
 }
 
-class L3Protocol::Impl {
-private:
-  Impl()
-  {
+// Parsed once, shared by the stacks until one of them changes its configuration
+static shared_ptr<nfd::ConfigSection>
+getDefaultConfig()
+{
+  static shared_ptr<nfd::ConfigSection> config = [] {
     // Do not modify initial config file. Use helpers to set specific NFD parameters
     std::string initialConfig =
       "general\n"
@@ -162,8 +165,19 @@ private:
       "}\n"
       "\n";
 
+    auto parsed = make_shared<nfd::ConfigSection>();
     std::istringstream input(initialConfig);
-    boost::property_tree::read_info(input, m_config);
+    boost::property_tree::read_info(input, *parsed);
+    return parsed;
+  }();
+  return config;
+}
+
+class L3Protocol::Impl {
+private:
+  Impl()
+    : m_config(getDefaultConfig())
+  {
   }
 
   friend class L3Protocol;
@@ -191,7 +205,12 @@ private:
   std::shared_ptr<::ndn::Face> m_internalRibClientFace;
   std::unique_ptr<::nfd::rib::Service> m_ribService;
 
-  nfd::ConfigSection m_config;
+  // face of each NetDevice, maintained on face table add/remove
+  std::unordered_map<const NetDevice*, Face*> m_facesByNetDevice;
+
+  // copied by getConfig() while shared with other stacks
+  shared_ptr<nfd::ConfigSection> m_config;
+  bool m_isHeadless = false;
 
   PolicyCreationCallback m_policy;
 };
@@ -212,10 +231,43 @@ L3Protocol::initialize()
 {
   m_impl->m_faceTable = make_unique<::nfd::FaceTable>();
   m_impl->m_forwarder = make_shared<::nfd::Forwarder>(*m_impl->m_faceTable);
-  m_impl->m_faceSystem = make_unique<::nfd::face::FaceSystem>(*m_impl->m_faceTable, nullptr);
 
-  initializeManagement();
-  initializeRibManager();
+  m_impl->m_faceTable->afterAdd.connect([this] (const Face& face) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(face.getTransport());
+      if (transport != nullptr) {
+        // the first face of a device is the one found, as when the face table was scanned
+        m_impl->m_facesByNetDevice.emplace(PeekPointer(transport->GetNetDevice()), const_cast<Face*>(&face));
+      }
+    });
+  m_impl->m_faceTable->beforeRemove.connect([this] (const Face& face) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(face.getTransport());
+      if (transport == nullptr) {
+        return;
+      }
+      const NetDevice* netDevice = PeekPointer(transport->GetNetDevice());
+      auto found = m_impl->m_facesByNetDevice.find(netDevice);
+      if (found == m_impl->m_facesByNetDevice.end() || found->second != &face) {
+        return;
+      }
+      m_impl->m_facesByNetDevice.erase(found);
+      // another face of the same device takes over
+      for (auto& other : *m_impl->m_faceTable) {
+        auto otherTransport = dynamic_cast<NetDeviceTransport*>(other.getTransport());
+        if (&other != &face && otherTransport != nullptr && PeekPointer(otherTransport->GetNetDevice()) == netDevice) {
+          m_impl->m_facesByNetDevice.emplace(netDevice, &other);
+          break;
+        }
+      }
+    });
+
+  if (m_impl->m_config->get<bool>("ndnSIM.headless", false)) {
+    initializeHeadless();
+  }
+  else {
+    m_impl->m_faceSystem = make_unique<::nfd::face::FaceSystem>(*m_impl->m_faceTable, nullptr);
+    initializeManagement();
+    initializeRibManager();
+  }
 
   m_impl->m_forwarder->beforeSatisfyInterest.connect(std::ref(m_satisfiedInterests));
   m_impl->m_forwarder->beforeExpirePendingInterest.connect(std::ref(m_timedOutInterests));
@@ -245,9 +297,79 @@ private:
 void
 L3Protocol::injectInterest(const Interest& interest)
 {
+  if (m_impl->m_internalClientFaceForInjects == nullptr) {
+    // headless stack: created on first use
+    std::tie(m_impl->m_internalFaceForInjects, m_impl->m_internalClientFaceForInjects) =
+      nfd::face::makeInternalFace(StackHelper::getKeyChain());
+    m_impl->m_faceTable->addReserved(m_impl->m_internalFaceForInjects, nfd::face::FACEID_INTERNAL_FACE + 1);
+  }
   m_impl->m_internalClientFaceForInjects->expressInterest(interest, nullptr, nullptr, nullptr);
 }
 
+bool
+L3Protocol::applyFibUpdate(const Name& prefix, nfd::FaceId faceId, nfd::FaceId replacedFaceId, uint64_t cost)
+{
+  nfd::Fib& fib = m_impl->m_forwarder->getFib();
+  nfd::fib::Entry* entry = nullptr;
+  bool isChanged = false;
+
+  // Same checks as FibManager::addNextHop
+  if (faceId != nfd::face::INVALID_FACEID) {
+    Face* face = m_impl->m_faceTable->get(faceId);
+    if (face == nullptr || prefix.size() > nfd::Fib::getMaxDepth()) {
+      NS_LOG_DEBUG("Cannot add next hop " << faceId << " to " << prefix);
+      return false;
+    }
+    entry = fib.insert(prefix).first;
+    fib.addOrUpdateNextHop(*entry, *face, cost);
+    isChanged = true;
+  }
+
+  if (replacedFaceId != nfd::face::INVALID_FACEID && replacedFaceId != faceId) {
+    Face* face = m_impl->m_faceTable->get(replacedFaceId);
+    if (entry == nullptr) {
+      entry = fib.findExactMatch(prefix);
+    }
+    if (face != nullptr && entry != nullptr) {
+      isChanged = fib.removeNextHop(*entry, *face) != nfd::Fib::RemoveNextHopResult::NO_SUCH_NEXTHOP
+                  || isChanged;
+    }
+  }
+  return isChanged;
+}
+
+bool
+L3Protocol::addNextHop(const Name& prefix, nfd::FaceId faceId, uint64_t cost)
+{
+  NS_LOG_FUNCTION(this << prefix << faceId << cost);
+  return applyFibUpdate(prefix, faceId, nfd::face::INVALID_FACEID, cost);
+}
+
+bool
+L3Protocol::removeNextHop(const Name& prefix, nfd::FaceId faceId)
+{
+  NS_LOG_FUNCTION(this << prefix << faceId);
+  return applyFibUpdate(prefix, nfd::face::INVALID_FACEID, faceId, 0);
+}
+
+bool
+L3Protocol::replaceNextHop(const Name& prefix, nfd::FaceId oldFaceId, nfd::FaceId newFaceId, uint64_t cost)
+{
+  NS_LOG_FUNCTION(this << prefix << oldFaceId << newFaceId << cost);
+  return applyFibUpdate(prefix, newFaceId, oldFaceId, cost);
+}
+
+size_t
+L3Protocol::updateFib(const std::vector<FibUpdate>& updates)
+{
+  NS_LOG_FUNCTION(this << updates.size());
+  size_t nChanged = 0;
+  for (const FibUpdate& update : updates) {
+    nChanged += applyFibUpdate(*update.prefix, update.face, update.replacedFace, update.cost);
+  }
+  return nChanged;
+}
+
 void
 L3Protocol::setCsReplacementPolicy(const PolicyCreationCallback& policy)
 {
@@ -269,7 +391,7 @@ L3Protocol::initializeManagement()
   m_impl->m_dispatcher = make_unique<::ndn::mgmt::Dispatcher>(*m_impl->m_internalClientFace, StackHelper::getKeyChain());
   m_impl->m_authenticator = ::nfd::CommandAuthenticator::create();
 
-  if (!this->getConfig().get<bool>("ndnSIM.disable_forwarder_status_manager", false)) {
+  if (!m_impl->m_config->get<bool>("ndnSIM.disable_forwarder_status_manager", false)) {
     m_impl->m_forwarderStatusManager = make_unique<::nfd::ForwarderStatusManager>(*m_impl->m_forwarder, *m_impl->m_dispatcher);
   }
   m_impl->m_faceManager = make_unique<::nfd::FaceManager>(*m_impl->m_faceSystem, *m_impl->m_dispatcher, *m_impl->m_authenticator);
@@ -277,7 +399,7 @@ L3Protocol::initializeManagement()
                                                         *m_impl->m_dispatcher, *m_impl->m_authenticator);
   m_impl->m_csManager = make_unique<::nfd::CsManager>(m_impl->m_forwarder->getCs(), m_impl->m_forwarder->getCounters(),
                                                       *m_impl->m_dispatcher, *m_impl->m_authenticator);
-  if (!this->getConfig().get<bool>("ndnSIM.disable_strategy_choice_manager", false)) {
+  if (!m_impl->m_config->get<bool>("ndnSIM.disable_strategy_choice_manager", false)) {
     m_impl->m_strategyChoiceManager = make_unique<::nfd::StrategyChoiceManager>(m_impl->m_forwarder->getStrategyChoice(),
                                                                                 *m_impl->m_dispatcher, *m_impl->m_authenticator);
 
@@ -300,7 +422,7 @@ L3Protocol::initializeManagement()
   // }
 
   // apply config
-  config.parse(m_impl->m_config, false, "ndnSIM.conf");
+  config.parse(*m_impl->m_config, false, "ndnSIM.conf");
 
   tablesConfig.ensureConfigured();
 
@@ -319,11 +441,34 @@ L3Protocol::initializeRibManager()
   std::tie(m_impl->m_internalRibFace, m_impl->m_internalRibClientFace) = face::makeInternalFace(StackHelper::getKeyChain());
   m_impl->m_faceTable->add(m_impl->m_internalRibFace);
 
-  m_impl->m_ribService = make_unique<rib::Service>(m_impl->m_config,
+  m_impl->m_ribService = make_unique<rib::Service>(*m_impl->m_config,
                                                    std::ref(*m_impl->m_internalRibClientFace),
                                                    std::ref(StackHelper::getKeyChain()));
 }
 
+void
+L3Protocol::initializeHeadless()
+{
+  using namespace nfd;
+  m_impl->m_isHeadless = true;
+
+  auto& forwarder = m_impl->m_forwarder;
+  forwarder->getCs().setPolicy(m_impl->m_policy());
+
+  // only the tables section applies
+  ConfigFile config(&ConfigFile::ignoreUnknownSection);
+  TablesConfigSection tablesConfig(*forwarder);
+  tablesConfig.setConfigFile(config);
+  config.parse(*m_impl->m_config, false, "ndnSIM.conf");
+  tablesConfig.ensureConfigured();
+}
+
+bool
+L3Protocol::isHeadless() const
+{
+  return m_impl->m_isHeadless;
+}
+
 shared_ptr<nfd::Forwarder>
 L3Protocol::getForwarder()
 {
@@ -345,19 +490,30 @@ L3Protocol::getFibManager()
 nfd::StrategyChoiceManager&
 L3Protocol::getStrategyChoiceManager()
 {
+  NS_ASSERT_MSG(m_impl->m_strategyChoiceManager != nullptr, "Strategy choice manager is not enabled");
   return *m_impl->m_strategyChoiceManager;
 }
 
 ::nfd::rib::Service&
 L3Protocol::getRibService()
 {
+  NS_ASSERT_MSG(m_impl->m_ribService != nullptr, "RIB service is not available on a headless stack");
   return *m_impl->m_ribService;
 }
 
 nfd::ConfigSection&
 L3Protocol::getConfig()
 {
-  return m_impl->m_config;
+  if (m_impl->m_config.use_count() > 1) {
+    m_impl->m_config = make_shared<nfd::ConfigSection>(*m_impl->m_config);
+  }
+  return *m_impl->m_config;
+}
+
+void
+L3Protocol::setConfig(shared_ptr<nfd::ConfigSection> config)
+{
+  m_impl->m_config = std::move(config);
 }
 
 /*
@@ -458,15 +614,11 @@ L3Protocol::getFaceById(nfd::FaceId id) const
 shared_ptr<Face>
 L3Protocol::getFaceByNetDevice(Ptr<NetDevice> netDevice) const
 {
-  for (auto& i : *m_impl->m_faceTable) {
-    auto transport = dynamic_cast<NetDeviceTransport*>(i.getTransport());
-    if (transport == nullptr)
-      continue;
-
-    if (transport->GetNetDevice() == netDevice)
-      return i.shared_from_this();
+  auto found = m_impl->m_facesByNetDevice.find(PeekPointer(netDevice));
+  if (found == m_impl->m_facesByNetDevice.end()) {
+    return nullptr;
   }
-  return nullptr;
+  return found->second->shared_from_this();
 }
 
 Ptr<L3Protocol>
@@ -109,7 +109,7 @@ public:
   getFaceTable();
 
   /**
-   * \brief Get smart pointer to nfd::FibManager, used by node's NFD
+   * \brief Get smart pointer to nfd::FibManager, used by node's NFD (nullptr if headless)
    */
   shared_ptr<nfd::FibManager>
   getFibManager();
@@ -150,22 +150,99 @@ public:
 
   /**
    * \brief Get face for NetDevice
+   *
+   * Constant time: the faces are indexed by NetDevice as they are added to and removed from
+   * the face table.
    */
   shared_ptr<Face>
   getFaceByNetDevice(Ptr<NetDevice> netDevice) const;
 
   /**
    * \brief Get NFD config (boost::property_tree)
+   *
+   * The stack gets its own copy first if its config is shared with other stacks.
    */
   nfd::ConfigSection&
   getConfig();
 
+  /**
+   * \brief Use a config shared with other stacks, which is not modified by this one
+   *
+   * Must be called before the stack is aggregated to the node. Stacks installed with the same
+   * settings can hold one tree instead of a copy each.
+   */
+  void
+  setConfig(shared_ptr<nfd::ConfigSection> config);
+
+  /**
+   * \brief Whether the stack was initialized without management (ndnSIM.headless config)
+   *
+   * A headless stack has the face table, the forwarder and its tables only: no internal
+   * management faces, dispatcher, command authenticator, managers, face system nor RIB
+   * service. FibHelper and StrategyChoiceHelper change its tables directly instead of
+   * sending command Interests, which it would not answer.
+   */
+  bool
+  isHeadless() const;
+
   /**
    * \brief Inject interest through internal Face
    */
   void
   injectInterest(const Interest& interest);
 
+  /**
+   * \brief Change of a FIB entry, see updateFib
+   *
+   * The next hop over face is added (or its cost updated), then the next hop over
+   * replacedFace is removed, so that a replaced entry never runs out of next hops.
+   * A face id of 0 (nfd::face::INVALID_FACEID) leaves out that step.
+   */
+  struct FibUpdate {
+    const Name* prefix;       ///< @brief Prefix of the entry, kept by the caller
+    nfd::FaceId face;         ///< @brief Next hop to add
+    nfd::FaceId replacedFace; ///< @brief Next hop to remove
+    uint64_t cost;            ///< @brief Cost of the added next hop
+  };
+
+  /**
+   * \brief Add a next hop to a FIB entry, or update its cost, in place
+   *
+   * Same as the add-nexthop command of the FIB manager, without building, signing and
+   * dispatching a command Interest: the FIB is changed before the call returns.
+   *
+   * \return false if the face does not exist or the prefix is too long (FIB unchanged)
+   */
+  bool
+  addNextHop(const Name& prefix, nfd::FaceId faceId, uint64_t cost);
+
+  /**
+   * \brief Remove a next hop from a FIB entry in place
+   *
+   * Same as the remove-nexthop command of the FIB manager: the entry is erased with its
+   * last next hop.
+   *
+   * \return false if there is no such next hop
+   */
+  bool
+  removeNextHop(const Name& prefix, nfd::FaceId faceId);
+
+  /**
+   * \brief Replace a next hop of a FIB entry in place (add the new one, remove the old one)
+   *
+   * \return false if the new face does not exist or the prefix is too long (FIB unchanged)
+   */
+  bool
+  replaceNextHop(const Name& prefix, nfd::FaceId oldFaceId, nfd::FaceId newFaceId, uint64_t cost);
+
+  /**
+   * \brief Apply changes to the FIB in place, in order
+   *
+   * \return Number of changes which modified the FIB
+   */
+  size_t
+  updateFib(const std::vector<FibUpdate>& updates);
+
   typedef std::function<std::unique_ptr<nfd::cs::Policy>()> PolicyCreationCallback;
 
   /**
@@ -208,6 +285,12 @@ private:
   void
   initializeRibManager();
 
+  void
+  initializeHeadless();
+
+  bool
+  applyFibUpdate(const Name& prefix, nfd::FaceId faceId, nfd::FaceId replacedFaceId, uint64_t cost);
+
 private:
   class Impl;
   std::unique_ptr<Impl> m_impl;
@@ -84,20 +84,43 @@ NetDeviceTransport::~NetDeviceTransport()
   NS_LOG_FUNCTION_NOARGS();
 }
 
-Block stripBlockHeader(BlockHeader header) {
+/**
+ * @brief Get the TLV-TYPE of the network layer packet without decoding it
+ *
+ * For an LpPacket this is the type of the element carried in its Fragment field.
+ * Returns 0 if the type cannot be determined (e.g., an LpPacket without fragment).
+ */
+static uint32_t
+peekNetworkPacketType(const Block& packet)
+{
   namespace tlv = ::ndn::tlv;
   namespace lp = ::ndn::lp;
-  ::ndn::Buffer::const_iterator first, last;
-  lp::Packet p(header.getBlock());
-  std::tie(first, last) = p.get<lp::FragmentField>(0);
-  try {
-    Block fragmentBlock(::ndn::make_span(&*first, std::distance(first, last)));
-    return fragmentBlock;
+
+  if (packet.type() != lp::tlv::LpPacket) {
+    return packet.type();
   }
-  catch (const tlv::Error& error) {
-    std::cout << "Non-TLV bytes (size: " << std::distance(first, last) << ")";
-    return header.getBlock();
+
+  // Walk the LpPacket header fields up to the fragment, skipping over their values
+  auto pos = packet.value_begin();
+  auto end = packet.value_end();
+  while (pos != end) {
+    uint64_t type = 0;
+    uint64_t length = 0;
+    if (!tlv::readVarNumber(pos, end, type) || !tlv::readVarNumber(pos, end, length) ||
+        length > static_cast<uint64_t>(std::distance(pos, end))) {
+      return 0;
+    }
+    if (type == lp::tlv::Fragment) {
+      uint64_t fragmentType = 0;
+      auto fragmentEnd = pos + length;
+      if (!tlv::readVarNumber(pos, fragmentEnd, fragmentType)) {
+        return 0;
+      }
+      return static_cast<uint32_t>(fragmentType);
+    }
+    pos += length;
   }
+  return 0;
 }
 
 ssize_t
@@ -145,32 +168,25 @@ NetDeviceTransport::doSend(const Block& packet)
     netDevice->Send(ns3Packet, netDevice->GetBroadcast(),
                       L3Protocol::ETHERNET_FRAME_TYPE);
   } else {
-    Block block = stripBlockHeader(header);
-    uint32_t tlv_type = block.type();
-    if (tlv_type == ::ndn::tlv::Interest) {
-      Interest i(block);
-      // Only get the first subname
-      // std::string prefix = i.getName().getSubName(0, 2).toUri();
-      // std::cout << prefix << std::endl;
-      // Removing appended sequence number 
-      // std::string prefix = i.getName().getPrefix(-1).toUri();
+    // Only the TLV-TYPE matters for the next hop fan-out, so do not decode the packet
+    uint32_t tlv_type = peekNetworkPacketType(packet);
+    if (tlv_type == ::ndn::tlv::Interest || tlv_type == ::ndn::tlv::Data) {
+      // Packet::Copy() only shares the serialized buffer (copy-on-write); the last
+      // next hop gets the original packet
+      auto last = m_next_hops.end();
       for (auto it = m_next_hops.begin(); it != m_next_hops.end(); it++) {
         if (it->second > 0)
-          netDevice->Send(ns3Packet->Copy(), it->first,
-                      L3Protocol::ETHERNET_FRAME_TYPE);
+          last = it;
       }
-    }
-    else if (tlv_type == ::ndn::tlv::Data) {
-      Data d(block);
-      // std::string prefix = d.getName().getSubName(0, 2).toUri();
-      // std::cout << prefix << std::endl;
-      // std::string prefix = d.getName().getPrefix(-1).toUri();
-      // std::cout << Simulator::Now().GetSeconds() << "," << netDevice->GetNode()->GetId() << ", " << m_next_data_hops.size() << std::endl;
-      for (auto it = m_next_hops.begin(); it != m_next_hops.end(); it++) {
+      for (auto it = m_next_hops.begin(); it != last; it++) {
         if (it->second > 0)
           netDevice->Send(ns3Packet->Copy(), it->first,
                       L3Protocol::ETHERNET_FRAME_TYPE);
       }
+      if (last != m_next_hops.end()) {
+        netDevice->Send(ns3Packet, last->first,
+                        L3Protocol::ETHERNET_FRAME_TYPE);
+      }
     } else {
       std::cout << "UNKNOWN TLV TYPE: " << tlv_type << std::endl; 
     }
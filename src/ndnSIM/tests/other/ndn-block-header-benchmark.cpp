@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-block-header-benchmark.cpp
+//
+// Per-packet cost of BlockHeader::Deserialize compared to the previous implementation,
+// which streamed the ns-3 buffer byte by byte through boost::iostreams into Block::fromStream.
+//
+//     ./waf --run "ndn-block-header-benchmark --iterations=200000"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <ndn-cxx/lp/packet.hpp>
+
+#include <boost/iostreams/concepts.hpp>
+#include <boost/iostreams/stream.hpp>
+
+#include <chrono>
+#include <iomanip>
+
+namespace ns3 {
+
+namespace io = boost::iostreams;
+
+class Ns3BufferIteratorSource : public io::source {
+public:
+  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
+    : m_is(is)
+  {
+  }
+
+  std::streamsize
+  read(char* buf, std::streamsize nMaxRead)
+  {
+    std::streamsize i = 0;
+    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
+      buf[i] = m_is.ReadU8();
+    }
+    if (i == 0) {
+      return -1;
+    }
+    else {
+      return i;
+    }
+  }
+
+private:
+  ns3::Buffer::Iterator& m_is;
+};
+
+/**
+ * @brief BlockHeader with the previous, stream-based Deserialize
+ */
+class StreamBlockHeader : public ndn::BlockHeader {
+public:
+  virtual uint32_t
+  Deserialize(ns3::Buffer::Iterator start)
+  {
+    io::stream<Ns3BufferIteratorSource> is(start);
+    getBlock() = ::ndn::Block::fromStream(is);
+    return getBlock().size();
+  }
+};
+
+template<class H>
+double
+measure(Ptr<const Packet> packet, uint32_t iterations)
+{
+  H header;
+  auto begin = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; i++) {
+    packet->PeekHeader(header);
+  }
+  auto end = std::chrono::steady_clock::now();
+  NS_ABORT_UNLESS(header.getBlock().size() == packet->GetSize());
+  return std::chrono::duration<double, std::nano>(end - begin).count() / iterations;
+}
+
+Ptr<Packet>
+makePacket(size_t payloadSize)
+{
+  auto data = std::make_shared<ndn::Data>("/leo/uid-1593/1");
+  data->setContent(std::make_shared< ::ndn::Buffer>(payloadSize));
+  ndn::StackHelper::getKeyChain().sign(*data);
+  ::ndn::lp::Packet lpPacket(data->wireEncode());
+
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(ndn::BlockHeader(lpPacket.wireEncode()));
+  return packet;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t iterations = 100000;
+  ns3::CommandLine cmd;
+  cmd.AddValue("iterations", "Number of deserializations per payload size", iterations);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Payload(B)\tWire(B)\tStream(ns/pkt)\tDirect(ns/pkt)\tSpeedup" << std::endl;
+  for (size_t payloadSize : {0, 1024, 8192}) {
+    ns3::Ptr<ns3::Packet> packet = ns3::makePacket(payloadSize);
+    double stream = ns3::measure<ns3::StreamBlockHeader>(packet, iterations);
+    double direct = ns3::measure<ns3::ndn::BlockHeader>(packet, iterations);
+    std::cout << payloadSize << "\t" << packet->GetSize() << "\t"
+              << std::fixed << std::setprecision(1) << stream << "\t" << direct << "\t"
+              << std::setprecision(2) << stream / direct << "x" << std::endl;
+  }
+  return 0;
+}
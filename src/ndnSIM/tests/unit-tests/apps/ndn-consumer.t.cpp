@@ -0,0 +1,284 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer-cbr.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief ConsumerCbr with access to the in-flight state of Consumer
+ *
+ * Send and Receive do the bookkeeping of Consumer for an Interest and its Data without any
+ * packet going through the network.
+ */
+class ConsumerTester : public ConsumerCbr
+{
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::ndn::ConsumerTester")
+      .SetGroupName("Ndn")
+      .SetParent<ConsumerCbr>()
+      .AddConstructor<ConsumerTester>();
+    return tid;
+  }
+
+  void
+  Send(uint32_t seq)
+  {
+    WillSendOutInterest(seq);
+  }
+
+  void
+  Receive(uint32_t seq)
+  {
+    Name name(m_interestName);
+    name.appendSequenceNumber(seq);
+    OnData(make_shared<Data>(name));
+  }
+
+  uint32_t
+  GetRetxCount(uint32_t seq)
+  {
+    SeqState* state = m_seqStates.Find(seq);
+    return state != nullptr ? state->retxCount : 0;
+  }
+
+  size_t
+  GetInFlight() const
+  {
+    return m_seqStates.Size();
+  }
+
+  size_t
+  GetWindowCapacity() const
+  {
+    return m_seqStates.Capacity();
+  }
+
+  size_t
+  GetOverflowSize() const
+  {
+    return m_seqStates.OverflowSize();
+  }
+
+  size_t
+  GetSeqTimeouts() const
+  {
+    return m_seqTimeouts.size();
+  }
+
+  size_t
+  GetStaleSeqTimeouts() const
+  {
+    return m_staleSeqTimeouts;
+  }
+
+  bool
+  IsRetxCheckScheduled() const
+  {
+    return m_retxEvent.IsRunning();
+  }
+
+  virtual void
+  OnTimeout(uint32_t seq) override
+  {
+    timeouts.push_back(std::make_pair(seq, Simulator::Now()));
+    ConsumerCbr::OnTimeout(seq);
+  }
+
+public:
+  std::vector<std::pair<uint32_t, Time>> timeouts;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(ConsumerTester);
+
+class ConsumerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ConsumerFixture()
+  {
+    // no routes: every Interest is Nacked by the forwarder of the node
+    createTopology({
+        {"1"},
+      });
+  }
+
+  Ptr<ConsumerTester>
+  install(uint32_t maxSeq, const std::string& retxTimer = "50ms")
+  {
+    Ptr<ConsumerTester> consumer = CreateObject<ConsumerTester>();
+    consumer->SetAttribute("Prefix", StringValue("/prefix"));
+    consumer->SetAttribute("Frequency", StringValue("1"));
+    consumer->SetAttribute("MaxSeq", IntegerValue(maxSeq));
+    consumer->SetAttribute("RetxTimer", StringValue(retxTimer));
+    consumer->TraceConnectWithoutContext("TransmittedInterests",
+                                         MakeCallback(&ConsumerFixture::transmitted, this));
+    getNode("1")->AddApplication(consumer);
+    consumer->SetStartTime(Seconds(0));
+    return consumer;
+  }
+
+  void
+  transmitted(shared_ptr<const Interest> interest, Ptr<App>, shared_ptr<Face>)
+  {
+    interests.push_back(std::make_pair(interest->getName().at(-1).toSequenceNumber(),
+                                       Simulator::Now()));
+  }
+
+public:
+  std::vector<std::pair<uint32_t, Time>> interests;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnConsumer, ConsumerFixture)
+
+BOOST_AUTO_TEST_CASE(UnreachableProducer)
+{
+  Ptr<ConsumerTester> consumer = install(1);
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  // The RTO starts at the initial RTT estimate of 1s and doubles with every timeout. A timed
+  // out Interest is sent again with the next packet of the consumer, 1s later.
+  std::vector<std::pair<uint32_t, Time>> expectedTimeouts = {
+    {0, Seconds(1)}, {0, Seconds(3)}, {0, Seconds(8)}, {0, Seconds(17)}};
+  std::vector<std::pair<uint32_t, Time>> expectedInterests = {
+    {0, Seconds(0)}, {0, Seconds(1)}, {0, Seconds(4)}, {0, Seconds(9)}, {0, Seconds(18)}};
+
+  BOOST_CHECK(consumer->timeouts == expectedTimeouts);
+  BOOST_CHECK(interests == expectedInterests);
+  BOOST_CHECK_EQUAL(consumer->GetRetxCount(0), 5u);
+  BOOST_CHECK_EQUAL(consumer->GetInFlight(), 1u);
+  BOOST_CHECK(consumer->IsRetxCheckScheduled());
+}
+
+BOOST_AUTO_TEST_CASE(SparseWindow)
+{
+  Ptr<ConsumerTester> consumer = install(0);
+
+  Simulator::Schedule(Seconds(0.1), [consumer] {
+      // Sequence number 0 never gets its Data, all later ones do right away
+      consumer->Send(0);
+      consumer->Send(0);
+      for (uint32_t seq = 1; seq < 4096; seq++) {
+        consumer->Send(seq);
+        consumer->Receive(seq);
+      }
+      BOOST_CHECK_EQUAL(consumer->GetWindowCapacity(), 4096u);
+      BOOST_CHECK_EQUAL(consumer->GetOverflowSize(), 0u);
+
+      // The window moves forward instead of growing, and 0 spills into the overflow map
+      for (uint32_t seq = 4096; seq < 10000; seq++) {
+        consumer->Send(seq);
+        consumer->Receive(seq);
+      }
+      BOOST_CHECK_EQUAL(consumer->GetWindowCapacity(), 4096u);
+      BOOST_CHECK_EQUAL(consumer->GetOverflowSize(), 1u);
+      BOOST_CHECK_EQUAL(consumer->GetInFlight(), 1u);
+      BOOST_CHECK_EQUAL(consumer->GetRetxCount(0), 2u);
+
+      // The spilled state is still found, retransmitted and finally erased
+      consumer->Send(0);
+      BOOST_CHECK_EQUAL(consumer->GetRetxCount(0), 3u);
+      BOOST_CHECK_EQUAL(consumer->GetOverflowSize(), 1u);
+
+      consumer->Receive(0);
+      BOOST_CHECK_EQUAL(consumer->GetInFlight(), 0u);
+      BOOST_CHECK_EQUAL(consumer->GetOverflowSize(), 0u);
+      BOOST_CHECK(!consumer->IsRetxCheckScheduled());
+
+      // A new window starts at the next sequence number
+      consumer->Send(10000);
+      BOOST_CHECK_EQUAL(consumer->GetInFlight(), 1u);
+      BOOST_CHECK_EQUAL(consumer->GetOverflowSize(), 0u);
+    });
+
+  Simulator::Stop(Seconds(0.2));
+  Simulator::Run();
+
+  BOOST_CHECK(consumer->timeouts.empty());
+}
+
+BOOST_AUTO_TEST_CASE(StaleTimeoutCompaction)
+{
+  Ptr<ConsumerTester> consumer = install(0);
+
+  Simulator::Schedule(Seconds(0.1), [consumer] {
+      // The timeout of 0 stays at the front, the ones behind it become stale
+      consumer->Send(0);
+      for (uint32_t seq = 1; seq <= 1024; seq++) {
+        consumer->Send(seq);
+        consumer->Receive(seq);
+      }
+      BOOST_CHECK_EQUAL(consumer->GetSeqTimeouts(), 1025u);
+      BOOST_CHECK_EQUAL(consumer->GetStaleSeqTimeouts(), 1024u);
+
+      // Past 1024 stale entries (and more than half of them), the FIFO is compacted
+      consumer->Send(1025);
+      consumer->Receive(1025);
+      BOOST_CHECK_EQUAL(consumer->GetSeqTimeouts(), 1u);
+      BOOST_CHECK_EQUAL(consumer->GetStaleSeqTimeouts(), 0u);
+      BOOST_CHECK_EQUAL(consumer->GetInFlight(), 1u);
+      BOOST_CHECK(consumer->IsRetxCheckScheduled());
+    });
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  // Only the timeout of 0 survives the compaction, and it still expires
+  BOOST_REQUIRE(!consumer->timeouts.empty());
+  for (const auto& timeout : consumer->timeouts) {
+    BOOST_CHECK_EQUAL(timeout.first, 0u);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RetxTimerZero)
+{
+  Ptr<ConsumerTester> consumer = install(1, "0s");
+
+  Simulator::Stop(Seconds(5));
+  Simulator::Run();
+
+  // No retransmission checks at all
+  BOOST_CHECK(consumer->timeouts.empty());
+  BOOST_CHECK_EQUAL(interests.size(), 1u);
+  BOOST_CHECK_EQUAL(consumer->GetRetxCount(0), 1u);
+  BOOST_CHECK(!consumer->IsRetxCheckScheduled());
+
+  // The pending timeout expires at the first check once the timer is set again
+  consumer->SetAttribute("RetxTimer", StringValue("50ms"));
+  BOOST_CHECK(consumer->IsRetxCheckScheduled());
+
+  Simulator::Stop(Seconds(0.5));
+  Simulator::Run();
+
+  std::vector<std::pair<uint32_t, Time>> expectedTimeouts = {{0, MilliSeconds(5050)}};
+  BOOST_CHECK(consumer->timeouts == expectedTimeouts);
+  BOOST_CHECK_EQUAL(interests.size(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
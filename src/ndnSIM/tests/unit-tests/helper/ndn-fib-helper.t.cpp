@@ -18,6 +18,9 @@
  **/
 
 #include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "NFD/daemon/fw/forwarder.hpp"
 
 #include "../tests-common.hpp"
 
@@ -97,8 +100,99 @@ BOOST_AUTO_TEST_CASE(Helper4)
   FibHelper::AddRoute(getNode("1"), Name("/prefix"), getNode("2"), 10);
 }
 
+// static void
+// AddRouteInPlace(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, int32_t metric);
+BOOST_AUTO_TEST_CASE(InPlace)
+{
+  FibHelper::AddRouteInPlace(getNode("1"), Name("/prefix"), getFace("1", "2"), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // AddRoute
 
+class InPlaceFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  InPlaceFixture()
+  {
+    createTopology({
+        {"1", "2"},
+        {"1", "3"}
+      });
+    ndn = getNode("1")->GetObject<L3Protocol>();
+  }
+
+  typedef std::vector<std::pair<nfd::FaceId, uint64_t>> NextHops;
+
+  // (face id, cost) of the next hops of the exact FIB entry, empty if there is no entry
+  NextHops
+  getNextHops(const Name& prefix)
+  {
+    NextHops nextHops;
+    const nfd::fib::Entry* entry = ndn->getForwarder()->getFib().findExactMatch(prefix);
+    if (entry != nullptr) {
+      for (const auto& nextHop : entry->getNextHops()) {
+        nextHops.push_back(std::make_pair(nextHop.getFace().getId(), nextHop.getCost()));
+      }
+    }
+    return nextHops;
+  }
+
+public:
+  Ptr<L3Protocol> ndn;
+};
+
+BOOST_FIXTURE_TEST_SUITE(InPlace, InPlaceFixture)
+
+BOOST_AUTO_TEST_CASE(AddReplaceRemove)
+{
+  Name prefix("/prefix");
+  nfd::FaceId face2 = getFace("1", "2")->getId();
+  nfd::FaceId face3 = getFace("1", "3")->getId();
+
+  BOOST_CHECK(ndn->addNextHop(prefix, face2, 10));
+  BOOST_CHECK(getNextHops(prefix) == NextHops({{face2, 10}}));
+  BOOST_CHECK(ndn->addNextHop(prefix, face2, 5));
+  BOOST_CHECK(getNextHops(prefix) == NextHops({{face2, 5}}));
+
+  BOOST_CHECK(ndn->replaceNextHop(prefix, face2, face3, 7));
+  BOOST_CHECK(getNextHops(prefix) == NextHops({{face3, 7}}));
+
+  // Same as the FIB manager: unknown faces and next hops change nothing
+  BOOST_CHECK(!ndn->addNextHop(prefix, 12345, 1));
+  BOOST_CHECK(!ndn->removeNextHop(prefix, face2));
+  BOOST_CHECK(!ndn->removeNextHop(Name("/other"), face3));
+  BOOST_CHECK(getNextHops(prefix) == NextHops({{face3, 7}}));
+
+  // The entry goes away with its last next hop
+  BOOST_CHECK(ndn->removeNextHop(prefix, face3));
+  BOOST_CHECK(ndn->getForwarder()->getFib().findExactMatch(prefix) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Bulk)
+{
+  Name a("/a");
+  Name b("/b");
+  nfd::FaceId face2 = getFace("1", "2")->getId();
+  nfd::FaceId face3 = getFace("1", "3")->getId();
+
+  std::vector<L3Protocol::FibUpdate> updates = {
+    {&a, face2, nfd::face::INVALID_FACEID, 1},
+    {&b, face3, nfd::face::INVALID_FACEID, 2},
+    {&a, face3, face2, 3},
+    {&b, nfd::face::INVALID_FACEID, face2, 0}
+  };
+  BOOST_CHECK_EQUAL(ndn->updateFib(updates), 3);
+  BOOST_CHECK(getNextHops(a) == NextHops({{face3, 3}}));
+  BOOST_CHECK(getNextHops(b) == NextHops({{face3, 2}}));
+
+  FibHelper::RemoveRouteInPlace(getNode("1"), b, getFace("1", "3"));
+  BOOST_CHECK(getNextHops(b).empty());
+  FibHelper::ReplaceRouteInPlace(getNode("1"), a, getFace("1", "3"), getFace("1", "2"), 4);
+  BOOST_CHECK(getNextHops(a) == NextHops({{face2, 4}}));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // InPlace
+
 BOOST_AUTO_TEST_SUITE_END() // HelperNdnFibHelper
 
 } // namespace ndn
@@ -161,6 +161,42 @@ BOOST_AUTO_TEST_CASE(PrintLpPacket)
   }
 }
 
+BOOST_AUTO_TEST_CASE(Deserialize)
+{
+  for (size_t payloadSize : {0, 200, 8192, 70000}) {
+    Data data("/other/prefix");
+    data.setContent(std::make_shared< ::ndn::Buffer>(payloadSize));
+    ndn::StackHelper::getKeyChain().sign(data);
+    lp::Packet lpPacket(data.wireEncode());
+    Block wire = lpPacket.wireEncode();
+
+    // bytes following the NDN packet must not become part of the block
+    Ptr<Packet> packet = Create<Packet>(16);
+    packet->AddHeader(BlockHeader(wire));
+
+    BlockHeader header;
+    BOOST_CHECK_EQUAL(packet->RemoveHeader(header), wire.size());
+    BOOST_CHECK_EQUAL(packet->GetSize(), 16);
+    BOOST_CHECK_EQUAL_COLLECTIONS(header.getBlock().begin(), header.getBlock().end(),
+                                  wire.begin(), wire.end());
+    BOOST_CHECK(lp::Packet(header.getBlock()).has<lp::FragmentField>());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DeserializeTruncated)
+{
+  Interest interest("/prefix");
+  interest.setNonce(10);
+  Block wire = lp::Packet(interest.wireEncode()).wireEncode();
+
+  Ptr<Packet> packet = Create<Packet>(wire.wire(), wire.size() - 1);
+  BlockHeader header;
+  BOOST_CHECK_THROW(packet->RemoveHeader(header), ::ndn::tlv::Error);
+
+  Ptr<Packet> empty = Create<Packet>();
+  BOOST_CHECK_THROW(empty->RemoveHeader(header), ::ndn::tlv::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -20,6 +20,12 @@
 #include "helper/ndn-scenario-helper.hpp"
 #include "helper/ndn-app-helper.hpp"
 
+#include "model/ndn-l3-protocol.hpp"
+#include "model/ndn-net-device-transport.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
 #include <ndn-cxx/face.hpp>
 
 #include "../tests-common.hpp"
@@ -124,6 +130,83 @@ BOOST_AUTO_TEST_CASE(DisabledForwarderStatusManager)
 
 BOOST_AUTO_TEST_SUITE_END() // ManagerCheck
 
+class FaceByNetDeviceFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  FaceByNetDeviceFixture()
+  {
+    createTopology({
+        {"1", "2"},
+          });
+    l3 = getNode("1")->GetObject<L3Protocol>();
+    netDevice = getNetDevice("1", "2");
+  }
+
+  // Adds another face on the same NetDevice, after the one of the stack helper
+  shared_ptr<Face>
+  addFace()
+  {
+    auto transport = make_unique<NetDeviceTransport>(getNode("1"), netDevice,
+                                                     "netdev://[00:00:00:00:00:01]",
+                                                     "netdev://[ff:ff:ff:ff:ff:ff]");
+    auto face = std::make_shared<Face>(make_unique<::nfd::face::GenericLinkService>(),
+                                       std::move(transport));
+    l3->addFace(face);
+    return face;
+  }
+
+  // The face which getFaceByNetDevice should return: the first one of the device in the table
+  shared_ptr<Face>
+  scanFaceTable()
+  {
+    for (auto& face : l3->getFaceTable()) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(face.getTransport());
+      if (transport != nullptr && transport->GetNetDevice() == netDevice) {
+        return face.shared_from_this();
+      }
+    }
+    return nullptr;
+  }
+
+  // The face table removes a closed face on the next scheduler event
+  void
+  removeFace(shared_ptr<Face> face)
+  {
+    face->close();
+    Simulator::Stop(Seconds(0.001));
+    Simulator::Run();
+  }
+
+public:
+  Ptr<L3Protocol> l3;
+  Ptr<NetDevice> netDevice;
+};
+
+BOOST_FIXTURE_TEST_CASE(FaceByNetDeviceFallback, FaceByNetDeviceFixture)
+{
+  // the face of the stack helper (not getFace, which reads the index under test)
+  shared_ptr<Face> first = scanFaceTable();
+  BOOST_REQUIRE(first != nullptr);
+  shared_ptr<Face> second = addFace();
+  BOOST_CHECK(first != second);
+
+  // the first face of the device wins
+  BOOST_CHECK_EQUAL(scanFaceTable(), first);
+  BOOST_CHECK_EQUAL(l3->getFaceByNetDevice(netDevice), first);
+
+  // the other face of the device takes over
+  nfd::FaceId firstId = first->getId();
+  removeFace(first);
+  BOOST_CHECK(l3->getFaceTable().get(firstId) == nullptr);
+  BOOST_CHECK_EQUAL(scanFaceTable(), second);
+  BOOST_CHECK_EQUAL(l3->getFaceByNetDevice(netDevice), second);
+
+  // no face left on the device
+  removeFace(second);
+  BOOST_CHECK(scanFaceTable() == nullptr);
+  BOOST_CHECK(l3->getFaceByNetDevice(netDevice) == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ModelNdnL3Protocol
 
 } // namespace ndn
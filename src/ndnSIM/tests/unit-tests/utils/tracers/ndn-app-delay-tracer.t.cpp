@@ -28,6 +28,7 @@ namespace ns3 {
 namespace ndn {
 
 const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+const boost::filesystem::path TEST_BINARY_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.bin";
 
 class AppDelayTracerFixture : public ScenarioHelperWithCleanupFixture
 {
@@ -68,6 +69,7 @@ public:
   ~AppDelayTracerFixture()
   {
     boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_BINARY_TRACE);
     AppDelayTracer::Destroy(); // additional cleanup
   }
 };
@@ -98,6 +100,29 @@ BOOST_AUTO_TEST_CASE(InstallAll)
 )STR");
 }
 
+BOOST_AUTO_TEST_CASE(InstallAllBinary)
+{
+  AppDelayTracer::InstallAll(TEST_BINARY_TRACE.string());
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to close the writer
+
+  std::stringstream buffer;
+  TraceWriter::ConvertToText(TEST_BINARY_TRACE.string(), buffer);
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+                    R"STR(Time	Node	AppId	SeqNo	Type	DelayS	DelayUS	RetxCount	HopCount
+1.04177	1	0	0	LastDelay	0.0417664	41766.4	1	2
+1.04177	1	0	0	FullDelay	0.0417664	41766.4	1	2
+2	2	0	0	LastDelay	0	0	1	1
+2	2	0	0	FullDelay	0	0	1	1
+3.02088	2	0	1	LastDelay	0.0208832	20883.2	1	1
+3.02088	2	0	1	FullDelay	0.0208832	20883.2	1	1
+)STR");
+}
+
 BOOST_AUTO_TEST_CASE(InstallNodeContainer)
 {
   NodeContainer nodes;
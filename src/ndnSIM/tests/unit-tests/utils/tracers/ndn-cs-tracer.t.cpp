@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-cs-tracer.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+const boost::filesystem::path TEST_BINARY_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.bin";
+
+class CsTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  CsTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    // setting default parameters for PointToPoint links and channels
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue<Packet>::MaxSize", StringValue("20p"));
+
+    createTopology({
+        {"1", "2"}
+      });
+  }
+
+  ~CsTracerFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_BINARY_TRACE);
+    CsTracer::Destroy(); // additional cleanup
+  }
+};
+
+// CsTracer is not connected to the content store of NFD yet, so all counts are zero
+const std::string CS_TRACE = R"STR(Time	Node	Type	Packets	
+1	1	CacheHits	0
+1	1	CacheMisses	0
+1	2	CacheHits	0
+1	2	CacheMisses	0
+2	1	CacheHits	0
+2	1	CacheMisses	0
+2	2	CacheHits	0
+2	2	CacheMisses	0
+)STR";
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnCsTracer, CsTracerFixture)
+
+BOOST_AUTO_TEST_CASE(InstallAll)
+{
+  CsTracer::InstallAll(TEST_TRACE.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  CsTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(), CS_TRACE);
+}
+
+BOOST_AUTO_TEST_CASE(InstallAllBinary)
+{
+  CsTracer::InstallAll(TEST_BINARY_TRACE.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  CsTracer::Destroy(); // to close the writer
+
+  std::stringstream buffer;
+  TraceWriter::ConvertToText(TEST_BINARY_TRACE.string(), buffer);
+
+  BOOST_CHECK_EQUAL(buffer.str(), CS_TRACE);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -28,6 +28,7 @@ namespace ns3 {
 namespace ndn {
 
 const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+const boost::filesystem::path TEST_BINARY_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.bin";
 
 class L3RateTracerFixture : public ScenarioHelperWithCleanupFixture
 {
@@ -55,6 +56,7 @@ public:
   ~L3RateTracerFixture()
   {
     boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_BINARY_TRACE);
     L3RateTracer::Destroy(); // additional cleanup
   }
 };
@@ -119,6 +121,58 @@ BOOST_AUTO_TEST_CASE(NackTracing)
   BOOST_CHECK(os.match_pattern());
 }
 
+BOOST_AUTO_TEST_CASE(NackTracingBinary)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  L3RateTracer::Install(nodes, TEST_BINARY_TRACE.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to close the writer
+
+  std::stringstream buffer;
+  TraceWriter::ConvertToText(TEST_BINARY_TRACE.string(), buffer);
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+                    R"STR(Time	Node	FaceId	FaceDescr	Type	Packets	Kilobytes	PacketRaw	KilobytesRaw
+1	1	1	internal://	InInterests	0	0	0	0
+1	1	1	internal://	OutInterests	0	0	0	0
+1	1	1	internal://	InData	0	0	0	0
+1	1	1	internal://	OutData	0	0	0	0
+1	1	1	internal://	InNacks	0	0	0	0
+1	1	1	internal://	OutNacks	0	0	0	0
+1	1	1	internal://	InSatisfiedInterests	0	0	0	0
+1	1	1	internal://	InTimedOutInterests	0	0	0	0
+1	1	1	internal://	OutSatisfiedInterests	4	0	5	0
+1	1	1	internal://	OutTimedOutInterests	0	0	0	0
+1	1	256	internal://	InInterests	0	0	0	0
+1	1	256	internal://	OutInterests	0	0	0	0
+1	1	256	internal://	InData	0	0	0	0
+1	1	256	internal://	OutData	0	0	0	0
+1	1	256	internal://	InNacks	0	0	0	0
+1	1	256	internal://	OutNacks	0	0	0	0
+1	1	256	internal://	InSatisfiedInterests	4	0	5	0
+1	1	256	internal://	InTimedOutInterests	0	0	0	0
+1	1	256	internal://	OutSatisfiedInterests	0	0	0	0
+1	1	256	internal://	OutTimedOutInterests	0	0	0	0
+1	1	257	appFace://	InInterests	0.8	0	1	0
+1	1	257	appFace://	OutInterests	0	0	0	0
+1	1	257	appFace://	InData	0	0	0	0
+1	1	257	appFace://	OutData	0	0	0	0
+1	1	257	appFace://	InNacks	0	0	0	0
+1	1	257	appFace://	OutNacks	0.8	0	1	0
+1	1	257	appFace://	InSatisfiedInterests	0	0	0	0
+1	1	257	appFace://	InTimedOutInterests	0	0	0	0
+1	1	257	appFace://	OutSatisfiedInterests	0	0	0	0
+1	1	257	appFace://	OutTimedOutInterests	0	0	0	0
+1	1	-1	all	SatisfiedInterests	4	0	5	0
+1	1	-1	all	TimedOutInterests	0.8	0	1	0
+)STR");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
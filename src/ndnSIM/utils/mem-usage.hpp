@@ -22,8 +22,9 @@
 
 #ifdef __linux__
 // #include <proc/readproc.h>
-// #include <unistd.h>
 // // #include <sys/resource.h>
+#include <fstream>
+#include <unistd.h>
 #include <sys/sysinfo.h>
 #endif
 
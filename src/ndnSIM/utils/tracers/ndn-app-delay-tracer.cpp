@@ -33,6 +33,7 @@
 #include <boost/make_shared.hpp>
 
 #include <fstream>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppDelayTracer");
 
@@ -48,12 +49,41 @@ AppDelayTracer::Destroy()
   g_tracers.clear();
 }
 
+static void
+InstallBinary(const NodeContainer& nodes, const std::string& file)
+{
+  auto writer = make_shared<TraceWriter>(file, AppDelayTracer::GetColumns());
+  if (!writer->IsOpen()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
+  }
+
+  std::list<Ptr<AppDelayTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    tracers.push_back(AppDelayTracer::Install(*node, writer));
+  }
+
+  if (tracers.size() > 0) {
+    std::ostringstream header;
+    tracers.front()->PrintHeader(header);
+    writer->SetHeader(header.str());
+  }
+
+  // the writer is closed together with the last tracer
+  g_tracers.push_back(std::make_tuple(shared_ptr<std::ostream>(), tracers));
+}
+
 void
 AppDelayTracer::InstallAll(const std::string& file)
 {
   using namespace boost;
   using namespace std;
 
+  if (IsBinaryTraceFile(file)) {
+    InstallBinary(NodeContainer::GetGlobal(), file);
+    return;
+  }
+
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -91,6 +121,11 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
   using namespace boost;
   using namespace std;
 
+  if (IsBinaryTraceFile(file)) {
+    InstallBinary(nodes, file);
+    return;
+  }
+
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -128,6 +163,11 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
   using namespace boost;
   using namespace std;
 
+  if (IsBinaryTraceFile(file)) {
+    InstallBinary(NodeContainer(node), file);
+    return;
+  }
+
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -167,6 +207,26 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
   return trace;
 }
 
+Ptr<AppDelayTracer>
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<TraceWriter> writer)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(shared_ptr<std::ostream>(), node);
+  trace->SetWriter(writer);
+
+  return trace;
+}
+
+const std::vector<TraceWriter::ColumnType>&
+AppDelayTracer::GetColumns()
+{
+  static const std::vector<TraceWriter::ColumnType> columns = {
+    TraceWriter::REAL, TraceWriter::STRING, TraceWriter::INT, TraceWriter::INT, TraceWriter::STRING,
+    TraceWriter::REAL, TraceWriter::REAL, TraceWriter::INT, TraceWriter::INT};
+  return columns;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -194,6 +254,15 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& n
 
 AppDelayTracer::~AppDelayTracer(){};
 
+void
+AppDelayTracer::SetWriter(shared_ptr<TraceWriter> writer)
+{
+  m_writer = writer;
+  m_nodeString = m_writer->Intern(m_node);
+  m_lastDelayString = m_writer->Intern("LastDelay");
+  m_fullDelayString = m_writer->Intern("FullDelay");
+}
+
 void
 AppDelayTracer::Connect()
 {
@@ -233,6 +302,11 @@ void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
+  if (m_writer != nullptr) {
+    WriteRecord(app, seqno, m_lastDelayString, delay, 1, hopCount);
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "LastDelay"
@@ -244,6 +318,11 @@ void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
+  if (m_writer != nullptr) {
+    WriteRecord(app, seqno, m_fullDelayString, delay, retxCount, hopCount);
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "FullDelay"
@@ -251,5 +330,22 @@ AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
         << "\t" << hopCount << "\n";
 }
 
+void
+AppDelayTracer::WriteRecord(Ptr<App> app, uint32_t seqno, uint64_t type, Time delay,
+                            uint32_t retxCount, int32_t hopCount)
+{
+  TraceWriter::Record record;
+  record.values[0] = TraceWriter::Real(Simulator::Now().ToDouble(Time::S));
+  record.values[1] = m_nodeString;
+  record.values[2] = TraceWriter::Int(app->GetId());
+  record.values[3] = TraceWriter::Int(seqno);
+  record.values[4] = type;
+  record.values[5] = TraceWriter::Real(delay.ToDouble(Time::S));
+  record.values[6] = TraceWriter::Real(delay.ToDouble(Time::US));
+  record.values[7] = TraceWriter::Int(retxCount);
+  record.values[8] = TraceWriter::Int(hopCount);
+  m_writer->Append(record);
+}
+
 } // namespace ndn
 } // namespace ns3
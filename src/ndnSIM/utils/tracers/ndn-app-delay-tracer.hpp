@@ -21,6 +21,7 @@
 #define CCNX_APP_DELAY_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-writer.hpp"
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -49,7 +50,8 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin, the binary TraceWriter is used
    *
    */
   static void
@@ -59,7 +61,8 @@ public:
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin, the binary TraceWriter is used
    *
    */
   static void
@@ -69,7 +72,8 @@ public:
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin, the binary TraceWriter is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *        second)
    */
@@ -91,6 +95,21 @@ public:
   static Ptr<AppDelayTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install a tracer writing binary records on a specific simulation node
+   *
+   * @param node   Node on which to install tracer
+   * @param writer Binary trace writer, with the columns of AppDelayTracer::GetColumns ()
+   */
+  static Ptr<AppDelayTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceWriter> writer);
+
+  /**
+   * @brief Column types of the binary records, in the order of PrintHeader
+   */
+  static const std::vector<TraceWriter::ColumnType>&
+  GetColumns();
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -138,11 +157,23 @@ private:
   FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t rextCount,
                          int32_t hopCount);
 
+  void
+  SetWriter(shared_ptr<TraceWriter> writer);
+
+  void
+  WriteRecord(Ptr<App> app, uint32_t seqno, uint64_t type, Time delay, uint32_t retxCount,
+              int32_t hopCount);
+
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+
+  shared_ptr<TraceWriter> m_writer; ///< instead of m_os, for binary traces
+  uint64_t m_nodeString;
+  uint64_t m_lastDelayString;
+  uint64_t m_fullDelayString;
 };
 
 } // namespace ndn
@@ -32,6 +32,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include <fstream>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE("ndn.CsTracer");
 
@@ -46,12 +47,41 @@ CsTracer::Destroy()
   g_tracers.clear();
 }
 
+static void
+InstallBinary(const NodeContainer& nodes, const std::string& file, Time averagingPeriod)
+{
+  auto writer = make_shared<TraceWriter>(file, CsTracer::GetColumns());
+  if (!writer->IsOpen()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
+  }
+
+  std::list<Ptr<CsTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    tracers.push_back(CsTracer::Install(*node, writer, averagingPeriod));
+  }
+
+  if (tracers.size() > 0) {
+    std::ostringstream header;
+    tracers.front()->PrintHeader(header);
+    writer->SetHeader(header.str());
+  }
+
+  // the writer is closed together with the last tracer
+  g_tracers.push_back(std::make_tuple(shared_ptr<std::ostream>(), tracers));
+}
+
 void
 CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
   using namespace boost;
   using namespace std;
 
+  if (IsBinaryTraceFile(file)) {
+    InstallBinary(NodeContainer::GetGlobal(), file, averagingPeriod);
+    return;
+  }
+
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -90,6 +120,11 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
   using namespace boost;
   using namespace std;
 
+  if (IsBinaryTraceFile(file)) {
+    InstallBinary(nodes, file, averagingPeriod);
+    return;
+  }
+
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -128,6 +163,11 @@ CsTracer::Install(Ptr<Node> node, const std::string& file,
   using namespace boost;
   using namespace std;
 
+  if (IsBinaryTraceFile(file)) {
+    InstallBinary(NodeContainer(node), file, averagingPeriod);
+    return;
+  }
+
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -169,6 +209,27 @@ CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
   return trace;
 }
 
+Ptr<CsTracer>
+CsTracer::Install(Ptr<Node> node, shared_ptr<TraceWriter> writer,
+                  Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<CsTracer> trace = Create<CsTracer>(shared_ptr<std::ostream>(), node);
+  trace->SetWriter(writer);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+const std::vector<TraceWriter::ColumnType>&
+CsTracer::GetColumns()
+{
+  static const std::vector<TraceWriter::ColumnType> columns = {
+    TraceWriter::REAL, TraceWriter::STRING, TraceWriter::STRING, TraceWriter::REAL};
+  return columns;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -196,6 +257,15 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
 
 CsTracer::~CsTracer(){};
 
+void
+CsTracer::SetWriter(shared_ptr<TraceWriter> writer)
+{
+  m_writer = writer;
+  m_nodeString = m_writer->Intern(m_node);
+  m_cacheHitsString = m_writer->Intern("CacheHits");
+  m_cacheMissesString = m_writer->Intern("CacheMisses");
+}
+
 void
 CsTracer::Connect()
 {
@@ -218,7 +288,12 @@ CsTracer::SetAveragingPeriod(const Time& period)
 void
 CsTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    WriteRecords();
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
@@ -258,6 +333,22 @@ CsTracer::Print(std::ostream& os) const
   PRINTER("CacheMisses", m_cacheMisses);
 }
 
+void
+CsTracer::WriteRecords() const
+{
+  TraceWriter::Record record;
+  record.values[0] = TraceWriter::Real(Simulator::Now().ToDouble(Time::S));
+  record.values[1] = m_nodeString;
+
+  record.values[2] = m_cacheHitsString;
+  record.values[3] = TraceWriter::Real(m_stats.m_cacheHits);
+  m_writer->Append(record);
+
+  record.values[2] = m_cacheMissesString;
+  record.values[3] = TraceWriter::Real(m_stats.m_cacheMisses);
+  m_writer->Append(record);
+}
+
 void
 CsTracer::CacheHits(shared_ptr<const Interest>, shared_ptr<const Data>)
 {
@@ -21,6 +21,7 @@
 #define CCNX_CS_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-writer.hpp"
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -64,7 +65,8 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin, the binary TraceWriter is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -80,7 +82,8 @@ public:
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin, the binary TraceWriter is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -96,7 +99,8 @@ public:
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin, the binary TraceWriter is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -124,6 +128,22 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install a tracer writing binary records on a specific simulation node
+   *
+   * @param node   Node on which to install tracer
+   * @param writer Binary trace writer, with the columns of CsTracer::GetColumns ()
+   * @param averagingPeriod How often data will be written into the trace file
+   */
+  static Ptr<CsTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceWriter> writer, Time averagingPeriod = Seconds(0.5));
+
+  /**
+   * @brief Column types of the binary records, in the order of PrintHeader
+   */
+  static const std::vector<TraceWriter::ColumnType>&
+  GetColumns();
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -188,11 +208,21 @@ private:
   void
   PeriodicPrinter();
 
+  void
+  SetWriter(shared_ptr<TraceWriter> writer);
+
+  void
+  WriteRecords() const;
+
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceWriter> m_writer; ///< instead of m_os, for binary traces
+  uint64_t m_nodeString;
+  uint64_t m_cacheHitsString;
+  uint64_t m_cacheMissesString;
 
   Time m_period;
   EventId m_printEvent;
@@ -30,6 +30,7 @@
 #include "daemon/table/pit-entry.hpp"
 
 #include <fstream>
+#include <sstream>
 #include <boost/lexical_cast.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
@@ -46,9 +47,38 @@ L3RateTracer::Destroy()
   g_tracers.clear();
 }
 
+static void
+InstallBinary(const NodeContainer& nodes, const std::string& file, Time averagingPeriod)
+{
+  auto writer = make_shared<TraceWriter>(file, L3RateTracer::GetColumns());
+  if (!writer->IsOpen()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
+  }
+
+  std::list<Ptr<L3RateTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    tracers.push_back(L3RateTracer::Install(*node, writer, averagingPeriod));
+  }
+
+  if (tracers.size() > 0) {
+    std::ostringstream header;
+    tracers.front()->PrintHeader(header);
+    writer->SetHeader(header.str());
+  }
+
+  // the writer is closed together with the last tracer
+  g_tracers.push_back(std::make_tuple(shared_ptr<std::ostream>(), tracers));
+}
+
 void
 L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
+  if (IsBinaryTraceFile(file)) {
+    InstallBinary(NodeContainer::GetGlobal(), file, averagingPeriod);
+    return;
+  }
+
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -87,6 +117,11 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
   using namespace boost;
   using namespace std;
 
+  if (IsBinaryTraceFile(file)) {
+    InstallBinary(nodes, file, averagingPeriod);
+    return;
+  }
+
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -125,6 +160,11 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
   using namespace boost;
   using namespace std;
 
+  if (IsBinaryTraceFile(file)) {
+    InstallBinary(NodeContainer(node), file, averagingPeriod);
+    return;
+  }
+
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -166,6 +206,29 @@ L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
   return trace;
 }
 
+Ptr<L3RateTracer>
+L3RateTracer::Install(Ptr<Node> node, shared_ptr<TraceWriter> writer,
+                      Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<L3RateTracer> trace = Create<L3RateTracer>(shared_ptr<std::ostream>(), node);
+  trace->SetWriter(writer);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+const std::vector<TraceWriter::ColumnType>&
+L3RateTracer::GetColumns()
+{
+  static const std::vector<TraceWriter::ColumnType> columns = {
+    TraceWriter::REAL, TraceWriter::STRING, TraceWriter::INT, TraceWriter::STRING,
+    TraceWriter::STRING, TraceWriter::REAL, TraceWriter::REAL, TraceWriter::REAL,
+    TraceWriter::REAL};
+  return columns;
+}
+
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : L3Tracer(node)
   , m_os(os)
@@ -185,6 +248,26 @@ L3RateTracer::~L3RateTracer()
   m_printEvent.Cancel();
 }
 
+// names of L3RateTracer::RecordType
+static const char* const RECORD_TYPE_NAMES[] = {
+  "InInterests", "OutInterests", "InData", "OutData", "InNacks", "OutNacks",
+  "InSatisfiedInterests", "InTimedOutInterests", "OutSatisfiedInterests", "OutTimedOutInterests",
+  "SatisfiedInterests", "TimedOutInterests"};
+
+void
+L3RateTracer::SetWriter(shared_ptr<TraceWriter> writer)
+{
+  m_writer = writer;
+  m_nodeString = m_writer->Intern(m_node);
+  m_allString = m_writer->Intern("all");
+  for (int type = 0; type < N_RECORD_TYPES; type++) {
+    m_typeStrings[type] = m_writer->Intern(RECORD_TYPE_NAMES[type]);
+  }
+  for (const auto& info : m_faceInfos) {
+    m_faceInfoStrings[info.first] = m_writer->Intern(info.second);
+  }
+}
+
 void
 L3RateTracer::SetAveragingPeriod(const Time& period)
 {
@@ -196,7 +279,7 @@ L3RateTracer::SetAveragingPeriod(const Time& period)
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  PrintRecords(m_os.get());
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
@@ -240,26 +323,63 @@ const double alpha = 0.8;
 #define STATS(INDEX) std::get<INDEX>(stats.second)
 #define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
 
-#define PRINTER(printName, fieldName)                                                              \
+#define PRINTER(type, fieldName)                                                                   \
   STATS(2).fieldName =                                                                             \
     /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
-    NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+  PrintRecord(os, time, stats.first, type, STATS(2).fieldName, STATS(3).fieldName,                 \
+              STATS(0).fieldName, STATS(1).fieldName / 1024.0);
+
+void
+L3RateTracer::PrintRecord(std::ostream* os, const Time& time, nfd::FaceId faceId, RecordType type,
+                          double packets, double kilobytes, double packetsRaw,
+                          double kilobytesRaw) const
+{
+  if (os == nullptr) {
+    TraceWriter::Record record;
+    record.values[0] = TraceWriter::Real(time.ToDouble(Time::S));
+    record.values[1] = m_nodeString;
+    if (faceId != nfd::face::INVALID_FACEID) {
+      NS_ASSERT(m_faceInfoStrings.find(faceId) != m_faceInfoStrings.end());
+      record.values[2] = TraceWriter::Int(faceId);
+      record.values[3] = m_faceInfoStrings.find(faceId)->second;
+    }
+    else {
+      record.values[2] = TraceWriter::Int(-1);
+      record.values[3] = m_allString;
+    }
+    record.values[4] = m_typeStrings[type];
+    record.values[5] = TraceWriter::Real(packets);
+    record.values[6] = TraceWriter::Real(kilobytes);
+    record.values[7] = TraceWriter::Real(packetsRaw);
+    record.values[8] = TraceWriter::Real(kilobytesRaw);
+    m_writer->Append(record);
+    return;
+  }
+
+  *os << time.ToDouble(Time::S) << "\t" << m_node << "\t";
+  if (faceId != nfd::face::INVALID_FACEID) {
+    *os << faceId << "\t";
+    NS_ASSERT(m_faceInfos.find(faceId) != m_faceInfos.end());
+    *os << m_faceInfos.find(faceId)->second << "\t";
+  }
+  else {
+    *os << "-1\tall\t";
+  }
+  *os << RECORD_TYPE_NAMES[type] << "\t" << packets << "\t" << kilobytes << "\t" << packetsRaw
+      << "\t" << kilobytesRaw << "\n";
+}
 
 void
 L3RateTracer::Print(std::ostream& os) const
+{
+  PrintRecords(&os);
+}
+
+void
+L3RateTracer::PrintRecords(std::ostream* os) const
 {
   Time time = Simulator::Now();
 
@@ -267,28 +387,28 @@ L3RateTracer::Print(std::ostream& os) const
     if (stats.first == nfd::face::INVALID_FACEID)
       continue;
 
-    PRINTER("InInterests", m_inInterests);
-    PRINTER("OutInterests", m_outInterests);
+    PRINTER(IN_INTERESTS, m_inInterests);
+    PRINTER(OUT_INTERESTS, m_outInterests);
 
-    PRINTER("InData", m_inData);
-    PRINTER("OutData", m_outData);
+    PRINTER(IN_DATA, m_inData);
+    PRINTER(OUT_DATA, m_outData);
 
-    PRINTER("InNacks", m_inNack);
-    PRINTER("OutNacks", m_outNack);
+    PRINTER(IN_NACKS, m_inNack);
+    PRINTER(OUT_NACKS, m_outNack);
 
-    PRINTER("InSatisfiedInterests", m_satisfiedInterests);
-    PRINTER("InTimedOutInterests", m_timedOutInterests);
+    PRINTER(IN_SATISFIED_INTERESTS, m_satisfiedInterests);
+    PRINTER(IN_TIMED_OUT_INTERESTS, m_timedOutInterests);
 
-    PRINTER("OutSatisfiedInterests", m_outSatisfiedInterests);
-    PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
+    PRINTER(OUT_SATISFIED_INTERESTS, m_outSatisfiedInterests);
+    PRINTER(OUT_TIMED_OUT_INTERESTS, m_outTimedOutInterests);
   }
 
   {
     auto i = m_stats.find(nfd::face::INVALID_FACEID);
     if (i != m_stats.end()) {
       auto& stats = *i;
-      PRINTER("SatisfiedInterests", m_satisfiedInterests);
-      PRINTER("TimedOutInterests", m_timedOutInterests);
+      PRINTER(SATISFIED_INTERESTS, m_satisfiedInterests);
+      PRINTER(TIMED_OUT_INTERESTS, m_timedOutInterests);
     }
   }
 }
@@ -398,6 +518,9 @@ L3RateTracer::AddInfo(const Face& face)
 {
   if (m_faceInfos.find(face.getId()) == m_faceInfos.end()) {
     m_faceInfos.insert(make_pair(face.getId(), boost::lexical_cast<std::string>(face.getLocalUri())));
+    if (m_writer != nullptr) {
+      m_faceInfoStrings[face.getId()] = m_writer->Intern(m_faceInfos[face.getId()]);
+    }
   }
 }
 
@@ -23,6 +23,7 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
 #include "ndn-l3-tracer.hpp"
+#include "ndn-trace-writer.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
@@ -44,7 +45,8 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin, the binary TraceWriter is used
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
@@ -56,7 +58,8 @@ public:
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin, the binary TraceWriter is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    */
@@ -67,7 +70,8 @@ public:
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin, the binary TraceWriter is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    */
@@ -118,6 +122,22 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install a tracer writing binary records on a specific simulation node
+   *
+   * @param node   Node on which to install tracer
+   * @param writer Binary trace writer, with the columns of L3RateTracer::GetColumns ()
+   * @param averagingPeriod How often data will be written into the trace file
+   */
+  static Ptr<L3RateTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceWriter> writer, Time averagingPeriod = Seconds(0.5));
+
+  /**
+   * @brief Column types of the binary records, in the order of PrintHeader
+   */
+  static const std::vector<TraceWriter::ColumnType>&
+  GetColumns();
+
   // from L3Tracer
   virtual void
   PrintHeader(std::ostream& os) const;
@@ -164,13 +184,50 @@ private:
   void
   AddInfo(const Face& face);
 
+  void
+  SetWriter(shared_ptr<TraceWriter> writer);
+
+  /**
+   * @brief Types of the printed records, in the order they are printed for a face
+   */
+  enum RecordType {
+    IN_INTERESTS,
+    OUT_INTERESTS,
+    IN_DATA,
+    OUT_DATA,
+    IN_NACKS,
+    OUT_NACKS,
+    IN_SATISFIED_INTERESTS,
+    IN_TIMED_OUT_INTERESTS,
+    OUT_SATISFIED_INTERESTS,
+    OUT_TIMED_OUT_INTERESTS,
+    SATISFIED_INTERESTS,
+    TIMED_OUT_INTERESTS,
+    N_RECORD_TYPES
+  };
+
+  /**
+   * @brief Print current trace data to @p os, or to the binary writer if @p os is null
+   */
+  void
+  PrintRecords(std::ostream* os) const;
+
+  void
+  PrintRecord(std::ostream* os, const Time& time, nfd::FaceId faceId, RecordType type,
+              double packets, double kilobytes, double packetsRaw, double kilobytesRaw) const;
+
 private:
   shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceWriter> m_writer; ///< instead of m_os, for binary traces
+  uint64_t m_nodeString;
+  uint64_t m_allString;
+  uint64_t m_typeStrings[N_RECORD_TYPES];
   Time m_period;
   EventId m_printEvent;
 
   mutable std::map<nfd::FaceId, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
   std::map<nfd::FaceId, std::string> m_faceInfos; // needed, because face may no longer exists at the time of stat printing
+  std::map<nfd::FaceId, uint64_t> m_faceInfoStrings; ///< m_faceInfos interned in m_writer
 };
 
 } // namespace ndn
@@ -0,0 +1,318 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-writer.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <chrono>
+#include <stdexcept>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceWriter");
+
+namespace ns3 {
+namespace ndn {
+
+// File layout:
+//   "NDNTRACE", version (u32), number of columns (u32), column types (u8 each)
+//   blocks: number of records n (u32, > 0), then per column n values (u64 each)
+//   end of blocks: 0 (u32)
+//   trailer: header (u32 length + bytes), number of strings (u64), strings (u32 length + bytes)
+//   offset of the trailer (u64)
+static const char MAGIC[8] = {'N', 'D', 'N', 'T', 'R', 'A', 'C', 'E'};
+static const uint32_t VERSION = 1;
+
+const size_t TraceWriter::MAX_COLUMNS;
+const size_t TraceWriter::BLOCK_RECORDS;
+
+template<typename T>
+static void
+WriteValue(std::ostream& os, T value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void
+WriteString(std::ostream& os, const std::string& value)
+{
+  WriteValue<uint32_t>(os, value.size());
+  os.write(value.data(), value.size());
+}
+
+template<typename T>
+static T
+ReadValue(std::istream& is)
+{
+  T value;
+  if (!is.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+    throw std::runtime_error("Truncated trace file");
+  }
+  return value;
+}
+
+static std::string
+ReadString(std::istream& is)
+{
+  std::string value(ReadValue<uint32_t>(is), '\0');
+  if (!is.read(&value[0], value.size())) {
+    throw std::runtime_error("Truncated trace file");
+  }
+  return value;
+}
+
+bool
+IsBinaryTraceFile(const std::string& file)
+{
+  static const std::string extension = ".bin";
+  return file.size() > extension.size()
+         && file.compare(file.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+TraceWriter::TraceWriter(const std::string& file, const std::vector<ColumnType>& columns,
+                         size_t capacity)
+  : m_columns(columns)
+  , m_head(0)
+  , m_tail(0)
+  , m_closing(false)
+{
+  NS_ASSERT(!columns.empty() && columns.size() <= MAX_COLUMNS);
+
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  m_ring.resize(size);
+  m_mask = size - 1;
+  m_block.resize(m_columns.size(), std::vector<uint64_t>(BLOCK_RECORDS));
+
+  m_file.open(file.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  if (!m_file.is_open()) {
+    return;
+  }
+  m_file.write(MAGIC, sizeof(MAGIC));
+  WriteValue<uint32_t>(m_file, VERSION);
+  WriteValue<uint32_t>(m_file, m_columns.size());
+  for (ColumnType type : m_columns) {
+    WriteValue<uint8_t>(m_file, type);
+  }
+
+  m_writer = std::thread(&TraceWriter::Drain, this);
+}
+
+TraceWriter::~TraceWriter()
+{
+  Close();
+}
+
+bool
+TraceWriter::IsOpen() const
+{
+  return m_file.is_open();
+}
+
+void
+TraceWriter::SetHeader(const std::string& header)
+{
+  m_header = header;
+}
+
+uint64_t
+TraceWriter::Intern(const std::string& value)
+{
+  auto result = m_index.insert(std::make_pair(value, m_dictionary.size()));
+  if (result.second) {
+    m_dictionary.push_back(value);
+  }
+  return result.first->second;
+}
+
+void
+TraceWriter::Append(const Record& record)
+{
+  size_t head = m_head.load(std::memory_order_relaxed);
+  size_t used = head - m_tail.load(std::memory_order_acquire);
+  if (used == m_ring.size()) {
+    m_wakeup.notify_one();
+    do {
+      std::this_thread::yield();
+    } while (head - m_tail.load(std::memory_order_acquire) == m_ring.size());
+  }
+
+  m_ring[head & m_mask] = record;
+  m_head.store(head + 1, std::memory_order_release);
+
+  // The writer also wakes up by itself, this only keeps the ring from filling up
+  if (used + 1 == m_ring.size() / 2) {
+    m_wakeup.notify_one();
+  }
+}
+
+void
+TraceWriter::Drain()
+{
+  size_t nRecords = 0;
+  while (true) {
+    // Read before the head: all records appended before Close are seen below
+    bool closing = m_closing.load(std::memory_order_acquire);
+
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    size_t head = m_head.load(std::memory_order_acquire);
+    for (; tail != head; tail++) {
+      const Record& record = m_ring[tail & m_mask];
+      for (size_t column = 0; column < m_columns.size(); column++) {
+        m_block[column][nRecords] = record.values[column];
+      }
+      if (++nRecords == BLOCK_RECORDS) {
+        m_tail.store(tail + 1, std::memory_order_release);
+        WriteBlock(nRecords);
+        nRecords = 0;
+      }
+    }
+    m_tail.store(tail, std::memory_order_release);
+
+    if (closing) {
+      WriteBlock(nRecords);
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_wakeup.wait_for(lock, std::chrono::milliseconds(10), [this, tail] {
+      return m_closing.load(std::memory_order_acquire)
+             || m_head.load(std::memory_order_acquire) - tail >= m_ring.size() / 2;
+    });
+  }
+}
+
+void
+TraceWriter::WriteBlock(size_t nRecords)
+{
+  if (nRecords == 0) {
+    return;
+  }
+  WriteValue<uint32_t>(m_file, nRecords);
+  for (const std::vector<uint64_t>& values : m_block) {
+    m_file.write(reinterpret_cast<const char*>(values.data()), nRecords * sizeof(uint64_t));
+  }
+}
+
+void
+TraceWriter::Close()
+{
+  if (!m_writer.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_closing.store(true, std::memory_order_release);
+  }
+  m_wakeup.notify_one();
+  m_writer.join();
+
+  WriteValue<uint32_t>(m_file, 0);
+  uint64_t trailer = m_file.tellp();
+  WriteString(m_file, m_header);
+  WriteValue<uint64_t>(m_file, m_dictionary.size());
+  for (const std::string& value : m_dictionary) {
+    WriteString(m_file, value);
+  }
+  WriteValue<uint64_t>(m_file, trailer);
+  m_file.close();
+  if (m_file.fail()) {
+    NS_LOG_ERROR("Trace file could not be written completely");
+  }
+}
+
+void
+TraceWriter::ConvertToText(const std::string& file, std::ostream& os)
+{
+  std::ifstream is(file.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    throw std::runtime_error("File " + file + " cannot be opened for reading");
+  }
+
+  char magic[sizeof(MAGIC)];
+  if (!is.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+      || ReadValue<uint32_t>(is) != VERSION) {
+    throw std::runtime_error(file + " is not a binary trace file");
+  }
+  std::vector<ColumnType> columns(ReadValue<uint32_t>(is));
+  for (ColumnType& type : columns) {
+    type = static_cast<ColumnType>(ReadValue<uint8_t>(is));
+    if (type > STRING) {
+      throw std::runtime_error("Unknown column type in " + file);
+    }
+  }
+  std::streampos blocks = is.tellg();
+
+  // Header and dictionary are at the end
+  is.seekg(-static_cast<std::streamoff>(sizeof(uint64_t)), std::ios_base::end);
+  uint64_t trailer = ReadValue<uint64_t>(is);
+  if (!is.seekg(trailer) || static_cast<uint64_t>(trailer) < static_cast<uint64_t>(blocks)) {
+    throw std::runtime_error(file + " was not closed properly");
+  }
+  std::string header = ReadString(is);
+  std::vector<std::string> dictionary(ReadValue<uint64_t>(is));
+  for (std::string& value : dictionary) {
+    value = ReadString(is);
+  }
+
+  if (!header.empty()) {
+    os << header << "\n";
+  }
+  is.seekg(blocks);
+  std::vector<std::vector<uint64_t>> values(columns.size());
+  while (uint32_t nRecords = ReadValue<uint32_t>(is)) {
+    for (std::vector<uint64_t>& column : values) {
+      column.resize(nRecords);
+      if (!is.read(reinterpret_cast<char*>(column.data()), nRecords * sizeof(uint64_t))) {
+        throw std::runtime_error("Truncated trace file");
+      }
+    }
+    for (uint32_t i = 0; i < nRecords; i++) {
+      for (size_t column = 0; column < columns.size(); column++) {
+        if (column > 0) {
+          os << "\t";
+        }
+        uint64_t value = values[column][i];
+        switch (columns[column]) {
+        case INT:
+          os << static_cast<int64_t>(value);
+          break;
+        case REAL: {
+          double real;
+          std::memcpy(&real, &value, sizeof(real));
+          os << real;
+          break;
+        }
+        case STRING:
+          if (value >= dictionary.size()) {
+            throw std::runtime_error("Invalid string index in " + file);
+          }
+          os << dictionary[value];
+          break;
+        }
+      }
+      os << "\n";
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_WRITER_H
+#define NDN_TRACE_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Binary backend of the tracers
+ *
+ * The simulation thread appends fixed-size records to a single-producer single-consumer
+ * ring, and a background thread drains the ring into a columnar file: blocks of up to
+ * BLOCK_RECORDS records, each column stored contiguously as 8-byte values. Strings (node
+ * names, record types) are interned once and stored as indices into a dictionary that is
+ * written, together with the text header of the trace, when the writer is closed.
+ *
+ * Tracers use this backend when their file name ends with ".bin" (see IsBinaryTraceFile).
+ * ConvertToText turns such a file back into the text format of the tracer, e.g.:
+ *
+ *     ./waf --run="ndn-trace-to-text --input=app-delays-trace.bin --output=app-delays-trace.txt"
+ *
+ * Values are stored in the byte order of the machine running the simulation.
+ */
+class TraceWriter {
+public:
+  enum ColumnType : uint8_t {
+    INT = 0,    ///< signed integer
+    REAL = 1,   ///< double, printed with the default precision of std::ostream
+    STRING = 2, ///< index returned by Intern
+  };
+
+  static const size_t MAX_COLUMNS = 10;
+  static const size_t BLOCK_RECORDS = 4096;
+
+  struct Record {
+    uint64_t values[MAX_COLUMNS];
+  };
+
+  /**
+   * @brief Open the trace file and start the background writer
+   *
+   * @param file     File to which records will be written
+   * @param columns  Types of the columns of every record (at most MAX_COLUMNS)
+   * @param capacity Number of records the ring can hold (rounded up to a power of two)
+   */
+  TraceWriter(const std::string& file, const std::vector<ColumnType>& columns,
+              size_t capacity = 65536);
+
+  /**
+   * @brief Close the writer, if not done before
+   */
+  ~TraceWriter();
+
+  TraceWriter(const TraceWriter&) = delete;
+  TraceWriter&
+  operator=(const TraceWriter&) = delete;
+
+  bool
+  IsOpen() const;
+
+  /**
+   * @brief Set the header line printed by the converter (e.g., the output of PrintHeader)
+   */
+  void
+  SetHeader(const std::string& header);
+
+  /**
+   * @brief Index of a string in the dictionary, to be stored in a STRING column
+   *
+   * Only to be called from the simulation thread. Tracers cache the indices of strings
+   * they print often.
+   */
+  uint64_t
+  Intern(const std::string& value);
+
+  /**
+   * @brief Queue a record for writing
+   *
+   * Waits for the background writer if the ring is full.
+   */
+  void
+  Append(const Record& record);
+
+  static uint64_t
+  Int(int64_t value)
+  {
+    return static_cast<uint64_t>(value);
+  }
+
+  static uint64_t
+  Real(double value)
+  {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  /**
+   * @brief Write all queued records, the header and the dictionary, and close the file
+   */
+  void
+  Close();
+
+  /**
+   * @brief Print a trace file written by TraceWriter in the text format of the tracer
+   *
+   * @throw std::runtime_error if the file cannot be read or was not closed properly
+   */
+  static void
+  ConvertToText(const std::string& file, std::ostream& os);
+
+private:
+  void
+  Drain();
+
+  void
+  WriteBlock(size_t nRecords);
+
+private:
+  std::ofstream m_file;
+  std::vector<ColumnType> m_columns;
+  std::string m_header;
+
+  std::vector<Record> m_ring;
+  size_t m_mask;
+  std::atomic<size_t> m_head;  ///< next record to append, written by the simulation thread
+  std::atomic<size_t> m_tail;  ///< next record to drain, written by the writer thread
+  std::atomic<bool> m_closing;
+  std::mutex m_mutex;
+  std::condition_variable m_wakeup;
+  std::thread m_writer;
+  std::vector<std::vector<uint64_t>> m_block; ///< per column, used by the writer thread
+
+  std::unordered_map<std::string, uint64_t> m_index;
+  std::vector<std::string> m_dictionary;
+};
+
+/**
+ * @brief Whether the binary TraceWriter is to be used for a trace file (name ending with ".bin")
+ */
+bool
+IsBinaryTraceFile(const std::string& file);
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_WRITER_H
@@ -0,0 +1,235 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+// Propagation cost of a whole constellation per time step: one
+// Satellite::GetPositionVelocity call per satellite against one
+// SatelliteConstellation::Propagate call for all of them.
+//
+// The channels do not step the constellation in lockstep though: they ask for
+// the positions of the two ends of a link at each packet's own instant. The
+// second part replays that pattern (one query of two random satellites every
+// query interval) through SatellitePositionMobilityModel, with exact positions
+// or on a CacheResolution grid, each with and without the constellation.
+//
+//     ./waf --run "satellite-constellation-benchmark --steps=2000"
+//     ./waf --run "satellite-constellation-benchmark --queries=5000 --queryInterval=10us"
+//
+// JulianDate counts milliseconds, so queries within the same millisecond share
+// one propagation of the constellation.
+//
+// The TLE file has the format of the satellite network directories:
+// "<orbits> <satellites per orbit>" followed by name/line 1/line 2 triplets.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/core-module.h"
+#include "ns3/satellite.h"
+#include "ns3/satellite-constellation.h"
+#include "ns3/satellite-position-mobility-model.h"
+
+using namespace ns3;
+
+namespace {
+
+double g_querySink = 0;
+
+void
+Query (const std::vector<Ptr<MobilityModel> > *models, uint32_t a, uint32_t b)
+{
+  g_querySink += (*models)[a]->GetDistanceFrom ((*models)[b]);
+}
+
+/**
+ * Mobility models of all satellites, with exact positions (resolution 0) or
+ * samples on a grid, propagated one by one or through a shared constellation.
+ */
+std::vector<Ptr<MobilityModel> >
+CreateModels (const std::vector<Ptr<Satellite> > &satellites, Time resolution, bool shared)
+{
+  Ptr<SatelliteConstellation> constellation;
+  if (shared)
+    {
+      constellation = CreateObject<SatelliteConstellation> ();
+    }
+  std::vector<Ptr<MobilityModel> > models;
+  for (const Ptr<Satellite> &sat : satellites)
+    {
+      Ptr<SatellitePositionMobilityModel> m = CreateObject<SatellitePositionMobilityModel> ();
+      m->SetAttribute ("CacheResolution", TimeValue (resolution));
+      m->SetSatellite (sat);
+      m->SetStartTime (satellites[0]->GetTleEpoch ());
+      if (constellation)
+        {
+          m->SetConstellation (constellation, constellation->Add (sat));
+        }
+      models.push_back (m);
+    }
+  return models;
+}
+
+/**
+ * Run one query per interval, in simulated time, and return the wall time
+ * per query in nanoseconds.
+ */
+double
+RunQueries (const std::vector<Ptr<MobilityModel> > &models,
+            const std::vector<std::pair<uint32_t, uint32_t> > &pairs, Time interval)
+{
+  for (uint32_t q = 0; q < pairs.size (); q++)
+    {
+      Simulator::Schedule (interval * q, &Query, &models, pairs[q].first, pairs[q].second);
+    }
+  auto begin = std::chrono::steady_clock::now ();
+  Simulator::Run ();
+  auto end = std::chrono::steady_clock::now ();
+  Simulator::Destroy ();
+  return std::chrono::duration<double, std::nano> (end - begin).count () / pairs.size ();
+}
+
+} // namespace
+
+int
+main (int argc, char *argv[])
+{
+  std::string tles = "scenarios/data/starlink_550_isls_plus_grid_ground_stations_4_different_orbits_algorithm_paired_many_only_over_isls/tles.txt";
+  uint32_t steps = 1000;
+  Time step = MilliSeconds (100);
+  uint32_t queries = 2000;
+  Time queryInterval = MicroSeconds (100);
+  Time resolution = MilliSeconds (1);
+
+  CommandLine cmd;
+  cmd.AddValue ("tles", "TLE file of the constellation", tles);
+  cmd.AddValue ("steps", "Number of time steps to propagate", steps);
+  cmd.AddValue ("step", "Time between steps", step);
+  cmd.AddValue ("queries", "Number of per-packet position queries (0: skip them)", queries);
+  cmd.AddValue ("queryInterval", "Simulated time between two queries", queryInterval);
+  cmd.AddValue ("resolution", "CacheResolution of the grid variants", resolution);
+  cmd.Parse (argc, argv);
+
+  std::ifstream fs (tles);
+  NS_ABORT_MSG_UNLESS (fs.is_open (), "File " << tles << " could not be opened");
+
+  std::string line, name, tle1, tle2;
+  std::getline (fs, line);
+  Ptr<SatelliteConstellation> constellation = CreateObject<SatelliteConstellation> ();
+  std::vector<Ptr<Satellite> > satellites;
+  while (std::getline (fs, name) && std::getline (fs, tle1) && std::getline (fs, tle2))
+    {
+      Ptr<Satellite> sat = CreateObject<Satellite> ();
+      sat->SetName (name);
+      NS_ABORT_MSG_UNLESS (sat->SetTleInfo (tle1, tle2), "Invalid TLE for " << name);
+      satellites.push_back (sat);
+      constellation->Add (sat);
+    }
+  NS_ABORT_MSG_IF (satellites.empty (), "No satellites in " << tles);
+
+  JulianDate start = satellites[0]->GetTleEpoch ();
+  Vector3D r, v;
+  double sink = 0;
+
+  auto begin = std::chrono::steady_clock::now ();
+  for (uint32_t k = 0; k < steps; k++)
+    {
+      JulianDate t = start + step * k;
+      for (const Ptr<Satellite> &sat : satellites)
+        {
+          sat->GetPositionVelocity (t, r, v);
+          sink += r.x;
+        }
+    }
+  auto middle = std::chrono::steady_clock::now ();
+  for (uint32_t k = 0; k < steps; k++)
+    {
+      JulianDate t = start + step * k;
+      constellation->Propagate (t);
+      for (uint32_t i = 0; i < constellation->GetN (); i++)
+        {
+          constellation->GetPositionVelocity (i, t, r, v);
+          sink -= r.x;
+        }
+    }
+  auto end = std::chrono::steady_clock::now ();
+
+  // both paths must agree
+  double maxPosition = 0, maxVelocity = 0;
+  for (uint32_t k = 0; k < steps; k += std::max (1u, steps / 10))
+    {
+      JulianDate t = start + step * k;
+      for (uint32_t i = 0; i < satellites.size (); i++)
+        {
+          Vector3D rs, vs;
+          satellites[i]->GetPositionVelocity (t, rs, vs);
+          constellation->GetPositionVelocity (i, t, r, v);
+          maxPosition = std::max (maxPosition, CalculateDistance (r, rs));
+          maxVelocity = std::max (maxVelocity, CalculateDistance (v, vs));
+        }
+    }
+
+  uint64_t n = static_cast<uint64_t> (steps) * satellites.size ();
+  double single = std::chrono::duration<double, std::nano> (middle - begin).count () / n;
+  double batch = std::chrono::duration<double, std::nano> (end - middle).count () / n;
+
+  std::cout << "Satellites.................. " << satellites.size () << std::endl;
+  std::cout << "Steps....................... " << steps << " x " << step.As (Time::MS) << std::endl;
+  std::cout << std::fixed << std::setprecision (1);
+  std::cout << "Per satellite (ns/sat-step). " << single << std::endl;
+  std::cout << "Constellation (ns/sat-step). " << batch << std::endl;
+  std::cout << std::setprecision (2);
+  std::cout << "Speedup..................... " << single / batch << "x" << std::endl;
+  std::cout << std::scientific;
+  std::cout << "Max difference.............. " << maxPosition << " m, "
+            << maxVelocity << " m/s" << std::endl;
+
+  if (queries > 0)
+    {
+      std::mt19937 rng (1);
+      std::uniform_int_distribution<uint32_t> index (0, satellites.size () - 1);
+      std::vector<std::pair<uint32_t, uint32_t> > pairs;
+      for (uint32_t q = 0; q < queries; q++)
+        {
+          pairs.push_back (std::make_pair (index (rng), index (rng)));
+        }
+
+      std::cout << "Per-packet queries.......... " << queries << " every " << queryInterval.GetMicroSeconds ()
+                << " us, grid " << resolution.GetMicroSeconds () << " us" << std::endl;
+      std::cout << std::fixed << std::setprecision (1);
+      std::cout << "Exact, per sat (ns/query)... "
+                << RunQueries (CreateModels (satellites, Seconds (0), false), pairs, queryInterval) << std::endl;
+      std::cout << "Exact, shared (ns/query).... "
+                << RunQueries (CreateModels (satellites, Seconds (0), true), pairs, queryInterval) << std::endl;
+      std::cout << "Grid, per sat (ns/query).... "
+                << RunQueries (CreateModels (satellites, resolution, false), pairs, queryInterval) << std::endl;
+      std::cout << "Grid, shared (ns/query)..... "
+                << RunQueries (CreateModels (satellites, resolution, true), pairs, queryInterval) << std::endl;
+      std::cout << std::scientific;
+    }
+
+  std::cout << "(checksum " << sink + g_querySink << ")" << std::endl;
+
+  return 0;
+}
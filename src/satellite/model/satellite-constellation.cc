@@ -0,0 +1,465 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "satellite-constellation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/log.h"
+#include "ns3/type-id.h"
+#include "ns3/vector.h"
+
+#include "sgp4unit.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SatelliteConstellation");
+
+NS_OBJECT_ENSURE_REGISTERED (SatelliteConstellation);
+
+TypeId
+SatelliteConstellation::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatelliteConstellation")
+    .SetParent<Object> ()
+    .SetGroupName ("Satellite")
+    .AddConstructor<SatelliteConstellation> ();
+
+  return tid;
+}
+
+SatelliteConstellation::SatelliteConstellation (void) :
+  m_loaded (false), m_uses (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  for (uint32_t k = 0; k < N_STATES; k++)
+    {
+      m_states[k].valid = false;
+      m_states[k].used = 0;
+    }
+}
+
+void
+SatelliteConstellation::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_satellites.clear ();
+  Object::DoDispose ();
+}
+
+uint32_t
+SatelliteConstellation::Add (Ptr<Satellite> sat)
+{
+  NS_ASSERT_MSG (sat, "Satellite cannot be null!");
+
+  m_satellites.push_back (sat);
+  m_loaded = false;
+
+  return m_satellites.size () - 1;
+}
+
+uint32_t
+SatelliteConstellation::GetN (void) const
+{
+  return m_satellites.size ();
+}
+
+Ptr<Satellite>
+SatelliteConstellation::GetSatellite (uint32_t i) const
+{
+  NS_ASSERT (i < m_satellites.size ());
+
+  return m_satellites[i];
+}
+
+void
+SatelliteConstellation::Propagate (const JulianDate &t)
+{
+  GetState (t);
+}
+
+void
+SatelliteConstellation::GetPositionVelocity (
+  uint32_t i, const JulianDate &t, Vector3D &position, Vector3D &velocity
+)
+{
+  NS_ASSERT (i < m_satellites.size ());
+
+  const State &s = GetState (t);
+  uint32_t j = m_slot[i];
+
+  position = Vector3D (s.rx[j], s.ry[j], s.rz[j]);
+  velocity = Vector3D (s.vx[j], s.vy[j], s.vz[j]);
+}
+
+const SatelliteConstellation::State&
+SatelliteConstellation::GetState (const JulianDate &t)
+{
+  if (!m_loaded)
+    Load ();
+
+  uint32_t lru = 0;
+  for (uint32_t k = 0; k < N_STATES; k++)
+    {
+      if (m_states[k].valid && m_states[k].t == t)
+        {
+          m_states[k].used = ++m_uses;
+          return m_states[k];
+        }
+      if (m_states[k].used < m_states[lru].used)
+        lru = k;
+    }
+
+  // replace the least recently used state
+  State &s = m_states[lru];
+  uint32_t n = m_satellites.size ();
+
+  NS_LOG_FUNCTION (this << t);
+
+  s.rx.resize (n); s.ry.resize (n); s.rz.resize (n);
+  s.vx.resize (n); s.vy.resize (n); s.vz.resize (n);
+
+  PropagateNearEarth (t, 0, m_nearEarth.size (), s);
+
+  for (uint32_t k = 0; k < m_other.size (); k++)
+    {
+      uint32_t j = m_slot[m_other[k]];
+      Vector3D r, v;
+
+      m_satellites[m_other[k]]->GetPositionVelocity (t, r, v);
+      s.rx[j] = r.x; s.ry[j] = r.y; s.rz[j] = r.z;
+      s.vx[j] = v.x; s.vy[j] = v.y; s.vz[j] = v.z;
+    }
+
+  s.t = t;
+  s.valid = true;
+  s.used = ++m_uses;
+
+  return s;
+}
+
+void
+SatelliteConstellation::Load (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_nearEarth.clear ();
+  m_other.clear ();
+  for (uint32_t i = 0; i < m_satellites.size (); i++)
+    {
+      const Satellite &sat = *m_satellites[i];
+
+      if (sat.IsInitialized () && sat.m_sgp4_record.method != 'd')
+        m_nearEarth.push_back (i);
+      else
+        m_other.push_back (i);
+    }
+
+  m_slot.resize (m_satellites.size ());
+  for (uint32_t k = 0; k < m_nearEarth.size (); k++)
+    m_slot[m_nearEarth[k]] = k;
+  for (uint32_t k = 0; k < m_other.size (); k++)
+    m_slot[m_other[k]] = m_nearEarth.size () + k;
+
+  uint32_t n = m_nearEarth.size ();
+  std::vector<double>* elements[] = {
+    &m_mo, &m_mdot, &m_argpo, &m_argpdot, &m_nodeo, &m_nodedot, &m_nodecf,
+    &m_cc1, &m_cc4, &m_cc5, &m_bstar, &m_t2cof, &m_t3cof, &m_t4cof, &m_t5cof,
+    &m_omgcof, &m_eta, &m_xmcof, &m_delmo, &m_d2, &m_d3, &m_d4, &m_sinmao,
+    &m_no, &m_ecco, &m_inclo, &m_sinio, &m_cosio, &m_aycof, &m_xlcof,
+    &m_con41, &m_x1mth2, &m_x7thm1,
+    &m_tsince, &m_am, &m_nm, &m_axnl, &m_aynl, &m_u, &m_nodep, &m_eo1,
+    &m_tem5, &m_sineo1, &m_coseo1
+  };
+  for (std::vector<double>* e : elements)
+    e->resize (n);
+  m_epochs.clear ();
+  m_epoch.resize (n);
+  m_isimp.resize (n);
+  m_error.resize (n);
+
+  for (uint32_t k = 0; k < n; k++)
+    {
+      const elsetrec &rec = m_satellites[m_nearEarth[k]]->m_sgp4_record;
+
+      JulianDate epoch = m_satellites[m_nearEarth[k]]->GetTleEpoch ();
+      uint32_t e = std::find (m_epochs.begin (), m_epochs.end (), epoch) - m_epochs.begin ();
+      if (e == m_epochs.size ())
+        m_epochs.push_back (epoch);
+
+      m_epoch[k] = e;
+      m_isimp[k] = rec.isimp;
+      m_mo[k] = rec.mo;
+      m_mdot[k] = rec.mdot;
+      m_argpo[k] = rec.argpo;
+      m_argpdot[k] = rec.argpdot;
+      m_nodeo[k] = rec.nodeo;
+      m_nodedot[k] = rec.nodedot;
+      m_nodecf[k] = rec.nodecf;
+      m_cc1[k] = rec.cc1;
+      m_cc4[k] = rec.cc4;
+      m_cc5[k] = rec.cc5;
+      m_bstar[k] = rec.bstar;
+      m_t2cof[k] = rec.t2cof;
+      m_t3cof[k] = rec.t3cof;
+      m_t4cof[k] = rec.t4cof;
+      m_t5cof[k] = rec.t5cof;
+      m_omgcof[k] = rec.omgcof;
+      m_eta[k] = rec.eta;
+      m_xmcof[k] = rec.xmcof;
+      m_delmo[k] = rec.delmo;
+      m_d2[k] = rec.d2;
+      m_d3[k] = rec.d3;
+      m_d4[k] = rec.d4;
+      m_sinmao[k] = rec.sinmao;
+      m_no[k] = rec.no;
+      m_ecco[k] = rec.ecco;
+      m_inclo[k] = rec.inclo;
+      // the inclination only changes in the deep-space branch
+      m_sinio[k] = sin (rec.inclo);
+      m_cosio[k] = cos (rec.inclo);
+      m_aycof[k] = rec.aycof;
+      m_xlcof[k] = rec.xlcof;
+      m_con41[k] = rec.con41;
+      m_x1mth2[k] = rec.x1mth2;
+      m_x7thm1[k] = rec.x7thm1;
+    }
+
+  for (uint32_t k = 0; k < N_STATES; k++)
+    m_states[k].valid = false;
+  m_loaded = true;
+}
+
+/*
+ * Near-Earth branch of sgp4 () in sgp4unit.cpp, split in three passes over
+ * the element arrays: secular and long period terms, Kepler's equation, and
+ * short period terms plus the TEME->ITRF rotation. Each pass is a loop without
+ * calls other than to the math library, and the expressions are the same as in
+ * sgp4 () and Satellite::GetPositionVelocity, so results are the same as those
+ * of the per-satellite path.
+ */
+void
+SatelliteConstellation::PropagateNearEarth (
+  const JulianDate &t, uint32_t begin, uint32_t end, State &s
+)
+{
+  double tumin, mu, radiusearthkm, xke, j2, j3, j4, j3oj2;
+  const double twopi = 2.0 * pi;
+  const double x2o3 = 2.0 / 3.0;
+
+  getgravconst (
+    Satellite::WGeoSys, tumin, mu, radiusearthkm, xke, j2, j3, j4, j3oj2
+  );
+  const double vkmpersec = radiusearthkm * xke/60.0;
+
+  // one rotation for the whole constellation
+  const Satellite::Matrix pmt = Satellite::PefToItrf (t);
+  const Satellite::Matrix tmt = Satellite::TemeToPef (t);
+  const double we = t.GetOmegaEarth ();
+
+  m_epochTsince.resize (m_epochs.size ());
+  for (uint32_t e = 0; e < m_epochs.size (); e++)
+    m_epochTsince[e] = (t - m_epochs[e]).GetMinutes ();
+  for (uint32_t k = begin; k < end; k++)
+    m_tsince[k] = m_epochTsince[m_epoch[k]];
+
+  /* ---------- secular gravity, atmospheric drag, long period ---------- */
+  for (uint32_t k = begin; k < end; k++)
+    {
+      const double tsince = m_tsince[k];
+      const double xmdf = m_mo[k] + m_mdot[k] * tsince;
+      const double argpdf = m_argpo[k] + m_argpdot[k] * tsince;
+      const double nodedf = m_nodeo[k] + m_nodedot[k] * tsince;
+      const double t2 = tsince * tsince;
+      double argpm = argpdf;
+      double mm = xmdf;
+      double nodem = nodedf + m_nodecf[k] * t2;
+      double tempa = 1.0 - m_cc1[k] * tsince;
+      double tempe = m_bstar[k] * m_cc4[k] * tsince;
+      double templ = m_t2cof[k] * t2;
+
+      if (m_isimp[k] != 1)
+        {
+          const double delomg = m_omgcof[k] * tsince;
+          const double delmtemp = 1.0 + m_eta[k] * cos (xmdf);
+          const double delm = m_xmcof[k] *
+                              (delmtemp * delmtemp * delmtemp - m_delmo[k]);
+          const double temp = delomg + delm;
+          const double t3 = t2 * tsince;
+          const double t4 = t3 * tsince;
+
+          mm = xmdf + temp;
+          argpm = argpdf - temp;
+          tempa = tempa - m_d2[k] * t2 - m_d3[k] * t3 - m_d4[k] * t4;
+          tempe = tempe + m_bstar[k] * m_cc5[k] * (sin (mm) - m_sinmao[k]);
+          templ = templ + m_t3cof[k] * t3 + t4 * (m_t4cof[k] +
+                          tsince * m_t5cof[k]);
+        }
+
+      double nm = m_no[k];
+      double em = m_ecco[k];
+      const double am = pow ((xke / nm), x2o3) * tempa * tempa;
+      const int nmError = (nm <= 0.0) ? 2 : 0;
+
+      nm = xke / pow (am, 1.5);
+      em = em - tempe;
+      m_error[k] = nmError ? nmError : (((em >= 1.0) || (em < -0.001)) ? 1 : 0);
+      if (em < 1.0e-6)
+        em = 1.0e-6;
+      mm = mm + m_no[k] * templ;
+
+      double xlm = mm + argpm + nodem;
+      nodem = fmod (nodem, twopi);
+      argpm = fmod (argpm, twopi);
+      xlm = fmod (xlm, twopi);
+      mm = fmod (xlm - argpm - nodem, twopi);
+
+      const double axnl = em * cos (argpm);
+      const double temp = 1.0 / (am * (1.0 - em * em));
+      const double aynl = em * sin (argpm) + temp * m_aycof[k];
+      const double xl = mm + argpm + nodem + temp * m_xlcof[k] * axnl;
+
+      m_am[k] = am;
+      m_nm[k] = nm;
+      m_axnl[k] = axnl;
+      m_aynl[k] = aynl;
+      m_nodep[k] = nodem;
+      m_u[k] = fmod (xl - nodem, twopi);
+      m_eo1[k] = m_u[k];
+      m_tem5[k] = 9999.9;
+    }
+
+  /* ---------------------- solve Kepler's equation --------------------- */
+  // same iteration limits as sgp4 (), lanes drop out once they converge
+  for (int ktr = 1; ktr <= 10; ktr++)
+    {
+      uint32_t active = 0;
+
+      for (uint32_t k = begin; k < end; k++)
+        {
+          if (fabs (m_tem5[k]) < 1.0e-12)
+            continue;
+
+          const double sineo1 = sin (m_eo1[k]);
+          const double coseo1 = cos (m_eo1[k]);
+          double tem5 = 1.0 - coseo1 * m_axnl[k] - sineo1 * m_aynl[k];
+
+          tem5 = (m_u[k] - m_aynl[k] * coseo1 + m_axnl[k] * sineo1 - m_eo1[k]) / tem5;
+          if (fabs (tem5) >= 0.95)
+            tem5 = tem5 > 0.0 ? 0.95 : -0.95;
+          m_eo1[k] = m_eo1[k] + tem5;
+          m_tem5[k] = tem5;
+          m_sineo1[k] = sineo1;
+          m_coseo1[k] = coseo1;
+          active++;
+        }
+
+      if (active == 0)
+        break;
+    }
+
+  /* --------------- short period periodics and rotation ---------------- */
+  for (uint32_t k = begin; k < end; k++)
+    {
+      const double am = m_am[k];
+      const double axnl = m_axnl[k];
+      const double aynl = m_aynl[k];
+      const double sineo1 = m_sineo1[k];
+      const double coseo1 = m_coseo1[k];
+      const double sinip = m_sinio[k];
+      const double cosip = m_cosio[k];
+
+      const double ecose = axnl*coseo1 + aynl*sineo1;
+      const double esine = axnl*sineo1 - aynl*coseo1;
+      const double el2 = axnl*axnl + aynl*aynl;
+      const double pl = am*(1.0-el2);
+
+      const double rl = am * (1.0 - ecose);
+      const double rdotl = sqrt (am) * esine/rl;
+      const double rvdotl = sqrt (pl) / rl;
+      const double betal = sqrt (1.0 - el2);
+      double temp = esine / (1.0 + betal);
+      const double sinu = am / rl * (sineo1 - aynl - axnl * temp);
+      const double cosu = am / rl * (coseo1 - axnl + aynl * temp);
+      double su = atan2 (sinu, cosu);
+      const double sin2u = (cosu + cosu) * sinu;
+      const double cos2u = 1.0 - 2.0 * sinu * sinu;
+      temp = 1.0 / pl;
+      const double temp1 = 0.5 * j2 * temp;
+      const double temp2 = temp1 * temp;
+
+      const double mrt = rl * (1.0 - 1.5 * temp2 * betal * m_con41[k]) +
+                         0.5 * temp1 * m_x1mth2[k] * cos2u;
+      su = su - 0.25 * temp2 * m_x7thm1[k] * sin2u;
+      const double xnode = m_nodep[k] + 1.5 * temp2 * cosip * sin2u;
+      const double xinc = m_inclo[k] + 1.5 * temp2 * cosip * sinip * cos2u;
+      const double mvt = rdotl - m_nm[k] * temp1 * m_x1mth2[k] * sin2u / xke;
+      const double rvdot = rvdotl + m_nm[k] * temp1 * (m_x1mth2[k] * cos2u +
+                           1.5 * m_con41[k]) / xke;
+
+      const double sinsu = sin (su);
+      const double cossu = cos (su);
+      const double snod = sin (xnode);
+      const double cnod = cos (xnode);
+      const double sini = sin (xinc);
+      const double cosi = cos (xinc);
+      const double xmx = -snod * cosi;
+      const double xmy = cnod * cosi;
+      const double ux = xmx * sinsu + cnod * cossu;
+      const double uy = xmy * sinsu + snod * cossu;
+      const double uz = sini * sinsu;
+      const double vx = xmx * cossu - cnod * sinsu;
+      const double vy = xmy * cossu - snod * sinsu;
+      const double vz = sini * cossu;
+
+      // TEME position (km) and velocity (km/s)
+      const double r0 = (mrt * ux)* radiusearthkm;
+      const double r1 = (mrt * uy)* radiusearthkm;
+      const double r2 = (mrt * uz)* radiusearthkm;
+      const double v0 = (mvt * ux + rvdot * vx) * vkmpersec;
+      const double v1 = (mvt * uy + rvdot * vy) * vkmpersec;
+      const double v2 = (mvt * uz + rvdot * vz) * vkmpersec;
+
+      // TEME->PEF
+      const double p0 = tmt[0][0]*r0 + tmt[0][1]*r1 + tmt[0][2]*r2;
+      const double p1 = tmt[1][0]*r0 + tmt[1][1]*r1 + tmt[1][2]*r2;
+      const double p2 = tmt[2][0]*r0 + tmt[2][1]*r1 + tmt[2][2]*r2;
+      // PEF velocity minus Earth's rotation: tmt*v - (0, 0, we) x tmt*r
+      const double d0 = (tmt[0][0]*v0 + tmt[0][1]*v1 + tmt[0][2]*v2) - (0.0*p2 - we*p1);
+      const double d1 = (tmt[1][0]*v0 + tmt[1][1]*v1 + tmt[1][2]*v2) - (we*p0 - 0.0*p2);
+      const double d2 = (tmt[2][0]*v0 + tmt[2][1]*v1 + tmt[2][2]*v2) - (0.0*p1 - 0.0*p0);
+
+      // same error conditions as sgp4 (), in the same order; on error the
+      // per-satellite path returns null vectors
+      const bool ok = (m_error[k] == 0) && (pl >= 0.0) && (mrt >= 1.0);
+
+      // PEF->ITRF, in meters and m/s
+      s.rx[k] = ok ? (pmt[0][0]*p0 + pmt[0][1]*p1 + pmt[0][2]*p2) * 1000 : 0.0;
+      s.ry[k] = ok ? (pmt[1][0]*p0 + pmt[1][1]*p1 + pmt[1][2]*p2) * 1000 : 0.0;
+      s.rz[k] = ok ? (pmt[2][0]*p0 + pmt[2][1]*p1 + pmt[2][2]*p2) * 1000 : 0.0;
+      s.vx[k] = ok ? (pmt[0][0]*d0 + pmt[0][1]*d1 + pmt[0][2]*d2) * 1000 : 0.0;
+      s.vy[k] = ok ? (pmt[1][0]*d0 + pmt[1][1]*d1 + pmt[1][2]*d2) * 1000 : 0.0;
+      s.vz[k] = ok ? (pmt[2][0]*d0 + pmt[2][1]*d1 + pmt[2][2]*d2) * 1000 : 0.0;
+    }
+}
+
+}
@@ -0,0 +1,186 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef SATELLITE_CONSTELLATION_H
+#define SATELLITE_CONSTELLATION_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/type-id.h"
+#include "ns3/vector.h"
+
+#include "julian-date.h"
+#include "satellite.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * @brief Propagates a whole set of satellites to a common time in one pass.
+ *
+ * Satellite::GetPosition runs SGP4 and builds the TEME->ITRF conversion
+ * matrices for a single satellite at a time. In a constellation, every
+ * satellite is asked for its position at the same instants, so this class
+ * keeps the near-Earth SGP4 elements of all satellites in a structure of
+ * arrays and advances all of them with straight-line loops over those arrays,
+ * sharing one GMST/polar-motion rotation per time instant. The results match
+ * the ones of Satellite::GetPositionVelocity.
+ *
+ * Deep-space satellites (orbital period of 225 minutes or more) and satellites
+ * that have not been initialized are propagated one by one through their
+ * Satellite object.
+ *
+ * The few most recently propagated time instants are kept, so mobility models
+ * and channels sampling the orbits at several instants (e.g. to interpolate
+ * between them) do not make the constellation propagate back and forth.
+ */
+class SatelliteConstellation : public Object {
+public:
+  /**
+   * @brief Get the type ID.
+   * @return the object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * @brief Default constructor.
+   */
+  SatelliteConstellation (void);
+
+  /**
+   * @brief Add a satellite to the constellation.
+   *
+   * The orbital elements are read on the next propagation, so the TLE
+   * information may also be set after adding the satellite.
+   * @param sat the satellite.
+   * @return the index of the satellite within the constellation.
+   */
+  uint32_t Add (Ptr<Satellite> sat);
+
+  /**
+   * @brief Get the number of satellites in the constellation.
+   * @return the number of satellites.
+   */
+  uint32_t GetN (void) const;
+
+  /**
+   * @brief Get a satellite of the constellation.
+   * @param i the index returned by Add.
+   * @return the satellite.
+   */
+  Ptr<Satellite> GetSatellite (uint32_t i) const;
+
+  /**
+   * @brief Propagate all satellites to a given time.
+   *
+   * Does nothing if the constellation has already been propagated to t.
+   * @param t When.
+   */
+  void Propagate (const JulianDate &t);
+
+  /**
+   * @brief Get a satellite's position and velocity at a given time.
+   *
+   * Propagates the whole constellation if it has not yet been propagated to t.
+   * @param i the index returned by Add.
+   * @param t When.
+   * @param position the position, in meters, on ITRF coordinate frame.
+   * @param velocity the velocity, in m/s, on ITRF coordinate frame.
+   */
+  void GetPositionVelocity (
+    uint32_t i, const JulianDate &t, Vector3D &position, Vector3D &velocity
+  );
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /// number of time instants kept: the two samples around the current time
+  /// of the mobility models, plus the boundary and check samples of an
+  /// interval of the propagation delay tables
+  static const uint32_t N_STATES = 8;
+
+  /// positions and velocities of all satellites at one time instant
+  struct State {
+    JulianDate t;
+    bool valid;
+    uint64_t used;                              //!< last use, for replacement
+    std::vector<double> rx, ry, rz;             //!< position (m, ITRF)
+    std::vector<double> vx, vy, vz;             //!< velocity (m/s, ITRF)
+  };
+
+  /**
+   * @brief Copy the SGP4 elements of all satellites into the arrays.
+   */
+  void Load (void);
+
+  /**
+   * @brief Propagate satellites [begin, end) of the near-Earth arrays.
+   * @param t When.
+   * @param begin first index into the near-Earth arrays.
+   * @param end one past the last index into the near-Earth arrays.
+   * @param s where to store the result (at the same indexes).
+   */
+  void PropagateNearEarth (
+    const JulianDate &t, uint32_t begin, uint32_t end, State &s
+  );
+
+  /**
+   * @brief Get the state for a given time, propagating if needed.
+   * @param t When.
+   * @return the state at t.
+   */
+  const State& GetState (const JulianDate &t);
+
+  std::vector<Ptr<Satellite> > m_satellites;    //!< all satellites.
+  bool m_loaded;                                //!< arrays match m_satellites.
+  uint64_t m_uses;                              //!< state use counter.
+  State m_states[N_STATES];                     //!< most recent states.
+
+  /// index of the satellites propagated through the near-Earth arrays (in the
+  /// order of the arrays), and of the others (deep space / uninitialized)
+  std::vector<uint32_t> m_nearEarth, m_other;
+  /// position of each satellite in the State arrays: near-Earth satellites
+  /// first, in array order, then the others
+  std::vector<uint32_t> m_slot;
+
+  /// distinct TLE epochs (constellations usually share one), as the time
+  /// difference between two JulianDate objects is costly to compute
+  std::vector<JulianDate> m_epochs;
+
+  /// near-Earth SGP4 elements, one entry per satellite in m_nearEarth (see
+  /// elsetrec for their meaning)
+  std::vector<uint32_t> m_epoch;                //!< index into m_epochs
+  std::vector<int> m_isimp;
+  std::vector<double> m_mo, m_mdot, m_argpo, m_argpdot, m_nodeo, m_nodedot,
+    m_nodecf, m_cc1, m_cc4, m_cc5, m_bstar, m_t2cof, m_t3cof, m_t4cof,
+    m_t5cof, m_omgcof, m_eta, m_xmcof, m_delmo, m_d2, m_d3, m_d4, m_sinmao,
+    m_no, m_ecco, m_inclo, m_sinio, m_cosio, m_aycof, m_xlcof, m_con41,
+    m_x1mth2, m_x7thm1;
+
+  /// intermediate values between the propagation passes
+  std::vector<double> m_epochTsince, m_tsince, m_am, m_nm, m_axnl, m_aynl, m_u, m_nodep,
+    m_eo1, m_tem5, m_sineo1, m_coseo1;
+  std::vector<int> m_error;
+};
+
+}
+
+#endif /* SATELLITE_CONSTELLATION_H */
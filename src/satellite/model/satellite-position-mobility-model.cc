@@ -22,7 +22,10 @@
 
 #include "satellite-position-mobility-model.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
 #include "ns3/mobility-model.h"
 #include "ns3/ptr.h"
 #include "ns3/satellite.h"
@@ -43,14 +46,32 @@ SatellitePositionMobilityModel::GetTypeId (void) {
     .AddAttribute("SatellitePositionHelper",
                   "The satellite position helper that holds the satellite reference of this node",
                   SatellitePositionHelperValue(SatellitePositionHelper()),
-                  MakeSatellitePositionHelperAccessor (&SatellitePositionMobilityModel::m_helper),
+                  MakeSatellitePositionHelperAccessor (&SatellitePositionMobilityModel::SetHelper,
+                                                       &SatellitePositionMobilityModel::GetHelper),
                   MakeSatellitePositionHelperChecker())
+    .AddAttribute("CacheResolution",
+                  "Spacing between the orbit samples that are propagated. Zero propagates the "
+                  "exact position once per simulation time instant and serves repeated queries "
+                  "at that instant from the cache.",
+                  TimeValue (Seconds (0)),
+                  MakeTimeAccessor (&SatellitePositionMobilityModel::m_resolution),
+                  MakeTimeChecker (Seconds (0)))
+    .AddAttribute("CacheInterpolation",
+                  "With a non-zero CacheResolution, interpolate between the two enclosing samples "
+                  "(cubic Hermite on position and velocity) instead of returning the previous sample.",
+                  BooleanValue (true),
+                  MakeBooleanAccessor (&SatellitePositionMobilityModel::m_interpolate),
+                  MakeBooleanChecker ())
   ;
 
   return tid;
 }
 
-SatellitePositionMobilityModel::SatellitePositionMobilityModel (void) { }
+SatellitePositionMobilityModel::SatellitePositionMobilityModel (void)
+  : m_constellationIndex (0),
+    m_valid (false),
+    m_samplesValid (false)
+{ }
 SatellitePositionMobilityModel::~SatellitePositionMobilityModel (void) { }
 
 std::string
@@ -75,18 +96,155 @@ void
 SatellitePositionMobilityModel::SetSatellite (Ptr<Satellite> sat)
 {
   m_helper.SetSatellite (sat);
+  Flush ();
 }
 
 void
 SatellitePositionMobilityModel::SetStartTime (const JulianDate &t)
 {
   m_helper.SetStartTime (t);
+  Flush ();
+}
+
+void
+SatellitePositionMobilityModel::SetConstellation (
+  Ptr<SatelliteConstellation> constellation, uint32_t index
+)
+{
+  NS_ASSERT (!constellation || index < constellation->GetN ());
+
+  m_constellation = constellation;
+  m_constellationIndex = index;
+  Flush ();
+}
+
+void
+SatellitePositionMobilityModel::GetPositionVelocity (
+  Time t, Vector3D &position, Vector3D &velocity
+) const
+{
+  Sample s = Propagate (t);
+
+  position = s.position;
+  velocity = s.velocity;
+}
+
+SatellitePositionHelper
+SatellitePositionMobilityModel::GetHelper (void) const
+{
+  return m_helper;
+}
+
+void
+SatellitePositionMobilityModel::SetHelper (SatellitePositionHelper helper)
+{
+  m_helper = helper;
+  Flush ();
+}
+
+void
+SatellitePositionMobilityModel::Flush (void)
+{
+  m_valid = false;
+  m_samplesValid = false;
+}
+
+SatellitePositionMobilityModel::Sample
+SatellitePositionMobilityModel::Propagate (Time t) const
+{
+  Sample s;
+  s.t = t;
+  if (m_constellation)
+    {
+      m_constellation->GetPositionVelocity (
+        m_constellationIndex, m_helper.GetStartTime () + t, s.position, s.velocity
+      );
+      return s;
+    }
+
+  Ptr<Satellite> sat = m_helper.GetSatellite ();
+  if (!sat)
+    return s;
+
+  sat->GetPositionVelocity (m_helper.GetStartTime () + t, s.position, s.velocity);
+  return s;
+}
+
+void
+SatellitePositionMobilityModel::Update (void) const
+{
+  Time now = Simulator::Now ();
+  if (m_valid && m_current.t == now)
+    return;
+
+  if (m_resolution.IsZero ())
+    {
+      m_current = Propagate (now);
+      m_valid = true;
+      return;
+    }
+
+  // samples at k*resolution and (k+1)*resolution with k*resolution <= now
+  int64_t k = now.GetTimeStep () / m_resolution.GetTimeStep ();
+  Time t0 = m_resolution * k;
+  if (!m_samplesValid || m_samples[0].t != t0)
+    {
+      if (m_samplesValid && m_samples[1].t == t0)
+        {
+          m_samples[0] = m_samples[1];
+        }
+      else
+        {
+          m_samples[0] = Propagate (t0);
+        }
+      m_samples[1] = Propagate (t0 + m_resolution);
+      m_samplesValid = true;
+    }
+
+  m_current.t = now;
+  m_valid = true;
+  if (!m_interpolate || now == t0)
+    {
+      m_current.position = m_samples[0].position;
+      m_current.velocity = m_samples[0].velocity;
+      return;
+    }
+
+  // cubic Hermite spline on the unit interval
+  double h = m_resolution.GetSeconds ();
+  double tau = (now - t0).GetSeconds () / h;
+  double tau2 = tau*tau;
+  double tau3 = tau2*tau;
+  double h00 = 2*tau3 - 3*tau2 + 1;
+  double h10 = tau3 - 2*tau2 + tau;
+  double h01 = -2*tau3 + 3*tau2;
+  double h11 = tau3 - tau2;
+  double d00 = 6*tau2 - 6*tau;
+  double d10 = 3*tau2 - 4*tau + 1;
+  double d01 = -6*tau2 + 6*tau;
+  double d11 = 3*tau2 - 2*tau;
+
+  const Vector3D &p0 = m_samples[0].position;
+  const Vector3D &v0 = m_samples[0].velocity;
+  const Vector3D &p1 = m_samples[1].position;
+  const Vector3D &v1 = m_samples[1].velocity;
+  m_current.position = Vector3D (
+    h00*p0.x + h10*h*v0.x + h01*p1.x + h11*h*v1.x,
+    h00*p0.y + h10*h*v0.y + h01*p1.y + h11*h*v1.y,
+    h00*p0.z + h10*h*v0.z + h01*p1.z + h11*h*v1.z
+  );
+  m_current.velocity = Vector3D (
+    (d00*p0.x + d01*p1.x)/h + d10*v0.x + d11*v1.x,
+    (d00*p0.y + d01*p1.y)/h + d10*v0.y + d11*v1.y,
+    (d00*p0.z + d01*p1.z)/h + d10*v0.z + d11*v1.z
+  );
 }
 
 Vector3D
 SatellitePositionMobilityModel::DoGetPosition (void) const
 {
-  return m_helper.GetPosition ();
+  Update ();
+  return m_current.position;
 }
 
 void
@@ -99,7 +257,8 @@ SatellitePositionMobilityModel::DoSetPosition (const Vector3D &position)
 Vector3D
 SatellitePositionMobilityModel::DoGetVelocity (void) const
 {
-  return m_helper.GetVelocity ();
+  Update ();
+  return m_current.velocity;
 }
 
 }
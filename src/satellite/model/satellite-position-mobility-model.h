@@ -28,6 +28,7 @@
 #include "ns3/mobility-model.h"
 #include "ns3/ptr.h"
 #include "ns3/satellite.h"
+#include "ns3/satellite-constellation.h"
 #include "ns3/type-id.h"
 
 #include "satellite-position-helper.h"
@@ -96,12 +97,74 @@ public:
    */
   void SetStartTime (const JulianDate &t);
 
+  /**
+   * @brief Propagate the orbit through a constellation instead of the
+   *        underlying Satellite object.
+   *
+   * All mobility models sharing the constellation are then served from one
+   * propagation of the whole constellation per time instant. This only pays
+   * off with a non-zero CacheResolution: the models then all ask for the same
+   * instants on the grid, while exact positions are asked for at nearly
+   * every packet's own instant, each of which would cost a propagation of the
+   * whole constellation.
+   * @param constellation the constellation (null to propagate the satellite
+   *        on its own again).
+   * @param index the index of this model's satellite within the constellation.
+   */
+  void SetConstellation (Ptr<SatelliteConstellation> constellation, uint32_t index);
+
+  /**
+   * @brief Get the exact position and velocity at any simulation time.
+   *
+   * Unlike GetPosition and GetVelocity, neither uses nor changes the cache.
+   * @param t the simulation time.
+   * @param position the position, in meters, on ITRF coordinate frame.
+   * @param velocity the velocity, in m/s, on ITRF coordinate frame.
+   */
+  void GetPositionVelocity (Time t, Vector3D &position, Vector3D &velocity) const;
+
 private:
   virtual Vector DoGetPosition (void) const;
   virtual void DoSetPosition (const Vector &position);
   virtual Vector DoGetVelocity (void) const;
 
+  /// orbit sample (position and velocity on ITRF) at a simulation time
+  struct Sample {
+    Time t;
+    Vector3D position;
+    Vector3D velocity;
+  };
+
+  SatellitePositionHelper GetHelper (void) const;
+  void SetHelper (SatellitePositionHelper helper);
+
+  /**
+   * @brief Propagate the orbit to simulation time t.
+   */
+  Sample Propagate (Time t) const;
+
+  /**
+   * @brief Update the cache for the current simulation time.
+   *
+   * Without a cache resolution, m_current holds the exact position and velocity
+   * at the current simulation time. Otherwise m_samples hold the samples around
+   * it and m_current is interpolated (or taken from the previous sample).
+   */
+  void Update (void) const;
+
+  /// Invalidate all cached samples.
+  void Flush (void);
+
   SatellitePositionHelper m_helper;     //!< helper for orbital computations
+  Ptr<SatelliteConstellation> m_constellation;  //!< batch propagator (optional)
+  uint32_t m_constellationIndex;        //!< index of the satellite in m_constellation
+  Time m_resolution;                    //!< spacing between cached orbit samples (0: exact)
+  bool m_interpolate;                   //!< interpolate between samples (cubic Hermite)
+
+  mutable bool m_valid;                 //!< m_current is valid for m_current.t
+  mutable Sample m_current;             //!< position/velocity at the last queried time
+  mutable bool m_samplesValid;          //!< m_samples are valid
+  mutable Sample m_samples[2];          //!< samples enclosing the last queried time
 };
 
 } // namespace ns3
@@ -131,6 +131,36 @@ Satellite::GetVelocity (const JulianDate &t) const
   );
 }
 
+void
+Satellite::GetPositionVelocity (
+  const JulianDate &t, Vector3D &position, Vector3D &velocity
+) const
+{
+  double r[3], v[3];
+  double delta = (t - GetTleEpoch ()).GetMinutes();
+
+  position = Vector3D ();
+  velocity = Vector3D ();
+
+  if (!IsInitialized ())
+    return;
+
+  sgp4 (WGeoSys, m_sgp4_record, delta, r, v);
+
+  if (m_sgp4_record.error != 0)
+    return;
+
+  Matrix pmt = PefToItrf (t);                   // PEF->ITRF matrix transposed
+  Matrix tmt = TemeToPef (t);                   // TEME->PEF matrix
+  Vector3D rteme (r[0], r[1], r[2]);
+  Vector3D w (0.0, 0.0, t.GetOmegaEarth ());
+
+  // same expressions as GetPosition and GetVelocity: SGP4 works in km and
+  // km/s, the results are scaled to m and m/s
+  position = pmt*(tmt*rteme)*1000;
+  velocity = 1000*(pmt*((tmt*Vector3D (v[0], v[1], v[2])) - CrossProduct (w, tmt*rteme)));
+}
+
 /*
  * This function uses the WGS84 constants as defined by the National
  * Geospatial-Intelligence Agency (NGA) on the report published on 2014-07-08
@@ -183,6 +213,19 @@ Satellite::GetOrbitalPeriod (void) const
   return MilliSeconds (60000*2*M_PI/m_sgp4_record.no);
 }
 
+double
+Satellite::GetPerigeeRadius (void) const
+{
+  if (!IsInitialized ())
+    return 0;
+
+  double tumin, mu, radiusearthkm, xke, j2, j3, j4, j3oj2;
+  getgravconst (WGeoSys, tumin, mu, radiusearthkm, xke, j2, j3, j4, j3oj2);
+
+  // altp: perigee altitude, in Earth radii
+  return (1.0 + m_sgp4_record.altp)*radiusearthkm*1000;
+}
+
 void
 Satellite::SetName (const std::string &name)
 {
@@ -135,6 +135,19 @@ public:
    */
   Vector3D GetVelocity (const JulianDate &t) const;
 
+  /**
+   * @brief Get the satellite's position and velocity with a single propagation.
+   *
+   * Equivalent to GetPosition (t) and GetVelocity (t), but runs SGP4/SDP4 and
+   * builds the coordinate conversion matrices only once.
+   * @param t When.
+   * @param position the position, in meters, on ITRF coordinate frame.
+   * @param velocity the velocity, in m/s, on ITRF coordinate frame.
+   */
+  void GetPositionVelocity (
+    const JulianDate &t, Vector3D &position, Vector3D &velocity
+  ) const;
+
   /**
    * @brief Get the predicted satellite's geographic position at a given time.
    * @param t When.
@@ -150,6 +163,16 @@ public:
    */
   Time GetOrbitalPeriod (void) const;
 
+  /**
+   * @brief Get the radius of the satellite's perigee.
+   *
+   * The perigee is the one of the mean orbit described by the TLE; the actual
+   * distance to the Earth's center oscillates by a few kilometers around it.
+   * @return the distance, in meters, between the Earth's center and the
+   *         perigee (0 if the satellite has not been initialized).
+   */
+  double GetPerigeeRadius (void) const;
+
   /**
    * @brief Set satellite's name.
    * @param name Satellite's name.
@@ -181,6 +204,9 @@ public:
   static std::string ExtractTleSatInfo (const std::string &info);
 
 private:
+  /// propagates the SGP4 records of many satellites at once
+  friend class SatelliteConstellation;
+
   /// row of a Matrix
   struct Row {
     double r[3];
@@ -230,6 +230,12 @@ VisualSimulatorImpl::GetEventCount (void) const
   return m_simulator->GetEventCount ();
 }
 
+uint64_t
+VisualSimulatorImpl::GetPendingEventCount (void) const
+{
+  return m_simulator->GetPendingEventCount ();
+}
+
 void
 VisualSimulatorImpl::RunRealSimulator (void)
 {